@@ -0,0 +1,344 @@
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+#include "ristra/elements/assembly.h"
+#include "ristra/elements/jacobian.h"
+#include "ristra/atomics/src/atomics.h"
+#include "ristra/assertions/errors.h"
+
+namespace ristra {
+namespace elements{
+
+namespace {
+
+// runs body(begin, end, thread) over [0, n_items) split in contiguous
+// chunks, one per thread
+template<class Body>
+void parallel_for(const int &n_items, const int &n_threads, Body body){
+
+   int n_used = std::max(1, std::min(n_threads, n_items));
+
+   if (n_used == 1){
+      body(0, n_items, 0);
+      return;
+   }
+
+   vector<std::thread> threads;
+   threads.reserve(n_used);
+
+   for (int t = 0; t < n_used; t++){
+      int begin = (n_items*t)/n_used;
+      int end   = (n_items*(t + 1))/n_used;
+      threads.emplace_back(body, begin, end, t);
+   }
+
+   for (auto &thread : threads) thread.join();
+}
+
+// local mass or stiffness matrix of one element from the reference table,
+// scratch holds at least 2*n_node*Dim values
+template<int Dim>
+void element_matrix_kernel(
+   real_t *local,
+   real_t *scratch,
+   const reference_table &table,
+   const real_t *coords,
+   const int *elem_nodes,
+   const bool &stiffness){
+
+   int n_node = table.n_node;
+
+   real_t *verts = scratch;                 // [n_node][Dim]
+   real_t *grad  = scratch + n_node*Dim;    // [n_node][Dim]
+
+   for (int node = 0; node < n_node; node++)
+      for (int d = 0; d < Dim; d++)
+         verts[node*Dim + d] = coords[elem_nodes[node]*Dim + d];
+
+   for (int i = 0; i < n_node*n_node; i++) local[i] = 0.0;
+
+   for (int qp = 0; qp < table.n_qp; qp++){
+
+      const real_t *partials = table.partials.data() + qp*n_node*Dim;
+
+      real_t J[Dim][Dim];
+      jacobian_kernel<Dim>(J, verts, partials, n_node);
+      real_t det = determinant_kernel<Dim>(J);
+      real_t w = table.weights[qp]*std::abs(det);
+
+      if (!stiffness){
+         const real_t *phi = table.basis.data() + qp*n_node;
+
+         for (int a = 0; a < n_node; a++){
+            real_t w_a = w*phi[a];
+            for (int b = 0; b < n_node; b++) local[a*n_node + b] += w_a*phi[b];
+         }
+         continue;
+      }
+
+      // physical gradients, grad_x = J^-1 grad_xi
+      real_t J_inv[Dim][Dim];
+      inverse_kernel<Dim>(J_inv, J, det);
+
+      for (int node = 0; node < n_node; node++){
+         for (int k = 0; k < Dim; k++){
+            real_t sum = 0.0;
+            for (int j = 0; j < Dim; j++) sum += J_inv[k][j]*partials[node*Dim + j];
+            grad[node*Dim + k] = sum;
+         }
+      }
+
+      for (int a = 0; a < n_node; a++){
+         for (int b = 0; b < n_node; b++){
+            real_t dot = 0.0;
+            for (int k = 0; k < Dim; k++) dot += grad[a*Dim + k]*grad[b*Dim + k];
+            local[a*n_node + b] += w*dot;
+         }
+      }
+   } // end for qp
+}
+
+} // namespace
+
+
+// position of (row, col) in col_idx/values, -1 if it is not stored
+int csr_matrix::find(const int &row, const int &col) const {
+
+   auto first = col_idx.begin() + row_ptr[row];
+   auto last  = col_idx.begin() + row_ptr[row + 1];
+   auto it = std::lower_bound(first, last, col);
+
+   if (it == last || *it != col) return -1;
+   return static_cast<int>(it - col_idx.begin());
+}
+
+// y = A x
+void csr_matrix::multiply(real_t *y, const real_t *x) const {
+
+   for (int row = 0; row < n_rows; row++){
+      real_t sum = 0.0;
+      for (int k = row_ptr[row]; k < row_ptr[row + 1]; k++)
+         sum += values[k]*x[col_idx[k]];
+      y[row] = sum;
+   }
+}
+
+
+// sparsity pattern of the global matrix
+void build_sparsity(
+   csr_matrix &matrix,
+   const int *connectivity,
+   const int &n_elem,
+   const int &n_node,
+   const int &n_global){
+
+   // elements around each node
+   vector<int> node_ptr(n_global + 1, 0);
+   for (int i = 0; i < n_elem*n_node; i++) node_ptr[connectivity[i] + 1]++;
+   for (int n = 0; n < n_global; n++) node_ptr[n + 1] += node_ptr[n];
+
+   vector<int> node_elems(node_ptr[n_global]);
+   vector<int> fill(node_ptr.begin(), node_ptr.end() - 1);
+   for (int elem = 0; elem < n_elem; elem++)
+      for (int node = 0; node < n_node; node++)
+         node_elems[fill[connectivity[elem*n_node + node]]++] = elem;
+
+   matrix.n_rows = n_global;
+   matrix.row_ptr.assign(n_global + 1, 0);
+   matrix.col_idx.clear();
+
+   // the columns of a row are the nodes of the elements around it
+   vector<int> cols;
+   for (int row = 0; row < n_global; row++){
+      cols.clear();
+      for (int k = node_ptr[row]; k < node_ptr[row + 1]; k++){
+         const int *elem_nodes = connectivity + node_elems[k]*n_node;
+         cols.insert(cols.end(), elem_nodes, elem_nodes + n_node);
+      }
+      std::sort(cols.begin(), cols.end());
+      cols.erase(std::unique(cols.begin(), cols.end()), cols.end());
+
+      matrix.col_idx.insert(matrix.col_idx.end(), cols.begin(), cols.end());
+      matrix.row_ptr[row + 1] = matrix.nnz();
+   } // end for row
+
+   matrix.values.assign(matrix.nnz(), 0.0);
+} // end of build_sparsity
+
+// greedy coloring such that elements of one color share no node
+int color_elements(
+   int *colors,
+   const int *connectivity,
+   const int &n_elem,
+   const int &n_node,
+   const int &n_global){
+
+   // bit c of node_colors[n] is set once an element of color c touches n,
+   // colors past 63 are kept in per node lists
+   vector<unsigned long long> node_colors(n_global, 0);
+   vector< vector<int> > node_high_colors;
+   int n_colors = 0;
+
+   for (int elem = 0; elem < n_elem; elem++){
+      const int *elem_nodes = connectivity + elem*n_node;
+
+      unsigned long long taken = 0;
+      for (int node = 0; node < n_node; node++) taken |= node_colors[elem_nodes[node]];
+
+      int color = 0;
+      while (color < 64 && (taken >> color) & 1ULL) color++;
+
+      if (color == 64){
+         if (node_high_colors.empty()) node_high_colors.resize(n_global);
+
+         vector<bool> used(n_colors, false);
+         for (int node = 0; node < n_node; node++)
+            for (int c : node_high_colors[elem_nodes[node]]) used[c] = true;
+         while (color < n_colors && used[color]) color++;
+
+         for (int node = 0; node < n_node; node++)
+            node_high_colors[elem_nodes[node]].push_back(color);
+      }
+      else {
+         for (int node = 0; node < n_node; node++)
+            node_colors[elem_nodes[node]] |= 1ULL << color;
+      }
+
+      colors[elem] = color;
+      n_colors = std::max(n_colors, color + 1);
+   } // end for elem
+
+   return n_colors;
+} // end of color_elements
+
+
+assembler::assembler(
+   const element_type &type,
+   const real_t *coords,
+   const int &n_global,
+   const int *connectivity,
+   const int &n_elem,
+   const quadrature_rule &rule,
+   const int &quad_order,
+   const assembly_options &options,
+   const int &elem_order)
+   : table_(&reference_cache::instance().get(type, rule, quad_order, elem_order)),
+     coords_(coords),
+     connectivity_(connectivity),
+     n_global_(n_global),
+     n_elem_(n_elem),
+     n_node_(table_->n_node),
+     dim_(table_->dim),
+     options_(options){
+
+   if (options_.n_threads <= 0)
+      options_.n_threads = std::max(1u, std::thread::hardware_concurrency());
+
+   build_sparsity(sparsity_, connectivity_, n_elem_, n_node_, n_global_);
+
+   colors_.resize(n_elem_);
+   n_colors_ = color_elements(colors_.data(), connectivity_, n_elem_, n_node_,
+      n_global_);
+
+   // elements bucketed by color
+   color_ptr_.assign(n_colors_ + 1, 0);
+   for (int elem = 0; elem < n_elem_; elem++) color_ptr_[colors_[elem] + 1]++;
+   for (int c = 0; c < n_colors_; c++) color_ptr_[c + 1] += color_ptr_[c];
+
+   color_elems_.resize(n_elem_);
+   vector<int> fill(color_ptr_.begin(), color_ptr_.end() - 1);
+   for (int elem = 0; elem < n_elem_; elem++) color_elems_[fill[colors_[elem]]++] = elem;
+}
+
+// global mass matrix
+void assembler::mass(csr_matrix &matrix) const {
+   assemble(matrix, element_operator::mass);
+}
+
+// global stiffness (Laplacian) matrix
+void assembler::stiffness(csr_matrix &matrix) const {
+   assemble(matrix, element_operator::stiffness);
+}
+
+// local matrix of one element
+void assembler::element_matrix(
+   real_t *local,
+   real_t *scratch,
+   const int &elem,
+   const element_operator &op) const {
+
+   const int *elem_nodes = connectivity_ + elem*n_node_;
+   bool stiffness = (op == element_operator::stiffness);
+
+   if (dim_ == 2)
+      element_matrix_kernel<2>(local, scratch, *table_, coords_, elem_nodes, stiffness);
+   else if (dim_ == 3)
+      element_matrix_kernel<3>(local, scratch, *table_, coords_, elem_nodes, stiffness);
+   else
+      THROW_IMPLEMENTED_ERROR("assembly is only defined in 2D and 3D");
+}
+
+void assembler::assemble(csr_matrix &matrix, const element_operator &op) const {
+
+   matrix = sparsity_;
+
+   int n_threads = options_.n_threads;
+   int local_size = n_node_*n_node_;
+   int scratch_size = 2*n_node_*dim_;
+
+   // per thread work space
+   vector< vector<real_t> > local(n_threads, vector<real_t>(local_size));
+   vector< vector<real_t> > scratch(n_threads, vector<real_t>(scratch_size));
+
+   if (options_.mode == scatter_mode::coloring){
+
+      // no two elements of a color share a row, plain adds are safe
+      for (int c = 0; c < n_colors_; c++){
+         const int *elems = color_elems_.data() + color_ptr_[c];
+
+         parallel_for(color_ptr_[c + 1] - color_ptr_[c], n_threads,
+            [&](int begin, int end, int t){
+               real_t *A = local[t].data();
+
+               for (int i = begin; i < end; i++){
+                  int elem = elems[i];
+                  const int *elem_nodes = connectivity_ + elem*n_node_;
+                  element_matrix(A, scratch[t].data(), elem, op);
+
+                  for (int a = 0; a < n_node_; a++)
+                     for (int b = 0; b < n_node_; b++)
+                        matrix.values[matrix.find(elem_nodes[a], elem_nodes[b])]
+                           += A[a*n_node_ + b];
+               }
+            });
+      } // end for c
+   }
+   else {
+
+      using atomic_real = atomics::atomic<real_t, atomics::strong>;
+      // the default constructor leaves the value uninitialized
+      vector<atomic_real> values(matrix.nnz());
+      for (auto &value : values) value.store(0.0);
+
+      parallel_for(n_elem_, n_threads,
+         [&](int begin, int end, int t){
+            real_t *A = local[t].data();
+
+            for (int elem = begin; elem < end; elem++){
+               const int *elem_nodes = connectivity_ + elem*n_node_;
+               element_matrix(A, scratch[t].data(), elem, op);
+
+               for (int a = 0; a < n_node_; a++)
+                  for (int b = 0; b < n_node_; b++)
+                     values[matrix.find(elem_nodes[a], elem_nodes[b])]
+                        .add(A[a*n_node_ + b]);
+            }
+         });
+
+      for (int k = 0; k < matrix.nnz(); k++) matrix.values[k] = values[k].load();
+   }
+} // end of assemble
+
+} // end namespace elements
+} // end namespace ristra
@@ -0,0 +1,150 @@
+#ifndef ELEMENTS_ASSEMBLY_H
+#define ELEMENTS_ASSEMBLY_H
+
+#include "ristra/elements/batched.h"
+#include "ristra/elements/quadrature.h"
+#include "ristra/elements/reference_cache.h"
+#include "ristra/elements/utilities.h"
+
+namespace ristra{
+namespace elements{
+
+/*
+ ==========================
+  Global assembly
+ ==========================
+
+ Assembles global mass and stiffness (Laplacian) matrices from a mesh of one
+ element type into compressed sparse row storage,
+
+    M_ij = sum_elem sum_qp w |det J| phi_i phi_j
+    K_ij = sum_elem sum_qp w |det J| grad phi_i . grad phi_j
+
+ The mesh is given as node coordinates coords[n_global][dim] and element
+ connectivity[n_elem][n_node], with the element nodes in the order of the
+ element class.
+
+ Elements are split over threads. In the coloring mode the elements are
+ greedily colored so that no two elements of a color share a node; the
+ colors are assembled one after the other and the elements of one color in
+ parallel, each thread adding straight into the matrix. In the atomic mode
+ all elements run at once and every contribution is added atomically.
+*/
+
+// compressed sparse row matrix, the columns of each row are sorted
+struct csr_matrix {
+
+   int n_rows = 0;
+
+   vector<int> row_ptr;     // [n_rows + 1]
+   vector<int> col_idx;     // [nnz]
+   vector<real_t> values;   // [nnz]
+
+   // number of stored entries
+   int nnz() const { return static_cast<int>(col_idx.size()); }
+
+   // position of (row, col) in col_idx/values, -1 if it is not stored
+   int find(const int &row, const int &col) const;
+
+   // y = A x
+   void multiply(real_t *y, const real_t *x) const;
+};
+
+// sparsity pattern of the global matrix, every pair of nodes sharing an
+// element is stored, values are zeroed
+void build_sparsity(
+   csr_matrix &matrix,              // matrix to size
+   const int *connectivity,         // element nodes [n_elem][n_node]
+   const int &n_elem,               // number of elements
+   const int &n_node,               // nodes per element
+   const int &n_global);            // number of global nodes
+
+// greedy coloring such that elements of one color share no node, returns
+// the number of colors
+int color_elements(
+   int *colors,                     // color of each element [n_elem]
+   const int *connectivity,         // element nodes [n_elem][n_node]
+   const int &n_elem,               // number of elements
+   const int &n_node,               // nodes per element
+   const int &n_global);            // number of global nodes
+
+
+// how concurrent element contributions are added into the matrix
+enum class scatter_mode {
+   coloring,   // colors one after the other, no two threads touch one row
+   atomic      // every element at once, atomic adds
+};
+
+struct assembly_options {
+   scatter_mode mode = scatter_mode::coloring;
+   int n_threads = 0;   // 0 uses std::thread::hardware_concurrency
+};
+
+
+// Assembles operators on a fixed mesh. The sparsity pattern, the coloring
+// and the reference tables are built once, in the constructor, and reused
+// by every assembly. The mesh arrays are not copied and must outlive the
+// assembler, as must the reference_cache tables (do not clear the cache).
+class assembler {
+   public:
+
+      assembler(
+         const element_type &type,        // element type
+         const real_t *coords,            // node coordinates [n_global][dim]
+         const int &n_global,             // number of global nodes
+         const int *connectivity,         // element nodes [n_elem][n_node]
+         const int &n_elem,               // number of elements
+         const quadrature_rule &rule,     // quadrature rule
+         const int &quad_order,           // points per direction
+         const assembly_options &options = assembly_options(),
+         const int &elem_order = 0);      // element order (quadN/hexN only)
+
+      // global mass matrix
+      void mass(csr_matrix &matrix) const;
+
+      // global stiffness (Laplacian) matrix
+      void stiffness(csr_matrix &matrix) const;
+
+      // empty matrix with the sparsity of the mesh
+      const csr_matrix &sparsity() const { return sparsity_; }
+
+      int num_colors() const { return n_colors_; }
+      const vector<int> &colors() const { return colors_; }
+      const assembly_options &options() const { return options_; }
+
+   private:
+
+      // which operator assemble() builds
+      enum class element_operator { mass, stiffness };
+
+      void assemble(csr_matrix &matrix, const element_operator &op) const;
+
+      // local matrix of one element, local[n_node][n_node]
+      void element_matrix(
+         real_t *local,
+         real_t *scratch,
+         const int &elem,
+         const element_operator &op) const;
+
+      const reference_table *table_;
+
+      const real_t *coords_;
+      const int *connectivity_;
+      int n_global_;
+      int n_elem_;
+      int n_node_;
+      int dim_;
+
+      assembly_options options_;
+      csr_matrix sparsity_;
+
+      int n_colors_ = 0;
+      vector<int> colors_;            // [n_elem]
+      vector<int> color_ptr_;         // [n_colors + 1] into color_elems_
+      vector<int> color_elems_;       // elements sorted by color
+};
+
+} //end namespace elements
+} //end namespace ristra
+
+#endif //ELEMENTS_ASSEMBLY_H
@@ -0,0 +1,302 @@
+#include "ristra/elements/batched.h"
+#include "ristra/elements/elements.h"
+#include "ristra/elements/element_kernels.h"
+#include "ristra/elements/jacobian.h"
+#include "ristra/elements/node_sets.h"
+#include "ristra/assertions/errors.h"
+
+namespace ristra {
+namespace elements{
+
+// number of nodes of an element type
+int num_nodes(const element_type &type){
+
+   switch (type) {
+      case element_type::quad4:  return 4;
+      case element_type::quad8:  return 8;
+      case element_type::quad12: return 12;
+      case element_type::hex8:   return 8;
+      case element_type::hex20:  return 20;
+      case element_type::hex32:  return 32;
+      case element_type::tess16: return 16;
+      case element_type::quadN:
+      case element_type::hexN:
+         THROW_IMPLEMENTED_ERROR("the number of nodes of quadN/hexN "
+            "depends on the element order");
+   }
+   THROW_IMPLEMENTED_ERROR("unknown element type");
+   return 0;
+}
+
+// number of nodes of an element type, elem_order is only used by quadN/hexN
+int num_nodes(const element_type &type, const int &elem_order){
+
+   int N = elem_order + 1;
+
+   switch (type) {
+      case element_type::quadN: return N*N;
+      case element_type::hexN:  return N*N*N;
+      default: return num_nodes(type);
+   }
+}
+
+// number of reference dimensions of an element type
+int num_dim(const element_type &type){
+
+   switch (type) {
+      case element_type::quad4:
+      case element_type::quad8:
+      case element_type::quad12:
+      case element_type::quadN:
+         return 2;
+      case element_type::hex8:
+      case element_type::hex20:
+      case element_type::hex32:
+      case element_type::hexN:
+         return 3;
+      case element_type::tess16:
+         return 4;
+   }
+   THROW_IMPLEMENTED_ERROR("unknown element type");
+   return 0;
+}
+
+// basis values and reference partials at a set of points
+void reference_basis(
+   real_t *basis,
+   real_t *partials,
+   const real_t *points,
+   const int &n_qp,
+   const element_type &type){
+
+   // one dispatch for the whole set of points
+   visit_element_kernel(type, [&](auto kernel){
+      decltype(kernel)::reference_basis(basis, partials, points, n_qp);
+   });
+} // end of reference_basis
+
+// Lagrange (QuadN/HexN) basis values and reference partials at a set of points
+void lagrange_reference_basis(
+   real_t *basis,
+   real_t *partials,
+   const real_t *points,
+   const int &n_qp,
+   const int &dim,
+   const int &elem_order,
+   const node_spacing &spacing){
+
+   if (dim != 2 && dim != 3)
+      THROW_IMPLEMENTED_ERROR("lagrange basis is only defined in 2D and 3D");
+
+   int N = elem_order + 1;
+   int n_node = (dim == 2) ? N*N : N*N*N;
+
+   // nodes and barycentric weights are built once per order
+   const node_set &nodes = get_node_set(spacing, elem_order);
+
+   vector <real_t> val_1d(dim*N);
+   vector <real_t> DVal_1d(dim*N);
+   vector< vector<real_t> > lag_partial(n_node, vector<real_t>(dim));
+   vector <real_t> lag_basis(n_node);
+   vector <real_t> xi_point(dim);
+
+   const QuadN quadN;
+   const HexN  hexN;
+
+   for (int qp = 0; qp < n_qp; qp++){
+      for (int d = 0; d < dim; d++) xi_point[d] = points[qp*dim + d];
+
+      if (dim == 2)
+         quadN.basis_partials(lag_basis, lag_partial, val_1d, DVal_1d, xi_point, nodes);
+      else
+         hexN.basis_partials(lag_basis, lag_partial, val_1d, DVal_1d, xi_point, nodes);
+
+      for (int node = 0; node < n_node; node++){
+         basis[qp*n_node + node] = lag_basis[node];
+         for (int d = 0; d < dim; d++)
+            partials[(qp*n_node + node)*dim + d] = lag_partial[node][d];
+      } // end for node
+   } // end for qp
+} // end of lagrange_reference_basis
+
+// physical positions of the points in each element of a block
+void batched_physical_position(
+   real_t *x_points,
+   const real_t *vertices,
+   const real_t *basis,
+   const int &n_elem,
+   const int &n_qp,
+   const int &n_node,
+   const int &dim){
+
+   for (int elem = 0; elem < n_elem; elem++){
+
+      const real_t *elem_verts = vertices + elem*n_node*dim;
+
+      for (int qp = 0; qp < n_qp; qp++){
+
+         const real_t *qp_basis = basis + qp*n_node;
+         real_t *x = x_points + (elem*n_qp + qp)*dim;
+
+         for (int d = 0; d < dim; d++) x[d] = 0.0;
+
+         for (int node = 0; node < n_node; node++){
+            for (int d = 0; d < dim; d++){
+               x[d] += elem_verts[node*dim + d]*qp_basis[node];
+            } // end for d
+         } // end for node
+      } // end for qp
+   } // end for elem
+} // end of batched_physical_position
+
+// jacobian and its determinant at the points of each element of a block
+void batched_jacobian(
+   real_t *J_matrix,
+   real_t *det_J,
+   const real_t *vertices,
+   const real_t *partials,
+   const int &n_elem,
+   const int &n_qp,
+   const int &n_node,
+   const int &dim){
+
+   // fixed size kernels for the node counts of the library elements
+   if (dim == 2){
+      switch (n_node) {
+         case 4:
+            batched_jacobian_kernel<2, 4>(J_matrix, det_J, nullptr, vertices,
+               partials, n_elem, n_qp);
+            return;
+         case 8:
+            batched_jacobian_kernel<2, 8>(J_matrix, det_J, nullptr, vertices,
+               partials, n_elem, n_qp);
+            return;
+         case 12:
+            batched_jacobian_kernel<2, 12>(J_matrix, det_J, nullptr, vertices,
+               partials, n_elem, n_qp);
+            return;
+         default:
+            batched_jacobian_kernel<2>(J_matrix, det_J, nullptr, vertices,
+               partials, n_elem, n_qp, n_node);
+            return;
+      }
+   }
+   else if (dim == 3){
+      switch (n_node) {
+         case 8:
+            batched_jacobian_kernel<3, 8>(J_matrix, det_J, nullptr, vertices,
+               partials, n_elem, n_qp);
+            return;
+         case 20:
+            batched_jacobian_kernel<3, 20>(J_matrix, det_J, nullptr, vertices,
+               partials, n_elem, n_qp);
+            return;
+         case 32:
+            batched_jacobian_kernel<3, 32>(J_matrix, det_J, nullptr, vertices,
+               partials, n_elem, n_qp);
+            return;
+         default:
+            batched_jacobian_kernel<3>(J_matrix, det_J, nullptr, vertices,
+               partials, n_elem, n_qp, n_node);
+            return;
+      }
+   }
+   else if (dim == 4){
+      if (n_node == 16)
+         batched_jacobian_kernel<4, 16>(J_matrix, det_J, nullptr, vertices,
+            partials, n_elem, n_qp);
+      else
+         batched_jacobian_kernel<4>(J_matrix, det_J, nullptr, vertices,
+            partials, n_elem, n_qp, n_node);
+      return;
+   }
+   THROW_IMPLEMENTED_ERROR("batched jacobians are only defined in 2D to 4D");
+} // end of batched_jacobian
+
+// inverse of a set of jacobians given their determinants
+void batched_jacobian_inverse(
+   real_t *J_inverse,
+   const real_t *J_matrix,
+   const real_t *det_J,
+   const int &n_mat,
+   const int &dim){
+
+   if (dim == 2)
+      batched_inverse_kernel<2>(J_inverse, J_matrix, det_J, n_mat);
+   else if (dim == 3)
+      batched_inverse_kernel<3>(J_inverse, J_matrix, det_J, n_mat);
+   else if (dim == 4)
+      batched_inverse_kernel<4>(J_inverse, J_matrix, det_J, n_mat);
+   else
+      THROW_IMPLEMENTED_ERROR("batched inverses are only defined in 2D to 4D");
+} // end of batched_jacobian_inverse
+
+// evaluate a whole block of elements in one call
+void evaluate_block(
+   element_block &block,
+   const element_type &type,
+   const real_t *vertices,
+   const int &n_elem,
+   const real_t *points,
+   const int &n_qp){
+
+   int n_node = num_nodes(type);
+   int dim    = num_dim(type);
+
+   block.type   = type;
+   block.n_elem = n_elem;
+   block.n_qp   = n_qp;
+   block.n_node = n_node;
+   block.dim    = dim;
+
+   block.basis.resize(n_qp*n_node);
+   block.partials.resize(n_qp*n_node*dim);
+   block.table_basis    = nullptr;
+   block.table_partials = nullptr;
+   block.x_points.resize(n_elem*n_qp*dim);
+   block.J_matrix.resize(n_elem*n_qp*dim*dim);
+   block.det_J.resize(n_elem*n_qp);
+   block.J_inverse.resize(n_elem*n_qp*dim*dim);
+
+   // one dispatch per block, the kernel loops are compiled for the type
+   visit_element_kernel(type, [&](auto kernel){
+      decltype(kernel)::evaluate_block(block.basis.data(),
+         block.partials.data(), block.x_points.data(), block.J_matrix.data(),
+         block.det_J.data(), block.J_inverse.data(), vertices, n_elem, points,
+         n_qp);
+   });
+} // end of evaluate_block
+
+// evaluate a block of Tess16 elements
+void evaluate_tess16_block(
+   element_block &block,
+   const real_t *vertices,
+   const int &n_elem,
+   const real_t *points,
+   const int &n_qp){
+
+   const int n_node = tess16_kernel::num_nodes;
+   const int dim    = tess16_kernel::num_dim;
+
+   block.type   = element_type::tess16;
+   block.n_elem = n_elem;
+   block.n_qp   = n_qp;
+   block.n_node = n_node;
+   block.dim    = dim;
+
+   block.basis.resize(n_qp*n_node);
+   block.partials.resize(n_qp*n_node*dim);
+   block.table_basis    = nullptr;
+   block.table_partials = nullptr;
+   block.x_points.resize(n_elem*n_qp*dim);
+   block.J_matrix.resize(n_elem*n_qp*dim*dim);
+   block.det_J.resize(n_elem*n_qp);
+   block.J_inverse.resize(n_elem*n_qp*dim*dim);
+
+   tess16_kernel::evaluate_block(block.basis.data(), block.partials.data(),
+      block.x_points.data(), block.J_matrix.data(), block.det_J.data(),
+      block.J_inverse.data(), vertices, n_elem, points, n_qp);
+} // end of evaluate_tess16_block
+
+} // end namespace elements
+} // end namespace ristra
@@ -0,0 +1,149 @@
+#ifndef ELEMENTS_BATCHED_H
+#define ELEMENTS_BATCHED_H
+
+#include "ristra/elements/node_sets.h"
+#include "ristra/elements/utilities.h"
+
+namespace ristra{
+namespace elements{
+
+/*
+ ==========================
+  Batched evaluation
+ ==========================
+
+ Flat structure-of-arrays counterparts of the per point element routines.
+ Every buffer is a contiguous, row major array whose layout is given next to
+ the argument, e.g. vertices[n_elem][n_node][dim] is indexed as
+
+    vertices[(elem*n_node + node)*dim + d]
+
+ The reference basis and partials only depend on the quadrature points, so
+ they are evaluated once per block and shared by every element in it.
+*/
+
+// element types understood by the batched routines
+enum class element_type {
+   quad4,
+   quad8,
+   quad12,
+   hex8,
+   hex20,
+   hex32,
+   quadN,   // arbitrary order Lagrange quad (QuadN)
+   hexN,    // arbitrary order Lagrange hex (HexN)
+   tess16   // 4D tesseract (Tess16)
+};
+
+// number of nodes of a fixed order element type
+int num_nodes(const element_type &type);
+
+// number of nodes of an element type, elem_order is only used by quadN/hexN
+int num_nodes(const element_type &type, const int &elem_order);
+
+// number of reference dimensions of an element type
+int num_dim(const element_type &type);
+
+// basis values and reference partials at a set of points
+void reference_basis(
+   real_t *basis,                // basis values [n_qp][n_node]
+   real_t *partials,             // reference partials [n_qp][n_node][dim]
+   const real_t *points,         // reference points [n_qp][dim]
+   const int &n_qp,              // number of points
+   const element_type &type);    // element type (fixed order)
+
+// Lagrange (QuadN/HexN) basis values and reference partials at a set of
+// points, nodes are numbered xi fastest
+void lagrange_reference_basis(
+   real_t *basis,                // basis values [n_qp][n_node]
+   real_t *partials,             // reference partials [n_qp][n_node][dim]
+   const real_t *points,         // reference points [n_qp][dim]
+   const int &n_qp,              // number of points
+   const int &dim,               // dimension (2 or 3)
+   const int &elem_order,        // element order
+   const node_spacing &spacing = node_spacing::chebyshev);  // 1D node spacing
+
+// physical positions of the points in each element of a block
+void batched_physical_position(
+   real_t *x_points,             // physical positions [n_elem][n_qp][dim]
+   const real_t *vertices,       // element vertices [n_elem][n_node][dim]
+   const real_t *basis,          // basis values [n_qp][n_node]
+   const int &n_elem,            // number of elements
+   const int &n_qp,              // number of points
+   const int &n_node,            // nodes per element
+   const int &dim);              // dimension
+
+// jacobian and its determinant at the points of each element of a block,
+// J[j][k] = sum_node vertices[node][k] * partials[node][j]
+void batched_jacobian(
+   real_t *J_matrix,             // jacobians [n_elem][n_qp][dim][dim]
+   real_t *det_J,                // determinants [n_elem][n_qp]
+   const real_t *vertices,       // element vertices [n_elem][n_node][dim]
+   const real_t *partials,       // reference partials [n_qp][n_node][dim]
+   const int &n_elem,            // number of elements
+   const int &n_qp,              // number of points
+   const int &n_node,            // nodes per element
+   const int &dim);              // dimension
+
+// inverse of a set of jacobians given their determinants
+void batched_jacobian_inverse(
+   real_t *J_inverse,            // inverse jacobians [n_mat][dim][dim]
+   const real_t *J_matrix,       // jacobians [n_mat][dim][dim]
+   const real_t *det_J,          // determinants [n_mat]
+   const int &n_mat,             // number of matrices
+   const int &dim);              // dimension (2 or 3)
+
+
+// Results of evaluating a block of elements of one type at a set of points
+struct element_block {
+
+   element_type type;
+
+   int n_elem = 0;   // number of elements in the block
+   int n_qp   = 0;   // number of points per element
+   int n_node = 0;   // nodes per element
+   int dim    = 0;   // dimension
+
+   aligned_vector<real_t> basis;      // [n_qp][n_node]
+   aligned_vector<real_t> partials;   // [n_qp][n_node][dim]
+   aligned_vector<real_t> x_points;   // [n_elem][n_qp][dim]
+   aligned_vector<real_t> J_matrix;   // [n_elem][n_qp][dim][dim]
+   aligned_vector<real_t> det_J;      // [n_elem][n_qp]
+   aligned_vector<real_t> J_inverse;  // [n_elem][n_qp][dim][dim]
+
+   // set when evaluated from a cached reference table, which then owns the
+   // basis and partials and basis/partials above are left empty
+   const real_t *table_basis    = nullptr;   // [n_qp][n_node]
+   const real_t *table_partials = nullptr;   // [n_qp][n_node][dim]
+
+   // basis and partials of the block, wherever they are stored
+   const real_t *basis_data() const {
+      return table_basis ? table_basis : basis.data();
+   }
+   const real_t *partials_data() const {
+      return table_partials ? table_partials : partials.data();
+   }
+};
+
+// evaluate basis, partials, positions, jacobians, determinants and inverse
+// jacobians for a whole block of elements in one call
+void evaluate_block(
+   element_block &block,         // results (resized as needed)
+   const element_type &type,     // element type
+   const real_t *vertices,       // element vertices [n_elem][n_node][dim]
+   const int &n_elem,            // number of elements
+   const real_t *points,         // reference points [n_qp][dim]
+   const int &n_qp);             // number of points
+
+// evaluate_block for the 4D Tess16 element, block.type is tess16 and dim 4
+void evaluate_tess16_block(
+   element_block &block,         // results (resized as needed)
+   const real_t *vertices,       // element vertices [n_elem][16][4]
+   const int &n_elem,            // number of elements
+   const real_t *points,         // reference points [n_qp][4]
+   const int &n_qp);             // number of points
+
+} //end namespace elements
+} //end namespace ristra
+
+#endif //ELEMENTS_BATCHED_H
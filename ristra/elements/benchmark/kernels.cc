@@ -0,0 +1,326 @@
+/*
+ Throughput of the element kernels with a JSON baseline for regression
+ checks.
+
+ Usage:
+
+    elements_kernel_benchmark [--save file] [--compare file]
+                              [--threshold fraction] [--seconds s]
+
+ Every case reports points per second and the bytes its buffers move per
+ point (inputs read plus outputs written, tables shared by every element of
+ a block counted once). --save writes the results as JSON, --compare reads
+ a saved baseline and flags every case that is slower than the baseline by
+ more than the threshold (default 0.10), returning a nonzero exit code.
+ --seconds sets the minimum time spent on each case (default 0.2).
+*/
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+
+#include "ristra/elements/batched.h"
+#include "ristra/elements/element_kernels.h"
+#include "ristra/elements/elements.h"
+#include "ristra/elements/jacobian.h"
+#include "ristra/elements/quadrature.h"
+#include "ristra/elements/test/fixtures.h"
+
+namespace elements = ristra::elements;
+using ristra::elements::vector;
+using ristra::elements::real_t;
+using ristra::elements::fixtures::make_points;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+struct result_t {
+   std::string name;
+   double points_per_second = 0.0;
+   double bytes_per_point = 0.0;
+};
+
+double min_seconds = 0.2;
+
+// seconds per call of body, repeated until min_seconds have passed
+template<class Body>
+double time_per_call(Body body){
+
+   body();   // warm up
+
+   int calls = 0;
+   auto start = clock_type::now();
+   double elapsed = 0.0;
+
+   do {
+      body();
+      calls++;
+      elapsed = std::chrono::duration<double>(clock_type::now() - start).count();
+   } while (elapsed < min_seconds);
+
+   return elapsed/calls;
+}
+
+// keeps the compiler from discarding a result
+volatile real_t sink = 0.0;
+
+const int n_elem = 256;
+const int n_qp = 27;
+
+// basis and partials one point at a time through the element classes
+void bench_element_class(vector<result_t> &results, const std::string &name,
+   elements::Element3D &element, int n_node){
+
+   auto points = make_points(3, n_qp);
+   vector<real_t> xi(3), basis(n_node), p_xi(n_node), p_eta(n_node), p_mu(n_node);
+   vector< vector<real_t> > vertices(n_node, vector<real_t>(3, 0.0));
+
+   double t = time_per_call([&]{
+      for (int qp = 0; qp < n_qp; qp++){
+         for (int d = 0; d < 3; d++) xi[d] = points[qp*3 + d];
+         element.basis(basis, xi, vertices);
+         element.partial_xi_shape_fcn(p_xi, xi);
+         element.partial_eta_shape_fcn(p_eta, xi);
+         element.partial_mu_shape_fcn(p_mu, xi);
+      }
+      sink = basis[0] + p_mu[0];
+   });
+
+   results.push_back({"basis_point/" + name, n_qp/t,
+      (3.0 + 4.0*n_node)*sizeof(real_t)});
+}
+
+// batched basis, positions, jacobians and inverses for a block
+void bench_block(vector<result_t> &results, const std::string &name,
+   elements::element_type type){
+
+   int n_node = elements::num_nodes(type);
+   int dim = elements::num_dim(type);
+
+   auto points = make_points(dim, n_qp);
+   vector<real_t> verts(n_elem*n_node*dim);
+   for (std::size_t i = 0; i < verts.size(); i++) verts[i] = std::cos(0.37*i);
+
+   elements::element_block block;
+   double t = time_per_call([&]{
+      elements::evaluate_block(block, type, verts.data(), n_elem, points.data(), n_qp);
+      sink = block.det_J[0];
+   });
+
+   int n_points = n_elem*n_qp;
+   double bytes = (double(n_elem)*n_node*dim                     // vertices
+                 + double(n_qp)*(dim + n_node*(1 + dim))         // points, tables
+                 + double(n_points)*(dim + 2*dim*dim + 1))       // outputs
+                 *sizeof(real_t);
+
+   results.push_back({"block/" + name, n_points/t, bytes/n_points});
+}
+
+// jacobian, determinant and inverse from precomputed partials
+template<int Dim, int NumNodes>
+void bench_jacobian(vector<result_t> &results, const std::string &name){
+
+   vector<real_t> verts(n_elem*NumNodes*Dim), partials(n_qp*NumNodes*Dim);
+   for (std::size_t i = 0; i < verts.size(); i++) verts[i] = std::cos(0.37*i);
+   for (std::size_t i = 0; i < partials.size(); i++) partials[i] = std::sin(0.21*i);
+
+   int n_points = n_elem*n_qp;
+   vector<real_t> J(n_points*Dim*Dim), det(n_points), J_inv(n_points*Dim*Dim);
+
+   double t = time_per_call([&]{
+      elements::batched_jacobian_kernel<Dim, NumNodes>(J.data(), det.data(),
+         J_inv.data(), verts.data(), partials.data(), n_elem, n_qp);
+      sink = det[0];
+   });
+
+   double bytes = (double(n_elem)*NumNodes*Dim + double(n_qp)*NumNodes*Dim
+                 + double(n_points)*(2*Dim*Dim + 1))*sizeof(real_t);
+
+   results.push_back({"jacobian/" + name, n_points/t, bytes/n_points});
+}
+
+// nested vector tensor rules
+void bench_rules(vector<result_t> &results){
+
+   int order = 4;
+
+   for (int dim = 2; dim <= 4; dim++){
+      int n_pts = std::pow(order, dim);
+      vector< vector<real_t> > pts(n_pts, vector<real_t>(dim));
+      vector< vector<real_t> > wts(n_pts, vector<real_t>(dim));
+      vector<real_t> tot(n_pts);
+
+      double t = time_per_call([&]{
+         if (dim == 2) elements::Gauss2D(pts, wts, tot, order);
+         else if (dim == 3) elements::Gauss3D(pts, wts, tot, order);
+         else elements::Gauss4D(pts, wts, order, dim);
+         sink = pts[0][0];
+      });
+
+      results.push_back({"rule/gauss" + std::to_string(dim) + "d", n_pts/t,
+         (2.0*dim)*sizeof(real_t)});
+   }
+
+   // 1D rule from scratch, without the cache
+   const int n = 16;
+   vector<real_t> points(n), weights(n);
+   double t = time_per_call([&]{
+      elements::compute_gauss_rule(points.data(), weights.data(), n);
+      sink = points[0];
+   });
+   results.push_back({"rule/compute_gauss_16", n/t, 2.0*sizeof(real_t)});
+}
+
+// Lagrange basis and partials of QuadN/HexN
+void bench_lagrange(vector<result_t> &results){
+
+   for (int dim = 2; dim <= 3; dim++)
+      for (int order : {2, 4, 8}){
+         int N = order + 1;
+         int n_node = (dim == 2) ? N*N : N*N*N;
+         auto points = make_points(dim, n_qp);
+         vector<real_t> basis(n_qp*n_node), partials(n_qp*n_node*dim);
+
+         double t = time_per_call([&]{
+            elements::lagrange_reference_basis(basis.data(), partials.data(),
+               points.data(), n_qp, dim, order);
+            sink = basis[0];
+         });
+
+         std::string name = (dim == 2) ? "lagrange/quadN_p" : "lagrange/hexN_p";
+         results.push_back({name + std::to_string(order), n_qp/t,
+            (dim + n_node*(1.0 + dim))*sizeof(real_t)});
+      }
+}
+
+void save_json(const std::string &file, const vector<result_t> &results){
+
+   std::ofstream out(file);
+   out << std::setprecision(10);
+   out << "{\n  \"benchmarks\": [\n";
+   for (std::size_t i = 0; i < results.size(); i++){
+      out << "    {\"name\": \"" << results[i].name << "\", "
+          << "\"points_per_second\": " << results[i].points_per_second << ", "
+          << "\"bytes_per_point\": " << results[i].bytes_per_point << "}"
+          << ((i + 1 < results.size()) ? "," : "") << "\n";
+   }
+   out << "  ]\n}\n";
+}
+
+// name -> points per second of a file written by save_json
+std::map<std::string, double> load_json(const std::string &file){
+
+   std::ifstream in(file);
+   std::stringstream text;
+   text << in.rdbuf();
+   std::string s = text.str();
+
+   std::map<std::string, double> baseline;
+   const std::string name_key = "\"name\": \"";
+   const std::string rate_key = "\"points_per_second\": ";
+
+   std::size_t pos = 0;
+   while ((pos = s.find(name_key, pos)) != std::string::npos){
+      pos += name_key.size();
+      std::size_t end = s.find('"', pos);
+      std::string name = s.substr(pos, end - pos);
+
+      std::size_t rate = s.find(rate_key, end);
+      if (rate == std::string::npos) break;
+      baseline[name] = std::atof(s.c_str() + rate + rate_key.size());
+      pos = rate;
+   }
+   return baseline;
+}
+
+} // namespace
+
+int main(int argc, char **argv){
+
+   std::string save_file, compare_file;
+   double threshold = 0.10;
+
+   for (int i = 1; i < argc; i++){
+      std::string arg = argv[i];
+      if (arg == "--save" && i + 1 < argc) save_file = argv[++i];
+      else if (arg == "--compare" && i + 1 < argc) compare_file = argv[++i];
+      else if (arg == "--threshold" && i + 1 < argc) threshold = std::atof(argv[++i]);
+      else if (arg == "--seconds" && i + 1 < argc) min_seconds = std::atof(argv[++i]);
+      else {
+         std::cerr << "unknown argument " << arg << std::endl;
+         return 2;
+      }
+   }
+
+   vector<result_t> results;
+
+   elements::Hex8 hex8;
+   elements::Hex20 hex20;
+   elements::Hex32 hex32;
+   bench_element_class(results, "hex8", hex8, 8);
+   bench_element_class(results, "hex20", hex20, 20);
+   bench_element_class(results, "hex32", hex32, 32);
+
+   bench_block(results, "quad4", elements::element_type::quad4);
+   bench_block(results, "quad8", elements::element_type::quad8);
+   bench_block(results, "quad12", elements::element_type::quad12);
+   bench_block(results, "hex8", elements::element_type::hex8);
+   bench_block(results, "hex20", elements::element_type::hex20);
+   bench_block(results, "hex32", elements::element_type::hex32);
+
+   bench_jacobian<2, 4>(results, "2d_4");
+   bench_jacobian<3, 8>(results, "3d_8");
+   bench_jacobian<3, 20>(results, "3d_20");
+   bench_jacobian<4, 16>(results, "4d_16");
+
+   bench_rules(results);
+   bench_lagrange(results);
+
+   std::map<std::string, double> baseline;
+   if (!compare_file.empty()) baseline = load_json(compare_file);
+
+   int n_regressions = 0;
+
+   std::cout << std::left << std::setw(26) << "case"
+             << std::right << std::setw(16) << "points/s"
+             << std::setw(14) << "bytes/point"
+             << std::setw(12) << "vs base" << std::endl;
+
+   for (const auto &r : results){
+      std::cout << std::left << std::setw(26) << r.name << std::right
+                << std::setw(16) << std::setprecision(4) << std::scientific
+                << r.points_per_second << std::fixed << std::setprecision(1)
+                << std::setw(14) << r.bytes_per_point;
+
+      auto base = baseline.find(r.name);
+      if (base != baseline.end() && base->second > 0.0){
+         double ratio = r.points_per_second/base->second;
+         std::cout << std::setw(11) << std::setprecision(2) << ratio << "x";
+         if (ratio < 1.0 - threshold){
+            std::cout << "  REGRESSION";
+            n_regressions++;
+         }
+      }
+      std::cout << std::endl;
+   }
+
+   if (!save_file.empty()){
+      save_json(save_file, results);
+      std::cout << "baseline written to " << save_file << std::endl;
+   }
+
+   if (n_regressions > 0){
+      std::cout << n_regressions << " case(s) slower than the baseline by more than "
+                << threshold*100.0 << "%" << std::endl;
+      return 1;
+   }
+   return 0;
+}
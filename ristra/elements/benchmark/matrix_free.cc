@@ -0,0 +1,133 @@
+/*
+ Throughput of the matrix-free stiffness operator against the assembled CSR
+ matrix on a structured, slightly distorted box mesh.
+
+ Usage:
+
+    elements_matrix_free_benchmark [type] [cells] [order] [repeats]
+
+ type is hex8, hex20, hex32 or hexN (default hexN), cells the number of
+ cells per side (default 8), order the hexN element order (default 3) and
+ repeats the number of operator applications timed (default 20).
+*/
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "ristra/elements/assembly.h"
+#include "ristra/elements/element_kernels.h"
+#include "ristra/elements/elements.h"
+#include "ristra/elements/matrix_free.h"
+#include "ristra/elements/test/fixtures.h"
+
+namespace elements = ristra::elements;
+using ristra::elements::vector;
+using ristra::elements::real_t;
+using ristra::elements::fixtures::flatten;
+using ristra::elements::fixtures::lagrange_nodes;
+using ristra::elements::fixtures::make_merged_mesh;
+using ristra::elements::fixtures::map_nodes;
+using ristra::elements::fixtures::mesh_t;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+double seconds_since(const clock_type::time_point &start){
+   return std::chrono::duration<double>(clock_type::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char **argv){
+
+   std::string name = (argc > 1) ? argv[1] : "hexN";
+   int cells   = (argc > 2) ? std::atoi(argv[2]) : 8;
+   int order   = (argc > 3) ? std::atoi(argv[3]) : 3;
+   int repeats = (argc > 4) ? std::atoi(argv[4]) : 20;
+
+   elements::element_type type;
+   vector<real_t> ref_nodes;
+   int quad_order;
+
+   if (name == "hex8"){
+      type = elements::element_type::hex8;
+      ref_nodes = flatten(elements::hex8_kernel::ref_vert);
+      quad_order = 2;
+      order = 1;
+   }
+   else if (name == "hex20"){
+      type = elements::element_type::hex20;
+      ref_nodes = flatten(elements::hex20_kernel::ref_vert);
+      quad_order = 3;
+      order = 2;
+   }
+   else if (name == "hex32"){
+      type = elements::element_type::hex32;
+      ref_nodes = flatten(elements::hex32_kernel::ref_vert);
+      quad_order = 4;
+      order = 3;
+   }
+   else if (name == "hexN"){
+      type = elements::element_type::hexN;
+      ref_nodes = lagrange_nodes(3, order);
+      quad_order = order + 1;
+   }
+   else {
+      std::cerr << "unknown element type " << name << std::endl;
+      return 1;
+   }
+
+   int elem_order = (type == elements::element_type::hexN) ? order : 0;
+   // n^3 unit cells, smoothly distorted
+   mesh_t mesh = make_merged_mesh(ref_nodes, 3, cells);
+   map_nodes(mesh, [](real_t *y, const real_t *x){
+      for (int d = 0; d < 3; d++) y[d] = x[d] + 0.05*std::sin(x[(d + 1) % 3]);
+   });
+
+   std::cout << name << " order " << order << ", " << mesh.n_elem
+             << " elements, " << mesh.n_global << " dofs, " << repeats
+             << " applications" << std::endl;
+
+   vector<real_t> x(mesh.n_global), y(mesh.n_global);
+   for (int g = 0; g < mesh.n_global; g++) x[g] = std::cos(0.37*g);
+
+   // matrix-free
+   auto start = clock_type::now();
+   elements::stiffness_operator K_free(type, mesh.coords.data(), mesh.n_global,
+      mesh.connectivity.data(), mesh.n_elem, elements::quadrature_rule::gauss,
+      quad_order, elem_order);
+   double free_setup = seconds_since(start);
+
+   start = clock_type::now();
+   for (int r = 0; r < repeats; r++) K_free.apply(y.data(), x.data());
+   double free_apply = seconds_since(start)/repeats;
+
+   // assembled
+   start = clock_type::now();
+   elements::assembler assembler(type, mesh.coords.data(), mesh.n_global,
+      mesh.connectivity.data(), mesh.n_elem, elements::quadrature_rule::gauss,
+      quad_order, elements::assembly_options(), elem_order);
+   elements::csr_matrix K;
+   assembler.stiffness(K);
+   double csr_setup = seconds_since(start);
+
+   start = clock_type::now();
+   for (int r = 0; r < repeats; r++) K.multiply(y.data(), x.data());
+   double csr_apply = seconds_since(start)/repeats;
+
+   std::size_t csr_bytes = K.values.size()*sizeof(real_t)
+      + K.col_idx.size()*sizeof(int) + K.row_ptr.size()*sizeof(int);
+
+   std::cout << "matrix-free: setup " << free_setup << " s, apply "
+             << free_apply << " s, " << mesh.n_global/free_apply
+             << " dofs/s, " << K_free.factor_bytes() << " bytes" << std::endl;
+   std::cout << "assembled:   setup " << csr_setup << " s, apply "
+             << csr_apply << " s, " << mesh.n_global/csr_apply
+             << " dofs/s, " << csr_bytes << " bytes" << std::endl;
+
+   return 0;
+}
@@ -0,0 +1,154 @@
+#include <cmath>
+
+#include "ristra/elements/collocation.h"
+#include "ristra/elements/jacobian.h"
+#include "ristra/elements/lagrange.h"
+#include "ristra/elements/node_sets.h"
+#include "ristra/assertions/errors.h"
+
+namespace ristra {
+namespace elements{
+
+namespace {
+
+// w |det J| at the nodes of one element from the differentiation matrix,
+// vertices[N^Dim][Dim] numbered xi fastest
+template<int Dim>
+void nodal_weighted_det(
+   real_t *w_det,
+   const real_t *vertices,
+   const real_t *D,
+   const real_t *weights,
+   const int &N){
+
+   int n_node = (Dim == 2) ? N*N : N*N*N;
+
+   for (int q = 0; q < n_node; q++){
+
+      int idx[3] = {q % N, (q/N) % N, (Dim == 3) ? q/(N*N) : 0};
+      int stride[3] = {1, N, N*N};
+
+      // J[j][k] = dx_k/dxi_j, only the nodes on the line through q along
+      // direction j contribute
+      real_t J[Dim][Dim];
+      real_t weight = 1.0;
+
+      for (int j = 0; j < Dim; j++){
+         const real_t *D_row = D + idx[j]*N;
+         int line_start = q - idx[j]*stride[j];
+
+         for (int k = 0; k < Dim; k++) J[j][k] = 0.0;
+
+         for (int n = 0; n < N; n++){
+            const real_t *x = vertices + (line_start + n*stride[j])*Dim;
+            for (int k = 0; k < Dim; k++) J[j][k] += D_row[n]*x[k];
+         }
+
+         weight *= weights[idx[j]];
+      } // end for j
+
+      w_det[q] = weight*std::abs(determinant_kernel<Dim>(J));
+   } // end for q
+}
+
+} // namespace
+
+
+// true when a 1D node set is the point set of a rule
+bool is_collocated(
+   const real_t *nodes_1d,
+   const int &num_nodes,
+   const quadrature_1d &rule,
+   const real_t &tol){
+
+   if (rule.order != num_nodes) return false;
+
+   for (int i = 0; i < num_nodes; i++)
+      if (!(std::abs(nodes_1d[i] - rule.points[i]) <= tol)) return false;
+
+   return true;
+}
+
+// derivatives of the Lagrange basis on a node set at its own nodes
+void differentiation_matrix(
+   real_t *D,
+   const real_t *nodes_1d,
+   const int &num_nodes){
+
+   lagrange_1d lagrange(nodes_1d, num_nodes);
+   vector<real_t> val(num_nodes);
+
+   for (int q = 0; q < num_nodes; q++)
+      lagrange.evaluate(val.data(), D + q*num_nodes, nodes_1d[q]);
+}
+
+
+collocation_mass::collocation_mass(
+   const element_type &type,
+   const real_t *coords,
+   const int &n_global,
+   const int *connectivity,
+   const int &n_elem,
+   const int &elem_order)
+   : connectivity_(connectivity),
+     n_global_(n_global),
+     n_elem_(n_elem){
+
+   if (type != element_type::quadN && type != element_type::hexN)
+      THROW_IMPLEMENTED_ERROR("GLL collocation is only defined for quadN/hexN");
+   if (elem_order < 1)
+      THROW_IMPLEMENTED_ERROR("GLL collocation needs an element order of at least 1");
+
+   int dim = num_dim(type);
+   int N = elem_order + 1;
+   n_qp_ = num_nodes(type, elem_order);
+
+   const quadrature_1d &rule = line_rule(quadrature_rule::lobatto, N);
+   const node_set &nodes = get_node_set(node_spacing::lobatto, elem_order);
+   const real_t *D = nodes.D.data();
+
+   weighted_det_J_.resize(n_elem_*n_qp_);
+   diagonal_.assign(n_global_, 0.0);
+   inverse_.resize(n_global_);
+
+   vector<real_t> verts(n_qp_*dim);
+
+   for (int elem = 0; elem < n_elem_; elem++){
+
+      const int *elem_nodes = connectivity_ + elem*n_qp_;
+      real_t *w_det = weighted_det_J_.data() + elem*n_qp_;
+
+      for (int node = 0; node < n_qp_; node++)
+         for (int d = 0; d < dim; d++)
+            verts[node*dim + d] = coords[elem_nodes[node]*dim + d];
+
+      if (dim == 2)
+         nodal_weighted_det<2>(w_det, verts.data(), D, rule.weights.data(), N);
+      else
+         nodal_weighted_det<3>(w_det, verts.data(), D, rule.weights.data(), N);
+
+      for (int node = 0; node < n_qp_; node++)
+         diagonal_[elem_nodes[node]] += w_det[node];
+   } // end for elem
+
+   for (int g = 0; g < n_global_; g++)
+      inverse_[g] = (diagonal_[g] != 0.0) ? 1.0/diagonal_[g] : 0.0;
+}
+
+// y = M x
+void collocation_mass::apply(real_t *y, const real_t *x) const {
+   for (int g = 0; g < n_global_; g++) y[g] = diagonal_[g]*x[g];
+}
+
+// y = M^-1 x
+void collocation_mass::apply_inverse(real_t *y, const real_t *x) const {
+   for (int g = 0; g < n_global_; g++) y[g] = inverse_[g]*x[g];
+}
+
+// values at the quadrature points, the basis table is the identity
+void collocation_mass::interpolate(real_t *u_points, const real_t *u) const {
+   for (int i = 0; i < n_elem_*n_qp_; i++) u_points[i] = u[connectivity_[i]];
+}
+
+} // end namespace elements
+} // end namespace ristra
@@ -0,0 +1,101 @@
+#ifndef ELEMENTS_COLLOCATION_H
+#define ELEMENTS_COLLOCATION_H
+
+#include "ristra/elements/batched.h"
+#include "ristra/elements/quadrature.h"
+#include "ristra/elements/utilities.h"
+
+namespace ristra{
+namespace elements{
+
+/*
+ ==========================
+  GLL collocation
+ ==========================
+
+ QuadN/HexN elements with their nodes on the Gauss-Lobatto points (see
+ lobatto_nodes_1D), integrated with the Lobatto rule of the same order + 1
+ points. Nodes and quadrature points then coincide and the basis table is
+ the identity,
+
+    phi_n(xi_q) = delta_nq
+
+ so interpolating nodal values to the quadrature points is a copy, a gather
+ on a mesh, and the mass matrix integrated with that rule is diagonal,
+
+    M_nn = sum_elem w_n |det J(xi_n)|
+
+ which makes M^-1 a per node scale. No basis is evaluated; the jacobian
+ only needs the 1D differentiation matrix applied along each direction.
+ Reference tables of the QuadN/HexN elements take the same short cut when
+ their nodes are the rule points (see reference_cache.h).
+
+ The mesh is given as in assembly.h, node coordinates coords[n_global][dim]
+ and connectivity[n_elem][n_node], element nodes numbered xi fastest.
+*/
+
+// true when a 1D node set is the point set of a rule, in which case the
+// Lagrange basis on those nodes is the identity at the rule points
+bool is_collocated(
+   const real_t *nodes_1d,          // nodes [num_nodes], ascending
+   const int &num_nodes,            // number of nodes
+   const quadrature_1d &rule,       // 1D rule
+   const real_t &tol = 1.0e-13);    // allowed node offset
+
+// derivatives of the Lagrange basis on a node set at its own nodes,
+// D[q][n] = l_n'(x_q)
+void differentiation_matrix(
+   real_t *D,                       // differentiation matrix [num_nodes][num_nodes]
+   const real_t *nodes_1d,          // nodes [num_nodes]
+   const int &num_nodes);           // number of nodes
+
+
+// diagonal GLL mass matrix of a QuadN/HexN mesh
+class collocation_mass {
+   public:
+
+      collocation_mass(
+         const element_type &type,        // quadN or hexN
+         const real_t *coords,            // node coordinates [n_global][dim]
+         const int &n_global,             // number of global nodes
+         const int *connectivity,         // element nodes [n_elem][n_node]
+         const int &n_elem,               // number of elements
+         const int &elem_order);          // element order
+
+      // y = M x, y and x are [n_global]
+      void apply(real_t *y, const real_t *x) const;
+
+      // y = M^-1 x, y and x are [n_global]
+      void apply_inverse(real_t *y, const real_t *x) const;
+
+      // values at the quadrature points of every element, a gather of the
+      // nodal values, u_points[n_elem][n_qp]
+      void interpolate(real_t *u_points, const real_t *u) const;
+
+      // diagonal of M, [n_global]
+      const real_t *diagonal() const { return diagonal_.data(); }
+
+      // w |det J| at the points of every element, [n_elem][n_qp]
+      const real_t *weighted_det_J() const { return weighted_det_J_.data(); }
+
+      int num_dofs() const { return n_global_; }
+      int num_elements() const { return n_elem_; }
+      int num_points() const { return n_qp_; }
+
+   private:
+
+      const int *connectivity_;
+
+      int n_global_;
+      int n_elem_;
+      int n_qp_;                            // = nodes per element
+
+      aligned_vector<real_t> weighted_det_J_;  // [n_elem][n_qp]
+      aligned_vector<real_t> diagonal_;        // [n_global]
+      aligned_vector<real_t> inverse_;         // [n_global], 1/diagonal
+};
+
+} //end namespace elements
+} //end namespace ristra
+
+#endif //ELEMENTS_COLLOCATION_H
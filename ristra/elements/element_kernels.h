@@ -0,0 +1,773 @@
+#ifndef ELEMENTS_ELEMENT_KERNELS_H
+#define ELEMENTS_ELEMENT_KERNELS_H
+
+#include "ristra/elements/batched.h"
+#include "ristra/elements/jacobian.h"
+#include "ristra/elements/utilities.h"
+#include "ristra/assertions/errors.h"
+
+namespace ristra{
+namespace elements{
+
+/*
+ ==========================
+  Element kernels
+ ==========================
+
+ Shape functions of the fixed order elements as static, header-only kernels.
+ Each kernel only provides
+
+    basis(basis, xi)            basis[NumNodes]
+    partial_xi(partial, xi)     partial[NumNodes], and partial_eta/_mu
+
+ on raw arrays, and element_kernel (CRTP) builds the point and block loops on
+ top of them. Nothing is virtual, the node count and dimension are template
+ parameters and the reference vertices are constant expressions, so a loop
+ over a block of one element type is straight-line code the compiler can
+ inline and vectorize. The Element2D/Element3D classes forward to these
+ kernels, and visit_element_kernel picks the kernel once per block.
+*/
+
+template<class Kernel, int Dim, int NumNodes>
+struct element_kernel {
+
+   static constexpr int num_dim = Dim;
+   static constexpr int num_nodes = NumNodes;
+
+   // reference partials at one point, partials[NumNodes][Dim]
+   static void partials(real_t *partials, const real_t *xi){
+
+      real_t partial[Dim][NumNodes];
+
+      Kernel::partial_xi(partial[0], xi);
+      Kernel::partial_eta(partial[1], xi);
+      if constexpr (Dim >= 3) Kernel::partial_mu(partial[2], xi);
+      if constexpr (Dim == 4) Kernel::partial_tau(partial[3], xi);
+
+      for (int node = 0; node < NumNodes; node++)
+         for (int d = 0; d < Dim; d++)
+            partials[node*Dim + d] = partial[d][node];
+   }
+
+   // physical position of one point, vertices[NumNodes][Dim]
+   static void physical_position(
+      real_t *x_point,
+      const real_t *xi,
+      const real_t *vertices){
+
+      real_t basis[NumNodes];
+      Kernel::basis(basis, xi);
+
+      for (int d = 0; d < Dim; d++) x_point[d] = 0.0;
+
+      for (int node = 0; node < NumNodes; node++)
+         for (int d = 0; d < Dim; d++)
+            x_point[d] += vertices[node*Dim + d]*basis[node];
+   }
+
+   // basis values and reference partials at a set of points
+   static void reference_basis(
+      real_t *basis,                // basis values [n_qp][NumNodes]
+      real_t *partials,             // reference partials [n_qp][NumNodes][Dim]
+      const real_t *points,         // reference points [n_qp][Dim]
+      const int &n_qp){             // number of points
+
+      for (int qp = 0; qp < n_qp; qp++){
+         Kernel::basis(basis + qp*NumNodes, points + qp*Dim);
+         Kernel::partials(partials + qp*NumNodes*Dim, points + qp*Dim);
+      } // end for qp
+   }
+
+   // physical positions of the points in each element of a block, the
+   // vertices and basis are read as Storage and summed in Accum
+   template<class Accum, class Storage>
+   static void batched_physical_position(
+      Accum *x_points,              // physical positions [n_elem][n_qp][Dim]
+      const Storage *vertices,      // element vertices [n_elem][NumNodes][Dim]
+      const no_deduce<Storage> *basis, // basis values [n_qp][NumNodes]
+      const int &n_elem,            // number of elements
+      const int &n_qp){             // number of points
+
+      for (int elem = 0; elem < n_elem; elem++){
+
+         const Storage *elem_verts = vertices + elem*NumNodes*Dim;
+
+         for (int qp = 0; qp < n_qp; qp++){
+
+            const Storage *qp_basis = basis + qp*NumNodes;
+            Accum x[Dim];
+
+            for (int d = 0; d < Dim; d++) x[d] = 0.0;
+
+            for (int node = 0; node < NumNodes; node++)
+               for (int d = 0; d < Dim; d++)
+                  x[d] += Accum(elem_verts[node*Dim + d])*Accum(qp_basis[node]);
+
+            for (int d = 0; d < Dim; d++)
+               x_points[(elem*n_qp + qp)*Dim + d] = x[d];
+         } // end for qp
+      } // end for elem
+   }
+
+   // basis, partials, positions, jacobians, determinants and inverses for a
+   // block, see evaluate_block for the layouts
+   static void evaluate_block(
+      real_t *basis,                // basis values [n_qp][NumNodes]
+      real_t *partials,             // reference partials [n_qp][NumNodes][Dim]
+      real_t *x_points,             // physical positions [n_elem][n_qp][Dim]
+      real_t *J_matrix,             // jacobians [n_elem][n_qp][Dim][Dim]
+      real_t *det_J,                // determinants [n_elem][n_qp]
+      real_t *J_inverse,            // inverses [n_elem][n_qp][Dim][Dim]
+      const real_t *vertices,       // element vertices [n_elem][NumNodes][Dim]
+      const int &n_elem,            // number of elements
+      const real_t *points,         // reference points [n_qp][Dim]
+      const int &n_qp){             // number of points
+
+      reference_basis(basis, partials, points, n_qp);
+
+      batched_physical_position(x_points, vertices, basis, n_elem, n_qp);
+
+      batched_jacobian_kernel<Dim, NumNodes>(J_matrix, det_J, J_inverse,
+         vertices, partials, n_elem, n_qp);
+   }
+};
+
+
+/*
+ Quad 4, nodes as in Quad_4_2D
+*/
+struct quad4_kernel : element_kernel<quad4_kernel, 2, 4> {
+
+   static constexpr real_t ref_vert[4][2] = {
+      {-1.0, -1.0}, { 1.0, -1.0}, { 1.0,  1.0}, {-1.0,  1.0}};
+
+   static void basis(real_t *basis, const real_t *xi){
+      for (int v = 0; v < 4; v++){
+         basis[v] = 1.0/4.0
+            * (1.0 + xi[0]*ref_vert[v][0])
+            * (1.0 + xi[1]*ref_vert[v][1]);
+      }
+   }
+
+   static void partial_xi(real_t *partial, const real_t *xi){
+      for (int v = 0; v < 4; v++){
+         partial[v] = (1.0/4.0)
+            * (ref_vert[v][0])
+            * (1.0 + xi[1]*ref_vert[v][1]);
+      }
+   }
+
+   static void partial_eta(real_t *partial, const real_t *xi){
+      for (int v = 0; v < 4; v++){
+         partial[v] = (1.0/4.0)
+            * (1.0 + xi[0]*ref_vert[v][0])
+            * (ref_vert[v][1]);
+      }
+   }
+};
+
+/*
+ Quad 8, nodes as in Quad_8_2D
+*/
+struct quad8_kernel : element_kernel<quad8_kernel, 2, 8> {
+
+   static constexpr real_t ref_vert[8][2] = {
+      {-1.0, -1.0}, { 1.0, -1.0}, { 1.0,  1.0}, {-1.0,  1.0},
+      { 0.0, -1.0}, { 1.0,  0.0}, { 0.0,  1.0}, {-1.0,  0.0}};
+
+   static void basis(real_t *basis, const real_t *xi){
+
+      // corners 0-3
+      for (int v = 0; v < 4; v++){
+         basis[v] = 1.0/4.0
+            * (1.0 + xi[0]*ref_vert[v][0])
+            * (1.0 + xi[1]*ref_vert[v][1])
+            * (xi[0]*ref_vert[v][0] + xi[1]*ref_vert[v][1] - 1);
+      }
+
+      // mid edge nodes 4,6
+      for (int v = 4; v <= 6; v += 2){
+         basis[v] = 1.0/2.0
+            * (1.0 - xi[0]*xi[0])
+            * (1.0 + xi[1]*ref_vert[v][1]);
+      }
+
+      // mid edge nodes 5,7
+      for (int v = 5; v <= 7; v += 2){
+         basis[v] = 1.0/2.0
+            * (1.0 + xi[0]*ref_vert[v][0])
+            * (1.0 - xi[1]*xi[1]);
+      }
+   }
+
+   static void partial_xi(real_t *partial, const real_t *xi){
+
+      for (int v = 0; v < 4; v++){
+         partial[v] = 1.0/4.0
+            * (ref_vert[v][0])
+            * (1 + ref_vert[v][1]*xi[1])
+            * ((2*ref_vert[v][0]*xi[0]) + (ref_vert[v][1]*xi[1]));
+      }
+
+      for (int v = 4; v <= 6; v += 2){
+         partial[v] = -1
+            * (xi[0])
+            * (1 + ref_vert[v][1]*xi[1]);
+      }
+
+      for (int v = 5; v <= 7; v += 2){
+         partial[v] = 1.0/2.0
+            * (ref_vert[v][0])
+            * (1 - xi[1]*xi[1]);
+      }
+   }
+
+   static void partial_eta(real_t *partial, const real_t *xi){
+
+      for (int v = 0; v < 4; v++){
+         partial[v] = 1.0/4.0
+            * (1 + ref_vert[v][0]*xi[0])
+            * (ref_vert[v][1])
+            * ((ref_vert[v][0]*xi[0]) + (2*ref_vert[v][1]*xi[1]));
+      }
+
+      for (int v = 4; v <= 6; v += 2){
+         partial[v] = 1.0/2.0
+            * (1 - xi[0]*xi[0])
+            * (ref_vert[v][1]);
+      }
+
+      for (int v = 5; v <= 7; v += 2){
+         partial[v] = -1
+            * (1 + ref_vert[v][0]*xi[0])
+            * (xi[1]);
+      }
+   }
+};
+
+/*
+ Quad 12, nodes as in Quad_12_2D
+*/
+struct quad12_kernel : element_kernel<quad12_kernel, 2, 12> {
+
+   static constexpr real_t ref_vert[12][2] = {
+      {-1.0, -1.0}, { 1.0, -1.0}, { 1.0,  1.0}, {-1.0,  1.0},
+      {-1./3., -1.0}, { 1./3., -1.0}, { 1./3.,  1.0}, {-1./3.,  1.0},
+      {-1.0, -1./3.}, { 1.0, -1./3.}, { 1.0,  1./3.}, {-1.0,  1./3.}};
+
+   static void basis(real_t *basis, const real_t *xi){
+
+      // corners 0-3
+      for (int v = 0; v < 4; v++){
+         basis[v] = 1.0/32.0
+            * (1.0 + xi[0]*ref_vert[v][0])
+            * (1.0 + xi[1]*ref_vert[v][1])
+            * (9.0*(xi[0]*xi[0] + xi[1]*xi[1]) - 10.0);
+      }
+
+      // edge nodes 4-7 (eta = +-1)
+      for (int v = 4; v <= 7; v++){
+         basis[v] = 9.0/32.0
+            * (1.0 - xi[0]*xi[0])
+            * (1.0 + xi[1]*ref_vert[v][1])
+            * (1.0 + 9.0*xi[0]*ref_vert[v][0]);
+      }
+
+      // edge nodes 8-11 (xi = +-1)
+      for (int v = 8; v <= 11; v++){
+         basis[v] = 9.0/32.0
+            * (1.0 + xi[0]*ref_vert[v][0])
+            * (1.0 - xi[1]*xi[1])
+            * (1.0 + 9.0*xi[1]*ref_vert[v][1]);
+      }
+   }
+
+   static void partial_xi(real_t *partial, const real_t *xi){
+
+      for (int v = 0; v < 4; v++){
+         partial[v] = 1.0/32.0
+            * (1 + xi[1]*ref_vert[v][1])
+            * ((9.0*ref_vert[v][0]*(xi[0]*xi[0] + xi[1]*xi[1]))
+            + (18.0*xi[0]*(1 + xi[0]*ref_vert[v][0]))
+            - (10.0*ref_vert[v][0]));
+      }
+
+      for (int v = 4; v < 8; v++){
+         partial[v] = (9.0/32.0)
+            * (1 + xi[1]*ref_vert[v][1])
+            * ((9.0*ref_vert[v][0]*(1 - 3*xi[0]*xi[0])) - (2*xi[0]));
+      }
+
+      for (int v = 8; v <= 11; v++){
+         partial[v] = 9.0/32.0
+            * (ref_vert[v][0])
+            * (1 - xi[1]*xi[1])
+            * (1 + 9*xi[1]*ref_vert[v][1]);
+      }
+   }
+
+   static void partial_eta(real_t *partial, const real_t *xi){
+
+      for (int v = 0; v < 4; v++){
+         partial[v] = 1.0/32.0
+            * (1 + xi[0]*ref_vert[v][0])
+            * ((9.0*ref_vert[v][1]*(xi[0]*xi[0] + xi[1]*xi[1]))
+            + (18.0*xi[1]*(1 + xi[1]*ref_vert[v][1]))
+            - (10.0*ref_vert[v][1]));
+      }
+
+      for (int v = 4; v <= 7; v++){
+         partial[v] = 9.0/32.0
+            * (1 - xi[0]*xi[0])
+            * (1 + 9*xi[0]*ref_vert[v][0])
+            * (ref_vert[v][1]);
+      }
+
+      for (int v = 8; v <= 11; v++){
+         partial[v] = 9.0/32.0
+            * (1 + xi[0]*ref_vert[v][0])
+            * ((9.0*ref_vert[v][1]*(1 - 3*xi[1]*xi[1])) - (2*xi[1]));
+      }
+   }
+};
+
+/*
+ Hex 8, nodes as in Hex8
+*/
+struct hex8_kernel : element_kernel<hex8_kernel, 3, 8> {
+
+   static constexpr real_t ref_vert[8][3] = {
+      {-1.0, -1.0, -1.0}, {+1.0, -1.0, -1.0}, {+1.0, -1.0, +1.0},
+      {-1.0, -1.0, +1.0}, {-1.0, +1.0, -1.0}, {+1.0, +1.0, -1.0},
+      {+1.0, +1.0, +1.0}, {-1.0, +1.0, +1.0}};
+
+   static void basis(real_t *basis, const real_t *xi){
+      for (int v = 0; v < 8; v++){
+         basis[v] = 1.0/8.0
+            * (1.0 + xi[0]*ref_vert[v][0])
+            * (1.0 + xi[1]*ref_vert[v][1])
+            * (1.0 + xi[2]*ref_vert[v][2]);
+      }
+   }
+
+   static void partial_xi(real_t *partial, const real_t *xi){
+      for (int v = 0; v < 8; v++){
+         partial[v] = (1.0/8.0)
+            * (ref_vert[v][0])
+            * (1.0 + xi[1]*ref_vert[v][1])
+            * (1.0 + xi[2]*ref_vert[v][2]);
+      }
+   }
+
+   static void partial_eta(real_t *partial, const real_t *xi){
+      for (int v = 0; v < 8; v++){
+         partial[v] = (1.0/8.0)
+            * (1.0 + xi[0]*ref_vert[v][0])
+            * (ref_vert[v][1])
+            * (1.0 + xi[2]*ref_vert[v][2]);
+      }
+   }
+
+   static void partial_mu(real_t *partial, const real_t *xi){
+      for (int v = 0; v < 8; v++){
+         partial[v] = (1.0/8.0)
+            * (1.0 + xi[0]*ref_vert[v][0])
+            * (1.0 + xi[1]*ref_vert[v][1])
+            * (ref_vert[v][2]);
+      }
+   }
+};
+
+/*
+ Hex 20, nodes as in Hex20
+*/
+struct hex20_kernel : element_kernel<hex20_kernel, 3, 20> {
+
+   static constexpr real_t ref_vert[20][3] = {
+      {-1.0, -1.0, -1.0}, {+1.0, -1.0, -1.0}, {+1.0, -1.0, +1.0},
+      {-1.0, -1.0, +1.0}, {-1.0, +1.0, -1.0}, {+1.0, +1.0, -1.0},
+      {+1.0, +1.0, +1.0}, {-1.0, +1.0, +1.0},
+      { 0.0, -1.0, -1.0}, {+1.0, -1.0,  0.0}, { 0.0, -1.0, +1.0},
+      {-1.0, -1.0,  0.0}, { 0.0, +1.0, -1.0}, {+1.0, +1.0,  0.0},
+      { 0.0, +1.0, +1.0}, {-1.0, +1.0,  0.0},
+      {-1.0,  0.0, -1.0}, {+1.0,  0.0, -1.0}, {+1.0,  0.0, +1.0},
+      {-1.0,  0.0, +1.0}};
+
+   static void basis(real_t *basis, const real_t *xi){
+
+      // corners 0-7
+      for (int v = 0; v < 8; v++){
+         basis[v] = 1.0/8.0
+            * (1.0 + xi[0]*ref_vert[v][0])
+            * (1.0 + xi[1]*ref_vert[v][1])
+            * (1.0 + xi[2]*ref_vert[v][2])
+            * (xi[0]*ref_vert[v][0] + xi[1]*ref_vert[v][1]
+            +  xi[2]*ref_vert[v][2] - 2.0);
+      }
+
+      // i=0 edges 8,10,12,14
+      for (int v = 8; v <= 14; v += 2){
+         basis[v] = 1.0/4.0
+            * (1.0 - xi[0]*xi[0])
+            * (1.0 + xi[1]*ref_vert[v][1])
+            * (1.0 + xi[2]*ref_vert[v][2]);
+      }
+
+      // j=0 edges 16-19
+      for (int v = 16; v <= 19; v++){
+         basis[v] = 1.0/4.0
+            * (1.0 + xi[0]*ref_vert[v][0])
+            * (1.0 - xi[1]*xi[1])
+            * (1.0 + xi[2]*ref_vert[v][2]);
+      }
+
+      // k=0 edges 9,11,13,15
+      for (int v = 9; v <= 15; v += 2){
+         basis[v] = 1.0/4.0
+            * (1.0 + xi[0]*ref_vert[v][0])
+            * (1.0 + xi[1]*ref_vert[v][1])
+            * (1.0 - xi[2]*xi[2]);
+      }
+   }
+
+   static void partial_xi(real_t *partial, const real_t *xi){
+
+      for (int v = 0; v < 8; v++){
+         partial[v] = (1.0/8.0)
+            * (ref_vert[v][0])
+            * (1 + (xi[1]*ref_vert[v][1]))
+            * (1 + (xi[2]*ref_vert[v][2]))
+            * (2*(xi[0]*ref_vert[v][0]) + xi[1]*ref_vert[v][1]
+            +  xi[2]*ref_vert[v][2] - 1);
+      }
+
+      for (int v = 8; v <= 14; v += 2){
+         partial[v] = (-1.0/2.0)
+            * (xi[0])
+            * (1 + xi[1]*ref_vert[v][1])
+            * (1 + xi[2]*ref_vert[v][2]);
+      }
+
+      for (int v = 9; v <= 15; v += 2){
+         partial[v] = (1.0/4.0)
+            * (ref_vert[v][0])
+            * (1 + xi[1]*ref_vert[v][1])
+            * (1 - xi[2]*xi[2]);
+      }
+
+      for (int v = 16; v <= 19; v++){
+         partial[v] = (1.0/4.0)
+            * (ref_vert[v][0])
+            * (1 - xi[1]*xi[1])
+            * (1 + xi[2]*ref_vert[v][2]);
+      }
+   }
+
+   static void partial_eta(real_t *partial, const real_t *xi){
+
+      for (int v = 0; v < 8; v++){
+         partial[v] = (1.0/8.0)
+            * (1 + xi[0]*ref_vert[v][0])
+            * (ref_vert[v][1])
+            * (1 + xi[2]*ref_vert[v][2])
+            * (xi[0]*ref_vert[v][0] + 2*xi[1]*ref_vert[v][1]
+            +  xi[2]*ref_vert[v][2] - 1);
+      }
+
+      for (int v = 8; v <= 14; v += 2){
+         partial[v] = (1.0/4.0)
+            * (1 - (xi[0]*xi[0]))
+            * (ref_vert[v][1])
+            * (1 + xi[2]*ref_vert[v][2]);
+      }
+
+      for (int v = 9; v <= 15; v += 2){
+         partial[v] = (1.0/4.0)
+            * (1 + xi[0]*ref_vert[v][0])
+            * (ref_vert[v][1])
+            * (1 - (xi[2]*xi[2]));
+      }
+
+      for (int v = 16; v <= 19; v++){
+         partial[v] = (-1.0/2.0)
+            * (1 + xi[0]*ref_vert[v][0])
+            * (xi[1])
+            * (1 + xi[2]*ref_vert[v][2]);
+      }
+   }
+
+   static void partial_mu(real_t *partial, const real_t *xi){
+
+      for (int v = 0; v < 8; v++){
+         partial[v] = (1.0/8.0)
+            * (1 + xi[0]*ref_vert[v][0])
+            * (1 + xi[1]*ref_vert[v][1])
+            * (ref_vert[v][2])
+            * ((xi[0]*ref_vert[v][0]) + (xi[1]*ref_vert[v][1])
+            +  (2*xi[2]*ref_vert[v][2]) - 1);
+      }
+
+      for (int v = 8; v <= 14; v += 2){
+         partial[v] = (1.0/4.0)
+            * (1 - (xi[0]*xi[0]))
+            * (1 + xi[1]*ref_vert[v][1])
+            * (ref_vert[v][2]);
+      }
+
+      for (int v = 9; v <= 15; v += 2){
+         partial[v] = (-1.0/2.0)
+            * (1 + xi[0]*ref_vert[v][0])
+            * (1 + xi[1]*ref_vert[v][1])
+            * (xi[2]);
+      }
+
+      for (int v = 16; v <= 19; v++){
+         partial[v] = (1.0/4.0)
+            * (1 + xi[0]*ref_vert[v][0])
+            * (1 - xi[1]*xi[1])
+            * (ref_vert[v][2]);
+      }
+   }
+};
+
+/*
+ Hex 32, nodes as in Hex32
+*/
+struct hex32_kernel : element_kernel<hex32_kernel, 3, 32> {
+
+   static constexpr real_t ref_vert[32][3] = {
+      {-1.0, -1.0, -1.0}, {+1.0, -1.0, -1.0}, {+1.0, -1.0, +1.0},
+      {-1.0, -1.0, +1.0}, {-1.0, +1.0, -1.0}, {+1.0, +1.0, -1.0},
+      {+1.0, +1.0, +1.0}, {-1.0, +1.0, +1.0},
+      // Xi/Eta = +- 1
+      {-1.0, -1.0, -1./3.}, { 1.0, -1.0, -1./3.}, { 1.0, -1.0,  1./3.},
+      {-1.0, -1.0,  1./3.}, {-1.0,  1.0, -1./3.}, { 1.0,  1.0, -1./3.},
+      { 1.0,  1.0,  1./3.}, {-1.0,  1.0,  1./3.},
+      // Eta/Mu = +- 1
+      {-1./3., -1.0, -1.0}, { 1./3., -1.0, -1.0}, { 1./3., -1.0,  1.0},
+      {-1./3., -1.0,  1.0}, {-1./3.,  1.0, -1.0}, { 1./3.,  1.0, -1.0},
+      { 1./3.,  1.0,  1.0}, {-1./3.,  1.0,  1.0},
+      // Xi/Mu = +- 1
+      {-1.0, -1./3., -1.0}, { 1.0, -1./3., -1.0}, { 1.0, -1./3.,  1.0},
+      {-1.0, -1./3.,  1.0}, {-1.0,  1./3., -1.0}, { 1.0,  1./3., -1.0},
+      { 1.0,  1./3.,  1.0}, {-1.0,  1./3.,  1.0}};
+
+   static void basis(real_t *basis, const real_t *xi){
+
+      // corners 0-7
+      for (int v = 0; v < 8; v++){
+         basis[v] = 1.0/64.0
+            * (1.0 + xi[0]*ref_vert[v][0])
+            * (1.0 + xi[1]*ref_vert[v][1])
+            * (1.0 + xi[2]*ref_vert[v][2])
+            * (9.0*xi[0]*xi[0] + 9.0*xi[1]*xi[1] + 9.0*xi[2]*xi[2] - 19.0);
+      }
+
+      // edges 8-15 along mu
+      for (int v = 8; v <= 15; v++){
+         basis[v] = 9.0/64.0
+            * (1.0 + xi[0]*ref_vert[v][0])
+            * (1.0 + xi[1]*ref_vert[v][1])
+            * (1.0 + 9*xi[2]*ref_vert[v][2])
+            * (1.0 - xi[2]*xi[2]);
+      }
+
+      // edges 16-23 along xi
+      for (int v = 16; v <= 23; v++){
+         basis[v] = 9.0/64.0
+            * (1.0 - xi[0]*xi[0])
+            * (1.0 + 9*xi[0]*ref_vert[v][0])
+            * (1.0 + xi[1]*ref_vert[v][1])
+            * (1.0 + xi[2]*ref_vert[v][2]);
+      }
+
+      // edges 24-31 along eta
+      for (int v = 24; v <= 31; v++){
+         basis[v] = 9.0/64.0
+            * (1.0 + xi[0]*ref_vert[v][0])
+            * (1.0 - xi[1]*xi[1])
+            * (1.0 + 9*xi[1]*ref_vert[v][1])
+            * (1.0 + xi[2]*ref_vert[v][2]);
+      }
+   }
+
+   static void partial_xi(real_t *partial, const real_t *xi){
+
+      for (int v = 0; v < 8; v++){
+         partial[v] = 1.0/64.0
+            * (1 + xi[1]*ref_vert[v][1])
+            * (1 + xi[2]*ref_vert[v][2])
+            * ((9.0*(ref_vert[v][0])*(xi[0]*xi[0] + xi[1]*xi[1] + xi[2]*xi[2]))
+            + (18.0*xi[0]*(1 + xi[0]*ref_vert[v][0]))
+            - (19.0*ref_vert[v][0]));
+      }
+
+      for (int v = 8; v <= 15; v++){
+         partial[v] = 9.0/64.0
+            * (ref_vert[v][0])
+            * (1 + xi[1]*ref_vert[v][1])
+            * (1 + 9.0*xi[2]*ref_vert[v][2])
+            * (1 - xi[2]*xi[2]);
+      }
+
+      for (int v = 16; v <= 23; v++){
+         partial[v] = 9.0/64.0
+            * (1 + xi[1]*ref_vert[v][1])
+            * (1 + xi[2]*ref_vert[v][2])
+            * (9.0*ref_vert[v][0]*(1 - 3*xi[0]*xi[0]) - (2*xi[0]));
+      }
+
+      for (int v = 24; v <= 31; v++){
+         partial[v] = 9.0/64.0
+            * (ref_vert[v][0])
+            * (1 - xi[1]*xi[1])
+            * (1 + 9.0*xi[1]*ref_vert[v][1])
+            * (1 + xi[2]*ref_vert[v][2]);
+      }
+   }
+
+   static void partial_eta(real_t *partial, const real_t *xi){
+
+      for (int v = 0; v < 8; v++){
+         partial[v] = 1.0/64.0
+            * (1 + xi[0]*ref_vert[v][0])
+            * (1 + xi[2]*ref_vert[v][2])
+            * ((9.0*ref_vert[v][1]*(xi[0]*xi[0] + xi[1]*xi[1] + xi[2]*xi[2]))
+            + (18.0*xi[1]*(1 + xi[1]*ref_vert[v][1]))
+            - (19.0*ref_vert[v][1]));
+      }
+
+      for (int v = 8; v <= 15; v++){
+         partial[v] = 9.0/64.0
+            * (1 + xi[0]*ref_vert[v][0])
+            * (ref_vert[v][1])
+            * (1 + 9.0*xi[2]*ref_vert[v][2])
+            * (1 - xi[2]*xi[2]);
+      }
+
+      for (int v = 16; v <= 23; v++){
+         partial[v] = 9.0/64.0
+            * (1 - xi[0]*xi[0])
+            * (1 + 9.0*xi[0]*ref_vert[v][0])
+            * (ref_vert[v][1])
+            * (1 + xi[2]*ref_vert[v][2]);
+      }
+
+      for (int v = 24; v <= 31; v++){
+         partial[v] = 9.0/64.0
+            * (1 + xi[0]*ref_vert[v][0])
+            * (1 + xi[2]*ref_vert[v][2])
+            * ((9.0*ref_vert[v][1]*(1 - 3*xi[1]*xi[1])) - (2*xi[1]));
+      }
+   }
+
+   static void partial_mu(real_t *partial, const real_t *xi){
+
+      for (int v = 0; v < 8; v++){
+         partial[v] = 1.0/64.0
+            * (1 + xi[0]*ref_vert[v][0])
+            * (1 + xi[1]*ref_vert[v][1])
+            * ((9.0*(ref_vert[v][2])*(xi[0]*xi[0] + xi[1]*xi[1] + xi[2]*xi[2]))
+            + (18.0*xi[2]*(1 + xi[2]*ref_vert[v][2]))
+            - (19.0*ref_vert[v][2]));
+      }
+
+      for (int v = 8; v <= 15; v++){
+         partial[v] = 9.0/64.0
+            * (1 + xi[0]*ref_vert[v][0])
+            * (1 + xi[1]*ref_vert[v][1])
+            * ((9.0*ref_vert[v][2]*(1 - 3.0*xi[2]*xi[2])) - (2*xi[2]));
+      }
+
+      for (int v = 16; v <= 23; v++){
+         partial[v] = 9.0/64.0
+            * (1 - xi[0]*xi[0])
+            * (1 + 9*xi[0]*ref_vert[v][0])
+            * (1 + xi[1]*ref_vert[v][1])
+            * (ref_vert[v][2]);
+      }
+
+      for (int v = 24; v <= 31; v++){
+         partial[v] = 9.0/64.0
+            * (1 + xi[0]*ref_vert[v][0])
+            * (1 - xi[1]*xi[1])
+            * (1 + 9*xi[1]*ref_vert[v][1])
+            * (ref_vert[v][2]);
+      }
+   }
+};
+
+/*
+ Tess16, nodes as in Tess16. Its blocks are evaluated like any other
+ element_type, or with evaluate_tess16_block.
+*/
+struct tess16_kernel : element_kernel<tess16_kernel, 4, 16> {
+
+   static constexpr real_t ref_vert[16][4] = {
+      {-1.0, -1.0, -1.0, -1.0}, { 1.0, -1.0, -1.0, -1.0},
+      { 1.0, -1.0,  1.0, -1.0}, {-1.0, -1.0,  1.0, -1.0},
+      {-1.0,  1.0, -1.0, -1.0}, { 1.0,  1.0, -1.0, -1.0},
+      { 1.0,  1.0,  1.0, -1.0}, {-1.0,  1.0,  1.0, -1.0},
+      {-1.0, -1.0, -1.0,  1.0}, { 1.0, -1.0, -1.0,  1.0},
+      { 1.0, -1.0,  1.0,  1.0}, {-1.0, -1.0,  1.0,  1.0},
+      {-1.0,  1.0, -1.0,  1.0}, { 1.0,  1.0, -1.0,  1.0},
+      { 1.0,  1.0,  1.0,  1.0}, {-1.0,  1.0,  1.0,  1.0}};
+
+   // the four 1D factors (1 + xi_d r_d) of every node, with the factor of
+   // direction skip replaced by r_skip (skip = -1 for the basis)
+   static void tensor_factor(real_t *out, const real_t *xi, const int &skip){
+      for (int v = 0; v < 16; v++){
+         real_t value = 1.0/16.0;
+         for (int d = 0; d < 4; d++)
+            value *= (d == skip) ? ref_vert[v][d] : (1.0 + xi[d]*ref_vert[v][d]);
+         out[v] = value;
+      }
+   }
+
+   static void basis(real_t *basis, const real_t *xi){
+      tensor_factor(basis, xi, -1);
+   }
+
+   static void partial_xi(real_t *partial, const real_t *xi){
+      tensor_factor(partial, xi, 0);
+   }
+
+   static void partial_eta(real_t *partial, const real_t *xi){
+      tensor_factor(partial, xi, 1);
+   }
+
+   static void partial_mu(real_t *partial, const real_t *xi){
+      tensor_factor(partial, xi, 2);
+   }
+
+   static void partial_tau(real_t *partial, const real_t *xi){
+      tensor_factor(partial, xi, 3);
+   }
+};
+
+
+// calls visitor(kernel) with the kernel of a fixed order element type. The
+// type is resolved once here, everything the visitor does with the kernel
+// is compiled for that one element.
+template<class Visitor>
+void visit_element_kernel(const element_type &type, Visitor &&visitor){
+
+   switch (type) {
+      case element_type::quad4:  visitor(quad4_kernel());  return;
+      case element_type::quad8:  visitor(quad8_kernel());  return;
+      case element_type::quad12: visitor(quad12_kernel()); return;
+      case element_type::hex8:   visitor(hex8_kernel());   return;
+      case element_type::hex20:  visitor(hex20_kernel());  return;
+      case element_type::hex32:  visitor(hex32_kernel());  return;
+      case element_type::tess16: visitor(tess16_kernel()); return;
+      case element_type::quadN:
+      case element_type::hexN:
+         THROW_IMPLEMENTED_ERROR("quadN/hexN have no fixed order kernel");
+   }
+   THROW_IMPLEMENTED_ERROR("unknown element type");
+}
+
+} //end namespace elements
+} //end namespace ristra
+
+#endif //ELEMENTS_ELEMENT_KERNELS_H
@@ -2,6 +2,10 @@
 #include <cmath>
 
 #include "ristra/elements/elements.h"
+#include "ristra/elements/element_kernels.h"
+#include "ristra/elements/jacobian.h"
+#include "ristra/elements/lagrange.h"
+#include "ristra/elements/quadrature.h"
 
 namespace ristra {
 namespace elements{
@@ -10,214 +14,52 @@ namespace elements{
 void LineGaussRuleInfo(
    real_t &x, 
    real_t &w, 
-   int &m, 
-   int &p){
-
-   m--;
-   // creating matrices for weights and points
-   real_t g2[2],w3[3],g3[3],w4[4],g4[4],g5[5],w5[5], 
-          g6[6],w6[6],g7[7],w7[7],g8[8],w8[8];
-   
-   g2[0] = -1.0/sqrt(3.0);
-   g2[1] = -1.0*g2[0]; 
-   
-   w3[0] = 5.0/9.0;
-   w3[1] = 8.0/9.0;
-   w3[2] = w3[0]; 
-        
-   g3[0] = -sqrt(3.0/5.0);
-   g3[1] = 0.0;
-   g3[2] = -1.0*g3[0]; 
-   
-   w4[0] = (1./2.)-sqrt(5./6.)/6.;
-   w4[1] = (1./2.)+sqrt(5./6.)/6.;
-   w4[2] = w4[1]; 
-   w4[3] = w4[0]; 
-   
-   g4[0] = -sqrt((3.+2.*sqrt(6./5.))/7.);
-   g4[1] = -sqrt((3.-2.*sqrt(6./5.))/7.);
-   g4[2] = -g4[1]; 
-   g4[3] = -g4[0]; 
-   
-   w5[0] = (322.-13.*sqrt(70.))/900.;
-   w5[1] = (322.+13.*sqrt(70.))/900.;
-   w5[2] =  512./900.;
-   w5[3] = w5[1]; 
-   w5[4] = w5[0]; 
-
-   g5[0] = -sqrt(5.+2.*sqrt(10./7.))/3.;
-   g5[1] = -sqrt(5.-2.*sqrt(10./7.))/3.;
-   g5[2] = 0.0;
-   g5[3] = -g5[1]; 
-   g5[4] = -g5[0]; 
-   
-   w6[0] = 0.1713244923791704;
-   w6[1] = 0.3607615730481386;
-   w6[2] = 0.4679139345726910; 
-   w6[3] = w6[2];
-   w6[4] = w6[1];
-   w6[5] = w6[0];
-
-   g6[0] = -0.9324695142031521;
-   g6[1] = -0.6612093864662645;
-   g6[2] = -0.2386191860831969;
-   g6[3] = -g6[2];
-   g6[4] = -g6[1];
-   g6[5] = -g6[0];
-
-   w7[0] = 0.1294849661688697;
-   w7[1] = 0.2797053914892766;
-   w7[2] = 0.3818300505051189;
-   w7[3] = 0.4179591836734694;
-   w7[4] = w7[2];
-   w7[5] = w7[1];
-   w7[6] = w7[0];
-
-   g7[0] = -0.9491079123427585;
-   g7[1] = -0.7415311855993945;
-   g7[2] = -0.4058451513773972;
-   g7[3] =  0.0;
-   g7[4] = -g7[2];
-   g7[5] = -g7[1];
-   g7[6] = -g7[0];
-
-   w8[0] = 0.1012285362903763;
-   w8[1] = 0.2223810344533745;
-   w8[2] = 0.3137066458778873;
-   w8[3] = 0.3626837833783620;
-   w8[4] = w8[3];
-   w8[5] = w8[2];
-   w8[6] = w8[1];
-   w8[7] = w8[0];
-   
-   g8[0] = -0.9602898564975363;
-   g8[1] = -0.7966664774136267;
-   g8[2] = -0.5255324099163290;
-   g8[3] = -0.1834346424956498;
-   g8[4] = -g8[3];
-   g8[5] = -g8[2];
-   g8[6] = -g8[1];
-   g8[7] = -g8[0];
-
-   if (p==1) {x=0.0;w=2.0;}
-   if (p==2) {x=g2[m];w=1.0;}
-   if (p==3) {x=g3[m];w=w3[m];}
-   if (p==4) {x=g4[m];w=w4[m];}
-   if (p==5) {x=g5[m];w=w5[m];}  
-   if (p==6) {x=g6[m];w=w6[m];} 
-   if (p==7) {x=g7[m];w=w7[m];} 
-   if (p==8) {x=g8[m];w=w8[m];} 
+   int &m,    // point index, 1 to p
+   int &p){   // number of points
 
+   const quadrature_1d &rule = line_rule(quadrature_rule::gauss, p);
+   x = rule.points[m - 1];
+   w = rule.weights[m - 1];
    } // end of line rule function      
 
 // Used by Lovatto 1D/2D to set Lobatto quadrature points
 void LineLobattoRuleInfo(
    real_t &x, 
    real_t &w, 
-   int &m, 
-   int &p){
-
-   m--;
-   // creating matrices for weights and points
-   real_t L2[2],w3[3],L3[3],w4[4],L4[4],L5[5],w5[5], 
-          L6[6],w6[6],L7[7],w7[7],L8[8],w8[8];
-   
-   L2[0] = -1.0;
-   L2[1] =  1.0;
-   
-   w3[0] = 1.0/3.0;
-   w3[1] = 4.0/3.0;
-   w3[2] = w3[0]; 
-        
-   L3[0] =  1.0;
-   L3[1] =  0.0;
-   L3[2] = -1.0; 
-   
-   w4[0] = 0.1666666666666666666667;
-   w4[1] = 0.8333333333333333333333;
-   w4[2] = w4[1]; 
-   w4[3] = w4[0]; 
-   
-   L4[0] = -1.0;
-   L4[1] = -0.447213595499957939282;
-   L4[2] = -L4[1]; 
-   L4[3] = -L4[0]; 
-   
-   L5[0] = -1.0;
-   L5[1] = -0.6546536707079771437983;
-   L5[2] = 0.0;
-   L5[3] = -L5[1]; 
-   L5[4] = -L5[0]; 
-   
-   w5[0] = 0.1;
-   w5[1] = 0.544444444444444444444;
-   w5[2] = 0.7111111111111111111111;
-   w5[3] = w5[1]; 
-   w5[4] = w5[0]; 
-
-   L6[0] = -1.0;
-   L6[1] = -0.765055323929464692851;
-   L6[2] = -0.2852315164806450963142;
-   L6[3] = -L6[2];
-   L6[4] = -L6[1];
-   L6[5] = -L6[0];
-
-   
-   w6[0] = 0.06666666666666666666667;
-   w6[1] = 0.3784749562978469803166;
-   w6[2] = 0.5548583770354863530167;
-   w6[3] = w6[2];
-   w6[4] = w6[1];
-   w6[5] = w6[0];
-
-   L7[0] = -1.0;
-   L7[1] = -0.830223896278566929872;
-   L7[2] = -0.4688487934707142138038;
-   L7[3] =  0.0;
-   L7[4] = -L7[2];
-   L7[5] = -L7[1];
-   L7[6] = -L7[0];
-
-   
-   w7[0] = 0.04761904761904761904762;
-   w7[1] = 0.276826047361565948011;
-   w7[2] = 0.4317453812098626234179;
-   w7[3] = 0.487619047619047619048;
-   w7[4] = w7[2];
-   w7[5] = w7[1];
-   w7[6] = w7[0];
-
-
-   L8[0] = -1.0;
-   L8[1] = -0.8717401485096066153375;
-   L8[2] = -0.5917001814331423021445;
-   L8[3] = -0.2092992179024788687687;
-   L8[4] = -L8[3];
-   L8[5] = -L8[2];
-   L8[6] = -L8[1];
-   L8[7] = -L8[0];
-
-   
-   w8[0] = 0.03571428571428571428571;
-   w8[1] = 0.210704227143506039383;
-   w8[2] = 0.3411226924835043647642;
-   w8[3] = 0.4124587946587038815671;
-   w8[4] = w8[3];
-   w8[5] = w8[2];
-   w8[6] = w8[1];
-   w8[7] = w8[0];
-   
-   if (p==1) {x=0.0;w=2.0;}
-   if (p==2) {x=L2[m];w=1.0;}
-   if (p==3) {x=L3[m];w=w3[m];}
-   if (p==4) {x=L4[m];w=w4[m];}
-   if (p==5) {x=L5[m];w=w5[m];}  
-   if (p==6) {x=L6[m];w=w6[m];} 
-   if (p==7) {x=L7[m];w=w7[m];} 
-   if (p==8) {x=L8[m];w=w8[m];} 
+   int &m,    // point index, 1 to p
+   int &p){   // number of points
 
+   const quadrature_1d &rule = line_rule(quadrature_rule::lobatto, p);
+   x = rule.points[m - 1];
+   w = rule.weights[m - 1];
    } // end of Lobatto line rule function      
 
+// copies a cached tensor rule into the per point, per direction layout
+// used by Gauss2D/3D/4D and Lobatto2D/3D/4D
+static void tensor_points(
+   vector< vector<real_t> > &these_pts,     // points
+   vector< vector<real_t> > &these_weights, // 1D weights in each direction
+   const quadrature_rule &rule,             // Gauss or Lobatto
+   const int &quad_order,                   // points per direction
+   const int &dim){                         // dimension
+
+   const quadrature_1d &line = line_rule(rule, quad_order);
+   const tensor_quadrature &tensor = tensor_rule(rule, quad_order, dim);
+
+   for (int m = 0; m < tensor.n_qp; m++) {
+      int index = m;
+
+      these_weights[m].assign(dim, 1.0);
+
+      // xi fastest, then eta, mu, tau
+      for (int d = 0; d < dim; d++){
+         these_pts[m][d] = tensor.points[m*dim + d];
+         these_weights[m][d] = line.weights[index % quad_order];
+         index /= quad_order;
+      } // end for d
+   } // end for m
+}
+
 // setting gauss quadrature points for 2D elements
 void Gauss2D(
    vector< vector<real_t> > &these_g_pts,  // gauss points
@@ -225,40 +67,15 @@ void Gauss2D(
    vector<real_t> &tot_g_weight,           // 2D product of gauss weights
    int &quad_order){                       // quadrature order (m)
 
-   int tot_pts = (quad_order*quad_order);    // total quad points in 2D
-
-   //find Gauss-Quadrature Points for volume integration
-   for (int m = 0; m < tot_pts; m++) {
-      
-      int i, j;
-      real_t x,w;
- 
-      // sets up the i, j, indices for the line rule implimentation
-
-      j = floor(m/quad_order)+1; 
-      i = (m+1) - quad_order*(j-1);
+   tensor_points(these_g_pts, these_weights, quadrature_rule::gauss,
+      quad_order, 2);
 
-      these_weights[m]={1.0,1.0};
-      
-      // xi direction
-      LineGaussRuleInfo(x,w,i,quad_order); // setting pts/weights in i direction
-      these_g_pts[m][0]=x; 
-      these_weights[m][0]*=w;
-          
-      // eta direction
-      LineGaussRuleInfo(x,w,j,quad_order); // setting pts/weights in j direction
-      these_g_pts[m][1]=x; 
-      these_weights[m][1]*=w;
-   }
+   const tensor_quadrature &tensor = 
+      tensor_rule(quadrature_rule::gauss, quad_order, 2);
 
-    for(int this_vert=0; this_vert < tot_pts; this_vert++){
-      
-      tot_g_weight[this_vert] = these_weights[this_vert][0] 
-                              * these_weights[this_vert][1]; 
+   for(int this_vert = 0; this_vert < tensor.n_qp; this_vert++){
+      tot_g_weight[this_vert] = tensor.weights[this_vert]; 
    } //end for
-
-
-
    } // end function
 
 // setting gauss quadrature points for 3D elements
@@ -268,54 +85,15 @@ void Gauss3D(
    vector<real_t> &tot_g_weight,            // 3D product of gauss weights
    int &quad_order){                        // quadrature order (n)
    
-   // total quad points in 3D
-   int tot_pts = (quad_order*quad_order*quad_order);  
-
-   //find Gauss-Quadrature Points for volume integration
-   for (int m = 0; m < tot_pts; m++) {
-      
-      int i, j, k, jj;
-
-      real_t x,w;
- 
-      // sets up the i, j, k indices for the line rule implimentation
-      int p12 = (quad_order * quad_order);
+   tensor_points(these_g_pts, these_weights, quadrature_rule::gauss,
+      quad_order, 3);
 
-      k=floor(m/p12)+1; 
+   const tensor_quadrature &tensor = 
+      tensor_rule(quadrature_rule::gauss, quad_order, 3);
 
-      jj=(m+1)-p12*(k-1); 
-      j=floor((jj-1)/quad_order)+1;
-
-      i=jj-quad_order*(j-1);  
-      
-      these_weights[m]={1.0,1.0,1.0};
-      
-      // xi direction
-      LineGaussRuleInfo(x,w,i,quad_order); // setting pts/weights in i direction
-      these_g_pts[m][0]=x; 
-      these_weights[m][0]*=w;
-          
-      // eta direction
-      LineGaussRuleInfo(x,w,j,quad_order); // setting pts/weights in j direction
-      these_g_pts[m][1]=x; 
-      these_weights[m][1]*=w;
-      
-      // mu direction
-      LineGaussRuleInfo(x,w,k,quad_order); // setting pts/weights in k direction
-      these_g_pts[m][2]=x; 
-      these_weights[m][2]*=w;
-          
-   } // end for    
-
-
-  for(int this_vert=0; this_vert < tot_pts; this_vert++){
-      
-      tot_g_weight[this_vert] = these_weights[this_vert][0] 
-                              * these_weights[this_vert][1]
-                              * these_weights[this_vert][2]; 
+   for(int this_vert = 0; this_vert < tensor.n_qp; this_vert++){
+      tot_g_weight[this_vert] = tensor.weights[this_vert]; 
    } //end for
-
-
    } // end function
 
 // setting gauss quadrature points for 4D elements
@@ -323,62 +101,10 @@ void Gauss4D(
    vector< vector<real_t> > &these_g_pts, // gauss points
    vector< vector<real_t> > &these_weights, // gauss weights
    int &quad_order, // quadrature order (n)
-   const int &dim){  // dimension
+   const int &/*dim*/){  // dimension
    
-   // total quad points in 3D
-   int tot_pts = (quad_order*quad_order*quad_order*quad_order);  
-
-   //find Gauss-Quadrature Points for volume integration
-   for (int m = 0; m < tot_pts; m++) {
-      
-      int i, j, k, l, kk, jj;
-      
-      real_t x,w;
-
-      real_t a, b, c;
-
-      a = pow(real_t(quad_order), real_t(dim-1.0));
-      b = pow(real_t(quad_order), real_t(dim-2.0));
- 
-      // sets up the i, j, k indices for the line rule implimentation
-      int p12 = (quad_order * quad_order);
-
-      l = floor(m/(a)) + 1.0;
-
-      kk = (m + 1) - (a)*(l - 1);
-
-      k=floor((kk - 1)/(b)) + 1;
-
-      jj=(m+1) - ((b)*(k - 1)) - (a)*(l - 1);
-
-      j=floor((jj-1)/quad_order)+1;
-
-      i=jj-quad_order*(j-1);  
-      
-      these_weights[m]={1.0,1.0,1.0,1.0};
-      
-      // xi direction
-      LineGaussRuleInfo(x,w,i,quad_order); // setting pts/weights in i direction
-      these_g_pts[m][0]=x; 
-      these_weights[m][0]*=w;
-          
-      // eta direction
-      LineGaussRuleInfo(x,w,j,quad_order); // setting pts/weights in j direction
-      these_g_pts[m][1]=x; 
-      these_weights[m][1]*=w;
-      
-      // mu direction
-      LineGaussRuleInfo(x,w,k,quad_order); // setting pts/weights in k direction
-      these_g_pts[m][2]=x; 
-      these_weights[m][2]*=w;
-
-      // tau direction
-      LineGaussRuleInfo(x,w,l,quad_order); // setting pts/weights in l direction
-      these_g_pts[m][3]=x; 
-      these_weights[m][3]*=w;
-
-          
-   } // end for        
+   tensor_points(these_g_pts, these_weights, quadrature_rule::gauss,
+      quad_order, 4);
    } // end function
 
 // setting Gauss-Lobatto quadrature points for 2D elements
@@ -387,33 +113,8 @@ void Lobatto2D(
    vector< vector<real_t> > &these_weights, // gauss weights
    int &quad_order){ // quadrature order (n)
 
-   int tot_pts = (quad_order*quad_order);    // total quad points in 2D
-
-   //find Gauss-Quadrature Points for volume integration
-   for (int m = 0; m < tot_pts; m++) {
-      
-      int i, j;
-      real_t x,w;
- 
-      // sets up the i, j, indices for the line rule implimentation
-
-      j = floor(m/quad_order)+1; 
-      i = (m+1) - quad_order*(j-1);
-
-      these_weights[m]={1.0,1.0};
-      
-      // xi direction
-      LineLobattoRuleInfo(x,w,i,quad_order); // setting pts/weights in i direction
-      these_L_pts[m][0]=x; 
-      these_weights[m][0]*=w;
-          
-      // eta direction
-      LineLobattoRuleInfo(x,w,j,quad_order); // setting pts/weights in j direction
-      these_L_pts[m][1]=x; 
-      these_weights[m][1]*=w;
-        
-   } // end for
-
+   tensor_points(these_L_pts, these_weights, quadrature_rule::lobatto,
+      quad_order, 2);
    } // end function
 
 // setting Gauss-Lobatto quadrature points for 3D elements
@@ -422,44 +123,8 @@ void Lobatto3D(
    vector< vector<real_t> > &these_weights, // gauss weights
    int &quad_order){  // quadrature order (n)
    
-   // total quad points in 3D
-   int tot_pts = (quad_order*quad_order*quad_order);  
-
-   //find Gauss-Quadrature Points for volume integration
-   for (int m = 0; m < tot_pts; m++) {
-      
-      int i, j, k, jj;
-
-      real_t x,w;
- 
-      // sets up the i, j, k indices for the line rule implimentation
-      int p12 = (quad_order * quad_order);
-
-      k=floor(m/p12)+1; 
-
-      jj=(m+1)-p12*(k-1); 
-      j=floor((jj-1)/quad_order)+1;
-
-      i=jj-quad_order*(j-1);  
-      
-      these_weights[m]={1.0,1.0,1.0};
-      
-      // xi direction
-      LineLobattoRuleInfo(x,w,i,quad_order); // setting pts/weights in i direction
-      these_L_pts[m][0]=x; 
-      these_weights[m][0]*=w;
-          
-      // eta direction
-      LineLobattoRuleInfo(x,w,j,quad_order); // setting pts/weights in j direction
-      these_L_pts[m][1]=x; 
-      these_weights[m][1]*=w;
-      
-      // mu direction
-      LineLobattoRuleInfo(x,w,k,quad_order); // setting pts/weights in k direction
-      these_L_pts[m][2]=x; 
-      these_weights[m][2]*=w;
-          
-   } // end for        
+   tensor_points(these_L_pts, these_weights, quadrature_rule::lobatto,
+      quad_order, 3);
    } // end function
 
 // setting gauss quadrature points for 4D elements
@@ -467,61 +132,43 @@ void Lobatto4D(
    vector< vector<real_t> > &these_L_pts, // gauss points
    vector< vector<real_t> > &these_weights, // gauss weights
    int &quad_order, // quadrature order (n)
-   const int &dim){  // dimension
+   const int &/*dim*/){  // dimension
    
-   // total quad points in 3D
-   int tot_pts = (quad_order*quad_order*quad_order*quad_order);  
-
-   //find Gauss-Quadrature Points for volume integration
-   for (int m = 0; m < tot_pts; m++) {
-      
-      int i, j, k, l, kk, jj;
-      
-      real_t x,w;
-
-      real_t a, b, c;
+   tensor_points(these_L_pts, these_weights, quadrature_rule::lobatto,
+      quad_order, 4);
+   } // end function
 
-      a = pow(real_t(quad_order), real_t(dim-1.0)); //to simplify indexing equations
-      b = pow(real_t(quad_order), real_t(dim-2.0));
- 
-      // sets up the i, j, k, l indices for the line rule implimentation
+// jacobian and determinant of a Dim x Dim element, accumulated in a fixed
+// size matrix and finished with the fixed size determinant kernel
+template<int Dim>
+static void jacobian_nested(
+   vector< vector<real_t> > &J_matrix, 
+   real_t &det_J,
+   const vector< vector<real_t> > &vertices, 
+   const vector< vector<real_t> > &this_partial,
+   const int &num_nodes){
 
-      l = floor(m/(a)) + 1.0;
+   real_t J[Dim][Dim];
 
-      kk = (m + 1) - (a)*(l - 1);
+   for(int j = 0; j < Dim; j++)
+      for(int k = 0; k < Dim; k++)
+         J[j][k] = 0.0;
 
-      k=floor((kk - 1)/(b)) + 1;
+   for(int this_x_vert = 0; this_x_vert < num_nodes; this_x_vert++){ 
+      const vector<real_t> &vert    = vertices[this_x_vert];
+      const vector<real_t> &partial = this_partial[this_x_vert];
 
-      jj=(m+1) - ((b)*(k - 1)) - (a)*(l - 1);
+      for(int j = 0; j < Dim; j++)
+         for(int k = 0; k < Dim; k++)
+            J[j][k] += vert[k]*partial[j];
+   } // end for num_nodes
 
-      j=floor((jj-1)/quad_order)+1;
+   for(int j = 0; j < Dim; j++)
+      for(int k = 0; k < Dim; k++)
+         J_matrix[j][k] = J[j][k];
 
-      i=jj-quad_order*(j-1);  
-      
-      these_weights[m]={1.0,1.0,1.0,1.0};
-      
-      // xi direction
-      LineLobattoRuleInfo(x,w,i,quad_order); // setting pts/weights in i direction
-      these_L_pts[m][0]=x; 
-      these_weights[m][0]*=w;
-          
-      // eta direction
-      LineLobattoRuleInfo(x,w,j,quad_order); // setting pts/weights in j direction
-      these_L_pts[m][1]=x; 
-      these_weights[m][1]*=w;
-      
-      // mu direction
-      LineLobattoRuleInfo(x,w,k,quad_order); // setting pts/weights in k direction
-      these_L_pts[m][2]=x; 
-      these_weights[m][2]*=w;
-
-      // tau direction
-      LineLobattoRuleInfo(x,w,l,quad_order); // setting pts/weights in l direction
-      these_L_pts[m][3]=x; 
-      these_weights[m][3]*=w;
-          
-   } // end for        
-   } // end function
+   det_J = determinant_kernel<Dim>(J);
+}
 
 //defining the jacobian for 2D/3D elements
 void jacobian(
@@ -532,33 +179,10 @@ void jacobian(
    const int &num_nodes,
    const int &dim){
    
-
-   // setting jacobian matrix to all zeros
-   for(int j = 0; j < dim; j++){  // looping over dimension
-      for(int k = 0; k < dim; k++){ //looping over dimension
-         J_matrix[j][k] = 0.0;
-      }// end for k
-   } // end for j
-   
-   // solving for the jacobian 
-   for(int j = 0; j < dim; j++){  // looping over dimension (partial)
-      for(int k = 0; k < dim; k++){ //looping over dimension (vertex position)
-         //looping over node positions
-         for(int this_x_vert = 0; this_x_vert < num_nodes; this_x_vert++){ 
-            J_matrix[j][k] += vertices[this_x_vert][k]
-                           * this_partial[this_x_vert][j];
-         } // end for num_nodes
-      } // end for k
-   } // end for j
-    
-
-   //calcualate the determinant of the jacobian for 2D/3D matrices
-   det_J =  J_matrix[0][0] *(J_matrix[1][1] * (J_matrix[2][2] - (J_matrix[2][2] - 1)*abs(dim-3)) 
-         - (J_matrix[2][1] * J_matrix[1][2])*abs(dim-2))  //group 1
-         -  J_matrix[0][1] *(J_matrix[1][0] * (J_matrix[2][2] - (J_matrix[2][2] - 1)*abs(dim-3)) 
-         - (J_matrix[2][0] * J_matrix[1][2])*abs(dim-2))  // group 2
-         +  J_matrix[0][2] *(J_matrix[1][0] *  J_matrix[2][1] 
-         -  J_matrix[2][0] * J_matrix[1][1])*(abs(dim-2)); // group 3 
+   if (dim == 2) 
+      jacobian_nested<2>(J_matrix, det_J, vertices, this_partial, num_nodes);
+   else
+      jacobian_nested<3>(J_matrix, det_J, vertices, this_partial, num_nodes);
    } // end of jacobian function
 
 //defining the jacobian for 4D elements
@@ -589,45 +213,40 @@ void jacobian4D(
       } // end for k
    } // end for j
     
-   det_J =  J_matrix[0][3] * J_matrix[1][2] * J_matrix[2][1] * J_matrix[3][0] 
-          - J_matrix[0][2] * J_matrix[1][3] * J_matrix[2][1] * J_matrix[3][0] 
-          - J_matrix[0][3] * J_matrix[1][1] * J_matrix[2][2] * J_matrix[3][0] 
-          + J_matrix[0][1] * J_matrix[1][3] * J_matrix[2][2] * J_matrix[3][0] 
-          + J_matrix[0][2] * J_matrix[1][1] * J_matrix[2][3] * J_matrix[3][0] 
-          - J_matrix[0][1] * J_matrix[1][2] * J_matrix[2][3] * J_matrix[3][0] 
-          - J_matrix[0][3] * J_matrix[1][2] * J_matrix[2][0] * J_matrix[3][1] 
-          + J_matrix[0][2] * J_matrix[1][3] * J_matrix[2][0] * J_matrix[3][1] 
-          + J_matrix[0][3] * J_matrix[1][0] * J_matrix[2][2] * J_matrix[3][1] 
-          - J_matrix[0][0] * J_matrix[1][3] * J_matrix[2][2] * J_matrix[3][1] 
-          - J_matrix[0][2] * J_matrix[1][0] * J_matrix[2][3] * J_matrix[3][1] 
-          + J_matrix[0][0] * J_matrix[1][2] * J_matrix[2][3] * J_matrix[3][1] 
-          + J_matrix[0][3] * J_matrix[1][1] * J_matrix[2][0] * J_matrix[3][2] 
-          - J_matrix[0][1] * J_matrix[1][3] * J_matrix[2][0] * J_matrix[3][2] 
-          - J_matrix[0][3] * J_matrix[1][0] * J_matrix[2][1] * J_matrix[3][2] 
-          + J_matrix[0][0] * J_matrix[1][3] * J_matrix[2][1] * J_matrix[3][2] 
-          + J_matrix[0][1] * J_matrix[1][0] * J_matrix[2][3] * J_matrix[3][2] 
-          - J_matrix[0][0] * J_matrix[1][1] * J_matrix[2][3] * J_matrix[3][2] 
-          - J_matrix[0][2] * J_matrix[1][1] * J_matrix[2][0] * J_matrix[3][3] 
-          + J_matrix[0][1] * J_matrix[1][2] * J_matrix[2][0] * J_matrix[3][3] 
-          + J_matrix[0][2] * J_matrix[1][0] * J_matrix[2][1] * J_matrix[3][3] 
-          - J_matrix[0][0] * J_matrix[1][2] * J_matrix[2][1] * J_matrix[3][3] 
-          - J_matrix[0][1] * J_matrix[1][0] * J_matrix[2][2] * J_matrix[3][3] 
-          + J_matrix[0][0] * J_matrix[1][1] * J_matrix[2][2] * J_matrix[3][3];
+   // cofactor expansion over the shared 2x2 minors
+   real_t J[4][4];
+   for(int j = 0; j < 4; j++)
+      for(int k = 0; k < 4; k++)
+         J[j][k] = J_matrix[j][k];
+
+   det_J = determinant_kernel<4>(J);
    
    } // end of jacobian function
 
+// copies a fixed size matrix into a nested vector, sizing it if needed
+template<int Dim>
+static void copy_nested(
+   vector< vector<real_t> > &A, 
+   const real_t (&B)[Dim][Dim]){
+
+   A.resize(Dim);
+   for(int j = 0; j < Dim; j++){
+      A[j].resize(Dim);
+      for(int k = 0; k < Dim; k++) A[j][k] = B[j][k];
+   }
+}
+
 //defining the inverse jacobian for 2D element    
 void jacobian_inverse_2d(
    vector< vector<real_t> > &J_inverse, 
    const vector< vector<real_t> > &jacobian){
 
-   real_t det = jacobian[0][0]*jacobian[1][1] 
-                - jacobian[0][1]*jacobian[1][0];
+   real_t J[2][2] = {{jacobian[0][0], jacobian[0][1]},
+                     {jacobian[1][0], jacobian[1][1]}};
+   real_t J_inv[2][2];
 
-   J_inverse = {
-               {jacobian[1][1]/det, -jacobian[0][1]/det},
-               {-jacobian[1][0]/det, jacobian[0][0]/det},
-               };
+   inverse_kernel<2>(J_inv, J, determinant_kernel<2>(J));
+   copy_nested<2>(J_inverse, J_inv);
    } // end of 2D jacobin inverse
 
 // defining  the inverse of the Jacobian for 3D elements
@@ -635,42 +254,14 @@ void jacobian_inverse_3d(
    vector<vector<real_t> > &J_inverse_matrix,
    const vector<vector<real_t> > &jacobian){
 
-   real_t A_11 = jacobian[1][1]*jacobian[2][2] 
-                 - jacobian[1][2]*jacobian[2][1];
-
-   real_t A_22 = jacobian[2][2]*jacobian[0][0] 
-                 - jacobian[2][0]*jacobian[0][2];
-
-   real_t A_33 = jacobian[0][0]*jacobian[1][1] 
-                 - jacobian[0][1]*jacobian[1][0];
-
-   real_t A_12 = jacobian[1][2]*jacobian[2][0] 
-                 - jacobian[1][0]*jacobian[2][2];
-
-   real_t A_23 = jacobian[2][0]*jacobian[0][1] 
-                 - jacobian[2][1]*jacobian[0][0];
-
-   real_t A_31 = jacobian[0][1]*jacobian[1][2] 
-                 - jacobian[0][2]*jacobian[1][1];
-
-   real_t A_21 = jacobian[2][1]*jacobian[0][2] 
-                 - jacobian[0][1]*jacobian[2][2];
-
-   real_t A_32 = jacobian[0][2]*jacobian[1][0] 
-                 - jacobian[1][2]*jacobian[0][0];
-
-   real_t A_13 = jacobian[1][0]*jacobian[1][1] 
-                 - jacobian[2][0]*jacobian[1][1];
- 
-   real_t  det = jacobian[0][0]*A_11 + jacobian[0][1]*A_21 
-                + jacobian[0][2]*A_31;
-
-   J_inverse_matrix = {
-                      {A_11/det, A_12/det, A_13/det},
-                      {A_21/det, A_22/det, A_23/det},
-                      {A_31/det, A_32/det, A_33/det},
-                      };
+   real_t J[3][3];
+   for(int j = 0; j < 3; j++)
+      for(int k = 0; k < 3; k++)
+         J[j][k] = jacobian[j][k];
 
+   real_t J_inv[3][3];
+   inverse_kernel<3>(J_inv, J, determinant_kernel<3>(J));
+   copy_nested<3>(J_inverse_matrix, J_inv);
     } // end of inverse jacobian 
 
 // defining  the inverse of the Jacobian for 4D elements
@@ -680,161 +271,17 @@ void jacobian_inverse_4d(
    const real_t &det_J){
 
 
-   real_t inv[16];
-   real_t m[16];
-   real_t inv_mat[16];
-
-   // convering jacobian into array length 16
-   for (int array = 0; array < 4; array++){ 
-       m[array] = jacobian[0][array];
-   }
-   for (int array = 4; array < 8; array++){ 
-       m[array] = jacobian[1][array-4];
-   }
-   for (int array = 8; array < 12; array++){ 
-       m[array] = jacobian[2][array-8];
-   }
-   for (int array = 12; array < 16; array++){ 
-       m[array] = jacobian[3][array-12];     
-   }
-
-
-   inv[0] = m[5]  * m[10] * m[15] 
-          - m[5]  * m[11] * m[14] 
-          - m[9]  * m[6]  * m[15] 
-          + m[9]  * m[7]  * m[14] 
-          + m[13] * m[6]  * m[11] 
-          - m[13] * m[7]  * m[10];
-
-   inv[4] = -m[4]  * m[10] * m[15] 
-          + m[4]  * m[11] * m[14] 
-          + m[8]  * m[6]  * m[15] 
-          - m[8]  * m[7]  * m[14] 
-          - m[12] * m[6]  * m[11] 
-          + m[12] * m[7]  * m[10];
-
-   inv[8] = m[4]  * m[9] * m[15] 
-          - m[4]  * m[11] * m[13] 
-          - m[8]  * m[5] * m[15] 
-          + m[8]  * m[7] * m[13] 
-          + m[12] * m[5] * m[11] 
-          - m[12] * m[7] * m[9];
-
-   inv[12] =-m[4]  * m[9] * m[14] 
-           + m[4]  * m[10] * m[13] 
-           + m[8]  * m[5] * m[14] 
-           - m[8]  * m[6] * m[13] 
-           - m[12] * m[5] * m[10] 
-           + m[12] * m[6] * m[9];
-
-   inv[1] =-m[1]  * m[10] * m[15] 
-          + m[1]  * m[11] * m[14] 
-          + m[9]  * m[2] * m[15] 
-          - m[9]  * m[3] * m[14] 
-          - m[13] * m[2] * m[11] 
-          + m[13] * m[3] * m[10];
-
-   inv[5] = m[0]  * m[10] * m[15] 
-          - m[0]  * m[11] * m[14] 
-          - m[8]  * m[2] * m[15] 
-          + m[8]  * m[3] * m[14] 
-          + m[12] * m[2] * m[11] 
-          - m[12] * m[3] * m[10];
-
-   inv[9] =-m[0]  * m[9] * m[15] 
-          + m[0]  * m[11] * m[13] 
-          + m[8]  * m[1] * m[15] 
-          - m[8]  * m[3] * m[13] 
-          - m[12] * m[1] * m[11] 
-          + m[12] * m[3] * m[9];
-
-   inv[13] = m[0]  * m[9] * m[14] 
-           - m[0]  * m[10] * m[13] 
-           - m[8]  * m[1] * m[14] 
-           + m[8]  * m[2] * m[13] 
-           + m[12] * m[1] * m[10] 
-           - m[12] * m[2] * m[9];
-
-   inv[2] =  m[1]  * m[6] * m[15] 
-           - m[1]  * m[7] * m[14] 
-           - m[5]  * m[2] * m[15] 
-           + m[5]  * m[3] * m[14] 
-           + m[13] * m[2] * m[7] 
-           - m[13] * m[3] * m[6];
-
-   inv[6] = -m[0]  * m[6] * m[15] 
-           + m[0]  * m[7] * m[14] 
-           + m[4]  * m[2] * m[15] 
-           - m[4]  * m[3] * m[14] 
-           - m[12] * m[2] * m[7] 
-           + m[12] * m[3] * m[6];
-
-   inv[10] = m[0]  * m[5] * m[15] 
-           - m[0]  * m[7] * m[13] 
-           - m[4]  * m[1] * m[15] 
-           + m[4]  * m[3] * m[13] 
-           + m[12] * m[1] * m[7] 
-           - m[12] * m[3] * m[6];
-
-   inv[14] =-m[0]  * m[5] * m[14] 
-           + m[0]  * m[6] * m[13] 
-           + m[4]  * m[1] * m[14] 
-           - m[4]  * m[2] * m[13] 
-           - m[12] * m[1] * m[6] 
-           + m[12] * m[2] * m[5];
-
-   inv[3] =-m[1] * m[6] * m[11] 
-          + m[1] * m[7] * m[10] 
-          + m[5] * m[2] * m[11] 
-          - m[5] * m[3] * m[10] 
-          - m[9] * m[2] * m[7] 
-          + m[9] * m[3] * m[6];
-
-   inv[7] =  m[0] * m[6] * m[11] 
-           - m[0] * m[7] * m[10] 
-           - m[4] * m[2] * m[11] 
-           + m[4] * m[3] * m[10] 
-           + m[8] * m[2] * m[7] 
-           - m[8] * m[3] * m[6];
-
-   inv[11] = -m[0] * m[5] * m[11] 
-           +  m[0] * m[7] * m[9] 
-           +  m[4] * m[1] * m[11] 
-           -  m[4] * m[3] * m[9] 
-           -  m[8] * m[1] * m[7] 
-           +  m[8] * m[3] * m[5];
-
-   inv[15] = m[0] * m[5] * m[10] 
-           - m[0] * m[6] * m[9] 
-           - m[4] * m[1] * m[10] 
-           + m[4] * m[2] * m[9] 
-           + m[8] * m[1] * m[6] 
-           - m[8] * m[2] * m[5];
-
-   real_t det_inv = (1.0 / det_J);
-
-   for (int i = 0; i < 16; i++){
-      inv_mat[i] = inv[i] * det_inv;
-   }
-   
-   // convering inverse jacobian back to 2D array
-   for (int array = 0; array < 4; array++){ 
-      J_inverse_matrix[0][array] = inv_mat[array];
-   }
-
-   for (int array = 4; array < 8; array++){
-      J_inverse_matrix[1][array-4] = inv_mat[array];      
-   }
-
-   for (int array = 8; array < 12; array++){
-      J_inverse_matrix[2][array-8] = inv_mat[array];    
-   }
-
-   for (int array = 12; array < 16; array++){ 
-      J_inverse_matrix[3][array-12] = inv_mat[array];          
-   }
+   real_t J[4][4];
+   for(int j = 0; j < 4; j++)
+      for(int k = 0; k < 4; k++)
+         J[j][k] = jacobian[j][k];
 
+   real_t J_inv[4][4];
+   inverse_kernel<4>(J_inv, J, det_J);
 
+   for(int j = 0; j < 4; j++)
+      for(int k = 0; k < 4; k++)
+         J_inverse_matrix[j][k] = J_inv[j][k];
    } // end of quad point inverse jacobian functions
 
 
@@ -887,79 +334,39 @@ real_t Quad_4_2D::ref_vert[4][2] = // listed as {Xi, Eta}
 void Quad_4_2D::physical_position(
    vector <real_t> &x_point, 
    const vector <real_t> &xi_2D_point, 
-   const vector< vector<real_t> > &vertices){
-
-   real_t shape_fcn[8];
-   real_t check_unity;
-
-   // calculate the shape functions from each vertex for 0 through 4(xi,eta)
-   for( int this_vert = 0; this_vert < 4; this_vert++ ){
-      shape_fcn[this_vert] = 1.0/4.0
-         * (1.0 + xi_2D_point[0]*ref_vert[this_vert][0])
-         * (1.0 + xi_2D_point[1]*ref_vert[this_vert][1]);
+   const vector< vector<real_t> > &vertices) const{
 
-   }// end for
+   // flat copy of the vertices for the kernel
+   real_t vert_flat[quad4_kernel::num_nodes*2];
+   for (int node = 0; node < quad4_kernel::num_nodes; node++)
+      for (int d = 0; d < 2; d++)
+         vert_flat[node*2 + d] = vertices[node][d];
 
-   // calculate the position in physical space
-   for (int dim = 0; dim < 2; dim++)
-      x_point[dim] = 0.0;
-
-      check_unity = 0.0;
-      for (int this_vert = 0; this_vert < 4; this_vert++ ){
-         for (int dim = 0; dim < 2; dim++){
-            x_point[dim] += vertices[this_vert][dim]*shape_fcn[this_vert];
-
-         }// end for dim
-          
-         // check partition of unity
-         check_unity += shape_fcn[this_vert];
-
-      } // end for this_vert
-       
-      // unit test
-      //std::cout << "partion of unity quad 4 2D: " << check_unity << std::endl;    
+   quad4_kernel::physical_position(x_point.data(), xi_2D_point.data(), vert_flat);
 } // end of physical position functionfunction
 
 // calculate the value for the basis at each node for a given xi,eta
 void Quad_4_2D::basis(
    vector <real_t> &basis,
    const vector <real_t> &xi_2D_point,
-   const vector< vector<real_t> > &vertices){
-
-   // calculate the shape functions from each vertex for 0 through 4(xi,eta)
-   for( int this_vert = 0; this_vert < 4; this_vert++ ){
-      basis[this_vert] = 1.0/4.0
-         * (1.0 + xi_2D_point[0]*ref_vert[this_vert][0])
-         * (1.0 + xi_2D_point[1]*ref_vert[this_vert][1]);
-
-   }// end for
+   const vector< vector<real_t> > &vertices) const{
+   quad4_kernel::basis(basis.data(), xi_2D_point.data());
 }// end of quad4 basis functions
 
 
 // Partial derivative of shape functions with respect to Xi
 void  Quad_4_2D::partial_xi_shape_fcn(
    vector<real_t>  &quad4_partial_xi, 
-   const vector <real_t> &xi_2D_point) {
-
-
-   for (int this_vert = 0; this_vert < 4; this_vert++){
-      quad4_partial_xi[this_vert] = (1.0/4.0)
-         * (ref_vert[this_vert][0])
-         * (1.0 + xi_2D_point[1]*ref_vert[this_vert][1]);
-   }
+   const vector <real_t> &xi_2D_point) const {
+   quad4_kernel::partial_xi(quad4_partial_xi.data(), xi_2D_point.data());
 }// end of partial xi funciton
 
 
 // Partial derivative of shape functions with respect to Eta
 void  Quad_4_2D::partial_eta_shape_fcn(
    vector<real_t> &quad4_partial_eta, 
-   const vector <real_t> &xi_2D_point) {
-
-   for (int this_vert = 0; this_vert < 4; this_vert++){
-      quad4_partial_eta[this_vert] = (1.0/4.0)
-         * (1.0 + xi_2D_point[0]*ref_vert[this_vert][0])
-         * (ref_vert[this_vert][1]);
-   }
+   const vector <real_t> &xi_2D_point) const {
+   quad4_kernel::partial_eta(quad4_partial_eta.data(), xi_2D_point.data());
 }// end of partial eta function
 
 /*
@@ -1006,141 +413,37 @@ real_t Quad_8_2D::ref_vert[8][2] = // listed as {Xi, Eta}
 void Quad_8_2D::physical_position(
    vector <real_t> &x_point, 
    const vector <real_t> &xi_2D_point, 
-   const vector< vector<real_t> > &vertices){
-  
-   real_t shape_fcn[8];
-   real_t check_unity;
-
-   // calculate the shape functions for node 0,1,2,3(xi,eta)
-   for( int this_vert = 0; this_vert < 4; this_vert++ ){
-      shape_fcn[this_vert] = 1.0/4.0
-         * (1.0 + xi_2D_point[0]*ref_vert[this_vert][0])
-         * (1.0 + xi_2D_point[1]*ref_vert[this_vert][1])
-         * (xi_2D_point[0]*ref_vert[this_vert][0] 
-         +  xi_2D_point[1]*ref_vert[this_vert][1] -1);
-   } // end for this_vert
-
+   const vector< vector<real_t> > &vertices) const{
 
-   // calculate the shape functions for node 4,6(xi,eta)
-   for( int this_vert = 4; this_vert <= 6; this_vert += 2 ){
-      shape_fcn[this_vert] = 1.0/2.0
-         * (1.0 - xi_2D_point[0]*xi_2D_point[0])
-         * (1.0 + xi_2D_point[1]*ref_vert[this_vert][1]);
-   } // end for this_vert
-
-   // calculate the shape functions for node 5,7 (xi,eta)
-   for( int this_vert = 5; this_vert <= 7; this_vert += 2 ){
-      shape_fcn[this_vert] = 1.0/2.0
-         * (1.0 + xi_2D_point[0]*ref_vert[this_vert][0])
-         * (1.0 - xi_2D_point[1]*xi_2D_point[1]);
-   } // end for this_vert
+   // flat copy of the vertices for the kernel
+   real_t vert_flat[quad8_kernel::num_nodes*2];
+   for (int node = 0; node < quad8_kernel::num_nodes; node++)
+      for (int d = 0; d < 2; d++)
+         vert_flat[node*2 + d] = vertices[node][d];
 
-   // calculate the position in physical space
-   for (int dim = 0; dim < 2; dim++)
-      x_point[dim] = 0.0;
-
-      check_unity = 0.0;
-      for (int this_vert = 0; this_vert < 8; this_vert++ ){
-         for (int dim = 0; dim < 2; dim++){
-            x_point[dim] += vertices[this_vert][dim]*shape_fcn[this_vert];
-         } // end for dim
-              
-         // check partition of unity
-         check_unity += shape_fcn[this_vert];
-      } // end for this_vert
-   
-      // unit test
-      //std::cout << "partion of unity quad 8 2D: " << check_unity << std::endl;      
+   quad8_kernel::physical_position(x_point.data(), xi_2D_point.data(), vert_flat);
 } // end of function
 
 // calculate the value for the basis at each node for a given xi,eta
 void Quad_8_2D::basis(
    vector <real_t> &basis,
    const vector <real_t> &xi_2D_point,
-   const vector< vector<real_t> > &vertices){
-
-   // calculate the shape functions for node 0,1,2,3(xi,eta)
-   for( int this_vert = 0; this_vert < 4; this_vert++ ){
-      basis[this_vert] = 1.0/4.0
-         * (1.0 + xi_2D_point[0]*ref_vert[this_vert][0])
-         * (1.0 + xi_2D_point[1]*ref_vert[this_vert][1])
-         * (xi_2D_point[0]*ref_vert[this_vert][0] 
-         +  xi_2D_point[1]*ref_vert[this_vert][1] -1);
-   } // end for this_vert
-
-
-   // calculate the shape functions for node 4,6(xi,eta)
-   for( int this_vert = 4; this_vert <= 6; this_vert += 2 ){
-      basis[this_vert] = 1.0/2.0
-         * (1.0 - xi_2D_point[0]*xi_2D_point[0])
-         * (1.0 + xi_2D_point[1]*ref_vert[this_vert][1]);
-   } // end for this_vert
-
-   // calculate the shape functions for node 5,7 (xi,eta)
-   for( int this_vert = 5; this_vert <= 7; this_vert += 2 ){
-      basis[this_vert] = 1.0/2.0
-         * (1.0 + xi_2D_point[0]*ref_vert[this_vert][0])
-         * (1.0 - xi_2D_point[1]*xi_2D_point[1]);
-   } // end for this_vert
+   const vector< vector<real_t> > &vertices) const{
+   quad8_kernel::basis(basis.data(), xi_2D_point.data());
 }// end of quad8 basis functions
 
 // Partial derivative of shape functions with respect to Xi
 void Quad_8_2D::partial_xi_shape_fcn(
    vector<real_t>  &quad8_partial_xi, 
-   const vector <real_t> &xi_2D_point) {
-
-   // calculate the Xi partials for node 0,1,2,3 (xi,eta)
-   for( int this_vert = 0; this_vert < 4; this_vert++ ){
-      quad8_partial_xi[this_vert] = 1.0/4.0
-         * (ref_vert[this_vert][0])
-         * (1 + ref_vert[this_vert][1]*xi_2D_point[1])
-         *((2 * ref_vert[this_vert][0]*xi_2D_point[0]) 
-         + (ref_vert[this_vert][1]*xi_2D_point[1]));
-   } // end for this_vert
-
-
-   // calculate the Xi partials for node 4,6 (xi,eta)
-   for( int this_vert = 4; this_vert <= 6; this_vert += 2 ){
-      quad8_partial_xi[this_vert] = -1
-         * (xi_2D_point[0])
-         * (1 + ref_vert[this_vert][1]*xi_2D_point[1]);
-   } // end for this_vert
-
-   // calculate the Xi partials for node 5,7 (xi,eta)
-   for( int this_vert = 5; this_vert <= 7; this_vert += 2 ){
-      quad8_partial_xi[this_vert] = 1.0/2.0
-         * (ref_vert[this_vert][0])
-         * (1 - xi_2D_point[1]*xi_2D_point[1]);
-   } // end for this_vert
+   const vector <real_t> &xi_2D_point) const {
+   quad8_kernel::partial_xi(quad8_partial_xi.data(), xi_2D_point.data());
 } // end partial Xi function
 
 // Partial derivative of shape functions with respect to Eta
 void Quad_8_2D::partial_eta_shape_fcn(
    vector<real_t> &quad8_partial_eta, 
-   const vector <real_t> &xi_2D_point) {
-
-   // calculate the Eta partials for node 0,1,2,3 (xi,eta)
-   for( int this_vert = 0; this_vert < 4; this_vert++ ){
-      quad8_partial_eta[this_vert] = 1.0/4.0
-         * (1 + ref_vert[this_vert][0]*xi_2D_point[0])
-         * (ref_vert[this_vert][1])
-         *((ref_vert[this_vert][0]*xi_2D_point[0])
-         + (2 * ref_vert[this_vert][1]*xi_2D_point[1])); 
-   } // end for this_vert
-
-   // calculate the Eta partials for node 4,6 (xi,eta)
-   for( int this_vert = 4; this_vert <= 6; this_vert += 2 ){
-      quad8_partial_eta[this_vert] = 1.0/2.0
-         * (1 - xi_2D_point[0]*xi_2D_point[0])
-         * (ref_vert[this_vert][1]);
-   } // end for this_vert
-
-   // calculate the Eta partials for node 5,7 (xi,eta)
-   for( int this_vert = 5; this_vert <= 7; this_vert += 2 ){
-     quad8_partial_eta[this_vert] = -1
-        * (1 + ref_vert[this_vert][0]*xi_2D_point[0])
-        * (xi_2D_point[1]);
-   } // end for this_vert
+   const vector <real_t> &xi_2D_point) const {
+   quad8_kernel::partial_eta(quad8_partial_eta.data(), xi_2D_point.data());
 } // end partial Eta function
 
 /*
@@ -1191,161 +494,37 @@ real_t Quad_12_2D::ref_vert[12][2] = // listed as {Xi, Eta}
 void Quad_12_2D::physical_position(
    vector <real_t> &x_point, 
    const vector <real_t> &xi_point,
-   const vector< vector<real_t> > &vertices){
-  
-   real_t shape_fcn[12];
-   real_t check_unity;
-
-   // calculate the shape functions for node 0,1,2,3(xi,eta)
-   for( int this_vert = 0; this_vert < 4; this_vert++ ){
-      shape_fcn[this_vert] = 1.0/32.0
-         * (1 + ref_vert[this_vert][0] * xi_point[0])
-         * (1 + ref_vert[this_vert][1] * xi_point[1])
-         * (9.0 * (xi_point[0] * xi_point[0] + xi_point[1] * xi_point[1])
-         - (10.0));
-
-   } // end for this_vert
-
-
-   // calculate the shape functions for node 4-7(xi,eta)
-   for( int this_vert = 4; this_vert <= 7; this_vert++ ){
-      shape_fcn[this_vert] = 9.0/32.0
-         * (1 - xi_point[0] * xi_point[0])
-         * (1 + xi_point[1] * ref_vert[this_vert][1])
-         * (1 + 9.0 * xi_point[0] * ref_vert[this_vert][0]);
-
-   } // end for this_vert
+   const vector< vector<real_t> > &vertices) const{
 
-   // calculate the shape functions for node 8-11 (xi,eta)
-   for( int this_vert = 8; this_vert <= 11; this_vert++ ){
-      shape_fcn[this_vert] = 9.0/32.0
-         * (1 + xi_point[0] * ref_vert[this_vert][0])
-         * (1 - xi_point[1] * xi_point[1])
-         * (1 + 9.0 * xi_point[1] * ref_vert[this_vert][1]);
+   // flat copy of the vertices for the kernel
+   real_t vert_flat[quad12_kernel::num_nodes*2];
+   for (int node = 0; node < quad12_kernel::num_nodes; node++)
+      for (int d = 0; d < 2; d++)
+         vert_flat[node*2 + d] = vertices[node][d];
 
-   } // end for this_vert
-
-   // calculate the position in physical space
-   for (int dim = 0; dim < 2; dim++)
-      x_point[dim] = 0.0;
-
-      check_unity = 0.0;
-      for (int this_vert = 0; this_vert < 12; this_vert++ ){
-         for (int dim = 0; dim < 2; dim++){
-            x_point[dim] += vertices[this_vert][dim]*shape_fcn[this_vert];
-         } // end for dim
-              
-        // check partition of unity
-        check_unity += shape_fcn[this_vert];
-     } // end for this_vert
-   
-   // unit test
-   //std::cout << "partion of unity quad 12 2D: " << check_unity << std::endl;
+   quad12_kernel::physical_position(x_point.data(), xi_point.data(), vert_flat);
 } // end of function
 
 // calculate the value for the basis at each node for a given xi,eta
 void Quad_12_2D::basis(
    vector <real_t> &basis,
    const vector <real_t> &xi_2D_point,
-   const vector< vector<real_t> > &vertices){
-
-   // calculate the shape functions for node 0,1,2,3(xi,eta)
-   for( int this_vert = 0; this_vert < 4; this_vert++ ){
-      basis[this_vert] = 1.0/4.0
-         * (1.0 + xi_2D_point[0]*ref_vert[this_vert][0])
-         * (1.0 + xi_2D_point[1]*ref_vert[this_vert][1])
-         * (xi_2D_point[0]*ref_vert[this_vert][0] 
-         +  xi_2D_point[1]*ref_vert[this_vert][1] -1);
-   } // end for this_vert
-
-
-   // calculate the shape functions for node 4,6(xi,eta)
-   for( int this_vert = 4; this_vert <= 6; this_vert += 2 ){
-      basis[this_vert] = 1.0/2.0
-         * (1.0 - xi_2D_point[0]*xi_2D_point[0])
-         * (1.0 + xi_2D_point[1]*ref_vert[this_vert][1]);
-   } // end for this_vert
-
-   // calculate the shape functions for node 5,7 (xi,eta)
-   for( int this_vert = 5; this_vert <= 7; this_vert += 2 ){
-      basis[this_vert] = 1.0/2.0
-         * (1.0 + xi_2D_point[0]*ref_vert[this_vert][0])
-         * (1.0 - xi_2D_point[1]*xi_2D_point[1]);
-   } // end for this_vert
+   const vector< vector<real_t> > &vertices) const{
+   quad12_kernel::basis(basis.data(), xi_2D_point.data());
 }// end of quad12 basis functions
 
 // Partial derivative of shape functions with respect to Xi
 void Quad_12_2D::partial_xi_shape_fcn(
    vector<real_t>  &quad12_partial_xi, 
-   const vector <real_t> &xi_point) {
-
-   // calculate the Xi partials for node 0,1,2,3 (xi,eta)
-   for( int this_vert = 0; this_vert < 4; this_vert++ ){
-      quad12_partial_xi[this_vert] = 1.0/32.0
-         * (1 + xi_point[1] * ref_vert[this_vert][1])
-         *((9.0 * ref_vert[this_vert][0] 
-         * (xi_point[0] * xi_point[0] + xi_point[1] * xi_point[1]))
-         + (18.0 * xi_point[0] * (1 + xi_point[0] * ref_vert[this_vert][0]))
-         - (10.0 * ref_vert[this_vert][0]));
-
-
-   } // end for this_vert
-
-   // calculate the Xi partials for node 4,5,6,7 (xi,eta)
-   for( int this_vert = 4; this_vert < 8; this_vert++ ){
-      quad12_partial_xi[this_vert] = (9.0/32.0) 
-         * (1 + xi_point[1] * ref_vert[this_vert][1])
-         *((9.0 * ref_vert[this_vert][0] 
-         * (1 - 3 * xi_point[0]*xi_point[0]))
-         - (2 * xi_point[0]));
-
-   } // end for this_vert
-
-   // calculate the Xi partials for node 8,9,10,11 (xi,eta)
-   for( int this_vert = 8; this_vert <= 11; this_vert++){
-      quad12_partial_xi[this_vert] = 9.0/32.0
-         * (ref_vert[this_vert][0])
-         * (1 - xi_point[1] * xi_point[1])
-         * (1 + 9 * xi_point[1] * ref_vert[this_vert][1]);
-
-
-   } // end for this_vert
+   const vector <real_t> &xi_point) const {
+   quad12_kernel::partial_xi(quad12_partial_xi.data(), xi_point.data());
 } // end partial Xi function
 
 // Partial derivative of shape functions with respect to Eta
 void Quad_12_2D::partial_eta_shape_fcn(
    vector<real_t> &quad12_partial_eta, 
-   const vector <real_t> &xi_point) {
-
-   // calculate the Eta partials for node 0,1,2,3 (xi,eta)
-   for( int this_vert = 0; this_vert < 4; this_vert++ ){
-      quad12_partial_eta[this_vert] = 1.0/32.0
-         * (1 + xi_point[0] * ref_vert[this_vert][0])
-         *((9.0 * ref_vert[this_vert][1] 
-         * (xi_point[0] * xi_point[0] + xi_point[1] * xi_point[1]))
-         + (18.0 * xi_point[1] * (1 + xi_point[1] * ref_vert[this_vert][1]))
-         - (10.0 * ref_vert[this_vert][1]));
-
-   } // end for this_vert
-
-
-   // calculate the Eta partials for node 4,5,6,7 (xi,eta)
-   for( int this_vert = 4; this_vert <= 7; this_vert++ ){
-      quad12_partial_eta[this_vert] = 9.0/32.0
-         * (1 - xi_point[0] * xi_point[0])
-         * (1 + 9 * xi_point[0] * ref_vert[this_vert][0])
-         * (ref_vert[this_vert][1]);
-
-   } // end for this_vert
-
-   // calculate the Eta partials for node 8,9,10,11 (xi,eta)
-   for( int this_vert = 8; this_vert <= 11; this_vert++){
-     quad12_partial_eta[this_vert] = 9.0/32.0
-         * (1 + xi_point[0] * ref_vert[this_vert][0])
-         *((9.0 * ref_vert[this_vert][1] * (1 - 3 * xi_point[1]*xi_point[1]))
-         - (2 * xi_point[1]));
-
-   } // end for this_vert
+   const vector <real_t> &xi_point) const {
+   quad12_kernel::partial_eta(quad12_partial_eta.data(), xi_point.data());
 } // end partial Eta function
 
 /* 
@@ -1407,90 +586,45 @@ real_t Hex8::ref_vert[8][3] = // listed as {Xi, Eta, Mu}
 void Hex8::physical_position (
    vector <real_t> &x_point,
    const vector <real_t> &xi_point,
-   const vector< vector<real_t> > &vertices){
-
-   real_t shape_fcn[8];
-   real_t check_unity;
-
-   // calculate the shape functions from each vertex for (xi,eta,mu)
-   for (int this_vert = 0; this_vert < 8; this_vert++ ){
-      shape_fcn[this_vert] = 1.0/8.0
-         * (1.0 + xi_point[0]*ref_vert[this_vert][0])
-         * (1.0 + xi_point[1]*ref_vert[this_vert][1])
-         * (1.0 + xi_point[2]*ref_vert[this_vert][2]);
-   } // end for this_vert
+   const vector< vector<real_t> > &vertices) const{
 
-   // calculate the position in physical space
-   for (int dim = 0; dim < 3; dim++)
-      x_point[dim] = 0.0;
+   // flat copy of the vertices for the kernel
+   real_t vert_flat[hex8_kernel::num_nodes*3];
+   for (int node = 0; node < hex8_kernel::num_nodes; node++)
+      for (int d = 0; d < 3; d++)
+         vert_flat[node*3 + d] = vertices[node][d];
 
-   check_unity = 0.0;
-   for (int this_vert = 0; this_vert < 8; this_vert++ ){
-      
-      for (int dim = 0; dim < 3; dim++){
-         x_point[dim] += vertices[this_vert][dim]*shape_fcn[this_vert];
-      } // end for dim
-   
-      // check partition of unity
-      check_unity += shape_fcn[this_vert];
-   } // end for this_vert
+   hex8_kernel::physical_position(x_point.data(), xi_point.data(), vert_flat);
 } // end of function
 
 // calculate the value for the basis at each node for a given xi,eta, mu
 void Hex8::basis(
    vector <real_t> &basis,
    const vector <real_t> &xi_point,
-   const vector< vector<real_t> > &vertices){
-
-   // calculate the shape functions from each vertex for (xi,eta,mu)
-   for (int this_vert = 0; this_vert < 8; this_vert++ ){
-      basis[this_vert] = 1.0/8.0
-         * (1.0 + xi_point[0]*ref_vert[this_vert][0])
-         * (1.0 + xi_point[1]*ref_vert[this_vert][1])
-         * (1.0 + xi_point[2]*ref_vert[this_vert][2]);
-   } // end for this_vert
+   const vector< vector<real_t> > &vertices) const{
+   hex8_kernel::basis(basis.data(), xi_point.data());
 } // end of hex8 basis functions
 
 // calculate the partials of the shape function 
 // with respect to Xi
 void Hex8::partial_xi_shape_fcn(
    vector<real_t> &hex8_partial_xi, 
-   const vector <real_t> &xi_point) {
-
-
-   for (int this_vert = 0; this_vert < 8; this_vert++){
-
-      hex8_partial_xi[this_vert] = (1.0/8.0)
-         * (ref_vert[this_vert][0])
-         * (1.0 + xi_point[1]*ref_vert[this_vert][1])
-         * (1.0 + xi_point[2]*ref_vert[this_vert][2]);
-   }   // end for this_vert
+   const vector <real_t> &xi_point) const {
+   hex8_kernel::partial_xi(hex8_partial_xi.data(), xi_point.data());
 } // end of partial Xi function
 
 // with respect to Eta
 void Hex8::partial_eta_shape_fcn(
    vector<real_t> &hex8_partial_eta, 
-   const vector <real_t> &xi_point) {
-
-   for (int this_vert = 0; this_vert < 8; this_vert++){
-      hex8_partial_eta[this_vert] = (1.0/8.0)
-         * (1.0 + xi_point[0]*ref_vert[this_vert][0])
-         * (ref_vert[this_vert][1])
-         * (1.0 + xi_point[2]*ref_vert[this_vert][2]);
-   } // end for this_vert
+   const vector <real_t> &xi_point) const {
+   hex8_kernel::partial_eta(hex8_partial_eta.data(), xi_point.data());
 } //end of partial eta function 
 
 // with repsect to Mu
 void Hex8::partial_mu_shape_fcn(
    vector<real_t> &hex8_partial_mu, 
-   const vector <real_t> &xi_point) {
-
-   for (int this_vert = 0; this_vert < 8; this_vert++){
-      hex8_partial_mu[this_vert] = (1.0/8.0)
-         * (1.0 + xi_point[0]*ref_vert[this_vert][0])
-         * (1.0 + xi_point[1]*ref_vert[this_vert][1])
-         * (ref_vert[this_vert][2]);
-   } // end for this_vert
+   const vector <real_t> &xi_point) const {
+   hex8_kernel::partial_mu(hex8_partial_mu.data(), xi_point.data());
 } // end of partial Mu function
 /*
 
@@ -1556,234 +690,45 @@ real_t Hex20::ref_vert[20][3] = // listed as {Xi, Eta, Mu}
 void Hex20::physical_position (
    vector <real_t> &x_point,
    const vector <real_t> &xi_point,
-   const vector< vector<real_t> > &vertices){
+   const vector< vector<real_t> > &vertices) const{
 
+   // flat copy of the vertices for the kernel
+   real_t vert_flat[hex20_kernel::num_nodes*3];
+   for (int node = 0; node < hex20_kernel::num_nodes; node++)
+      for (int d = 0; d < 3; d++)
+         vert_flat[node*3 + d] = vertices[node][d];
 
-   real_t shape_fcn[20];
-   real_t check_unity;
-
-
-   // calculate the 8 corner shape functions for (xi,eta,mu)
-   for (int this_vert=0; this_vert<8; this_vert++){
-      shape_fcn[this_vert] = 1.0/8.0
-         * (1.0 +  xi_point[0]*ref_vert[this_vert][0])
-         * (1.0 +  xi_point[1]*ref_vert[this_vert][1])
-         * (1.0 +  xi_point[2]*ref_vert[this_vert][2])
-         * (xi_point[0]*ref_vert[this_vert][0]
-         +  xi_point[1]*ref_vert[this_vert][1]
-         +  xi_point[2]*ref_vert[this_vert][2] - 2.0);
-   } // end for this_vert
-
-   // calculate the i=0 edge shape functions pts=[8,10,12,14]
-   for (int this_vert=8; this_vert<=14; this_vert+=2){
-      shape_fcn[this_vert] = 1.0/4.0
-         * (1.0 - xi_point[0]*xi_point[0])
-         * (1.0 + xi_point[1]*ref_vert[this_vert][1])
-         * (1.0 + xi_point[2]*ref_vert[this_vert][2]);
-   } // end for this_vert
-
-   // calculate the j=0 edge shape functions pts=[16,17,18,19]
-   for (int this_vert=16; this_vert<=19; this_vert++){
-      shape_fcn[this_vert] = 1.0/4.0
-         * (1.0 + xi_point[0]*ref_vert[this_vert][0])
-         * (1.0 - xi_point[1]*xi_point[1])
-         * (1.0 + xi_point[2]*ref_vert[this_vert][2]);
-   } // end for this_vert
-
-   // calculate the k=0 edge shape functions pts=[9,11,15,13]
-   for (int this_vert=9; this_vert<=15; this_vert+=2){
-      shape_fcn[this_vert] = 1.0/4.0
-         * (1.0 + xi_point[0]*ref_vert[this_vert][0])
-         * (1.0 + xi_point[1]*ref_vert[this_vert][1])
-         * (1.0 - xi_point[2]*xi_point[2]);
-   } // end for this_vert
-
-
-   // calculate the position in physical space
-   for (int dim=0; dim<3; dim++)
-      x_point[dim] = 0.0;
-
-   check_unity = 0.0;
-   for (int dim=0; dim<3; dim++){
-      for (int this_vert=0; this_vert<20; this_vert++ ){
-         x_point[dim] += vertices[this_vert][dim]*shape_fcn[this_vert];
-
-      }   
-   } // end for this_vert
-
-   for (this_vert=0; this_vert<20; this_vert++ ){
-      // check partition of unity
-      check_unity += shape_fcn[this_vert];
-   }
-
-   //std::cout << "partion of unity :" << check_unity << std::endl;
+   hex20_kernel::physical_position(x_point.data(), xi_point.data(), vert_flat);
 } // end of physical position function
 
 // calculate the value for the basis at each node for a given xi,eta, mu
 void Hex20::basis(
    vector <real_t> &basis,
    const vector <real_t> &xi_point,
-   const vector< vector<real_t> > &vertices){
-
-   // calculate the 8 corner shape functions for (xi,eta,mu)
-   for (int this_vert=0; this_vert<8; this_vert++){
-      basis[this_vert] = 1.0/8.0
-         * (1.0 +  xi_point[0]*ref_vert[this_vert][0])
-         * (1.0 +  xi_point[1]*ref_vert[this_vert][1])
-         * (1.0 +  xi_point[2]*ref_vert[this_vert][2])
-         * (xi_point[0]*ref_vert[this_vert][0]
-         +  xi_point[1]*ref_vert[this_vert][1]
-         +  xi_point[2]*ref_vert[this_vert][2] - 2.0);
-   } // end for this_vert
-
-   // calculate the i=0 edge shape functions pts=[8,10,12,14]
-   for (int this_vert=8; this_vert<=14; this_vert+=2){
-      basis[this_vert] = 1.0/4.0
-         * (1.0 - xi_point[0]*xi_point[0])
-         * (1.0 + xi_point[1]*ref_vert[this_vert][1])
-         * (1.0 + xi_point[2]*ref_vert[this_vert][2]);
-   } // end for this_vert
-
-   // calculate the j=0 edge shape functions pts=[16,17,18,19]
-   for (int this_vert=16; this_vert<=19; this_vert++){
-      basis[this_vert] = 1.0/4.0
-         * (1.0 + xi_point[0]*ref_vert[this_vert][0])
-         * (1.0 - xi_point[1]*xi_point[1])
-         * (1.0 + xi_point[2]*ref_vert[this_vert][2]);
-   } // end for this_vert
-
-   // calculate the k=0 edge shape functions pts=[9,11,15,13]
-   for (int this_vert=9; this_vert<=15; this_vert+=2){
-      basis[this_vert] = 1.0/4.0
-         * (1.0 + xi_point[0]*ref_vert[this_vert][0])
-         * (1.0 + xi_point[1]*ref_vert[this_vert][1])
-         * (1.0 - xi_point[2]*xi_point[2]);
-   } // end for this_vert
+   const vector< vector<real_t> > &vertices) const{
+   hex20_kernel::basis(basis.data(), xi_point.data());
 } // end of hex20 basis functions
 
 // Calculate the partials of the shape functions
 // with respect to Xi
 void  Hex20::partial_xi_shape_fcn(
    vector<real_t> &hex20_partial_xi, 
-   const vector <real_t> &xi_point) {
-
-   // For 8 Corner shape functions pts=[0,1,2,3,4,5,6,7]
-   for (int this_vert=0; this_vert<8; this_vert++){
-      hex20_partial_xi[this_vert] = (1.0/8.0) 
-         * (ref_vert[this_vert][0])
-         * (1 + (xi_point[1]*ref_vert[this_vert][1]))
-         * (1 + (xi_point[2]*ref_vert[this_vert][2]))
-         * (2 * (xi_point[0]*ref_vert[this_vert][0])
-         + xi_point[1]*ref_vert[this_vert][1]
-         + xi_point[2]*ref_vert[this_vert][2] - 1);  
-   } // end for this_vert
-
-   // for the i=0 edge shape functions pts=[8,10,12,14]
-   for (int this_vert=8; this_vert<=14; this_vert+=2){
-      hex20_partial_xi[this_vert] = (-1.0/2.0)
-         * (xi_point[0])
-         * (1 + xi_point[1]*ref_vert[this_vert][1])
-         * (1 + xi_point[2]*ref_vert[this_vert][2]);
-   } // end for this_vert
-
-   // for the k=0 shape functions pts=[9,11,13,15]
-   for (int this_vert = 9; this_vert <= 15; this_vert += 2){
-      hex20_partial_xi[this_vert] = (1.0/4.0)
-         * (ref_vert[this_vert][0])
-         * (1 + xi_point[1]*ref_vert[this_vert][1])
-         * (1 - xi_point[2]*xi_point[2]);
-   } // end for this_vert
-
-
-   // for the j=0 edge shape functions pts=[16,17,18,19]
-   for (int this_vert=16; this_vert<=19; this_vert++){
-      hex20_partial_xi[this_vert] = (1.0/4.0)
-         * (ref_vert[this_vert][0])
-         * (1 - xi_point[1]*xi_point[1])
-         * (1 + xi_point[2]*ref_vert[this_vert][2]);
-   } // end for this_vert
+   const vector <real_t> &xi_point) const {
+   hex20_kernel::partial_xi(hex20_partial_xi.data(), xi_point.data());
 } // end of partial Xi function
 
 // with respect to Eta
 void Hex20::partial_eta_shape_fcn(
    vector<real_t> &hex20_partial_eta, 
-   const vector <real_t> &xi_point) {
-
-   // For 8 Corner shape functions pts=[0,1,2,3,4,5,6,7]
-   for (int this_vert=0; this_vert < 8; this_vert++){
-      hex20_partial_eta[this_vert] = (1.0/8.0)
-         * (1 + xi_point[0]*ref_vert[this_vert][0])
-         * (ref_vert[this_vert][1])
-         * (1 + xi_point[2]*ref_vert[this_vert][2])
-         * (xi_point[0]*ref_vert[this_vert][0]
-         + 2 * xi_point[1]*ref_vert[this_vert][1]
-         + xi_point[2]*ref_vert[this_vert][2] - 1);
-   } // end for this_vert
-
-   // for the i=0 edge shape functions pts=[8,10,12,14]
-   for (int this_vert=8; this_vert<=14; this_vert+=2){
-      hex20_partial_eta[this_vert] = (1.0/4.0)
-         * (1 - (xi_point[0]*xi_point[0]))
-         * (ref_vert[this_vert][1])
-         * (1 + xi_point[2]*ref_vert[this_vert][2]);
-   } // end for this_vert
-
-   // for the k=0 shape functions pts=[9,11,13,15]
-   for (int this_vert=9; this_vert<=15; this_vert+=2){
-      hex20_partial_eta[this_vert] = (1.0/4.0)
-         * (1 + xi_point[0]*ref_vert[this_vert][0])
-         * (ref_vert[this_vert][1])
-         * (1 - (xi_point[2]*xi_point[2]));
-   } // end for this_vert
-
-   // for the j=0 edge shape functions pts=[16,17,18,19]
-   for (int this_vert=16; this_vert<=19; this_vert++){
-      hex20_partial_eta[this_vert] = (-1.0/2.0)
-         * (1 + xi_point[0]*ref_vert[this_vert][0])
-         * (xi_point[1])
-         * (1 + xi_point[2]*ref_vert[this_vert][2]);
-   } // end for this_vert
+   const vector <real_t> &xi_point) const {
+   hex20_kernel::partial_eta(hex20_partial_eta.data(), xi_point.data());
 } // end of partial Eta function
 
 // with repsect to mu
 void Hex20::partial_mu_shape_fcn(
    vector<real_t> &hex20_partial_mu, 
-   const vector <real_t> &xi_point) {
-
-   // For 8 Corner shape functions pts=[0,1,2,3,4,5,6,7]
-   for (int this_vert=0; this_vert < 8; this_vert++){
-      hex20_partial_mu[this_vert] = (1.0/8.0)
-         * (1 + xi_point[0]*ref_vert[this_vert][0])
-         * (1 + xi_point[1]*ref_vert[this_vert][1])
-         * (ref_vert[this_vert][2])
-         * ((xi_point[0]*ref_vert[this_vert][0])
-         + (xi_point[1]*ref_vert[this_vert][1])
-         + (2 * xi_point[2]*ref_vert[this_vert][2]) - 1);
-   } // end for this_vert
-
-   // for the i=0 edge shape functions pts=[8,10,12,14]
-   for (int this_vert=8; this_vert<=14; this_vert+=2){
-      hex20_partial_mu[this_vert] = (1.0/4.0)
-         * (1 - (xi_point[0]*xi_point[0])) 
-         * (1 + xi_point[1]*ref_vert[this_vert][1])
-         * (ref_vert[this_vert][2]);
-   }
-
-   // for the k=0 shape functions pts=[9,11,13,15]
-   for (int this_vert = 9; this_vert <= 15; this_vert += 2){
-      hex20_partial_mu[this_vert] = (-1.0/2.0)
-         * (1 + xi_point[0]*ref_vert[this_vert][0])
-         * (1 + xi_point[1]*ref_vert[this_vert][1])
-         * (xi_point[2]);
-   } // end for this_vert
-
-   // for the j=0 edge shape functions pts=[16,17,18,19]
-   for (int this_vert = 16; this_vert <= 19; this_vert++){
-      hex20_partial_mu[this_vert] = (1.0/4.0)
-         * (1 + xi_point[0]*ref_vert[this_vert][0])
-         * (1 - xi_point[1]*xi_point[1])
-         * (ref_vert[this_vert][2]);
-   } // end for this_vert
+   const vector <real_t> &xi_point) const {
+   hex20_kernel::partial_mu(hex20_partial_mu.data(), xi_point.data());
 } // end of partial Mu function
 
 
@@ -1871,259 +816,45 @@ real_t Hex32::ref_vert[32][3] = // listed as {Xi, Eta, Mu}
 void Hex32::physical_position (
    vector <real_t> &x_point,
    const vector <real_t> &xi_point,
-   const vector< vector<real_t> > &vertices){
-
-   real_t shape_fcn[32];
-   real_t check_unity;
-
-
-   // calculate the 8 corner shape functions for (xi,eta,mu)
-   for (int this_vert = 0; this_vert < 8; this_vert++){
-      shape_fcn[this_vert] = 1.0/64.0 
-         * (1.0 + xi_point[0]*ref_vert[this_vert][0])
-         * (1.0 + xi_point[1]*ref_vert[this_vert][1])
-         * (1.0 + xi_point[2]*ref_vert[this_vert][2])
-         * (9.0 * xi_point[0]*xi_point[0]
-         +  9.0 * xi_point[1]*xi_point[1]
-         +  9.0 * xi_point[2]*xi_point[2] - 19.0);  
-   } // end for this_vert
-
-   // calculate the edge shape functions for pts=[8-15]
-   for (int this_vert = 8; this_vert <= 15; this_vert++){
-      shape_fcn[this_vert] = 9.0/64.0 
-         * (1.0 + xi_point[0]*ref_vert[this_vert][0])
-         * (1.0 + xi_point[1]*ref_vert[this_vert][1])
-         * (1.0 + 9 * xi_point[2]*ref_vert[this_vert][2])
-         * (1.0 - xi_point[2]*xi_point[2]); 
-     
-   } // end for this_vert
-
-   // calculate the edge shape functions for pts=[16-23]
-   for (int this_vert = 16; this_vert <= 23; this_vert++){
-      shape_fcn[this_vert] = 9.0/64.0
-         * (1.0 - xi_point[0]*xi_point[0])
-         * (1.0 + 9 * xi_point[0]*ref_vert[this_vert][0])
-         * (1.0 + xi_point[1]*ref_vert[this_vert][1])
-         * (1.0 + xi_point[2]*ref_vert[this_vert][2]); 
-     
-   } // end for this_vert
-
-   // calculate the edge shape functions for pts=[24-31]
-   for (int this_vert = 24; this_vert <= 31; this_vert++){
-      shape_fcn[this_vert] = 9.0/64.0
-         * (1.0 + xi_point[0]*ref_vert[this_vert][0])
-         * (1.0 - xi_point[1]*xi_point[1])
-         * (1.0 + 9 * xi_point[1]*ref_vert[this_vert][1])
-         * (1.0 + xi_point[2]*ref_vert[this_vert][2]); 
-     
-   } // end for this_vert
+   const vector< vector<real_t> > &vertices) const{
 
+   // flat copy of the vertices for the kernel
+   real_t vert_flat[hex32_kernel::num_nodes*3];
+   for (int node = 0; node < hex32_kernel::num_nodes; node++)
+      for (int d = 0; d < 3; d++)
+         vert_flat[node*3 + d] = vertices[node][d];
 
-   // calculate the position in physical space
-   for (int dim=0; dim<3; dim++)
-      x_point[dim] = 0.0;
-
-   for (int this_vert = 0; this_vert <= 31; this_vert++ ){
-      for (int dim = 0; dim < 3; dim++){
-         x_point[dim] += vertices[this_vert][dim]*shape_fcn[this_vert];
-      }
-   }
-   
-   // check partition of unity
-   check_unity = 0.0;
-   for (int this_vert = 0; this_vert < 32; this_vert++ ){
-      check_unity += shape_fcn[this_vert];
-
-   } // end for this_vert
-
-   // unit test
-   //std::cout << "Hex 32 partion of unity:" << check_unity << std::endl;
+   hex32_kernel::physical_position(x_point.data(), xi_point.data(), vert_flat);
 } // end of physical position function
 
 // calculate the value for the basis at each node for a given xi,eta, mu
 void Hex32::basis(
    vector <real_t> &basis,
    const vector <real_t> &xi_point,
-   const vector< vector<real_t> > &vertices){
-
-   // calculate the 8 corner shape functions for (xi,eta,mu)
-   for (int this_vert = 0; this_vert < 8; this_vert++){
-      basis[this_vert] = 1.0/64.0 
-         * (1.0 + xi_point[0]*ref_vert[this_vert][0])
-         * (1.0 + xi_point[1]*ref_vert[this_vert][1])
-         * (1.0 + xi_point[2]*ref_vert[this_vert][2])
-         * (9.0 * xi_point[0]*xi_point[0]
-         +  9.0 * xi_point[1]*xi_point[1]
-         +  9.0 * xi_point[2]*xi_point[2] - 19.0);  
-   } // end for this_vert
-
-   // calculate the edge shape functions for pts=[8-15]
-   for (int this_vert = 8; this_vert <= 15; this_vert++){
-      basis[this_vert] = 9.0/64.0 
-         * (1.0 + xi_point[0]*ref_vert[this_vert][0])
-         * (1.0 + xi_point[1]*ref_vert[this_vert][1])
-         * (1.0 + 9 * xi_point[2]*ref_vert[this_vert][2])
-         * (1.0 - xi_point[2]*xi_point[2]); 
-     
-   } // end for this_vert
-
-   // calculate the edge shape functions for pts=[16-23]
-   for (int this_vert = 16; this_vert <= 23; this_vert++){
-      basis[this_vert] = 9.0/64.0
-         * (1.0 - xi_point[0]*xi_point[0])
-         * (1.0 + 9 * xi_point[0]*ref_vert[this_vert][0])
-         * (1.0 + xi_point[1]*ref_vert[this_vert][1])
-         * (1.0 + xi_point[2]*ref_vert[this_vert][2]); 
-     
-   } // end for this_vert
-
-   // calculate the edge shape functions for pts=[24-31]
-   for (int this_vert = 24; this_vert <= 31; this_vert++){
-      basis[this_vert] = 9.0/64.0
-         * (1.0 + xi_point[0]*ref_vert[this_vert][0])
-         * (1.0 - xi_point[1]*xi_point[1])
-         * (1.0 + 9 * xi_point[1]*ref_vert[this_vert][1])
-         * (1.0 + xi_point[2]*ref_vert[this_vert][2]); 
-     
-   } // end for this_vert
+   const vector< vector<real_t> > &vertices) const{
+   hex32_kernel::basis(basis.data(), xi_point.data());
 } // end of hex20 basis functions
 
 // Calculate the partials of the shape functions
 // with respect to Xi
 void  Hex32::partial_xi_shape_fcn(
    vector<real_t> &hex32_partial_xi, 
-   const vector <real_t> &xi_point) {
-
-   // calculate the 8 corner partial wrt Xi 
-   for (int this_vert = 0; this_vert < 8; this_vert++){
-      hex32_partial_xi[this_vert] = 1.0/64.0 
-         * (1 + xi_point[1] * ref_vert[this_vert][1])
-         * (1 + xi_point[2] * ref_vert[this_vert][2])
-         *((9.0 * (ref_vert[this_vert][0])
-         * (xi_point[0]*xi_point[0] +  xi_point[1]*xi_point[1] +  xi_point[2]*xi_point[2]))
-         + (18.0 * xi_point[0] * (1 + xi_point[0]*ref_vert[this_vert][0]))
-         - (19.0 * ref_vert[this_vert][0]));
-   } // end for this_vert
-
-   // calculate the edge partial wrt Xi for pts=[8-15]
-   for (int this_vert = 8; this_vert <= 15; this_vert++){
-      hex32_partial_xi[this_vert] = 9.0/64.0 
-         * (ref_vert[this_vert][0])
-         * (1 + xi_point[1] * ref_vert[this_vert][1])
-         * (1 + 9.0 * xi_point[2] * ref_vert[this_vert][2])
-         * (1 - xi_point[2] * xi_point[2]);
-   } // end for this_vert
-
-   // calculate the edge partial wrt Xi for pts=[16-23]
-   for (int this_vert = 16; this_vert <= 23; this_vert++){
-      hex32_partial_xi[this_vert] = 9.0/64.0 
-         * (1 + xi_point[1] * ref_vert[this_vert][1])
-         * (1 + xi_point[2] * ref_vert[this_vert][2])
-         * (9.0 * ref_vert[this_vert][0] * (1 - 3 * xi_point[0] * xi_point[0])
-         - (2 * xi_point[0]));
-   } // end for this_vert
-
-   // calculate the edge partial wrt Xi for pts=[24-31]
-   for (int this_vert = 24; this_vert <= 31; this_vert++){
-      hex32_partial_xi[this_vert] = 9.0/64.0 
-         * (ref_vert[this_vert][0])
-         * (1 - xi_point[1] * xi_point[1])
-         * (1 + 9.0 * xi_point[1] * ref_vert[this_vert][1])
-         * (1 + xi_point[2] * ref_vert[this_vert][2]);
-   } // end for this_vert
+   const vector <real_t> &xi_point) const {
+   hex32_kernel::partial_xi(hex32_partial_xi.data(), xi_point.data());
 } // end of partial Xi function
 
 // with respect to Eta
 void Hex32::partial_eta_shape_fcn(
    vector<real_t> &hex32_partial_eta, 
-   const vector <real_t> &xi_point) {
-
-   // calculate the 8 corner partial wrt Eta 
-   for (int this_vert = 0; this_vert < 8; this_vert++){
-      hex32_partial_eta[this_vert] = 1.0/64.0 
-         * (1 + xi_point[0] * ref_vert[this_vert][0])
-         * (1 + xi_point[2] * ref_vert[this_vert][2])
-         *((9.0 * ref_vert[this_vert][1]
-         * (xi_point[0]*xi_point[0] 
-         +  xi_point[1]*xi_point[1]
-         +  xi_point[2]*xi_point[2]))
-         + (18.0 * xi_point[1] * (1 + xi_point[1]*ref_vert[this_vert][1]))
-         - (19.0 * ref_vert[this_vert][1]));
-   } // end for this_vert
-
-   // calculate the edge partial wrt Eta for pts=[8-15]
-   for (int this_vert = 8; this_vert <= 15; this_vert++){
-      hex32_partial_eta[this_vert] = 9.0/64.0 
-         * (1 + xi_point[0] * ref_vert[this_vert][0])
-         * (ref_vert[this_vert][1])
-         * (1 + 9.0 * xi_point[2] * ref_vert[this_vert][2])
-         * (1 - xi_point[2] * xi_point[2]);
-   } // end for this_vert
-
-   // calculate the edge partial wrt Eta for pts=[16-23]
-   for (int this_vert = 16; this_vert <= 23; this_vert++){
-      hex32_partial_eta[this_vert] = 9.0/64.0 
-         * (1 - xi_point[0] * xi_point[0])
-         * (1 + 9.0 * xi_point[0] * ref_vert[this_vert][0])
-         * (ref_vert[this_vert][1])
-         * (1 + xi_point[2] * ref_vert[this_vert][2]);
-   } // end for this_vert
-
-   // calculate the edge partial wrt Eta for pts=[24-31]
-   for (int this_vert = 24; this_vert <= 31; this_vert++){
-      hex32_partial_eta[this_vert] = 9.0/64.0 
-         * (1 + xi_point[0] * ref_vert[this_vert][0])
-         * (1 + xi_point[2] * ref_vert[this_vert][2])
-         *((9.0 * ref_vert[this_vert][1] * (1 - 3 * xi_point[1] * xi_point[1]))
-         - (2 * xi_point[1]));
-   } // end for this_vert
+   const vector <real_t> &xi_point) const {
+   hex32_kernel::partial_eta(hex32_partial_eta.data(), xi_point.data());
 } // end of partial Eta function
 
 // with repsect to mu
 void Hex32::partial_mu_shape_fcn(
    vector<real_t> &hex32_partial_mu, 
-   const vector <real_t> &xi_point) {
-
-   // calculate the 8 corner partial wrt Mu 
-   for (int this_vert = 0; this_vert < 8; this_vert++){
-      hex32_partial_mu[this_vert] = 1.0/64.0 
-         * (1 + xi_point[0] * ref_vert[this_vert][0])
-         * (1 + xi_point[1] * ref_vert[this_vert][1])
-         *((9.0 * (ref_vert[this_vert][2])
-         * (xi_point[0]*xi_point[0] 
-         +  xi_point[1]*xi_point[1]
-         +  xi_point[2]*xi_point[2])) 
-         + (18.0 * xi_point[2] * (1 + xi_point[2]*ref_vert[this_vert][2]))
-         - (19.0 * ref_vert[this_vert][2]));
-   } // end for this_vert
-
-   // calculate the edge partial wrt Mu for pts=[8-15]
-   for (int this_vert = 8; this_vert <= 15; this_vert++){
-      hex32_partial_mu[this_vert] = 9.0/64.0 
-         * (1 + xi_point[0] * ref_vert[this_vert][0])
-         * (1 + xi_point[1] * ref_vert[this_vert][1])
-         *((9.0 * ref_vert[this_vert][2] 
-         * (1 -  3.0 * xi_point[2] * xi_point[2]))
-         - (2 * xi_point[2]));
-   } // end for this_vert
-
-   // calculate the edge partial wrt Mu for pts=[16-23]
-   for (int this_vert = 16; this_vert <= 23; this_vert++){
-      hex32_partial_mu[this_vert] = 9.0/64.0 
-         * (1 - xi_point[0] * xi_point[0])
-         * (1 + 9 * xi_point[0] * ref_vert[this_vert][0])
-         * (1 + xi_point[1] * ref_vert[this_vert][1])
-         * (ref_vert[this_vert][2]);
-   } // end for this_vert
-
-   // calculate the edge partial wrt Mu for pts=[24-31]
-   for (int this_vert = 24; this_vert <= 31; this_vert++){
-      hex32_partial_mu[this_vert] = 9.0/64.0 
-         * (1 + xi_point[0] * ref_vert[this_vert][0])
-         * (1 - xi_point[1] * xi_point[1])
-         * (1 + 9 * xi_point[1] * ref_vert[this_vert][1])
-         * (ref_vert[this_vert][2]);
-   } // end for this_vert
+   const vector <real_t> &xi_point) const {
+   hex32_kernel::partial_mu(hex32_partial_mu.data(), xi_point.data());
 } // end of partial Mu function
 
 /*
@@ -2161,18 +892,22 @@ representative linear element for visualization
 // creates nodal positions with Chebyshev spacing
 void QuadN::chebyshev_nodes_1D(
    vector<real_t> &cheb_nodes_1D,  // Chebyshev nodes
-   const int &order){              // Interpolation order
-   
-   real_t pi = 3.14159265358979323846;
-   
-   // loop to build the base set of Chebyshev nodes
-   for (int i = 1; i < order + 1; i++){
-      cheb_nodes_1D[i - 1] = -cos(pi*(2.0*i - 1.0)/(2.0*(order + 1.0)));
-   } // end for i
-   
-   //replacing the first and last index with the element boundary 
-   cheb_nodes_1D[0] = -1.0;
-   cheb_nodes_1D[order] = 1.0;
+   const int &order) const{              // Interpolation order
+
+   // built once per order, see node_sets.cc
+   const node_set &set = get_node_set(node_spacing::chebyshev, order);
+
+   for (int i = 0; i < order + 1; i++) cheb_nodes_1D[i] = set.nodes[i];
+}
+
+// creates nodal positions at the Gauss-Lobatto points
+void QuadN::lobatto_nodes_1D(
+   vector<real_t> &lob_nodes_1D,   // Gauss-Lobatto nodes
+   const int &order) const{              // Interpolation order
+
+   const node_set &set = get_node_set(node_spacing::lobatto, order);
+
+   for (int i = 0; i < order + 1; i++) lob_nodes_1D[i] = set.nodes[i];
 }
 
 // Lagrange Interp in 1D, returns interpolants and derivative
@@ -2182,52 +917,19 @@ void QuadN::lagrange_1D(
    vector <real_t> &Dinterp,           // derivative of function
    const real_t &x_point,              // point of interest in element
    const vector <real_t> &xi_point,    // nodal positions in 1D, normally chebyshev
-   const int &orderN){                 // order of element
-   
-   vector <real_t> num(orderN + 1);     // numerator of interpolant
-   vector <real_t> denom(orderN + 1);   // denomenator of interpolant
-   real_t q = 0.0;
-   
-   for(int i = 0; i < orderN + 1; i++){ // looping over the nodes
-      real_t n = 1.0;         // placeholder numerator
-      real_t d = 1.0;         // placeholder denominator
-      real_t c = 1.0;         // placeholder value of n/d
-      real_t p = 0.0;         // placeholder for derivative values
-      real_t s = 1.0;
-      for(int j = 0; j < orderN + 1; j++){  // looping over the nodes !=i
-
-         if (j != i ){
-            n = n*(x_point - xi_point[j]);
-            d = d*(xi_point[i] - xi_point[j]);
-            
-            real_t s = 1.0;
-            for(int N = 0; N < orderN + 1; N++){  // looping over the nodes !=i
-               if (N != j && N != i ){
-                  
-                  s = s * (x_point - xi_point[N]);
-                  
-               }// end if
-            }//end for
-            p += s; 
-
-         }//end if
-         
-         c = n/d; // storing a single value for interpolation for node i
-         q = (p/d); // storing the derivative of the interpolating function
-      } // end looping over nodes != i
-
-      // writing value to vectors for later use
-      interp[i]   = c;     // Interpolant value at given point
-      Dinterp[i]  = q;     // derivative of each function
-
-   } // end loop over all nodes
+   const int &orderN) const{                 // order of element
+
+   // barycentric form without allocation; the nodes are arbitrary, so their
+   // weights are formed here at O(N^2), cached weights come with a node_set
+   barycentric_lagrange(interp.data(), Dinterp.data(), x_point,
+      xi_point.data(), nullptr, orderN + 1);
 } // end of Legrange_1D function
 
 // Corners of Lagrange element for mapping
 void QuadN::corners (
    vector< vector<real_t> > &lag_nodes,   // Nodes of Lagrange elements 
    vector< vector<real_t> > &lag_corner,  // corner nodes of QuadN element
-   const int &orderN){                    // Element order
+   const int &orderN) const{                    // Element order
 
 
    /*
@@ -2258,16 +960,9 @@ void QuadN::corners (
 
 
    lag_corner[0] = lag_nodes[A];
-   std::cout<<"Corner A = "<<lag_corner[0][0] << "  "<<lag_corner[0][1] <<std::endl;
-
    lag_corner[1] = lag_nodes[B];
-   std::cout<<"Corner B = "<<lag_corner[1][0] << "  "<<lag_corner[1][1] <<std::endl;
-
    lag_corner[2] = lag_nodes[C];
-   std::cout<<"Corner C = "<<lag_corner[2][0] << "  "<<lag_corner[2][1] <<std::endl;
-
    lag_corner[3] = lag_nodes[D];
-   std::cout<<"Corner D = "<<lag_corner[3][0] << "  "<<lag_corner[3][1] <<std::endl;
 }// end of corner mapping function
 
 // Functions for mapping reference position to physical position for any 
@@ -2276,14 +971,14 @@ void QuadN::physical_position (
    vector <real_t> &x_point,                    // location in real space
    const vector< vector<real_t> > &lag_nodes_2d,   // Nodes of Lagrange elements 
    const vector <real_t> &lag_basis_2d,         // 3D basis values 
-   const int &orderN){                          // order of the element
+   const int &orderN) const{                          // order of the element
 
 
    int nodes = orderN + 1;
    int numnodes_2d = nodes * nodes;
 
    for (int this_vert = 0; this_vert < numnodes_2d; this_vert++ ){
-      for (int dim = 0; dim < 1; dim++){
+      for (int dim = 0; dim < 2; dim++){
          x_point[dim] += lag_nodes_2d[this_vert][dim]*lag_basis_2d[this_vert];
       } // end for dim
    } // end for this_vert
@@ -2299,7 +994,7 @@ void QuadN::basis_partials (
    vector <real_t> &lag_basis_2d,         // 3D basis values 
    vector< vector<real_t> > &lag_partial, // Partial of basis 
    const vector <real_t> &xi_point,       // point of interest
-   const int &orderN){                    // Element order
+   const int &orderN) const{                    // Element order
 
    /*
 
@@ -2325,59 +1020,32 @@ void QuadN::basis_partials (
 
    int N = orderN + 1;      //number of nodes in each direction
    int tot_pts = (N*N);     // total nodes in 2D
-   
-   real_t sumi = 0.0;
-   real_t sumj = 0.0;
-
-
 
    //Setting nodes for Lagrange Elements
    for (int m = 0; m < tot_pts; m++) {
 
-      int i, j;
-
-
-
-      // sets up the i and j indices for the nodes of an 
-
-
-      j = floor(m/N)+1; 
-      i = (m+1) - N*(j-1);
-
       // xi direction
-      lag_nodes_2d[m][0] = nodes_1d[i-1]; 
+      lag_nodes_2d[m][0] = nodes_1d[m % N]; 
 
       // eta direction
-      lag_nodes_2d[m][1] = nodes_1d[j-1]; 
-
+      lag_nodes_2d[m][1] = nodes_1d[m / N]; 
+   } // end for m
 
-   // calling function to assign nodal values for basis and derivative
+   // the 1D interpolants only depend on the direction, evaluate them once
+   // per direction and pick them up for every node
+   for (int dim = 0; dim < 2; dim++){
 
-      //evaluating Lagrange interpolants for each function at xi_point
+      lagrange_1D(val_1d, DVal_1d, xi_point[dim], nodes_1d, orderN);
 
-      lagrange_1D(val_1d, DVal_1d, xi_point[0], nodes_1d, orderN);
-      val_2d[m][0]  = val_1d[i-1]; 
-      DVal_2d[m][0] = DVal_1d[i-1];
+      for (int m = 0; m < tot_pts; m++) {
+         int index = (dim == 0) ? m % N : m / N;
 
-      // resetting to zero
-      for(int i = 0.0; i < N; i++){
-         val_1d[i]  = 0.0;
-         DVal_1d[i] = 0.0;
-      }
-
-
-      //evaluating Legrange interpolants for each function at xi_point
-
-      lagrange_1D(val_1d, DVal_1d, xi_point[1], nodes_1d, orderN);
-      val_2d[m][1]  = val_1d[j-1]; 
-      DVal_2d[m][1] = DVal_1d[j-1];
-
-      // resetting to zero
-      for(int i = 0.0; i < N; i++){
-         val_1d[i]  = 0.0;
-         DVal_1d[i] = 0.0;
-      }
+         val_2d[m][dim]  = val_1d[index]; 
+         DVal_2d[m][dim] = DVal_1d[index];
+      } // end for m
+   } // end for dim
 
+   for (int m = 0; m < tot_pts; m++) {
 
    // Assigning and storing the Basis
       lag_basis_2d[m] = val_2d[m][0] * val_2d[m][1];
@@ -2390,6 +1058,34 @@ void QuadN::basis_partials (
    } // end for  
 }// end basis_partials function
 
+// basis values and partials on a cached node set
+void QuadN::basis_partials (
+   vector <real_t> &lag_basis_2d,         // 2D basis values
+   vector< vector<real_t> > &lag_partial, // Partial of basis
+   vector <real_t> &val_1d,               // Interpolant values, 2*(orderN + 1)
+   vector <real_t> &DVal_1d,              // Derivatives of basis, 2*(orderN + 1)
+   const vector <real_t> &xi_point,       // point of interest
+   const node_set &nodes) const{          // 1D nodes of the element order
+
+   int N = nodes.num_nodes;
+
+   for (int dim = 0; dim < 2; dim++)
+      barycentric_lagrange(val_1d.data() + dim*N, DVal_1d.data() + dim*N,
+         xi_point[dim], nodes.nodes.data(), nodes.weights.data(), N);
+
+   const real_t *v0 = val_1d.data(),  *v1 = val_1d.data() + N;
+   const real_t *d0 = DVal_1d.data(), *d1 = DVal_1d.data() + N;
+
+   // nodes xi fastest
+   for (int j = 0; j < N; j++)
+      for (int i = 0; i < N; i++){
+         int m = j*N + i;
+         lag_basis_2d[m]   = v0[i]*v1[j];
+         lag_partial[m][0] = d0[i]*v1[j];
+         lag_partial[m][1] = v0[i]*d1[j];
+      }
+}// end basis_partials function
+
 
 
 
@@ -2424,18 +1120,22 @@ representative linear element for visualization
 // creates nodal positions with Chebyshev spacing
 void HexN::chebyshev_nodes_1D(
    vector<real_t> &cheb_nodes_1D,  // Chebyshev nodes
-   const int &order){              // Interpolation order
-   
-   real_t pi = 3.14159265358979323846;
-   
-   // loop to build the base set of Chebyshev nodes
-   for (int i = 1; i < order + 1; i++){
-      cheb_nodes_1D[i - 1] = -cos(pi*(2.0*i - 1.0)/(2.0*(order + 1.0)));
-   } // end for i
-   
-   //replacing the first and last index with the element boundary 
-   cheb_nodes_1D[0] = -1.0;
-   cheb_nodes_1D[order] = 1.0;
+   const int &order) const{              // Interpolation order
+
+   // built once per order, see node_sets.cc
+   const node_set &set = get_node_set(node_spacing::chebyshev, order);
+
+   for (int i = 0; i < order + 1; i++) cheb_nodes_1D[i] = set.nodes[i];
+}
+
+// creates nodal positions at the Gauss-Lobatto points
+void HexN::lobatto_nodes_1D(
+   vector<real_t> &lob_nodes_1D,   // Gauss-Lobatto nodes
+   const int &order) const{              // Interpolation order
+
+   const node_set &set = get_node_set(node_spacing::lobatto, order);
+
+   for (int i = 0; i < order + 1; i++) lob_nodes_1D[i] = set.nodes[i];
 }
 
 // Lagrange Interp in 1D, returns interpolants and derivative
@@ -2445,52 +1145,19 @@ void HexN::lagrange_1D(
    vector <real_t> &Dinterp,           // derivative of function
    const real_t &x_point,              // point of interest in element
    const vector <real_t> &xi_point,    // nodal positions in 1D, normally chebyshev
-   const int &orderN){                 // order of element
-   
-   vector <real_t> num(orderN + 1);     // numerator of interpolant
-   vector <real_t> denom(orderN + 1);   // denomenator of interpolant
-   real_t q = 0.0;
-   
-   for(int i = 0; i < orderN + 1; i++){ // looping over the nodes
-      real_t n = 1.0;         // placeholder numerator
-      real_t d = 1.0;         // placeholder denominator
-      real_t c = 1.0;         // placeholder value of n/d
-      real_t p = 0.0;         // placeholder for derivative values
-      real_t s = 1.0;
-      for(int j = 0; j < orderN + 1; j++){  // looping over the nodes !=i
-
-         if (j != i ){
-            n = n*(x_point - xi_point[j]);
-            d = d*(xi_point[i] - xi_point[j]);
-            
-            real_t s = 1.0;
-            for(int N = 0; N < orderN + 1; N++){  // looping over the nodes !=i
-               if (N != j && N != i ){
-                  
-                  s = s * (x_point - xi_point[N]);
-                  
-               }// end if
-            }//end for
-            p += s; 
-
-         }//end if
-         
-         c = n/d; // storing a single value for interpolation for node i
-         q = (p/d); // storing the derivative of the interpolating function
-      } // end looping over nodes != i
-
-      // writing value to vectors for later use
-      interp[i]   = c;     // Interpolant value at given point
-      Dinterp[i]  = q;     // derivative of each function
-
-   } // end loop over all nodes
+   const int &orderN) const{                 // order of element
+
+   // barycentric form without allocation; the nodes are arbitrary, so their
+   // weights are formed here at O(N^2), cached weights come with a node_set
+   barycentric_lagrange(interp.data(), Dinterp.data(), x_point,
+      xi_point.data(), nullptr, orderN + 1);
 } // end of Legrange_1D function
 
 // Corners of Lagrange element for mapping
 void HexN::corners (
    vector< vector<real_t> > &lag_nodes,   // Nodes of Lagrange elements 
    vector< vector<real_t> > &lag_corner,  // corner nodes of HexN element
-   const int &orderN){                    // Element order
+   const int &orderN) const{                    // Element order
 
 
    /*
@@ -2528,28 +1195,13 @@ void HexN::corners (
 
 
    lag_corner[0] = lag_nodes[A];
-   std::cout<<"Corner A = "<<lag_corner[0][0] << "  "<<lag_corner[0][1] << "  "<<lag_corner[0][2] <<std::endl;
-
    lag_corner[1] = lag_nodes[B];
-   std::cout<<"Corner B = "<<lag_corner[1][0] << "  "<<lag_corner[1][1] << "  "<<lag_corner[1][2] <<std::endl;
-
    lag_corner[2] = lag_nodes[C];
-   std::cout<<"Corner C = "<<lag_corner[2][0] << "  "<<lag_corner[2][1] << "  "<<lag_corner[2][2] <<std::endl;
-
    lag_corner[3] = lag_nodes[D];
-   std::cout<<"Corner D = "<<lag_corner[3][0] << "  "<<lag_corner[3][1] << "  "<<lag_corner[3][2] <<std::endl;
-
    lag_corner[4] = lag_nodes[E];
-   std::cout<<"Corner E = "<<lag_corner[4][0] << "  "<<lag_corner[4][1] << "  "<<lag_corner[4][2] <<std::endl;
-
    lag_corner[5] = lag_nodes[F];
-   std::cout<<"Corner F = "<<lag_corner[5][0] << "  "<<lag_corner[5][1] << "  "<<lag_corner[5][2] <<std::endl;
-
    lag_corner[6] = lag_nodes[G];
-   std::cout<<"Corner G = "<<lag_corner[6][0] << "  "<<lag_corner[6][1] << "  "<<lag_corner[6][2] <<std::endl;
-
    lag_corner[7] = lag_nodes[H];
-   std::cout<<"Corner H = "<<lag_corner[7][0] << "  "<<lag_corner[7][1] << "  "<<lag_corner[7][2] <<std::endl;
 }// end of corner mapping function
 
 // Functions for mapping reference position to physical position for any 
@@ -2558,14 +1210,14 @@ void HexN::physical_position (
    vector <real_t> &x_point,                    // location in real space
    const vector< vector<real_t> > &lag_nodes,   // Nodes of Lagrange elements 
    const vector <real_t> &lag_basis_3d,         // 3D basis values 
-   const int &orderN){                          // order of the element
+   const int &orderN) const{                          // order of the element
 
 
    int nodes = orderN + 1;
    int numnodes_3d = nodes * nodes * nodes;
 
    for (int this_vert = 0; this_vert < numnodes_3d; this_vert++ ){
-      for (int dim = 0; dim < 2; dim++){
+      for (int dim = 0; dim < 3; dim++){
          x_point[dim] += lag_nodes[this_vert][dim]*lag_basis_3d[this_vert];
       } // end for dim
    } // end for this_vert
@@ -2581,7 +1233,7 @@ void HexN::basis_partials (
    vector <real_t> &lag_basis_3d,         // 3D basis values 
    vector< vector<real_t> > &lag_partial, // Partial of basis 
    const vector <real_t> &xi_point,       // point of interest
-   const int &orderN){                    // Element order
+   const int &orderN) const{                    // Element order
 
    /*
 
@@ -2607,77 +1259,37 @@ void HexN::basis_partials (
 
    int N = orderN + 1;      //number of nodes in each direction
    int tot_pts = (N*N*N);  // total nodes in 3D
-   
-   real_t sumi = 0.0;
-   real_t sumj = 0.0;
-   real_t sumk = 0.0;
-
 
    //Setting nodes for Lagrange Elements
    for (int m = 0; m < tot_pts; m++) {
 
-      int i, j, k, jj;
-
-
-
-      // sets up the i, j, k indices for the nodes of an 
-      // arbitrary order lagrange element
-      int p12 = (N * N);
-
-      k  = floor(m/p12) + 1; 
-
-      jj = (m+1) - p12 * (k-1); 
-      j  = floor((jj-1) / N)+1;
-
-      i  = jj - N * (j-1); 
-
       // xi direction
-      lag_nodes[m][0] = nodes_1d[i-1]; 
+      lag_nodes[m][0] = nodes_1d[m % N]; 
 
       // eta direction
-      lag_nodes[m][1] = nodes_1d[j-1]; 
+      lag_nodes[m][1] = nodes_1d[(m / N) % N]; 
 
       // mu direction 
-      lag_nodes[m][2] = nodes_1d[k-1]; 
+      lag_nodes[m][2] = nodes_1d[m / (N*N)]; 
+   } // end for m
 
-   // calling function to assign nodal values for basis and derivative
+   // the 1D interpolants only depend on the direction, evaluate them once
+   // per direction and pick them up for every node
+   for (int dim = 0; dim < 3; dim++){
 
-      //evaluating Lagrange interpolants for each function at xi_point
+      lagrange_1D(val_1d, DVal_1d, xi_point[dim], nodes_1d, orderN);
 
-      lagrange_1D(val_1d, DVal_1d, xi_point[0], nodes_1d, orderN);
-      val_3d[m][0]  = val_1d[i-1]; 
-      DVal_3d[m][0] = DVal_1d[i-1];
+      int stride = (dim == 0) ? 1 : (dim == 1) ? N : N*N;
 
-      // resetting to zero
-      for(int i = 0.0; i < N; i++){
-         val_1d[i]  = 0.0;
-         DVal_1d[i] = 0.0;
-      }
+      for (int m = 0; m < tot_pts; m++) {
+         int index = (m / stride) % N;
 
+         val_3d[m][dim]  = val_1d[index]; 
+         DVal_3d[m][dim] = DVal_1d[index];
+      } // end for m
+   } // end for dim
 
-      //evaluating Legrange interpolants for each function at xi_point
-
-      lagrange_1D(val_1d, DVal_1d, xi_point[1], nodes_1d, orderN);
-      val_3d[m][1]  = val_1d[j-1]; 
-      DVal_3d[m][1] = DVal_1d[j-1];
-
-      // resetting to zero
-      for(int i = 0.0; i < N; i++){
-         val_1d[i]  = 0.0;
-         DVal_1d[i] = 0.0;
-      }
-
-      //evaluating Legrange interpolants for each function at xi_point
-
-      lagrange_1D(val_1d, DVal_1d, xi_point[2], nodes_1d, orderN);
-      val_3d[m][2]  = val_1d[k-1];   //3d[2dto1d(m, 2)]
-      DVal_3d[m][2] = DVal_1d[k-1];
-      // resetting to zero
-      for(int i = 0.0; i < N; i++){
-         val_1d[i]  = 0.0;
-         DVal_1d[i] = 0.0;
-      }
-
+   for (int m = 0; m < tot_pts; m++) {
 
    // Assigning and storing the Basis
       lag_basis_3d[m] = val_3d[m][0] * val_3d[m][1] * val_3d[m][2];
@@ -2688,10 +1300,39 @@ void HexN::basis_partials (
       lag_partial[m][1]  = val_3d[m][0] * DVal_3d[m][1] * val_3d[m][2];
       lag_partial[m][2]  = val_3d[m][0] * val_3d[m][1] * DVal_3d[m][2];
 
-
    } // end for  
 }// end basis_partials function
 
+// basis values and partials on a cached node set
+void HexN::basis_partials (
+   vector <real_t> &lag_basis_3d,         // 3D basis values
+   vector< vector<real_t> > &lag_partial, // Partial of basis
+   vector <real_t> &val_1d,               // Interpolant values, 3*(orderN + 1)
+   vector <real_t> &DVal_1d,              // Derivatives of basis, 3*(orderN + 1)
+   const vector <real_t> &xi_point,       // point of interest
+   const node_set &nodes) const{          // 1D nodes of the element order
+
+   int N = nodes.num_nodes;
+
+   for (int dim = 0; dim < 3; dim++)
+      barycentric_lagrange(val_1d.data() + dim*N, DVal_1d.data() + dim*N,
+         xi_point[dim], nodes.nodes.data(), nodes.weights.data(), N);
+
+   const real_t *v0 = val_1d.data(),  *v1 = val_1d.data() + N,  *v2 = val_1d.data() + 2*N;
+   const real_t *d0 = DVal_1d.data(), *d1 = DVal_1d.data() + N, *d2 = DVal_1d.data() + 2*N;
+
+   // nodes xi fastest
+   for (int k = 0; k < N; k++)
+      for (int j = 0; j < N; j++)
+         for (int i = 0; i < N; i++){
+            int m = (k*N + j)*N + i;
+            lag_basis_3d[m]   = v0[i]*v1[j]*v2[k];
+            lag_partial[m][0] = d0[i]*v1[j]*v2[k];
+            lag_partial[m][1] = v0[i]*d1[j]*v2[k];
+            lag_partial[m][2] = v0[i]*v1[j]*d2[k];
+         }
+}// end basis_partials function
+
 
 
 
@@ -2749,9 +1390,7 @@ void HexN::basis_partials (
  */
 
 
-int  num_nodes = 16;
-
-real_t ref_vert[16][4] = // listed as {Xi, Eta, Mu, Tau}
+real_t Tess16::ref_vert[16][4] = // listed as {Xi, Eta, Mu, Tau}
    {
    // Interior cube bottom
    {-1.0, -1.0, -1.0, -1.0},//0
@@ -2781,100 +1420,44 @@ real_t ref_vert[16][4] = // listed as {Xi, Eta, Mu, Tau}
 void Tess16::physical_position(
    vector <real_t> &x_point,
    const vector <real_t> &xi_point,
-   const vector< vector<real_t> > &vertices){
+   const vector< vector<real_t> > &vertices) const{
 
-   real_t shape_fcn[16];
-   real_t check_unity;
-   real_t sum = 0;
-   
-   // calculate the shape functions from each vertex for (xi,eta,mu, tau)
-   for(int this_vert = 0; this_vert < 16; this_vert++){
-      shape_fcn[this_vert] = 1.0/16.0
-                  * (1 + xi_point[0]*ref_vert[this_vert][0]) 
-                  * (1 + xi_point[1]*ref_vert[this_vert][1]) 
-                  * (1 + xi_point[2]*ref_vert[this_vert][2]) 
-                  * (1 + xi_point[3]*ref_vert[this_vert][3]);
-   } // end for shape functions
-
-   // calculate the position in physical space
-   for (int dim = 0; dim < 4; dim++)
-      x_point[dim] = 0.0;
-
-   check_unity = 0.0;
-   for (int this_vert = 0; this_vert < 16; this_vert++ ){
-      
-      for (int dim = 0; dim < 4; dim++){
-         x_point[dim] += vertices[this_vert][dim]*shape_fcn[this_vert];
-      } // end for dim
-   
-      // check partition of unity
-      check_unity += shape_fcn[this_vert];
-   } // end for this_vert
-    
-   // unit test
-   // std::cout << "Tess 16 partion of unity :" << check_unity << std::endl;
+   // flat copy of the vertices for the kernel
+   real_t vert_flat[tess16_kernel::num_nodes*4];
+   for (int node = 0; node < tess16_kernel::num_nodes; node++)
+      for (int d = 0; d < 4; d++)
+         vert_flat[node*4 + d] = vertices[node][d];
+
+   tess16_kernel::physical_position(x_point.data(), xi_point.data(), vert_flat);
 } // End physical position function
 
 
 // Partial derivative of shape functions with respect to Xi at Xi_point
 void Tess16::partial_xi_shape_fcn(
    vector<real_t>  &tess16_partial_xi, 
-   const vector <real_t> &xi_point) {
-
-   for (int this_vert = 0; this_vert < 16; this_vert++){
-
-      tess16_partial_xi[this_vert] = 1.0/16.0
-                                     * (ref_vert[this_vert][0])
-                                     * (1 + xi_point[1]*ref_vert[this_vert][1])
-                                     * (1 + xi_point[2]*ref_vert[this_vert][2])
-                                     * (1 + xi_point[3]*ref_vert[this_vert][3]);
-   }   // end for this_vert 
+   const vector <real_t> &xi_point) const {
+   tess16_kernel::partial_xi(tess16_partial_xi.data(), xi_point.data());
 } // end partial Xi function
 
 // Partial derivative of shape functions with respect to Eta
 void Tess16::partial_eta_shape_fcn(
    vector<real_t> &tess16_partial_eta, 
-   const vector <real_t> &xi_point) {
-
-   for (int this_vert = 0; this_vert < 16; this_vert++){  
-      tess16_partial_eta[this_vert] = 1.0/16.0
-                                    * (1 + xi_point[0]*ref_vert[this_vert][0])
-                                    * (ref_vert[this_vert][1])
-                                    * (1 + xi_point[2]*ref_vert[this_vert][2])
-                                    * (1 + xi_point[3]*ref_vert[this_vert][3]);
-                                     
-   }   // end for this_vert 
+   const vector <real_t> &xi_point) const {
+   tess16_kernel::partial_eta(tess16_partial_eta.data(), xi_point.data());
 }  // End partial eta function
 
 // Partial derivative of shape functions with respect to Mu
 void Tess16::partial_mu_shape_fcn(
    vector<real_t> &tess16_partial_mu, 
-   const vector <real_t> &xi_point) {
-
-    for (int this_vert = 0; this_vert < 16; this_vert++){  
-      tess16_partial_mu[this_vert] = 1.0/16.0
-                                     * (1 + xi_point[0]*ref_vert[this_vert][0])
-                                     * (1 + xi_point[1]*ref_vert[this_vert][1])
-                                     * (ref_vert[this_vert][2])
-                                     * (1 + xi_point[3]*ref_vert[this_vert][3]);
-
-   } // end for this_vert   
+   const vector <real_t> &xi_point) const {
+   tess16_kernel::partial_mu(tess16_partial_mu.data(), xi_point.data());
 } // end partial Mu fuction
 
 // Partial derivative of shape functions with respect to Tau
 void Tess16::partial_tau_shape_fcn(
    vector<real_t> &tess16_partial_tau, 
-   const vector <real_t> &xi_point) {
-
-   for (int this_vert = 0; this_vert < 16; this_vert++){  
-      tess16_partial_tau[this_vert] = 1.0/16.0
-                                     * (1 + xi_point[0]*ref_vert[this_vert][0])
-                                     * (1 + xi_point[1]*ref_vert[this_vert][1])
-                                     * (1 + xi_point[2]*ref_vert[this_vert][2])
-                                     * (ref_vert[this_vert][3]);
-                                     
-
-   } // end for this_vert    
+   const vector <real_t> &xi_point) const {
+   tess16_kernel::partial_tau(tess16_partial_tau.data(), xi_point.data());
 } // End partial tau function
 
 
@@ -3,6 +3,7 @@
 
 #include <iostream>
 
+#include "ristra/elements/node_sets.h"
 #include "ristra/elements/utilities.h"
 
 namespace ristra{
@@ -106,21 +107,21 @@ class Element2D {
       // calculate a physical position in an element for a given xi,eta
       virtual void physical_position(vector <real_t> &x_2D_point,
                                      const vector <real_t> &xi_2D_point,
-                                     const vector< vector<real_t> > &vertices) = 0;
+                                     const vector< vector<real_t> > &vertices) const = 0;
 
       // calculate the value for the basis at each node for a given xi,eta
       virtual void basis(vector <real_t> &basis,
                          const vector <real_t> &xi_2D_point,
-                         const vector< vector<real_t> > &vertices) = 0;
+                         const vector< vector<real_t> > &vertices) const = 0;
 
       // Partial derivative of shape functions with respect to Xi
       virtual void  partial_xi_shape_fcn(vector<real_t>  &partial_xi, 
-                                         const vector <real_t> &xi_2D_point) = 0;
+                                         const vector <real_t> &xi_2D_point) const = 0;
 
    
       // Partial derivative of shape functions with respect to Xi
       virtual void  partial_eta_shape_fcn(vector<real_t> &partial_eta, 
-                                          const vector <real_t> &xi_2D_point) = 0;
+                                          const vector <real_t> &xi_2D_point) const = 0;
 }; // end of 2D element class
 
 class Element3D {
@@ -133,24 +134,24 @@ class Element3D {
       // calculate a physical position in an element for a given xi,eta,mu
       virtual void physical_position(vector <real_t> &x_point,
                                      const vector <real_t> &xi_point,
-                                     const vector< vector<real_t> > &vertices) = 0;
+                                     const vector< vector<real_t> > &vertices) const = 0;
 
       // calculate the value for the basis at each node for a given xi,eta, mu
       virtual void basis(vector <real_t> &basis,
                          const vector <real_t> &xi_point,
-                         const vector< vector<real_t> > &vertices) = 0;
+                         const vector< vector<real_t> > &vertices) const = 0;
 
       // Partial derivative of shape functions with respect to Xi at Xi_point
       virtual void partial_xi_shape_fcn(vector<real_t>  &partial_xi, 
-                                        const vector <real_t> &xi_point) = 0;
+                                        const vector <real_t> &xi_point) const = 0;
 
       // Partial derivative of shape functions with respect to Eta
       virtual void partial_eta_shape_fcn(vector<real_t> &partial_eta, 
-                                         const vector <real_t> &xi_point) = 0;
+                                         const vector <real_t> &xi_point) const = 0;
 
       // Partial derivative of shape functions with respect to Mu
       virtual void partial_mu_shape_fcn(vector<real_t> &partial_mu, 
-                                        const vector <real_t> &xi_point) = 0;
+                                        const vector <real_t> &xi_point) const = 0;
 }; // end of 3D parent class
 
 class Element4D {
@@ -160,23 +161,23 @@ class Element4D {
       // calculate a physical position in an element for a given xi,eta,mu
       virtual void physical_position(vector<real_t> &x_point,
                             const vector <real_t> &xi_point,
-                            const vector< vector<real_t> > &vertices) = 0;
+                            const vector< vector<real_t> > &vertices) const = 0;
 
       // Partial derivative of shape functions with respect to Xi at Xi_point
       virtual void partial_xi_shape_fcn(vector<real_t>  &tess16_partial_xi, 
-                                const vector <real_t> &xi_point) = 0;
+                                const vector <real_t> &xi_point) const = 0;
 
       // Partial derivative of shape functions with respect to Eta
       virtual void partial_eta_shape_fcn(vector<real_t> &tess16_partial_eta, 
-                                 const vector <real_t> &xi_point) = 0;
+                                 const vector <real_t> &xi_point) const = 0;
 
       // Partial derivative of shape functions with respect to Mu
       virtual void partial_mu_shape_fcn(vector<real_t> &tess16_partial_mu, 
-                                const vector <real_t> &xi_point) = 0;
+                                const vector <real_t> &xi_point) const = 0;
 
       // Partial derivative of shape functions with respect to Tau
       virtual void partial_tau_shape_fcn(vector<real_t> &tess16_partial_tau, 
-                                 const vector <real_t> &xi_point) = 0;
+                                 const vector <real_t> &xi_point) const = 0;
 }; // end of 3D parent class
 
 
@@ -227,24 +228,21 @@ class Quad_4_2D: public Element2D {
       // calculate a physical position in an element for a given xi,eta
       void physical_position(vector <real_t> &x_point, 
                              const vector <real_t> &xi_2D_point, 
-                             const vector< vector<real_t> > &vertices);
-  
-         real_t shape_fcn[4];
-         real_t check_unity;
+                             const vector< vector<real_t> > &vertices) const;
 
       // calculate the value for the basis at each node for a given xi,eta
       void basis(vector <real_t> &basis,
                  const vector <real_t> &xi_2D_point,
-                 const vector< vector<real_t> > &vertices);
+                 const vector< vector<real_t> > &vertices) const;
 
       // Partial derivative of shape functions with respect to Xi
       void  partial_xi_shape_fcn(vector<real_t>  &quad4_partial_xi, 
-                                 const vector <real_t> &xi_2D_point);
+                                 const vector <real_t> &xi_2D_point) const;
 
 
       // Partial derivative of shape functions with respect to Eta
       void  partial_eta_shape_fcn(vector<real_t> &quad4_partial_eta, 
-                                  const vector <real_t> &xi_2D_point);
+                                  const vector <real_t> &xi_2D_point) const;
 }; // end of quad_4_2D class
 
 /*
@@ -283,23 +281,20 @@ class Quad_8_2D: public Element2D {
       void physical_position(
                vector <real_t> &x_point, 
                const vector <real_t> &xi_2D_point, 
-               const vector< vector<real_t> > &vertices);
-  
-         real_t shape_fcn[8];
-         real_t check_unity;
+               const vector< vector<real_t> > &vertices) const;
 
       // calculate the value for the basis at each node for a given xi,eta
       void basis(vector <real_t> &basis,
                  const vector <real_t> &xi_2D_point,
-                 const vector< vector<real_t> > &vertices); 
+                 const vector< vector<real_t> > &vertices) const; 
 
       // Partial derivative of shape functions with respect to Xi
       void partial_xi_shape_fcn(vector<real_t>  &quad8_partial_xi, 
-                                 const vector <real_t> &xi_2D_point);
+                                 const vector <real_t> &xi_2D_point) const;
 
       // Partial derivative of shape functions with respect to Eta
       void partial_eta_shape_fcn(vector<real_t> &quad8_partial_eta, 
-                                 const vector <real_t> &xi_2D_point);
+                                 const vector <real_t> &xi_2D_point) const;
 }; // end of quad8 class
 
 /*
@@ -335,23 +330,20 @@ class Quad_12_2D: public Element2D {
       void physical_position(
                vector <real_t> &x_point, 
                const vector <real_t> &xi_point,
-               const vector< vector<real_t> > &vertices);
-  
-         real_t shape_fcn[12];
-         real_t check_unity;
+               const vector< vector<real_t> > &vertices) const;
 
       // calculate the value for the basis at each node for a given xi,eta
       void basis(vector <real_t> &basis,
                  const vector <real_t> &xi_2D_point,
-                 const vector< vector<real_t> > &vertices);
+                 const vector< vector<real_t> > &vertices) const;
 
       // Partial derivative of shape functions with respect to Xi
       void partial_xi_shape_fcn(vector<real_t>  &quad12_partial_xi, 
-                                const vector <real_t> &xi_point);
+                                const vector <real_t> &xi_point) const;
 
       // Partial derivative of shape functions with respect to Eta
       void partial_eta_shape_fcn(vector<real_t> &quad12_partial_eta, 
-                                 const vector <real_t> &xi_point);
+                                 const vector <real_t> &xi_point) const;
 }; // end of quad12 class
 
 
@@ -404,29 +396,25 @@ class Hex8: public Element3D {
       // get the physical location for a given xi_point
       void physical_position (vector <real_t> &x_point,
                               const vector <real_t> &xi_3D_point,
-                              const vector< vector<real_t> > &vertices);
-         int    dim;
-         
-         real_t shape_fcn[8];
-         real_t check_unity;
-      
+                              const vector< vector<real_t> > &vertices) const;
+
       // calculate the value for the basis at each node for a given xi,eta, mu
       void basis(vector <real_t> &basis,
                  const vector <real_t> &xi_3D_point,
-                 const vector< vector<real_t> > &vertices);
+                 const vector< vector<real_t> > &vertices) const;
 
       // calculate the partials of the shape function 
       // with respect to Xi
       void partial_xi_shape_fcn(vector<real_t> &hex8_partial_xi, 
-                                const vector <real_t> &xi_3D_point);
+                                const vector <real_t> &xi_3D_point) const;
 
       // with respect to Eta
       void partial_eta_shape_fcn(vector<real_t> &hex8_partial_eta, 
-                                 const vector <real_t> &xi_3D_point);
+                                 const vector <real_t> &xi_3D_point) const;
 
       // with repsect to Mu
       void partial_mu_shape_fcn(vector<real_t> &hex8_partial_mu, 
-                                const vector <real_t> &xi_3D_point);
+                                const vector <real_t> &xi_3D_point) const;
 }; // end of hex 8 class
 
 /*
@@ -468,30 +456,24 @@ class Hex20: public Element3D {
       // get the physical location for a given xi_3D_point
       void physical_position (vector <real_t> &x_point,
                               const vector <real_t> &xi_3D_point,
-                              const vector< vector<real_t> > &vertices);
-      
-         int    this_vert;
-         int    dim;
-      
-         real_t shape_fcn[20];
-         real_t check_unity;
-     
+                              const vector< vector<real_t> > &vertices) const;
+
       // calculate the value for the basis at each node for a given xi,eta, mu
       void basis(vector <real_t> &basis,
                  const vector <real_t> &xi_3D_point,
-                 const vector< vector<real_t> > &vertices);
+                 const vector< vector<real_t> > &vertices) const;
 
       // Calculate the partials of the shape functions
       // with respect to Xi
       void  partial_xi_shape_fcn(vector<real_t> &hex20_partial_xi, 
-                                 const vector <real_t> &xi_3D_point);
+                                 const vector <real_t> &xi_3D_point) const;
 
       // with respect to Eta
       void partial_eta_shape_fcn(vector<real_t> &hex20_partial_eta, 
-                                 const vector <real_t> &xi_3D_point);
+                                 const vector <real_t> &xi_3D_point) const;
       // with repsect to mu
       void partial_mu_shape_fcn(vector<real_t> &hex20_partial_mu, 
-                                const vector <real_t> &xi_3D_point);
+                                const vector <real_t> &xi_3D_point) const;
 }; //end of 20 node element class
 
 
@@ -542,29 +524,24 @@ class Hex32: public Element3D {
       // get the physical location for a given xi_3D_point
       void physical_position (vector <real_t> &x_point,
                              const vector <real_t> &xi_3D_point,
-                             const vector< vector<real_t> > &vertices);
-
-         int    dim;
-      
-         real_t shape_fcn[32];
-         real_t check_unity;
+                             const vector< vector<real_t> > &vertices) const;
 
       // calculate the value for the basis at each node for a given xi,eta, mu
       void basis(vector <real_t> &basis,
                  const vector <real_t> &xi_3D_point,
-                 const vector< vector<real_t> > &vertices);
+                 const vector< vector<real_t> > &vertices) const;
       
       // Calculate the partials of the shape functions
       // with respect to Xi
       void  partial_xi_shape_fcn(vector<real_t> &hex32_partial_xi, 
-                                 const vector <real_t> &xi_3D_point);
+                                 const vector <real_t> &xi_3D_point) const;
 
       // with respect to Eta
       void partial_eta_shape_fcn(vector<real_t> &hex32_partial_eta, 
-                                 const vector <real_t> &xi_3D_point);
+                                 const vector <real_t> &xi_3D_point) const;
       // with repsect to mu
       void partial_mu_shape_fcn(vector<real_t> &hex32_partial_mu, 
-                                const vector <real_t> &xi_3D_point);
+                                const vector <real_t> &xi_3D_point) const;
 }; //end of 32 node element class
 
 
@@ -607,27 +584,37 @@ class QuadN{
       // creates nodal positions with Chebyshev spacing
       void chebyshev_nodes_1D(
          vector<real_t> &cheb_nodes_1D,  // Chebyshev nodes
-         const int &orderN);              // Interpolation order
+         const int &orderN) const;        // Interpolation order
+
+      // creates nodal positions at the Gauss-Lobatto points, with a Lobatto
+      // rule of orderN + 1 points the nodes and quadrature points coincide
+      void lobatto_nodes_1D(
+         vector<real_t> &lob_nodes_1D,   // Gauss-Lobatto nodes
+         const int &orderN) const;        // Interpolation order
 
       // calculates the basis values and derivatives in 1D
       // used in teh basis_partials functiosn to build the 3D element
+      //
+      // the barycentric weights of xi_point are formed on every call, O(N^2)
+      // for N = orderN + 1 nodes; repeated evaluations should use the
+      // node_set overload of basis_partials, which reuses cached weights
       void lagrange_1D(
          vector <real_t> &interp,            // interpolant
          vector <real_t> &Dinterp,           // derivative of function
          const real_t &x_point,              // point of interest in element
          const vector <real_t> &xi_point,    // nodal positions in 1D, normally chebyshev
-         const int &orderN);                 // order of element
+         const int &orderN) const;           // order of element
 
       void corners (
          vector< vector<real_t> > &lag_nodes,   // Nodes of Lagrange elements 
          vector< vector<real_t> > &lag_corner,  // corner nodes of HexN element
-         const int &orderN);                    // Element order)
+         const int &orderN) const;              // Element order)
       
       void physical_position (
          vector <real_t> &x_point,                    // location in real space
          const vector< vector<real_t> > &lag_nodes,   // Nodes of Lagrange elements 
          const vector <real_t> &lag_basis_2d,         // 2D basis values 
-         const int &orderN);                          // order of the element
+         const int &orderN) const;                    // order of the element
       
       void basis_partials (
          vector< vector<real_t> > &lag_nodes,   // Nodes of Lagrange elements (to be filled in)
@@ -639,7 +626,17 @@ class QuadN{
          vector <real_t> &lag_basis_2d,         // 3D basis values 
          vector< vector<real_t> > &lag_partial, // Partial of basis 
          const vector <real_t> &xi_point,       // point of interest
-         const int &orderN);                    // Element order
+         const int &orderN) const;              // Element order
+
+      // basis values and partials on a cached node set (node_sets.h), the
+      // node coordinates are not rebuilt and the barycentric weights reused
+      void basis_partials (
+         vector <real_t> &lag_basis_2d,         // 2D basis values
+         vector< vector<real_t> > &lag_partial, // Partial of basis
+         vector <real_t> &val_1d,               // Interpolant values, 2*(orderN + 1)
+         vector <real_t> &DVal_1d,              // Derivatives of basis, 2*(orderN + 1)
+         const vector <real_t> &xi_point,       // point of interest
+         const node_set &nodes) const;          // 1D nodes of the element order
 };
 
 
@@ -649,27 +646,37 @@ class HexN{
       // creates nodal positions with Chebyshev spacing
       void chebyshev_nodes_1D(
          vector<real_t> &cheb_nodes_1D,  // Chebyshev nodes
-         const int &orderN);              // Interpolation order
+         const int &orderN) const;        // Interpolation order
+
+      // creates nodal positions at the Gauss-Lobatto points, with a Lobatto
+      // rule of orderN + 1 points the nodes and quadrature points coincide
+      void lobatto_nodes_1D(
+         vector<real_t> &lob_nodes_1D,   // Gauss-Lobatto nodes
+         const int &orderN) const;        // Interpolation order
 
       // calculates the basis values and derivatives in 1D
       // used in teh basis_partials functiosn to build the 3D element
+      //
+      // the barycentric weights of xi_point are formed on every call, O(N^2)
+      // for N = orderN + 1 nodes; repeated evaluations should use the
+      // node_set overload of basis_partials, which reuses cached weights
       void lagrange_1D(
          vector <real_t> &interp,            // interpolant
          vector <real_t> &Dinterp,           // derivative of function
          const real_t &x_point,              // point of interest in element
          const vector <real_t> &xi_point,    // nodal positions in 1D, normally chebyshev
-         const int &orderN);                 // order of element
+         const int &orderN) const;           // order of element
 
       void corners (
          vector< vector<real_t> > &lag_nodes,   // Nodes of Lagrange elements 
          vector< vector<real_t> > &lag_corner,  // corner nodes of HexN element
-         const int &orderN);                    // Element order)
+         const int &orderN) const;              // Element order)
       
       void physical_position (
          vector <real_t> &x_point,                    // location in real space
          const vector< vector<real_t> > &lag_nodes,   // Nodes of Lagrange elements 
          const vector <real_t> &lag_basis_3d,         // 3D basis values 
-         const int &orderN);                          // order of the element
+         const int &orderN) const;                    // order of the element
       
       void basis_partials (
          vector< vector<real_t> > &lag_nodes,   // Nodes of Lagrange elements (to be filled in)
@@ -681,7 +688,17 @@ class HexN{
          vector <real_t> &lag_basis_3d,         // 3D basis values 
          vector< vector<real_t> > &lag_partial, // Partial of basis 
          const vector <real_t> &xi_point,       // point of interest
-         const int &orderN);                    // Element order
+         const int &orderN) const;              // Element order
+
+      // basis values and partials on a cached node set (node_sets.h), the
+      // node coordinates are not rebuilt and the barycentric weights reused
+      void basis_partials (
+         vector <real_t> &lag_basis_3d,         // 3D basis values
+         vector< vector<real_t> > &lag_partial, // Partial of basis
+         vector <real_t> &val_1d,               // Interpolant values, 3*(orderN + 1)
+         vector <real_t> &DVal_1d,              // Derivatives of basis, 3*(orderN + 1)
+         const vector <real_t> &xi_point,       // point of interest
+         const node_set &nodes) const;          // 1D nodes of the element order
 };
 
 
@@ -742,9 +759,9 @@ class HexN{
 
 class Tess16: public Element4D {
    protected:
-      int  num_nodes;
+      static const int num_nodes = 16;
 
-      real_t ref_vert[16][4];  // listed as {Xi, Eta, Mu, Tau}
+      static real_t ref_vert[16][4];  // listed as {Xi, Eta, Mu, Tau}
 
 
 
@@ -753,23 +770,23 @@ class Tess16: public Element4D {
       // calculate a physical position in an element for a given xi,eta,mu
       void physical_position(vector <real_t> &x_point,
                             const vector <real_t> &xi_4D_point,
-                            const vector< vector<real_t> > &vertices);
+                            const vector< vector<real_t> > &vertices) const;
 
       // Partial derivative of shape functions with respect to Xi at Xi_point
       void partial_xi_shape_fcn(vector<real_t>  &tess16_partial_xi, 
-                                const vector <real_t> &xi_4D_point);
+                                const vector <real_t> &xi_4D_point) const;
 
       // Partial derivative of shape functions with respect to Eta
       void partial_eta_shape_fcn(vector<real_t> &tess16_partial_eta, 
-                                 const vector <real_t> &xi_4D_point);
+                                 const vector <real_t> &xi_4D_point) const;
 
       // Partial derivative of shape functions with respect to Mu
       void partial_mu_shape_fcn(vector<real_t> &tess16_partial_mu, 
-                                const vector <real_t> &xi_4D_point);
+                                const vector <real_t> &xi_4D_point) const;
 
       // Partial derivative of shape functions with respect to Tau
       void partial_tau_shape_fcn(vector<real_t> &tess16_partial_tau, 
-                                 const vector <real_t> &xi_4D_point);                                          
+                                 const vector <real_t> &xi_4D_point) const;                                          
 }; // End of Tess16 Element Class
 
 
@@ -0,0 +1,280 @@
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+#include "ristra/elements/faces.h"
+#include "ristra/elements/element_kernels.h"
+#include "ristra/elements/elements.h"
+#include "ristra/elements/jacobian.h"
+#include "ristra/elements/node_sets.h"
+#include "ristra/assertions/errors.h"
+
+namespace ristra {
+namespace elements{
+
+namespace {
+
+// reference coordinates of the element nodes, nodes[n_node][dim]
+void reference_nodes(vector<real_t> &nodes, const element_type &type,
+   const int &elem_order){
+
+   int dim = num_dim(type);
+
+   if (type == element_type::quadN || type == element_type::hexN){
+
+      if (elem_order < 1)
+         THROW_IMPLEMENTED_ERROR("quadN/hexN need an element order of at least 1");
+
+      const node_set &set = get_node_set(node_spacing::chebyshev, elem_order);
+      if (dim == 2) nodes.assign(set.nodes_2d.begin(), set.nodes_2d.end());
+      else nodes.assign(set.nodes_3d.begin(), set.nodes_3d.end());
+      return;
+   }
+
+   visit_element_kernel(type, [&](auto kernel){
+      using Kernel = decltype(kernel);
+      constexpr int Dim = Kernel::num_dim;
+      constexpr int NumNodes = Kernel::num_nodes;
+
+      nodes.resize(NumNodes*Dim);
+      for (int node = 0; node < NumNodes; node++)
+         for (int d = 0; d < Dim; d++) nodes[node*Dim + d] = Kernel::ref_vert[node][d];
+   });
+}
+
+// positions, normals and surface jacobians of a list of faces
+template<int Dim>
+void face_kernel(
+   face_block &block,
+   const vector<face_table> &face_tables,
+   const real_t *coords,
+   const int *connectivity,
+   const int *faces,
+   const int &n_faces){
+
+   int n_qp   = block.n_qp;
+   int n_node = face_tables[0].n_node;
+
+   vector<real_t> verts(n_node*Dim);
+
+   for (int f = 0; f < n_faces; f++){
+
+      int elem = faces[2*f];
+      const face_table &table = face_tables[faces[2*f + 1]];
+
+      const int *elem_nodes = connectivity + elem*n_node;
+      for (int node = 0; node < n_node; node++)
+         for (int d = 0; d < Dim; d++)
+            verts[node*Dim + d] = coords[elem_nodes[node]*Dim + d];
+
+      for (int qp = 0; qp < n_qp; qp++){
+
+         int m = f*n_qp + qp;
+         const real_t *phi = table.basis.data() + qp*n_node;
+         const real_t *partials = table.partials.data() + qp*n_node*Dim;
+
+         real_t *x = block.x_points.data() + m*Dim;
+         for (int d = 0; d < Dim; d++) x[d] = 0.0;
+         for (int node = 0; node < n_node; node++)
+            for (int d = 0; d < Dim; d++) x[d] += verts[node*Dim + d]*phi[node];
+
+         real_t J[Dim][Dim];
+         real_t J_inv[Dim][Dim];
+         jacobian_kernel<Dim>(J, verts.data(), partials, n_node);
+         real_t det = determinant_kernel<Dim>(J);
+
+         // n dS = |det J| J^-1 e_dir side
+         real_t *normal = block.normals.data() + m*Dim;
+         real_t length = 0.0;
+
+         if (det != 0.0){
+            inverse_kernel<Dim>(J_inv, J, det);
+            real_t scale = std::abs(det)*table.side;
+            for (int k = 0; k < Dim; k++){
+               normal[k] = scale*J_inv[k][table.dir];
+               length += normal[k]*normal[k];
+            }
+            length = std::sqrt(length);
+         }
+
+         if (length > 0.0)
+            for (int k = 0; k < Dim; k++) normal[k] /= length;
+         else
+            for (int k = 0; k < Dim; k++) normal[k] = 0.0;
+
+         block.det_S[m] = length;
+         block.w_det_S[m] = table.weights[qp]*length;
+      } // end for qp
+   } // end for f
+}
+
+} // namespace
+
+
+// number of local faces or edges
+int num_faces(const element_type &type){
+   return 2*num_dim(type);
+}
+
+// builds the table of one local face
+void build_face_table(
+   face_table &table,
+   const element_type &type,
+   const int &face,
+   const quadrature_rule &rule,
+   const int &quad_order,
+   const int &elem_order){
+
+   int dim = num_dim(type);
+
+   if (dim != 2 && dim != 3)
+      THROW_IMPLEMENTED_ERROR("faces are only defined in 2D and 3D");
+
+   if (face < 0 || face >= num_faces(type))
+      THROW_IMPLEMENTED_ERROR("local face out of range for this element type");
+
+   const tensor_quadrature &tensor = tensor_rule(rule, quad_order, dim - 1);
+
+   int n_qp = tensor.n_qp;
+   int n_node = num_nodes(type, elem_order);
+
+   table.type       = type;
+   table.rule       = rule;
+   table.face       = face;
+   table.dir        = face/2;
+   table.side       = (face % 2 == 0) ? -1.0 : 1.0;
+   table.quad_order = quad_order;
+   table.elem_order = elem_order;
+   table.n_qp       = n_qp;
+   table.n_node     = n_node;
+   table.dim        = dim;
+
+   // face points, the face directions in increasing order
+   table.points.resize(n_qp*dim);
+   table.weights.assign(tensor.weights.begin(), tensor.weights.end());
+
+   for (int qp = 0; qp < n_qp; qp++){
+      int t = 0;
+      for (int d = 0; d < dim; d++)
+         table.points[qp*dim + d] = (d == table.dir)
+            ? table.side : tensor.points[qp*(dim - 1) + t++];
+   }
+
+   table.basis.resize(n_qp*n_node);
+   table.partials.resize(n_qp*n_node*dim);
+
+   if (type == element_type::quadN || type == element_type::hexN)
+      lagrange_reference_basis(table.basis.data(), table.partials.data(),
+         table.points.data(), n_qp, dim, elem_order);
+   else
+      reference_basis(table.basis.data(), table.partials.data(),
+         table.points.data(), n_qp, type);
+} // end of build_face_table
+
+// tables of every local face
+void build_face_tables(
+   vector<face_table> &tables,
+   const element_type &type,
+   const quadrature_rule &rule,
+   const int &quad_order,
+   const int &elem_order){
+
+   tables.resize(num_faces(type));
+   for (int face = 0; face < num_faces(type); face++)
+      build_face_table(tables[face], type, face, rule, quad_order, elem_order);
+}
+
+// local nodes lying on a face
+void face_nodes(
+   vector<int> &nodes,
+   const element_type &type,
+   const int &face,
+   const int &elem_order){
+
+   if (face < 0 || face >= num_faces(type))
+      THROW_IMPLEMENTED_ERROR("local face out of range for this element type");
+
+   int dim = num_dim(type);
+   int dir = face/2;
+   real_t side = (face % 2 == 0) ? -1.0 : 1.0;
+
+   vector<real_t> ref_nodes;
+   reference_nodes(ref_nodes, type, elem_order);
+
+   nodes.clear();
+   int n_node = ref_nodes.size()/dim;
+   for (int node = 0; node < n_node; node++)
+      if (std::abs(ref_nodes[node*dim + dir] - side) < 1.0e-12) nodes.push_back(node);
+}
+
+// faces that belong to a single element
+void boundary_faces(
+   vector<int> &faces,
+   const element_type &type,
+   const int *connectivity,
+   const int &n_elem,
+   const int &elem_order){
+
+   int n_face = num_faces(type);
+   int n_node = num_nodes(type, elem_order);
+
+   vector< vector<int> > local(n_face);
+   for (int face = 0; face < n_face; face++)
+      face_nodes(local[face], type, face, elem_order);
+
+   // a face is identified by the sorted global ids of its nodes
+   std::map<vector<int>, int> count;
+   vector< vector<int> > keys(n_elem*n_face);
+
+   for (int elem = 0; elem < n_elem; elem++)
+      for (int face = 0; face < n_face; face++){
+         vector<int> &key = keys[elem*n_face + face];
+         for (int node : local[face]) key.push_back(connectivity[elem*n_node + node]);
+         std::sort(key.begin(), key.end());
+         count[key]++;
+      }
+
+   faces.clear();
+   for (int elem = 0; elem < n_elem; elem++)
+      for (int face = 0; face < n_face; face++)
+         if (count[keys[elem*n_face + face]] == 1){
+            faces.push_back(elem);
+            faces.push_back(face);
+         }
+} // end of boundary_faces
+
+
+// positions, outward normals and surface jacobians on a list of faces
+void evaluate_faces(
+   face_block &block,
+   const vector<face_table> &face_tables,
+   const real_t *coords,
+   const int *connectivity,
+   const int *faces,
+   const int &n_faces){
+
+   if (face_tables.empty())
+      THROW_IMPLEMENTED_ERROR("evaluate_faces needs the tables of every local face");
+
+   int n_qp = face_tables[0].n_qp;
+   int dim  = face_tables[0].dim;
+
+   block.n_faces = n_faces;
+   block.n_qp    = n_qp;
+   block.dim     = dim;
+
+   block.x_points.resize(n_faces*n_qp*dim);
+   block.normals.resize(n_faces*n_qp*dim);
+   block.det_S.resize(n_faces*n_qp);
+   block.w_det_S.resize(n_faces*n_qp);
+
+   if (dim == 2)
+      face_kernel<2>(block, face_tables, coords, connectivity, faces, n_faces);
+   else if (dim == 3)
+      face_kernel<3>(block, face_tables, coords, connectivity, faces, n_faces);
+   else
+      THROW_IMPLEMENTED_ERROR("faces are only defined in 2D and 3D");
+} // end of evaluate_faces
+
+} // end namespace elements
+} // end namespace ristra
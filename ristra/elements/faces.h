@@ -0,0 +1,122 @@
+#ifndef ELEMENTS_FACES_H
+#define ELEMENTS_FACES_H
+
+#include "ristra/elements/batched.h"
+#include "ristra/elements/quadrature.h"
+#include "ristra/elements/utilities.h"
+
+namespace ristra{
+namespace elements{
+
+/*
+ ==========================
+  Face quadrature
+ ==========================
+
+ Surface integrals over the faces of hex elements and the edges of quad
+ elements. Local face f lies on the reference plane
+
+    xi_dir = side,    dir = f/2,    side = -1 for even f, +1 for odd f
+
+ so a hex has the faces {-xi, +xi, -eta, +eta, -mu, +mu} and a quad the
+ edges {-xi, +xi, -eta, +eta}. A face_table holds a (dim - 1) tensor rule
+ mapped onto one face together with the trace of the volume basis and its
+ reference partials there, so it is built once per (type, face, rule).
+
+ On a physical face the scaled outward normal follows from Nanson's formula,
+
+    n dS = |det J| J^-1 e_dir side dA,    det_S = |n dS|/dA
+
+ with J[j][k] = dx_k/dxi_j as in jacobian.h, which stays outward for left
+ handed elements. evaluate_faces() gives positions, unit normals and
+ surface jacobians for any list of (element, face) pairs, usually the
+ boundary faces found by boundary_faces().
+
+ The mesh is given as in assembly.h, node coordinates coords[n_global][dim]
+ and connectivity[n_elem][n_node].
+*/
+
+// number of local faces (hex) or edges (quad) of an element type
+int num_faces(const element_type &type);
+
+// reference face data of one local face
+struct face_table {
+
+   element_type type;
+   quadrature_rule rule;
+
+   int face       = 0;  // local face
+   int dir        = 0;  // reference direction normal to the face
+   real_t side    = 0;  // -1 or +1, the face lies on xi_dir = side
+   int quad_order = 0;  // points per direction on the face
+   int elem_order = 0;  // element order (quadN/hexN only)
+   int n_qp   = 0;      // number of face points
+   int n_node = 0;      // nodes per element
+   int dim    = 0;      // dimension of the element
+
+   aligned_vector<real_t> points;    // [n_qp][dim], volume reference coordinates
+   aligned_vector<real_t> weights;   // [n_qp], weights of the face rule
+   aligned_vector<real_t> basis;     // [n_qp][n_node], trace of the basis
+   aligned_vector<real_t> partials;  // [n_qp][n_node][dim]
+};
+
+// builds the table of one local face
+void build_face_table(
+   face_table &table,               // table to fill
+   const element_type &type,        // element type
+   const int &face,                 // local face
+   const quadrature_rule &rule,     // quadrature rule
+   const int &quad_order,           // points per direction
+   const int &elem_order = 0);      // element order (quadN/hexN only)
+
+// tables of every local face, tables[face]
+void build_face_tables(
+   vector<face_table> &tables,      // tables [num_faces]
+   const element_type &type,        // element type
+   const quadrature_rule &rule,     // quadrature rule
+   const int &quad_order,           // points per direction
+   const int &elem_order = 0);      // element order (quadN/hexN only)
+
+// local nodes lying on a face, in increasing order
+void face_nodes(
+   vector<int> &nodes,              // local nodes on the face
+   const element_type &type,        // element type
+   const int &face,                 // local face
+   const int &elem_order = 0);      // element order (quadN/hexN only)
+
+// faces of a mesh that belong to a single element, as (element, face) pairs
+void boundary_faces(
+   vector<int> &faces,              // pairs [n_faces][2]
+   const element_type &type,        // element type
+   const int *connectivity,         // element nodes [n_elem][n_node]
+   const int &n_elem,               // number of elements
+   const int &elem_order = 0);      // element order (quadN/hexN only)
+
+
+// Results of evaluating a list of faces
+struct face_block {
+
+   int n_faces = 0;  // number of faces
+   int n_qp    = 0;  // points per face
+   int dim     = 0;  // dimension of the element
+
+   aligned_vector<real_t> x_points;  // [n_faces][n_qp][dim]
+   aligned_vector<real_t> normals;   // [n_faces][n_qp][dim], unit outward
+   aligned_vector<real_t> det_S;     // [n_faces][n_qp], surface jacobian
+   aligned_vector<real_t> w_det_S;   // [n_faces][n_qp], weight times det_S
+};
+
+// positions, outward normals and surface jacobians on a list of faces, the
+// trace basis of each face is face_tables[face].basis
+void evaluate_faces(
+   face_block &block,                       // results (resized as needed)
+   const vector<face_table> &face_tables,   // tables of every local face
+   const real_t *coords,                    // node coordinates [n_global][dim]
+   const int *connectivity,                 // element nodes [n_elem][n_node]
+   const int *faces,                        // (element, face) pairs [n_faces][2]
+   const int &n_faces);                     // number of faces
+
+} //end namespace elements
+} //end namespace ristra
+
+#endif //ELEMENTS_FACES_H
@@ -0,0 +1,135 @@
+#include <algorithm>
+
+#include "ristra/elements/geometry_cache.h"
+#include "ristra/elements/jacobian.h"
+#include "ristra/assertions/errors.h"
+
+namespace ristra {
+namespace elements{
+
+geometry_cache::geometry_cache(
+   const element_type &type,
+   const int *connectivity,
+   const int &n_elem,
+   const int &n_global,
+   const quadrature_rule &rule,
+   const int &quad_order,
+   const int &elem_order)
+   : table_(&reference_cache::instance().get(type, rule, quad_order, elem_order)),
+     connectivity_(connectivity),
+     n_elem_(n_elem),
+     n_global_(n_global),
+     n_node_(table_->n_node),
+     n_qp_(table_->n_qp),
+     dim_(table_->dim){
+
+   if (dim_ != 2 && dim_ != 3)
+      THROW_IMPLEMENTED_ERROR("the geometry cache is only defined in 2D and 3D");
+
+   dirty_.assign(n_elem_, 1);
+   version_.assign(n_elem_, 0);
+
+   det_J_.resize(n_elem_*n_qp_);
+   J_inverse_.resize(n_elem_*n_qp_*dim_*dim_);
+   weighted_det_J_.resize(n_elem_*n_qp_);
+
+   // elements around each node
+   node_ptr_.assign(n_global_ + 1, 0);
+   for (int i = 0; i < n_elem_*n_node_; i++) node_ptr_[connectivity_[i] + 1]++;
+   for (int n = 0; n < n_global_; n++) node_ptr_[n + 1] += node_ptr_[n];
+
+   node_elems_.resize(node_ptr_[n_global_]);
+   vector<int> fill(node_ptr_.begin(), node_ptr_.end() - 1);
+   for (int elem = 0; elem < n_elem_; elem++)
+      for (int node = 0; node < n_node_; node++)
+         node_elems_[fill[connectivity_[elem*n_node_ + node]]++] = elem;
+}
+
+// flag one element for recomputation
+void geometry_cache::mark_dirty(const int &elem){
+   dirty_[elem] = 1;
+}
+
+// flag every element touching a node
+void geometry_cache::mark_node_moved(const int &node){
+   for (int k = node_ptr_[node]; k < node_ptr_[node + 1]; k++)
+      dirty_[node_elems_[k]] = 1;
+}
+
+// flag every element
+void geometry_cache::mark_all_dirty(){
+   std::fill(dirty_.begin(), dirty_.end(), 1);
+}
+
+// recompute the dirty elements
+int geometry_cache::update(const real_t *coords){
+
+   vector<real_t> scratch(n_node_*dim_ + n_qp_*dim_*dim_);
+   int n_updated = 0;
+
+   for (int elem = 0; elem < n_elem_; elem++){
+      if (!dirty_[elem]) continue;
+      compute(elem, coords, scratch.data());
+      n_updated++;
+   }
+   return n_updated;
+}
+
+// recompute the dirty and the out of date elements
+int geometry_cache::update(const real_t *coords, const std::uint64_t *node_version){
+
+   vector<real_t> scratch(n_node_*dim_ + n_qp_*dim_*dim_);
+   int n_updated = 0;
+
+   for (int elem = 0; elem < n_elem_; elem++){
+      const int *elem_nodes = connectivity_ + elem*n_node_;
+
+      std::uint64_t newest = 0;
+      for (int node = 0; node < n_node_; node++)
+         newest = std::max(newest, node_version[elem_nodes[node]]);
+
+      if (newest > version_[elem]) dirty_[elem] = 1;
+      if (!dirty_[elem]) continue;
+
+      compute(elem, coords, scratch.data());
+      version_[elem] = newest;
+      n_updated++;
+   }
+   return n_updated;
+}
+
+// recompute one element
+void geometry_cache::compute(const int &elem, const real_t *coords, real_t *scratch){
+
+   const int *elem_nodes = connectivity_ + elem*n_node_;
+
+   real_t *verts = scratch;                   // [n_node][dim]
+   real_t *J = scratch + n_node_*dim_;        // [n_qp][dim][dim]
+
+   for (int node = 0; node < n_node_; node++)
+      for (int d = 0; d < dim_; d++)
+         verts[node*dim_ + d] = coords[elem_nodes[node]*dim_ + d];
+
+   real_t *det = det_J_.data() + elem*n_qp_;
+   real_t *J_inv = J_inverse_.data() + elem*n_qp_*dim_*dim_;
+
+   if (dim_ == 2)
+      batched_jacobian_kernel<2>(J, det, J_inv, verts, table_->partials.data(),
+         1, n_qp_, n_node_);
+   else
+      batched_jacobian_kernel<3>(J, det, J_inv, verts, table_->partials.data(),
+         1, n_qp_, n_node_);
+
+   real_t *w_det = weighted_det_J_.data() + elem*n_qp_;
+   for (int qp = 0; qp < n_qp_; qp++) w_det[qp] = table_->weights[qp]*det[qp];
+
+   dirty_[elem] = 0;
+}
+
+// bytes held for the geometric factors
+std::size_t geometry_cache::memory_bytes() const {
+   return (det_J_.size() + J_inverse_.size() + weighted_det_J_.size())*sizeof(real_t);
+}
+
+} // end namespace elements
+} // end namespace ristra
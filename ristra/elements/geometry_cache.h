@@ -0,0 +1,121 @@
+#ifndef ELEMENTS_GEOMETRY_CACHE_H
+#define ELEMENTS_GEOMETRY_CACHE_H
+
+#include <cstdint>
+
+#include "ristra/elements/batched.h"
+#include "ristra/elements/quadrature.h"
+#include "ristra/elements/reference_cache.h"
+#include "ristra/elements/utilities.h"
+
+namespace ristra{
+namespace elements{
+
+/*
+ ==========================
+  Geometry cache
+ ==========================
+
+ Keeps det J, J^-1 and w det J at every quadrature point of every element of
+ a mesh so repeated passes over a mesh that has not moved do no geometry
+ work. The memory held is
+
+    n_elem * n_qp * (dim*dim + 2) * sizeof(real_t)
+
+ see memory_bytes(). The mesh is given as in assembly.h, node coordinates
+ coords[n_global][dim] and connectivity[n_elem][n_node].
+
+ Elements are recomputed by update() only when stale. An element becomes
+ stale when it is marked dirty, directly or through one of its nodes, or,
+ with the versioned update(), when one of its nodes carries a version newer
+ than the one the element was last computed with. The cache starts with
+ every element dirty.
+
+ update() and the mark functions are not thread safe; the accessors are as
+ long as no update runs at the same time.
+*/
+
+class geometry_cache {
+   public:
+
+      geometry_cache(
+         const element_type &type,        // element type
+         const int *connectivity,         // element nodes [n_elem][n_node]
+         const int &n_elem,               // number of elements
+         const int &n_global,             // number of global nodes
+         const quadrature_rule &rule,     // quadrature rule
+         const int &quad_order,           // points per direction
+         const int &elem_order = 0);      // element order (quadN/hexN only)
+
+      // flag one element for recomputation
+      void mark_dirty(const int &elem);
+
+      // flag every element touching a node
+      void mark_node_moved(const int &node);
+
+      // flag every element
+      void mark_all_dirty();
+
+      bool is_dirty(const int &elem) const { return dirty_[elem] != 0; }
+
+      // recompute the dirty elements, returns how many were recomputed
+      int update(const real_t *coords);
+
+      // recompute the dirty elements and those with a node whose version is
+      // newer than the one they were computed with, returns how many were
+      // recomputed
+      int update(const real_t *coords, const std::uint64_t *node_version);
+
+      // det J at the points of an element, [n_qp]
+      const real_t *det_J(const int &elem) const {
+         return det_J_.data() + elem*n_qp_;
+      }
+
+      // J^-1 at the points of an element, [n_qp][dim][dim]
+      const real_t *J_inverse(const int &elem) const {
+         return J_inverse_.data() + elem*n_qp_*dim_*dim_;
+      }
+
+      // quadrature weight times det J at the points of an element, [n_qp]
+      const real_t *weighted_det_J(const int &elem) const {
+         return weighted_det_J_.data() + elem*n_qp_;
+      }
+
+      const reference_table &table() const { return *table_; }
+
+      int num_elements() const { return n_elem_; }
+      int num_points() const { return n_qp_; }
+      int num_dim() const { return dim_; }
+
+      // bytes held for the geometric factors
+      std::size_t memory_bytes() const;
+
+   private:
+
+      // recompute one element
+      void compute(const int &elem, const real_t *coords, real_t *scratch);
+
+      const reference_table *table_;
+      const int *connectivity_;
+
+      int n_elem_;
+      int n_global_;
+      int n_node_;
+      int n_qp_;
+      int dim_;
+
+      vector<char> dirty_;                  // [n_elem]
+      vector<std::uint64_t> version_;       // [n_elem], newest node version used
+
+      vector<int> node_ptr_;                // [n_global + 1] into node_elems_
+      vector<int> node_elems_;              // elements around each node
+
+      aligned_vector<real_t> det_J_;        // [n_elem][n_qp]
+      aligned_vector<real_t> J_inverse_;    // [n_elem][n_qp][dim][dim]
+      aligned_vector<real_t> weighted_det_J_; // [n_elem][n_qp]
+};
+
+} //end namespace elements
+} //end namespace ristra
+
+#endif //ELEMENTS_GEOMETRY_CACHE_H
@@ -0,0 +1,174 @@
+#include <cmath>
+#include <type_traits>
+
+#include "ristra/elements/gradients.h"
+#include "ristra/elements/jacobian.h"
+#include "ristra/assertions/errors.h"
+
+namespace ristra {
+namespace elements{
+
+namespace {
+
+// sizes the results of a block
+void resize(gradient_block &grads, const int &n_elem, const int &n_qp,
+   const int &n_node, const int &dim){
+
+   grads.n_elem = n_elem;
+   grads.n_qp   = n_qp;
+   grads.n_node = n_node;
+   grads.dim    = dim;
+
+   grads.B.resize(n_elem*n_qp*dim*n_node);
+   grads.w_det_J.resize(n_elem*n_qp);
+}
+
+// B and w |det J| of one element from its determinants and inverses
+template<int Dim>
+void weighted_gradients(
+   real_t *B,                  // [n_qp][Dim][n_node]
+   real_t *w_det_J,            // [n_qp]
+   const real_t *partials,     // [n_qp][n_node][Dim]
+   const real_t *det_J,        // [n_qp]
+   const real_t *J_inverse,    // [n_qp][Dim][Dim]
+   const real_t *weights,      // [n_qp]
+   const int &n_qp,
+   const int &n_node){
+
+   for (int qp = 0; qp < n_qp; qp++){
+
+      real_t scale = weights[qp]*std::abs(det_J[qp]);
+      w_det_J[qp] = scale;
+
+      // the weight is folded into J^-1 so the node loop is one multiply-add,
+      // a singular point keeps zero rows rather than inf*0
+      real_t A[Dim][Dim];
+      for (int k = 0; k < Dim; k++)
+         for (int j = 0; j < Dim; j++)
+            A[k][j] = (scale != 0.0) ? scale*J_inverse[(qp*Dim + k)*Dim + j] : 0.0;
+
+      const real_t *qp_partials = partials + qp*n_node*Dim;
+
+      for (int k = 0; k < Dim; k++){
+         real_t *row = B + (qp*Dim + k)*n_node;
+
+         for (int node = 0; node < n_node; node++){
+            real_t sum = 0.0;
+            for (int j = 0; j < Dim; j++) sum += A[k][j]*qp_partials[node*Dim + j];
+            row[node] = sum;
+         }
+      }
+   } // end for qp
+}
+
+// runs body with the dimension as a compile time constant
+template<class Body>
+void dispatch_dim(const int &dim, Body body){
+   if (dim == 2) body(std::integral_constant<int, 2>());
+   else if (dim == 3) body(std::integral_constant<int, 3>());
+   else if (dim == 4) body(std::integral_constant<int, 4>());
+   else THROW_IMPLEMENTED_ERROR("physical gradients need a dimension of 2, 3 or 4");
+}
+
+} // namespace
+
+
+// B from an evaluated block
+void build_gradients(
+   gradient_block &grads,
+   const element_block &block,
+   const real_t *weights){
+
+   int n_elem = block.n_elem;
+   int n_qp   = block.n_qp;
+   int n_node = block.n_node;
+   int dim    = block.dim;
+
+   resize(grads, n_elem, n_qp, n_node, dim);
+
+   dispatch_dim(dim, [&](auto dim_constant){
+      constexpr int Dim = decltype(dim_constant)::value;
+
+      for (int elem = 0; elem < n_elem; elem++){
+         int m = elem*n_qp;
+         weighted_gradients<Dim>(
+            grads.B.data() + m*Dim*n_node,
+            grads.w_det_J.data() + m,
+            block.partials_data(),
+            block.det_J.data() + m,
+            block.J_inverse.data() + m*Dim*Dim,
+            weights, n_qp, n_node);
+      }
+   });
+} // end of build_gradients
+
+
+// B straight from a reference table
+void build_gradients(
+   gradient_block &grads,
+   const reference_table &table,
+   const real_t *vertices,
+   const int &n_elem){
+
+   int n_qp   = table.n_qp;
+   int n_node = table.n_node;
+   int dim    = table.dim;
+
+   resize(grads, n_elem, n_qp, n_node, dim);
+
+   dispatch_dim(dim, [&](auto dim_constant){
+      constexpr int Dim = decltype(dim_constant)::value;
+
+      // jacobians of one element
+      vector<real_t> J(n_qp*Dim*Dim), det(n_qp), J_inv(n_qp*Dim*Dim);
+
+      for (int elem = 0; elem < n_elem; elem++){
+
+         batched_jacobian_kernel<Dim>(J.data(), det.data(), J_inv.data(),
+            vertices + elem*n_node*Dim, table.partials.data(), 1, n_qp, n_node);
+
+         int m = elem*n_qp;
+         weighted_gradients<Dim>(
+            grads.B.data() + m*Dim*n_node,
+            grads.w_det_J.data() + m,
+            table.partials.data(), det.data(), J_inv.data(),
+            table.weights.data(), n_qp, n_node);
+      }
+   });
+} // end of build_gradients
+
+
+// local stiffness matrix of one element
+void element_stiffness(
+   real_t *local,
+   const gradient_block &grads,
+   const int &elem){
+
+   int n_qp   = grads.n_qp;
+   int n_node = grads.n_node;
+   int dim    = grads.dim;
+
+   for (int i = 0; i < n_node*n_node; i++) local[i] = 0.0;
+
+   for (int qp = 0; qp < n_qp; qp++){
+
+      int m = elem*n_qp + qp;
+      real_t w = grads.w_det_J[m];
+      if (w == 0.0) continue;
+
+      real_t inv_w = 1.0/w;
+
+      for (int k = 0; k < dim; k++){
+         const real_t *row = grads.B.data() + (m*dim + k)*n_node;
+
+         for (int a = 0; a < n_node; a++){
+            real_t b_a = inv_w*row[a];
+            real_t *local_row = local + a*n_node;
+            for (int b = 0; b < n_node; b++) local_row[b] += b_a*row[b];
+         }
+      }
+   } // end for qp
+}
+
+} // end namespace elements
+} // end namespace ristra
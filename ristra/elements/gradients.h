@@ -0,0 +1,69 @@
+#ifndef ELEMENTS_GRADIENTS_H
+#define ELEMENTS_GRADIENTS_H
+
+#include "ristra/elements/batched.h"
+#include "ristra/elements/reference_cache.h"
+#include "ristra/elements/utilities.h"
+
+namespace ristra{
+namespace elements{
+
+/*
+ ==========================
+  Physical gradients
+ ==========================
+
+ Weighted physical basis gradients (the B matrix) of a block of elements,
+
+    B[elem][qp][k][node] = w_qp |det J| dphi_node/dx_k,
+    dphi/dx_k = sum_j J^-1[k][j] dphi/dxi_j
+
+ with J[j][k] = dx_k/dxi_j as in jacobian.h. The node index is fastest, so
+ each (qp, k) row is one contiguous stretch of n_node values, and the
+ weighted determinants w |det J| are kept next to it.
+
+ With B a local divergence or gradient operator is a single weighted sum,
+
+    G[a][(b,k)] = sum_qp phi_a B[qp][k][b]
+
+ and a local stiffness matrix is sum_qp B^T B / (w |det J|), see
+ element_stiffness(). Points with a zero determinant contribute nothing.
+*/
+
+// weighted physical gradients of a block of elements
+struct gradient_block {
+
+   int n_elem = 0;   // number of elements in the block
+   int n_qp   = 0;   // number of points per element
+   int n_node = 0;   // nodes per element
+   int dim    = 0;   // dimension
+
+   aligned_vector<real_t> B;         // [n_elem][n_qp][dim][n_node]
+   aligned_vector<real_t> w_det_J;   // [n_elem][n_qp], w |det J|
+};
+
+// B from an evaluated block and the weights of its points
+void build_gradients(
+   gradient_block &grads,            // results (resized as needed)
+   const element_block &block,       // evaluated block, dim 2, 3 or 4
+   const real_t *weights);           // quadrature weights [n_qp]
+
+// B straight from a reference table, only the jacobians of one element are
+// held at a time
+void build_gradients(
+   gradient_block &grads,            // results (resized as needed)
+   const reference_table &table,     // reference table
+   const real_t *vertices,           // element vertices [n_elem][n_node][dim]
+   const int &n_elem);               // number of elements
+
+// local stiffness (Laplacian) matrix of one element,
+// local[a][b] = sum_qp sum_k B[k][a] B[k][b]/(w |det J|)
+void element_stiffness(
+   real_t *local,                    // local matrix [n_node][n_node]
+   const gradient_block &grads,      // weighted gradients
+   const int &elem);                 // element in the block
+
+} //end namespace elements
+} //end namespace ristra
+
+#endif //ELEMENTS_GRADIENTS_H
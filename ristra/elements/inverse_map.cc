@@ -0,0 +1,275 @@
+#include <algorithm>
+#include <cmath>
+
+#include "ristra/elements/inverse_map.h"
+#include "ristra/elements/element_kernels.h"
+#include "ristra/elements/elements.h"
+#include "ristra/elements/jacobian.h"
+#include "ristra/elements/lagrange.h"
+#include "ristra/elements/node_sets.h"
+#include "ristra/assertions/errors.h"
+
+namespace ristra {
+namespace elements{
+
+namespace {
+
+const int W = inverse_map_lane_width;
+
+// Newton iteration for every point, evaluate(basis, partials, xi) gives the
+// basis [n_node] and reference partials [n_node][Dim] at one point. NumNodes
+// is the node count when known at compile time, 0 otherwise.
+template<int Dim, int NumNodes, class Evaluate>
+void newton_solve(
+   real_t *xi,
+   inverse_map_status *status,
+   int *iterations,
+   const real_t *coords,
+   const int *connectivity,
+   const real_t *x_points,
+   const int *point_elem,
+   const int &n_points,
+   const inverse_map_options &options,
+   const int &n_node,
+   Evaluate &&evaluate){
+
+   const int nn = (NumNodes > 0) ? NumNodes : n_node;
+
+   vector<real_t> verts(W*nn*Dim);     // [W][n_node][Dim]
+   vector<real_t> basis(nn);
+   vector<real_t> partials(nn*Dim);
+
+   for (int first = 0; first < n_points; first += W){
+
+      int n_lane = std::min(W, n_points - first);
+
+      real_t lane_xi[Dim][W];
+      real_t resid[Dim][W];         // x(xi) - x
+      real_t J[Dim][Dim][W];
+      real_t step[Dim][W];
+      real_t det[W];
+      bool active[W];
+      int n_iter[W];
+      inverse_map_status lane_status[W];
+
+      for (int lane = 0; lane < W; lane++){
+         active[lane] = lane < n_lane;
+         n_iter[lane] = 0;
+         lane_status[lane] = inverse_map_status::not_converged;
+         for (int d = 0; d < Dim; d++){
+            lane_xi[d][lane] = 0.0;
+            resid[d][lane] = 0.0;
+            for (int k = 0; k < Dim; k++) J[d][k][lane] = (d == k) ? 1.0 : 0.0;
+         }
+      }
+
+      for (int lane = 0; lane < n_lane; lane++){
+         int p = first + lane;
+         const int *elem_nodes = connectivity + point_elem[p]*nn;
+
+         for (int node = 0; node < nn; node++)
+            for (int d = 0; d < Dim; d++)
+               verts[(lane*nn + node)*Dim + d] = coords[elem_nodes[node]*Dim + d];
+
+         if (options.use_initial_guess)
+            for (int d = 0; d < Dim; d++) lane_xi[d][lane] = xi[p*Dim + d];
+      }
+
+      int n_active = n_lane;
+
+      for (int iter = 0; iter < options.max_iterations && n_active > 0; iter++){
+
+         // positions and jacobians of the active lanes
+         for (int lane = 0; lane < n_lane; lane++){
+            if (!active[lane]) continue;
+
+            real_t xi_point[Dim];
+            for (int d = 0; d < Dim; d++) xi_point[d] = lane_xi[d][lane];
+
+            evaluate(basis.data(), partials.data(), xi_point);
+
+            const real_t *elem_verts = verts.data() + lane*nn*Dim;
+            const real_t *target = x_points + (first + lane)*Dim;
+
+            real_t x[Dim];
+            real_t J_point[Dim][Dim];
+
+            for (int d = 0; d < Dim; d++) x[d] = 0.0;
+            for (int node = 0; node < nn; node++)
+               for (int d = 0; d < Dim; d++)
+                  x[d] += elem_verts[node*Dim + d]*basis[node];
+
+            if constexpr (NumNodes > 0)
+               jacobian_kernel<Dim, NumNodes>(J_point, elem_verts, partials.data());
+            else
+               jacobian_kernel<Dim>(J_point, elem_verts, partials.data(), nn);
+
+            for (int j = 0; j < Dim; j++){
+               resid[j][lane] = x[j] - target[j];
+               for (int k = 0; k < Dim; k++) J[j][k][lane] = J_point[j][k];
+            }
+         } // end for lane
+
+         // fixed size solves J^T dxi = resid, across every lane
+         for (int lane = 0; lane < W; lane++){
+
+            real_t J_point[Dim][Dim];
+            real_t J_inv[Dim][Dim];
+
+            for (int j = 0; j < Dim; j++)
+               for (int k = 0; k < Dim; k++) J_point[j][k] = J[j][k][lane];
+
+            det[lane] = determinant_kernel<Dim>(J_point);
+            real_t safe_det = (det[lane] != 0.0) ? det[lane] : 1.0;
+            inverse_kernel<Dim>(J_inv, J_point, safe_det);
+
+            for (int j = 0; j < Dim; j++){
+               step[j][lane] = 0.0;
+               for (int k = 0; k < Dim; k++)
+                  step[j][lane] += J_inv[k][j]*resid[k][lane];
+            }
+         } // end for lane
+
+         // updates and per lane convergence
+         for (int lane = 0; lane < n_lane; lane++){
+            if (!active[lane]) continue;
+
+            if (!(std::abs(det[lane]) > 0.0) || !std::isfinite(det[lane])){
+               lane_status[lane] = inverse_map_status::singular;
+               active[lane] = false;
+               n_active--;
+               continue;
+            }
+
+            real_t largest = 0.0;
+            for (int d = 0; d < Dim; d++){
+               lane_xi[d][lane] -= step[d][lane];
+               largest = std::max(largest, std::abs(step[d][lane]));
+            }
+            n_iter[lane]++;
+
+            if (largest <= options.tolerance){
+               lane_status[lane] = inverse_map_status::converged;
+               active[lane] = false;
+               n_active--;
+            }
+         } // end for lane
+      } // end for iter
+
+      for (int lane = 0; lane < n_lane; lane++){
+         int p = first + lane;
+         for (int d = 0; d < Dim; d++) xi[p*Dim + d] = lane_xi[d][lane];
+         status[p] = lane_status[lane];
+         if (iterations) iterations[p] = n_iter[lane];
+      }
+   } // end for first
+}
+
+// QuadN/HexN basis from the 1D Chebyshev interpolants, nodes xi fastest
+template<int Dim>
+struct lagrange_evaluator {
+
+   const node_set &nodes;
+   int N;
+   vector<real_t> val;     // [Dim][N]
+   vector<real_t> deriv;   // [Dim][N]
+
+   explicit lagrange_evaluator(const int &elem_order)
+      : nodes(get_node_set(node_spacing::chebyshev, elem_order)),
+        N(elem_order + 1), val(Dim*(elem_order + 1)), deriv(Dim*(elem_order + 1)){}
+
+   void operator()(real_t *basis, real_t *partials, const real_t *xi){
+
+      for (int d = 0; d < Dim; d++)
+         barycentric_lagrange(val.data() + d*N, deriv.data() + d*N, xi[d],
+            nodes.nodes.data(), nodes.weights.data(), N);
+
+      const real_t *v0 = val.data(),   *v1 = val.data() + N;
+      const real_t *d0 = deriv.data(), *d1 = deriv.data() + N;
+
+      if constexpr (Dim == 2){
+         for (int j = 0; j < N; j++)
+            for (int i = 0; i < N; i++){
+               int node = j*N + i;
+               basis[node] = v0[i]*v1[j];
+               partials[node*2 + 0] = d0[i]*v1[j];
+               partials[node*2 + 1] = v0[i]*d1[j];
+            }
+      }
+      else {
+         const real_t *v2 = val.data() + 2*N, *d2 = deriv.data() + 2*N;
+         for (int k = 0; k < N; k++)
+            for (int j = 0; j < N; j++)
+               for (int i = 0; i < N; i++){
+                  int node = (k*N + j)*N + i;
+                  basis[node] = v0[i]*v1[j]*v2[k];
+                  partials[node*3 + 0] = d0[i]*v1[j]*v2[k];
+                  partials[node*3 + 1] = v0[i]*d1[j]*v2[k];
+                  partials[node*3 + 2] = v0[i]*v1[j]*d2[k];
+               }
+      }
+   }
+};
+
+} // namespace
+
+
+// reference coordinates of a set of physical points
+void inverse_map(
+   real_t *xi,
+   inverse_map_status *status,
+   int *iterations,
+   const element_type &type,
+   const real_t *coords,
+   const int *connectivity,
+   const real_t *x_points,
+   const int *point_elem,
+   const int &n_points,
+   const inverse_map_options &options,
+   const int &elem_order){
+
+   if (type == element_type::quadN || type == element_type::hexN){
+
+      if (elem_order < 1)
+         THROW_IMPLEMENTED_ERROR("quadN/hexN need an element order of at least 1");
+
+      int n_node = num_nodes(type, elem_order);
+
+      if (type == element_type::quadN)
+         newton_solve<2, 0>(xi, status, iterations, coords, connectivity,
+            x_points, point_elem, n_points, options, n_node,
+            lagrange_evaluator<2>(elem_order));
+      else
+         newton_solve<3, 0>(xi, status, iterations, coords, connectivity,
+            x_points, point_elem, n_points, options, n_node,
+            lagrange_evaluator<3>(elem_order));
+      return;
+   }
+
+   visit_element_kernel(type, [&](auto kernel){
+      using Kernel = decltype(kernel);
+      constexpr int Dim = Kernel::num_dim;
+      constexpr int NumNodes = Kernel::num_nodes;
+
+      newton_solve<Dim, NumNodes>(xi, status, iterations, coords, connectivity,
+         x_points, point_elem, n_points, options, NumNodes,
+         [](real_t *basis, real_t *partials, const real_t *xi_point){
+            Kernel::basis(basis, xi_point);
+            Kernel::partials(partials, xi_point);
+         });
+   });
+} // end of inverse_map
+
+// true when xi lies in the reference element widened by tol
+bool inside_reference(
+   const real_t *xi,
+   const int &dim,
+   const real_t &tol){
+
+   for (int d = 0; d < dim; d++)
+      if (!(std::abs(xi[d]) <= 1.0 + tol)) return false;
+   return true;
+}
+
+} // end namespace elements
+} // end namespace ristra
@@ -0,0 +1,73 @@
+#ifndef ELEMENTS_INVERSE_MAP_H
+#define ELEMENTS_INVERSE_MAP_H
+
+#include "ristra/elements/batched.h"
+#include "ristra/elements/utilities.h"
+
+namespace ristra{
+namespace elements{
+
+/*
+ ==========================
+  Inverse isoparametric map
+ ==========================
+
+ Finds the reference coordinates xi of physical points x, each in a known
+ element, by Newton's method on
+
+    x(xi) - x = 0,    J^T dxi = x(xi) - x,    xi <- xi - dxi
+
+ with J[j][k] = dx_k/dxi_j as in jacobian.h. Points are processed in lanes
+ of lane_width: the positions and jacobians of the active lanes are
+ evaluated, then the fixed size determinants, inverses and updates of all
+ lanes are taken in one loop. A lane stops as soon as its point converges
+ or its jacobian is singular, and a block ends when no lane is active.
+
+ Fixed order elements use the static kernels of element_kernels.h. For
+ QuadN/HexN the Chebyshev nodes and barycentric weights come from the node
+ set cache and the tensor product basis is formed from 1D evaluations.
+
+ The mesh is given as in assembly.h, node coordinates coords[n_global][dim]
+ and connectivity[n_elem][n_node].
+*/
+
+// outcome of the inverse map of one point
+enum class inverse_map_status {
+   converged,        // the last update was below the tolerance
+   not_converged,    // max_iterations reached
+   singular          // the jacobian vanished during the iteration
+};
+
+struct inverse_map_options {
+   int max_iterations = 20;         // Newton iterations per point
+   real_t tolerance = 1.0e-12;      // on the largest component of dxi
+   bool use_initial_guess = false;  // start from xi rather than the centre
+};
+
+// points per lane block in inverse_map()
+constexpr int inverse_map_lane_width = 8;
+
+// reference coordinates of a set of physical points
+void inverse_map(
+   real_t *xi,                          // reference coordinates [n_points][dim]
+   inverse_map_status *status,          // outcome [n_points]
+   int *iterations,                     // Newton iterations [n_points] or null
+   const element_type &type,            // element type
+   const real_t *coords,                // node coordinates [n_global][dim]
+   const int *connectivity,             // element nodes [n_elem][n_node]
+   const real_t *x_points,              // physical points [n_points][dim]
+   const int *point_elem,               // element of each point [n_points]
+   const int &n_points,                 // number of points
+   const inverse_map_options &options = inverse_map_options(),
+   const int &elem_order = 0);          // element order (quadN/hexN only)
+
+// true when xi lies in the reference element [-1, 1]^dim widened by tol
+bool inside_reference(
+   const real_t *xi,                    // reference coordinates [dim]
+   const int &dim,                      // dimension
+   const real_t &tol = 0.0);            // allowed overshoot
+
+} //end namespace elements
+} //end namespace ristra
+
+#endif //ELEMENTS_INVERSE_MAP_H
@@ -0,0 +1,281 @@
+#ifndef ELEMENTS_JACOBIAN_H
+#define ELEMENTS_JACOBIAN_H
+
+#include "ristra/elements/utilities.h"
+
+namespace ristra{
+namespace elements{
+
+/*
+ ==========================
+  Jacobian kernels
+ ==========================
+
+ Fixed size Jacobian, determinant and inverse kernels. The dimension (and
+ optionally the node count) are template parameters so every loop has a
+ compile time trip count, the matrices live in registers and nothing is
+ allocated. The convention is the one used by jacobian(),
+
+    J[j][k] = sum_node vertices[node][k] * partials[node][j]
+
+ with vertices[n_node][Dim] and partials[n_node][Dim] stored row major.
+
+ The kernels are also templated on the scalar types: vertices and partials
+ are read as Storage and J, det J and J^-1 are formed in Accum, so float
+ tables can be accumulated in double (see precision_policy).
+*/
+
+// jacobian of one point, node count known at compile time
+template<int Dim, int NumNodes, class Accum, class Storage>
+inline void jacobian_kernel(
+   Accum (&J)[Dim][Dim],            // jacobian
+   const Storage *vertices,         // element vertices [NumNodes][Dim]
+   const Storage *partials){        // reference partials [NumNodes][Dim]
+
+   for (int j = 0; j < Dim; j++)
+      for (int k = 0; k < Dim; k++)
+         J[j][k] = 0.0;
+
+   for (int node = 0; node < NumNodes; node++){
+      for (int j = 0; j < Dim; j++){
+         for (int k = 0; k < Dim; k++){
+            J[j][k] += Accum(vertices[node*Dim + k])*Accum(partials[node*Dim + j]);
+         } // end for k
+      } // end for j
+   } // end for node
+}
+
+// jacobian of one point, node count known at run time
+template<int Dim, class Accum, class Storage>
+inline void jacobian_kernel(
+   Accum (&J)[Dim][Dim],            // jacobian
+   const Storage *vertices,         // element vertices [num_nodes][Dim]
+   const Storage *partials,         // reference partials [num_nodes][Dim]
+   const int &num_nodes){           // nodes per element
+
+   for (int j = 0; j < Dim; j++)
+      for (int k = 0; k < Dim; k++)
+         J[j][k] = 0.0;
+
+   for (int node = 0; node < num_nodes; node++){
+      for (int j = 0; j < Dim; j++){
+         for (int k = 0; k < Dim; k++){
+            J[j][k] += Accum(vertices[node*Dim + k])*Accum(partials[node*Dim + j]);
+         } // end for k
+      } // end for j
+   } // end for node
+}
+
+// 2x2 minors of a 4x4 matrix, s from rows 0-1 on columns {01, 02, 03, 12,
+// 13, 23} and c from rows 2-3 on the complementary columns {23, 13, 12, 03,
+// 02, 01}, so det = s0 c0 - s1 c1 + s2 c2 + s3 c3 - s4 c4 + s5 c5 and every
+// cofactor is a three term combination of them
+template<class T>
+inline void minors_4x4(T (&s)[6], T (&c)[6], const T (&J)[4][4]){
+
+   s[0] = J[0][0]*J[1][1] - J[1][0]*J[0][1];
+   s[1] = J[0][0]*J[1][2] - J[1][0]*J[0][2];
+   s[2] = J[0][0]*J[1][3] - J[1][0]*J[0][3];
+   s[3] = J[0][1]*J[1][2] - J[1][1]*J[0][2];
+   s[4] = J[0][1]*J[1][3] - J[1][1]*J[0][3];
+   s[5] = J[0][2]*J[1][3] - J[1][2]*J[0][3];
+
+   c[0] = J[2][2]*J[3][3] - J[3][2]*J[2][3];
+   c[1] = J[2][1]*J[3][3] - J[3][1]*J[2][3];
+   c[2] = J[2][1]*J[3][2] - J[3][1]*J[2][2];
+   c[3] = J[2][0]*J[3][3] - J[3][0]*J[2][3];
+   c[4] = J[2][0]*J[3][2] - J[3][0]*J[2][2];
+   c[5] = J[2][0]*J[3][1] - J[3][0]*J[2][1];
+}
+
+// determinant of a Dim x Dim matrix
+template<int Dim, class T>
+inline T determinant_kernel(const T (&J)[Dim][Dim]){
+
+   static_assert(Dim >= 2 && Dim <= 4, "determinant_kernel is defined in 2D to 4D");
+
+   if constexpr (Dim == 2){
+      return J[0][0]*J[1][1] - J[0][1]*J[1][0];
+   }
+   else if constexpr (Dim == 3){
+      return J[0][0]*(J[1][1]*J[2][2] - J[1][2]*J[2][1])
+           - J[0][1]*(J[1][0]*J[2][2] - J[1][2]*J[2][0])
+           + J[0][2]*(J[1][0]*J[2][1] - J[1][1]*J[2][0]);
+   }
+   else {
+      T s[6], c[6];
+      minors_4x4(s, c, J);
+      return s[0]*c[0] - s[1]*c[1] + s[2]*c[2] + s[3]*c[3] - s[4]*c[4] + s[5]*c[5];
+   }
+}
+
+// inverse of a Dim x Dim matrix given its determinant
+template<int Dim, class T>
+inline void inverse_kernel(
+   T (&J_inverse)[Dim][Dim],
+   const T (&J)[Dim][Dim],
+   const no_deduce<T> &det_J){
+
+   static_assert(Dim >= 2 && Dim <= 4, "inverse_kernel is defined in 2D to 4D");
+
+   T inv_det = T(1.0)/det_J;
+
+   if constexpr (Dim == 2){
+      J_inverse[0][0] =  J[1][1]*inv_det;
+      J_inverse[0][1] = -J[0][1]*inv_det;
+      J_inverse[1][0] = -J[1][0]*inv_det;
+      J_inverse[1][1] =  J[0][0]*inv_det;
+   }
+   else if constexpr (Dim == 3){
+      // transposed cofactors
+      J_inverse[0][0] = (J[1][1]*J[2][2] - J[1][2]*J[2][1])*inv_det;
+      J_inverse[0][1] = (J[0][2]*J[2][1] - J[0][1]*J[2][2])*inv_det;
+      J_inverse[0][2] = (J[0][1]*J[1][2] - J[0][2]*J[1][1])*inv_det;
+      J_inverse[1][0] = (J[1][2]*J[2][0] - J[1][0]*J[2][2])*inv_det;
+      J_inverse[1][1] = (J[0][0]*J[2][2] - J[0][2]*J[2][0])*inv_det;
+      J_inverse[1][2] = (J[0][2]*J[1][0] - J[0][0]*J[1][2])*inv_det;
+      J_inverse[2][0] = (J[1][0]*J[2][1] - J[1][1]*J[2][0])*inv_det;
+      J_inverse[2][1] = (J[0][1]*J[2][0] - J[0][0]*J[2][1])*inv_det;
+      J_inverse[2][2] = (J[0][0]*J[1][1] - J[0][1]*J[1][0])*inv_det;
+   }
+   else {
+      // transposed cofactors, each a combination of the shared 2x2 minors
+      T s[6], c[6];
+      minors_4x4(s, c, J);
+
+      J_inverse[0][0] = ( J[1][1]*c[0] - J[1][2]*c[1] + J[1][3]*c[2])*inv_det;
+      J_inverse[0][1] = (-J[0][1]*c[0] + J[0][2]*c[1] - J[0][3]*c[2])*inv_det;
+      J_inverse[0][2] = ( J[3][1]*s[5] - J[3][2]*s[4] + J[3][3]*s[3])*inv_det;
+      J_inverse[0][3] = (-J[2][1]*s[5] + J[2][2]*s[4] - J[2][3]*s[3])*inv_det;
+
+      J_inverse[1][0] = (-J[1][0]*c[0] + J[1][2]*c[3] - J[1][3]*c[4])*inv_det;
+      J_inverse[1][1] = ( J[0][0]*c[0] - J[0][2]*c[3] + J[0][3]*c[4])*inv_det;
+      J_inverse[1][2] = (-J[3][0]*s[5] + J[3][2]*s[2] - J[3][3]*s[1])*inv_det;
+      J_inverse[1][3] = ( J[2][0]*s[5] - J[2][2]*s[2] + J[2][3]*s[1])*inv_det;
+
+      J_inverse[2][0] = ( J[1][0]*c[1] - J[1][1]*c[3] + J[1][3]*c[5])*inv_det;
+      J_inverse[2][1] = (-J[0][0]*c[1] + J[0][1]*c[3] - J[0][3]*c[5])*inv_det;
+      J_inverse[2][2] = ( J[3][0]*s[4] - J[3][1]*s[2] + J[3][3]*s[0])*inv_det;
+      J_inverse[2][3] = (-J[2][0]*s[4] + J[2][1]*s[2] - J[2][3]*s[0])*inv_det;
+
+      J_inverse[3][0] = (-J[1][0]*c[2] + J[1][1]*c[4] - J[1][2]*c[5])*inv_det;
+      J_inverse[3][1] = ( J[0][0]*c[2] - J[0][1]*c[4] + J[0][2]*c[5])*inv_det;
+      J_inverse[3][2] = (-J[3][0]*s[3] + J[3][1]*s[1] - J[3][2]*s[0])*inv_det;
+      J_inverse[3][3] = ( J[2][0]*s[3] - J[2][1]*s[1] + J[2][2]*s[0])*inv_det;
+   }
+}
+
+
+// jacobians, determinants and (optionally) inverses at every point of a
+// block of elements, see batched_jacobian for the layouts. J_inverse may be
+// null when only J and det J are wanted.
+template<int Dim, int NumNodes, class Accum, class Storage>
+void batched_jacobian_kernel(
+   Accum *J_matrix,                 // jacobians [n_elem][n_qp][Dim][Dim]
+   no_deduce<Accum> *det_J,         // determinants [n_elem][n_qp]
+   no_deduce<Accum> *J_inverse,     // inverses [n_elem][n_qp][Dim][Dim] or null
+   const Storage *vertices,         // element vertices [n_elem][NumNodes][Dim]
+   const no_deduce<Storage> *partials, // reference partials [n_qp][NumNodes][Dim]
+   const int &n_elem,               // number of elements
+   const int &n_qp){                // number of points
+
+   for (int elem = 0; elem < n_elem; elem++){
+
+      const Storage *elem_verts = vertices + elem*NumNodes*Dim;
+
+      for (int qp = 0; qp < n_qp; qp++){
+
+         int m = elem*n_qp + qp;
+         Accum J[Dim][Dim];
+
+         jacobian_kernel<Dim, NumNodes>(J, elem_verts,
+            partials + qp*NumNodes*Dim);
+
+         Accum det = determinant_kernel<Dim>(J);
+         det_J[m] = det;
+
+         for (int j = 0; j < Dim; j++)
+            for (int k = 0; k < Dim; k++)
+               J_matrix[(m*Dim + j)*Dim + k] = J[j][k];
+
+         if (J_inverse){
+            Accum J_inv[Dim][Dim];
+            inverse_kernel<Dim>(J_inv, J, det);
+
+            for (int j = 0; j < Dim; j++)
+               for (int k = 0; k < Dim; k++)
+                  J_inverse[(m*Dim + j)*Dim + k] = J_inv[j][k];
+         }
+      } // end for qp
+   } // end for elem
+}
+
+// as above with the node count known at run time
+template<int Dim, class Accum, class Storage>
+void batched_jacobian_kernel(
+   Accum *J_matrix,                 // jacobians [n_elem][n_qp][Dim][Dim]
+   no_deduce<Accum> *det_J,         // determinants [n_elem][n_qp]
+   no_deduce<Accum> *J_inverse,     // inverses [n_elem][n_qp][Dim][Dim] or null
+   const Storage *vertices,         // element vertices [n_elem][n_node][Dim]
+   const no_deduce<Storage> *partials, // reference partials [n_qp][n_node][Dim]
+   const int &n_elem,               // number of elements
+   const int &n_qp,                 // number of points
+   const int &n_node){              // nodes per element
+
+   for (int elem = 0; elem < n_elem; elem++){
+
+      const Storage *elem_verts = vertices + elem*n_node*Dim;
+
+      for (int qp = 0; qp < n_qp; qp++){
+
+         int m = elem*n_qp + qp;
+         Accum J[Dim][Dim];
+
+         jacobian_kernel<Dim>(J, elem_verts, partials + qp*n_node*Dim, n_node);
+
+         Accum det = determinant_kernel<Dim>(J);
+         det_J[m] = det;
+
+         for (int j = 0; j < Dim; j++)
+            for (int k = 0; k < Dim; k++)
+               J_matrix[(m*Dim + j)*Dim + k] = J[j][k];
+
+         if (J_inverse){
+            Accum J_inv[Dim][Dim];
+            inverse_kernel<Dim>(J_inv, J, det);
+
+            for (int j = 0; j < Dim; j++)
+               for (int k = 0; k < Dim; k++)
+                  J_inverse[(m*Dim + j)*Dim + k] = J_inv[j][k];
+         }
+      } // end for qp
+   } // end for elem
+}
+
+// inverses of a set of Dim x Dim matrices given their determinants
+template<int Dim, class T>
+void batched_inverse_kernel(
+   T *J_inverse,                    // inverses [n_mat][Dim][Dim]
+   const no_deduce<T> *J_matrix,    // matrices [n_mat][Dim][Dim]
+   const no_deduce<T> *det_J,       // determinants [n_mat]
+   const int &n_mat){               // number of matrices
+
+   for (int m = 0; m < n_mat; m++){
+      T J[Dim][Dim], J_inv[Dim][Dim];
+
+      for (int j = 0; j < Dim; j++)
+         for (int k = 0; k < Dim; k++)
+            J[j][k] = J_matrix[(m*Dim + j)*Dim + k];
+
+      inverse_kernel<Dim>(J_inv, J, det_J[m]);
+
+      for (int j = 0; j < Dim; j++)
+         for (int k = 0; k < Dim; k++)
+            J_inverse[(m*Dim + j)*Dim + k] = J_inv[j][k];
+   } // end for m
+}
+
+} //end namespace elements
+} //end namespace ristra
+
+#endif //ELEMENTS_JACOBIAN_H
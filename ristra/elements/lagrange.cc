@@ -0,0 +1,130 @@
+#include <cmath>
+
+#include "ristra/elements/lagrange.h"
+
+namespace ristra {
+namespace elements{
+
+namespace {
+
+// barycentric weight of node i
+inline real_t weight_of(const real_t *nodes, const int &num_nodes, const int &i){
+
+   real_t prod = 1.0;
+   for (int j = 0; j < num_nodes; j++){
+      if (j != i) prod *= (nodes[i] - nodes[j]);
+   }
+   return 1.0/prod;
+}
+
+} // namespace
+
+
+// barycentric weights of a node set
+void barycentric_weights(
+   real_t *weights,
+   const real_t *nodes,
+   const int &num_nodes){
+
+   for (int i = 0; i < num_nodes; i++){
+      weights[i] = weight_of(nodes, num_nodes, i);
+   }
+}
+
+// values and derivatives of every interpolant at x
+void barycentric_lagrange(
+   real_t *val,
+   real_t *deriv,
+   const real_t &x,
+   const real_t *nodes,
+   const real_t *weights,
+   const int &num_nodes){
+
+   // node closest to x
+   int k = 0;
+   for (int j = 1; j < num_nodes; j++){
+      if (std::abs(x - nodes[j]) < std::abs(x - nodes[k])) k = j;
+   }
+
+   // prod and sum of 1/(x - x_j) over j != k
+   real_t ell_k = 1.0;
+   real_t R_k = 0.0;
+   for (int j = 0; j < num_nodes; j++){
+      if (j == k) continue;
+      real_t dx = x - nodes[j];
+      ell_k *= dx;
+      R_k += 1.0/dx;
+   }
+
+   real_t dx_k = x - nodes[k];
+
+   for (int i = 0; i < num_nodes; i++){
+
+      real_t w_i = weights ? weights[i] : weight_of(nodes, num_nodes, i);
+
+      if (i == k){
+         val[i]   = w_i*ell_k;
+         deriv[i] = val[i]*R_k;
+      }
+      else {
+         real_t inv_dx_i = 1.0/(x - nodes[i]);
+         real_t L_i = w_i*ell_k*inv_dx_i;
+
+         val[i]   = L_i*dx_k;
+         deriv[i] = L_i*(dx_k*(R_k - inv_dx_i) + 1.0);
+      }
+   } // end for i
+}
+
+// values and derivatives of every interpolant at a set of points
+void barycentric_lagrange(
+   real_t *val,
+   real_t *deriv,
+   const real_t *x,
+   const int &num_x,
+   const real_t *nodes,
+   const real_t *weights,
+   const int &num_nodes){
+
+   for (int p = 0; p < num_x; p++){
+      barycentric_lagrange(val + p*num_nodes, deriv + p*num_nodes, x[p],
+         nodes, weights, num_nodes);
+   }
+}
+
+
+lagrange_1d::lagrange_1d(const real_t *nodes, const int &num_nodes){
+   set_nodes(nodes, num_nodes);
+}
+
+// replace the node set and recompute the weights
+void lagrange_1d::set_nodes(const real_t *nodes, const int &num_nodes){
+
+   nodes_.assign(nodes, nodes + num_nodes);
+   weights_.resize(num_nodes);
+   barycentric_weights(weights_.data(), nodes_.data(), num_nodes);
+}
+
+// values and derivatives at one point
+void lagrange_1d::evaluate(
+   real_t *val,
+   real_t *deriv,
+   const real_t &x) const {
+
+   barycentric_lagrange(val, deriv, x, nodes_.data(), weights_.data(),
+      num_nodes());
+}
+
+// values and derivatives at a set of points
+void lagrange_1d::evaluate(
+   real_t *val,
+   real_t *deriv,
+   const real_t *x,
+   const int &num_x) const {
+
+   barycentric_lagrange(val, deriv, x, num_x, nodes_.data(), weights_.data(),
+      num_nodes());
+}
+
+} // end namespace elements
+} // end namespace ristra
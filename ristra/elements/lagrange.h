@@ -0,0 +1,93 @@
+#ifndef ELEMENTS_LAGRANGE_H
+#define ELEMENTS_LAGRANGE_H
+
+#include "ristra/elements/utilities.h"
+
+namespace ristra{
+namespace elements{
+
+/*
+ ==========================
+  Barycentric Lagrange
+ ==========================
+
+ 1D Lagrange interpolants in barycentric form. With the weights
+
+    w_i = 1 / prod_{j != i} (x_i - x_j)
+
+ every interpolant and its derivative at a point x is found in O(N) work.
+ The products are taken relative to the node k closest to x,
+
+    l_k(x) = w_k prod_{j != k} (x - x_j)
+    l_i(x) = w_i prod_{j != k} (x - x_j) (x - x_k) / (x - x_i),   i != k
+
+ so nothing is divided by (x - x_k) and x may sit exactly on a node.
+*/
+
+// barycentric weights of a node set
+void barycentric_weights(
+   real_t *weights,                 // weights [num_nodes]
+   const real_t *nodes,             // nodes [num_nodes]
+   const int &num_nodes);           // number of nodes
+
+// values and derivatives of every interpolant at x, when weights is null
+// they are formed on the fly at O(N^2) cost, still without allocating
+void barycentric_lagrange(
+   real_t *val,                     // values [num_nodes]
+   real_t *deriv,                   // derivatives [num_nodes]
+   const real_t &x,                 // point of interest
+   const real_t *nodes,             // nodes [num_nodes]
+   const real_t *weights,           // weights [num_nodes] or nullptr
+   const int &num_nodes);           // number of nodes
+
+// values and derivatives of every interpolant at a set of points
+void barycentric_lagrange(
+   real_t *val,                     // values [num_x][num_nodes]
+   real_t *deriv,                   // derivatives [num_x][num_nodes]
+   const real_t *x,                 // points of interest [num_x]
+   const int &num_x,                // number of points
+   const real_t *nodes,             // nodes [num_nodes]
+   const real_t *weights,           // weights [num_nodes]
+   const int &num_nodes);           // number of nodes
+
+
+// a node set with its barycentric weights computed once
+class lagrange_1d {
+   public:
+
+      lagrange_1d() = default;
+
+      lagrange_1d(const real_t *nodes, const int &num_nodes);
+
+      // replace the node set and recompute the weights
+      void set_nodes(const real_t *nodes, const int &num_nodes);
+
+      int num_nodes() const { return static_cast<int>(nodes_.size()); }
+
+      const real_t *nodes() const { return nodes_.data(); }
+
+      const real_t *weights() const { return weights_.data(); }
+
+      // values and derivatives at one point
+      void evaluate(
+         real_t *val,               // values [num_nodes]
+         real_t *deriv,             // derivatives [num_nodes]
+         const real_t &x) const;    // point of interest
+
+      // values and derivatives at a set of points
+      void evaluate(
+         real_t *val,               // values [num_x][num_nodes]
+         real_t *deriv,             // derivatives [num_x][num_nodes]
+         const real_t *x,           // points of interest [num_x]
+         const int &num_x) const;   // number of points
+
+   private:
+
+      aligned_vector<real_t> nodes_;
+      aligned_vector<real_t> weights_;
+};
+
+} //end namespace elements
+} //end namespace ristra
+
+#endif //ELEMENTS_LAGRANGE_H
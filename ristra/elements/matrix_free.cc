@@ -0,0 +1,206 @@
+#include <algorithm>
+#include <cmath>
+
+#include "ristra/elements/matrix_free.h"
+#include "ristra/elements/jacobian.h"
+#include "ristra/assertions/errors.h"
+
+namespace ristra {
+namespace elements{
+
+namespace {
+
+// D = w |det J| J^-T J^-1 at every point of one element, packed
+template<int Dim>
+void geometric_factors(
+   real_t *factors,
+   const reference_table &table,
+   const real_t *verts){
+
+   for (int qp = 0; qp < table.n_qp; qp++){
+
+      real_t J[Dim][Dim], J_inv[Dim][Dim];
+      jacobian_kernel<Dim>(J, verts, table.partials.data() + qp*table.n_node*Dim,
+         table.n_node);
+      real_t det = determinant_kernel<Dim>(J);
+      inverse_kernel<Dim>(J_inv, J, det);
+
+      real_t w = table.weights[qp]*std::abs(det);
+
+      // grad_x = J^-1 grad_xi, so grad_x.grad_x = grad_xi^T J^-T J^-1 grad_xi
+      int s = 0;
+      for (int i = 0; i < Dim; i++){
+         for (int j = i; j < Dim; j++){
+            real_t sum = 0.0;
+            for (int k = 0; k < Dim; k++) sum += J_inv[k][i]*J_inv[k][j];
+            factors[qp*(Dim*(Dim + 1)/2) + s++] = w*sum;
+         }
+      }
+   } // end for qp
+}
+
+// f = D g at every point of a block of elements
+template<int Dim>
+void apply_factors(
+   real_t *f_qp,
+   const real_t *grad_qp,
+   const real_t *factors,
+   const int &n_points){
+
+   const int n_sym = Dim*(Dim + 1)/2;
+
+   for (int p = 0; p < n_points; p++){
+      const real_t *D = factors + p*n_sym;
+      const real_t *g = grad_qp + p*Dim;
+      real_t *f = f_qp + p*Dim;
+
+      if constexpr (Dim == 2){
+         f[0] = D[0]*g[0] + D[1]*g[1];
+         f[1] = D[1]*g[0] + D[2]*g[1];
+      }
+      else {
+         f[0] = D[0]*g[0] + D[1]*g[1] + D[2]*g[2];
+         f[1] = D[1]*g[0] + D[3]*g[1] + D[4]*g[2];
+         f[2] = D[2]*g[0] + D[4]*g[1] + D[5]*g[2];
+      }
+   } // end for p
+}
+
+} // namespace
+
+
+stiffness_operator::stiffness_operator(
+   const element_type &type,
+   const real_t *coords,
+   const int &n_global,
+   const int *connectivity,
+   const int &n_elem,
+   const quadrature_rule &rule,
+   const int &quad_order,
+   const int &elem_order)
+   : table_(&reference_cache::instance().get(type, rule, quad_order, elem_order)),
+     connectivity_(connectivity),
+     n_global_(n_global),
+     n_elem_(n_elem),
+     n_node_(table_->n_node),
+     n_qp_(table_->n_qp),
+     dim_(table_->dim),
+     n_sym_(dim_*(dim_ + 1)/2){
+
+   if (dim_ != 2 && dim_ != 3)
+      THROW_IMPLEMENTED_ERROR("matrix-free operators are only defined in 2D and 3D");
+
+   tensor_ = (type == element_type::quadN || type == element_type::hexN);
+   if (tensor_) build_tensor_basis_1d(basis_1d_, elem_order, rule, quad_order);
+
+   factors_.resize(n_elem_*n_qp_*n_sym_);
+
+   vector<real_t> verts(n_node_*dim_);
+   for (int elem = 0; elem < n_elem_; elem++){
+      const int *elem_nodes = connectivity_ + elem*n_node_;
+
+      for (int node = 0; node < n_node_; node++)
+         for (int d = 0; d < dim_; d++)
+            verts[node*dim_ + d] = coords[elem_nodes[node]*dim_ + d];
+
+      real_t *elem_factors = factors_.data() + elem*n_qp_*n_sym_;
+      if (dim_ == 2) geometric_factors<2>(elem_factors, *table_, verts.data());
+      else geometric_factors<3>(elem_factors, *table_, verts.data());
+   } // end for elem
+}
+
+// reference gradients of a block of element vectors
+void stiffness_operator::gradient(
+   real_t *grad_qp,
+   const real_t *u,
+   const int &n) const {
+
+   if (tensor_){
+      if (dim_ == 2) gradient_2d(grad_qp, u, basis_1d_, n);
+      else gradient_3d(grad_qp, u, basis_1d_, n);
+      return;
+   }
+
+   const real_t *partials = table_->partials.data();
+
+   for (int e = 0; e < n; e++){
+      const real_t *u_e = u + e*n_node_;
+
+      for (int qp = 0; qp < n_qp_; qp++){
+         const real_t *p_qp = partials + qp*n_node_*dim_;
+         real_t *g = grad_qp + (e*n_qp_ + qp)*dim_;
+
+         for (int d = 0; d < dim_; d++) g[d] = 0.0;
+
+         for (int node = 0; node < n_node_; node++)
+            for (int d = 0; d < dim_; d++)
+               g[d] += p_qp[node*dim_ + d]*u_e[node];
+      } // end for qp
+   } // end for e
+}
+
+// transpose of gradient
+void stiffness_operator::integrate_gradient(
+   real_t *r,
+   const real_t *f_qp,
+   const int &n) const {
+
+   if (tensor_){
+      if (dim_ == 2) integrate_gradient_2d(r, f_qp, basis_1d_, n);
+      else integrate_gradient_3d(r, f_qp, basis_1d_, n);
+      return;
+   }
+
+   const real_t *partials = table_->partials.data();
+
+   for (int e = 0; e < n; e++){
+      real_t *r_e = r + e*n_node_;
+
+      for (int node = 0; node < n_node_; node++) r_e[node] = 0.0;
+
+      for (int qp = 0; qp < n_qp_; qp++){
+         const real_t *p_qp = partials + qp*n_node_*dim_;
+         const real_t *f = f_qp + (e*n_qp_ + qp)*dim_;
+
+         for (int node = 0; node < n_node_; node++){
+            real_t sum = 0.0;
+            for (int d = 0; d < dim_; d++) sum += p_qp[node*dim_ + d]*f[d];
+            r_e[node] += sum;
+         }
+      } // end for qp
+   } // end for e
+}
+
+// y = K x
+void stiffness_operator::apply(real_t *y, const real_t *x) const {
+
+   vector<real_t> u(block_size*n_node_);
+   vector<real_t> r(block_size*n_node_);
+   vector<real_t> grad_qp(block_size*n_qp_*dim_);
+   vector<real_t> f_qp(block_size*n_qp_*dim_);
+
+   for (int i = 0; i < n_global_; i++) y[i] = 0.0;
+
+   for (int first = 0; first < n_elem_; first += block_size){
+
+      int n = std::min(block_size, n_elem_ - first);
+      const int *block_nodes = connectivity_ + first*n_node_;
+
+      // gather
+      for (int i = 0; i < n*n_node_; i++) u[i] = x[block_nodes[i]];
+
+      gradient(grad_qp.data(), u.data(), n);
+
+      const real_t *factors = factors_.data() + first*n_qp_*n_sym_;
+      if (dim_ == 2) apply_factors<2>(f_qp.data(), grad_qp.data(), factors, n*n_qp_);
+      else apply_factors<3>(f_qp.data(), grad_qp.data(), factors, n*n_qp_);
+
+      integrate_gradient(r.data(), f_qp.data(), n);
+
+      // scatter
+      for (int i = 0; i < n*n_node_; i++) y[block_nodes[i]] += r[i];
+   } // end for first
+}
+
+} // end namespace elements
+} // end namespace ristra
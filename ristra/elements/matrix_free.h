@@ -0,0 +1,93 @@
+#ifndef ELEMENTS_MATRIX_FREE_H
+#define ELEMENTS_MATRIX_FREE_H
+
+#include "ristra/elements/batched.h"
+#include "ristra/elements/quadrature.h"
+#include "ristra/elements/reference_cache.h"
+#include "ristra/elements/sum_factorization.h"
+#include "ristra/elements/utilities.h"
+
+namespace ristra{
+namespace elements{
+
+/*
+ ==========================
+  Matrix-free operators
+ ==========================
+
+ Applies the stiffness (Laplacian) operator of assembly.h, y = K x, element
+ by element without forming K. At every quadrature point only the symmetric
+ geometric factor
+
+    D = w |det J| J^-T J^-1
+
+ is stored, packed as {00, 01, 11} in 2D and {00, 01, 02, 11, 12, 22} in
+ 3D. An application gathers the element values, takes their reference
+ gradients, multiplies by D and applies the transposed gradient,
+
+    y_e = G^T D G x_e
+
+ QuadN/HexN use the sum factorization kernels for G and G^T, the other
+ element types the dense reference partial tables. Elements are processed
+ in blocks so the element vectors stay in cache.
+
+ The mesh is given as in assembly.h, node coordinates coords[n_global][dim]
+ and connectivity[n_elem][n_node]. The connectivity is not copied.
+*/
+
+class stiffness_operator {
+   public:
+
+      stiffness_operator(
+         const element_type &type,        // element type
+         const real_t *coords,            // node coordinates [n_global][dim]
+         const int &n_global,             // number of global nodes
+         const int *connectivity,         // element nodes [n_elem][n_node]
+         const int &n_elem,               // number of elements
+         const quadrature_rule &rule,     // quadrature rule
+         const int &quad_order,           // points per direction
+         const int &elem_order = 0);      // element order (quadN/hexN only)
+
+      // y = K x, y and x are [n_global]
+      void apply(real_t *y, const real_t *x) const;
+
+      int num_dofs() const { return n_global_; }
+      int num_elements() const { return n_elem_; }
+
+      // true when the tensor product kernels are used
+      bool sum_factorized() const { return tensor_; }
+
+      // bytes held for the geometric factors
+      std::size_t factor_bytes() const { return factors_.size()*sizeof(real_t); }
+
+      // elements per block in apply()
+      static constexpr int block_size = 64;
+
+   private:
+
+      // reference gradients of a block of element vectors, [n][n_qp][dim]
+      void gradient(real_t *grad_qp, const real_t *u, const int &n) const;
+
+      // transpose of gradient
+      void integrate_gradient(real_t *r, const real_t *f_qp, const int &n) const;
+
+      const reference_table *table_;
+      const int *connectivity_;
+
+      int n_global_;
+      int n_elem_;
+      int n_node_;
+      int n_qp_;
+      int dim_;
+      int n_sym_;                        // stored entries of D per point
+
+      bool tensor_ = false;
+      tensor_basis_1d basis_1d_;
+
+      aligned_vector<real_t> factors_;   // [n_elem][n_qp][n_sym]
+};
+
+} //end namespace elements
+} //end namespace ristra
+
+#endif //ELEMENTS_MATRIX_FREE_H
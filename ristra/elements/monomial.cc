@@ -0,0 +1,250 @@
+#include <algorithm>
+#include <cmath>
+
+#include "ristra/elements/monomial.h"
+#include "ristra/elements/element_kernels.h"
+#include "ristra/assertions/errors.h"
+
+namespace ristra {
+namespace elements{
+
+namespace {
+
+// largest superlinear degree of the space spanned by an element type
+int superlinear_order(const element_type &type){
+
+   switch (type) {
+      case element_type::quad4:
+      case element_type::hex8:   return 1;
+      case element_type::quad8:
+      case element_type::hex20:  return 2;
+      case element_type::quad12:
+      case element_type::hex32:  return 3;
+      default:
+         THROW_IMPLEMENTED_ERROR("monomial bases are only built for fixed order elements");
+   }
+   return 0;
+}
+
+// in place inverse of an n x n matrix by Gauss-Jordan elimination with
+// partial pivoting
+void invert(real_t *A, const int &n){
+
+   vector<real_t> inv(n*n, 0.0);
+   for (int i = 0; i < n; i++) inv[i*n + i] = 1.0;
+
+   for (int col = 0; col < n; col++){
+
+      int pivot = col;
+      for (int row = col + 1; row < n; row++)
+         if (std::abs(A[row*n + col]) > std::abs(A[pivot*n + col])) pivot = row;
+
+      if (A[pivot*n + col] == 0.0)
+         THROW_IMPLEMENTED_ERROR("singular Vandermonde matrix");
+
+      if (pivot != col)
+         for (int k = 0; k < n; k++){
+            std::swap(A[col*n + k], A[pivot*n + k]);
+            std::swap(inv[col*n + k], inv[pivot*n + k]);
+         }
+
+      real_t scale = 1.0/A[col*n + col];
+      for (int k = 0; k < n; k++){
+         A[col*n + k] *= scale;
+         inv[col*n + k] *= scale;
+      }
+
+      for (int row = 0; row < n; row++){
+         if (row == col) continue;
+         real_t factor = A[row*n + col];
+         if (factor == 0.0) continue;
+         for (int k = 0; k < n; k++){
+            A[row*n + k] -= factor*A[col*n + k];
+            inv[row*n + k] -= factor*inv[col*n + k];
+         }
+      }
+   } // end for col
+
+   std::copy(inv.begin(), inv.end(), A);
+}
+
+} // namespace
+
+
+// builds the monomial basis of a fixed order element type
+void build_monomial_basis(
+   monomial_basis &basis,
+   const element_type &type){
+
+   int r = superlinear_order(type);
+   int dim = num_dim(type);
+   int n_node = num_nodes(type);
+
+   basis.type = type;
+   basis.dim = dim;
+   basis.n_node = n_node;
+   basis.exponents.clear();
+
+   // every exponent set of superlinear degree <= r, xi fastest
+   int nz = (dim == 3) ? r : 0;
+   for (int c = 0; c <= nz; c++)
+      for (int b = 0; b <= r; b++)
+         for (int a = 0; a <= r; a++){
+            int e[3] = {a, b, c};
+            int degree = 0;
+            for (int d = 0; d < dim; d++) degree += (e[d] >= 2) ? e[d] : 0;
+            if (degree > r) continue;
+            for (int d = 0; d < dim; d++) basis.exponents.push_back(e[d]);
+         }
+
+   basis.n_mono = basis.exponents.size()/dim;
+   if (basis.n_mono != n_node)
+      THROW_IMPLEMENTED_ERROR("monomial count does not match the node count");
+
+   // reference nodes of the element
+   vector<real_t> nodes(n_node*dim);
+   visit_element_kernel(type, [&](auto kernel){
+      using Kernel = decltype(kernel);
+      for (int node = 0; node < n_node; node++)
+         for (int d = 0; d < dim; d++)
+            nodes[node*dim + d] = Kernel::ref_vert[node][d];
+   });
+
+   // C = V^-1
+   basis.coeffs.resize(n_node*n_node);
+   monomial_table(basis.coeffs.data(), nullptr, basis, nodes.data(), n_node);
+   invert(basis.coeffs.data(), n_node);
+} // end of build_monomial_basis
+
+// monomials and their partials at a set of points
+void monomial_table(
+   real_t *values,
+   real_t *partials,
+   const monomial_basis &basis,
+   const real_t *points,
+   const int &n_qp){
+
+   const int dim = basis.dim;
+   const int n_mono = basis.n_mono;
+   const int max_power = 4;
+
+   for (int qp = 0; qp < n_qp; qp++){
+
+      // powers of each coordinate
+      real_t power[3][max_power];
+      for (int d = 0; d < dim; d++){
+         power[d][0] = 1.0;
+         for (int e = 1; e < max_power; e++)
+            power[d][e] = power[d][e - 1]*points[qp*dim + d];
+      }
+
+      for (int m = 0; m < n_mono; m++){
+         const int *e = basis.exponents.data() + m*dim;
+
+         real_t value = 1.0;
+         for (int d = 0; d < dim; d++) value *= power[d][e[d]];
+         values[qp*n_mono + m] = value;
+
+         if (!partials) continue;
+
+         for (int j = 0; j < dim; j++){
+            real_t partial = (e[j] > 0) ? e[j]*power[j][e[j] - 1] : 0.0;
+            for (int d = 0; d < dim; d++)
+               if (d != j) partial *= power[d][e[d]];
+            partials[(j*n_qp + qp)*n_mono + m] = partial;
+         }
+      } // end for m
+   } // end for qp
+} // end of monomial_table
+
+// basis values and reference partials at a set of points
+void monomial_reference_basis(
+   real_t *values,
+   real_t *partials,
+   const monomial_basis &basis,
+   const real_t *points,
+   const int &n_qp){
+
+   const int dim = basis.dim;
+   const int n_mono = basis.n_mono;
+   const int n_node = basis.n_node;
+   const int n_rows = (1 + dim)*n_qp;
+
+   // stacked tables [values; d/dxi; d/deta; d/dmu]
+   aligned_vector<real_t> table(n_rows*n_mono);
+   monomial_table(table.data(), table.data() + n_qp*n_mono, basis, points, n_qp);
+
+   aligned_vector<real_t> result(n_rows*n_node, 0.0);
+   small_gemm(result.data(), table.data(), basis.coeffs.data(), n_rows, n_node,
+      n_mono);
+
+   std::copy(result.begin(), result.begin() + n_qp*n_node, values);
+
+   for (int j = 0; j < dim; j++){
+      const real_t *partial_j = result.data() + (1 + j)*n_qp*n_node;
+      for (int qp = 0; qp < n_qp; qp++)
+         for (int node = 0; node < n_node; node++)
+            partials[(qp*n_node + node)*dim + j] = partial_j[qp*n_node + node];
+   }
+} // end of monomial_reference_basis
+
+// physical positions of the points in each element of a block
+void gemm_physical_position(
+   real_t *x_points,
+   const real_t *vertices,
+   const real_t *values,
+   const int &n_elem,
+   const int &n_qp,
+   const int &n_node,
+   const int &dim){
+
+   const int n_cols = n_elem*dim;
+
+   // vertices as [n_node][n_elem][dim]
+   aligned_vector<real_t> gathered(n_node*n_cols);
+   for (int elem = 0; elem < n_elem; elem++)
+      for (int node = 0; node < n_node; node++)
+         for (int d = 0; d < dim; d++)
+            gathered[(node*n_elem + elem)*dim + d] =
+               vertices[(elem*n_node + node)*dim + d];
+
+   aligned_vector<real_t> x(n_qp*n_cols, 0.0);
+   small_gemm(x.data(), values, gathered.data(), n_qp, n_cols, n_node);
+
+   for (int qp = 0; qp < n_qp; qp++)
+      for (int elem = 0; elem < n_elem; elem++)
+         for (int d = 0; d < dim; d++)
+            x_points[(elem*n_qp + qp)*dim + d] = x[(qp*n_elem + elem)*dim + d];
+} // end of gemm_physical_position
+
+// C += A B, row major
+void small_gemm(
+   real_t *C,
+   const real_t *A,
+   const real_t *B,
+   const int &m,
+   const int &n,
+   const int &k){
+
+   // column panels keep a strip of C and B in cache, the unit stride inner
+   // loop vectorizes
+   const int panel = 256;
+
+   for (int col = 0; col < n; col += panel){
+      int width = std::min(panel, n - col);
+
+      for (int i = 0; i < m; i++){
+         real_t *C_row = C + i*n + col;
+
+         for (int p = 0; p < k; p++){
+            real_t a = A[i*k + p];
+            if (a == 0.0) continue;
+            const real_t *B_row = B + p*n + col;
+            for (int j = 0; j < width; j++) C_row[j] += a*B_row[j];
+         }
+      }
+   }
+} // end of small_gemm
+
+} // end namespace elements
+} // end namespace ristra
@@ -0,0 +1,93 @@
+#ifndef ELEMENTS_MONOMIAL_H
+#define ELEMENTS_MONOMIAL_H
+
+#include "ristra/elements/batched.h"
+#include "ristra/elements/utilities.h"
+
+namespace ristra{
+namespace elements{
+
+/*
+ ==========================
+  Monomial basis
+ ==========================
+
+ The fixed order elements span serendipity spaces: the monomials
+
+    xi^a eta^b mu^c   with superlinear degree <= r
+
+ where the superlinear degree sums only the exponents of 2 or more, and r is
+ 1 for Quad4/Hex8, 2 for Quad8/Hex20 and 3 for Quad12/Hex32. There are
+ exactly as many such monomials as nodes, so with the Vandermonde matrix
+ V[i][m] = p_m(node_i) every shape function is a column of C = V^-1,
+
+    phi_n(xi) = sum_m p_m(xi) C[m][n]
+
+ Evaluating the basis and its partials at a batch of points is then one
+ dense product of the stacked monomial and monomial derivative tables
+ [(1 + dim) n_qp][n_mono] with C [n_mono][n_node], and the physical
+ positions of many elements a second product of the basis table with the
+ gathered vertices [n_node][n_elem dim]. This is an optional alternative to
+ the hand written kernels of element_kernels.h with the same layouts.
+*/
+
+// coefficients of the shape functions of an element over its monomials
+struct monomial_basis {
+
+   element_type type;
+
+   int dim    = 0;   // dimension
+   int n_node = 0;   // nodes per element
+   int n_mono = 0;   // monomials, equal to n_node
+
+   vector<int> exponents;          // [n_mono][dim]
+   aligned_vector<real_t> coeffs;  // C [n_mono][n_node]
+};
+
+// builds the monomial basis of a fixed order element type
+void build_monomial_basis(
+   monomial_basis &basis,           // basis to fill
+   const element_type &type);       // element type (fixed order)
+
+// monomials of a basis at a set of points, with their partials when
+// partials is not null
+void monomial_table(
+   real_t *values,                  // monomials [n_qp][n_mono]
+   real_t *partials,                // partials [dim][n_qp][n_mono] or null
+   const monomial_basis &basis,     // monomial basis
+   const real_t *points,            // reference points [n_qp][dim]
+   const int &n_qp);                // number of points
+
+// basis values and reference partials at a set of points, laid out as
+// reference_basis in batched.h
+void monomial_reference_basis(
+   real_t *values,                  // basis values [n_qp][n_node]
+   real_t *partials,                // reference partials [n_qp][n_node][dim]
+   const monomial_basis &basis,     // monomial basis
+   const real_t *points,            // reference points [n_qp][dim]
+   const int &n_qp);                // number of points
+
+// physical positions of the points in each element of a block as one
+// product of the basis table with the gathered vertices
+void gemm_physical_position(
+   real_t *x_points,                // physical positions [n_elem][n_qp][dim]
+   const real_t *vertices,          // element vertices [n_elem][n_node][dim]
+   const real_t *values,            // basis values [n_qp][n_node]
+   const int &n_elem,               // number of elements
+   const int &n_qp,                 // number of points
+   const int &n_node,               // nodes per element
+   const int &dim);                 // dimension
+
+// C[m][n] += sum_k A[m][k] B[k][n], row major
+void small_gemm(
+   real_t *C,                       // [m][n]
+   const real_t *A,                 // [m][k]
+   const real_t *B,                 // [k][n]
+   const int &m,
+   const int &n,
+   const int &k);
+
+} //end namespace elements
+} //end namespace ristra
+
+#endif //ELEMENTS_MONOMIAL_H
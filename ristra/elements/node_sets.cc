@@ -0,0 +1,105 @@
+#include <cmath>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+
+#include "ristra/elements/node_sets.h"
+#include "ristra/elements/lagrange.h"
+#include "ristra/elements/quadrature.h"
+#include "ristra/assertions/errors.h"
+
+namespace ristra {
+namespace elements{
+
+// builds a node set
+void build_node_set(
+   node_set &set,
+   const node_spacing &spacing,
+   const int &order){
+
+   if (order < 1)
+      THROW_IMPLEMENTED_ERROR("node sets need an element order of at least 1");
+
+   int N = order + 1;
+
+   set.spacing   = spacing;
+   set.order     = order;
+   set.num_nodes = N;
+
+   set.nodes.resize(N);
+   real_t *x = set.nodes.data();
+
+   if (spacing == node_spacing::chebyshev){
+      real_t pi = 3.14159265358979323846;
+
+      for (int i = 1; i < N; i++)
+         x[i - 1] = -cos(pi*(2.0*i - 1.0)/(2.0*(order + 1.0)));
+
+      // the first and last node on the element boundary
+      x[0] = -1.0;
+      x[order] = 1.0;
+   }
+   else if (spacing == node_spacing::lobatto){
+      const quadrature_1d &rule = line_rule(quadrature_rule::lobatto, N);
+      for (int i = 0; i < N; i++) x[i] = rule.points[i];
+   }
+   else {
+      for (int i = 0; i < N; i++) x[i] = -1.0 + 2.0*i/order;
+   }
+
+   set.weights.resize(N);
+   barycentric_weights(set.weights.data(), x, N);
+
+   // D[q][n] = l_n'(x_q)
+   set.D.resize(N*N);
+   vector<real_t> val(N);
+   for (int q = 0; q < N; q++)
+      barycentric_lagrange(val.data(), set.D.data() + q*N, x[q], x,
+         set.weights.data(), N);
+
+   set.nodes_2d.resize(N*N*2);
+   for (int node = 0; node < N*N; node++){
+      set.nodes_2d[node*2 + 0] = x[node % N];
+      set.nodes_2d[node*2 + 1] = x[node / N];
+   }
+
+   set.nodes_3d.resize(N*N*N*3);
+   for (int node = 0; node < N*N*N; node++){
+      set.nodes_3d[node*3 + 0] = x[node % N];
+      set.nodes_3d[node*3 + 1] = x[(node / N) % N];
+      set.nodes_3d[node*3 + 2] = x[node / (N*N)];
+   }
+} // end of build_node_set
+
+// cached node set
+const node_set &get_node_set(
+   const node_spacing &spacing,
+   const int &order){
+
+   using key_t = std::tuple<node_spacing, int>;
+
+   static std::mutex mutex;
+   static std::map< key_t, std::unique_ptr<node_set> > sets;
+
+   if (order < 1)
+      THROW_IMPLEMENTED_ERROR("node sets need an element order of at least 1");
+
+   // built before taking this lock, line_rule has its own
+   if (spacing == node_spacing::lobatto)
+      line_rule(quadrature_rule::lobatto, order + 1);
+
+   std::lock_guard<std::mutex> lock(mutex);
+
+   key_t key(spacing, order);
+   auto it = sets.find(key);
+   if (it != sets.end()) return *it->second;
+
+   std::unique_ptr<node_set> set(new node_set);
+   build_node_set(*set, spacing, order);
+
+   return *sets.emplace(key, std::move(set)).first->second;
+}
+
+} // end namespace elements
+} // end namespace ristra
@@ -0,0 +1,68 @@
+#ifndef ELEMENTS_NODE_SETS_H
+#define ELEMENTS_NODE_SETS_H
+
+#include "ristra/elements/utilities.h"
+
+namespace ristra{
+namespace elements{
+
+/*
+ ==========================
+  Node sets
+ ==========================
+
+ The 1D nodes of the Lagrange elements QuadN/HexN, with everything that only
+ depends on them:
+
+    nodes       x_i, ascending, x_0 = -1 and x_order = 1
+    weights     barycentric weights w_i = 1 / prod_{j != i} (x_i - x_j)
+    D           differentiation matrix D[q][n] = l_n'(x_q)
+    nodes_2d    tensor node coordinates, xi fastest
+    nodes_3d    tensor node coordinates, xi fastest
+
+ Chebyshev nodes are the Gauss-Chebyshev points with the end points moved
+ onto -1 and 1, as QuadN/HexN have always used. Lobatto nodes are the points
+ of the order + 1 point Gauss-Lobatto rule and equispaced nodes are uniform.
+
+ Node sets are built once per (spacing, order) and kept in a process wide
+ cache like the quadrature rules, so references stay valid and unchanged for
+ the life of the program.
+*/
+
+// 1D node spacings of the Lagrange elements
+enum class node_spacing {
+   chebyshev,
+   lobatto,
+   equispaced
+};
+
+// immutable node data of one spacing and element order
+struct node_set {
+
+   node_spacing spacing;
+
+   int order = 0;       // element order
+   int num_nodes = 0;   // order + 1
+
+   aligned_vector<real_t> nodes;      // [num_nodes]
+   aligned_vector<real_t> weights;    // [num_nodes], barycentric weights
+   aligned_vector<real_t> D;          // [num_nodes][num_nodes]
+   aligned_vector<real_t> nodes_2d;   // [num_nodes^2][2]
+   aligned_vector<real_t> nodes_3d;   // [num_nodes^3][3]
+};
+
+// builds a node set
+void build_node_set(
+   node_set &set,                   // node set to fill
+   const node_spacing &spacing,     // node spacing
+   const int &order);               // element order, at least 1
+
+// cached node set, built on first use
+const node_set &get_node_set(
+   const node_spacing &spacing,     // node spacing
+   const int &order);               // element order, at least 1
+
+} //end namespace elements
+} //end namespace ristra
+
+#endif //ELEMENTS_NODE_SETS_H
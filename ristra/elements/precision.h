@@ -0,0 +1,205 @@
+#ifndef ELEMENTS_PRECISION_H
+#define ELEMENTS_PRECISION_H
+
+#include "ristra/elements/batched.h"
+#include "ristra/elements/element_kernels.h"
+#include "ristra/elements/jacobian.h"
+#include "ristra/elements/reference_cache.h"
+#include "ristra/elements/utilities.h"
+#include "ristra/assertions/errors.h"
+
+namespace ristra{
+namespace elements{
+
+/*
+ ==========================
+  Precision modes
+ ==========================
+
+ Block evaluation and integration templated on a precision_policy
+ (utilities.h):
+
+    double_precision    double tables and coordinates, double sums
+    single_precision    float tables and coordinates, float sums
+    mixed_precision     float tables and coordinates, double sums
+
+ The reference tables are still built in double by reference_cache and only
+ rounded to the storage type, so every mode starts from correctly rounded
+ basis values. The bandwidth bound loops then stream half the bytes in the
+ float modes while the mixed mode keeps double jacobians, determinants and
+ integrals. Expect relative errors near 1e-7 in the float modes.
+*/
+
+// copy of n values rounded to T
+template<class T, class U>
+void round_copy(T *out, const U *in, const int &n){
+   for (int i = 0; i < n; i++) out[i] = static_cast<T>(in[i]);
+}
+
+// reference table with its values held in the storage type
+template<class Precision>
+struct precision_table {
+
+   using storage_t = typename Precision::storage_t;
+
+   element_type type;
+   quadrature_rule rule;
+
+   int quad_order = 0;  // points per direction
+   int elem_order = 0;  // element order (quadN/hexN only)
+   int n_qp   = 0;      // number of quadrature points
+   int n_node = 0;      // nodes per element
+   int dim    = 0;      // dimension
+
+   aligned_vector<storage_t> points;    // [n_qp][dim]
+   aligned_vector<storage_t> weights;   // [n_qp]
+   aligned_vector<storage_t> basis;     // [n_qp][n_node]
+   aligned_vector<storage_t> partials;  // [n_qp][n_node][dim]
+};
+
+// results of evaluating a block, held in the accumulation type
+template<class Precision>
+struct precision_block {
+
+   using accum_t = typename Precision::accum_t;
+
+   int n_elem = 0;   // number of elements in the block
+   int n_qp   = 0;   // number of points per element
+   int n_node = 0;   // nodes per element
+   int dim    = 0;   // dimension
+
+   aligned_vector<accum_t> x_points;   // [n_elem][n_qp][dim]
+   aligned_vector<accum_t> J_matrix;   // [n_elem][n_qp][dim][dim]
+   aligned_vector<accum_t> det_J;      // [n_elem][n_qp]
+   aligned_vector<accum_t> J_inverse;  // [n_elem][n_qp][dim][dim]
+};
+
+// rounds a double reference table to the storage type
+template<class Precision>
+void convert_table(
+   precision_table<Precision> &out,    // rounded table
+   const reference_table &table){      // double table
+
+   out.type       = table.type;
+   out.rule       = table.rule;
+   out.quad_order = table.quad_order;
+   out.elem_order = table.elem_order;
+   out.n_qp       = table.n_qp;
+   out.n_node     = table.n_node;
+   out.dim        = table.dim;
+
+   out.points.resize(table.points.size());
+   out.weights.resize(table.weights.size());
+   out.basis.resize(table.basis.size());
+   out.partials.resize(table.partials.size());
+
+   round_copy(out.points.data(), table.points.data(), table.points.size());
+   round_copy(out.weights.data(), table.weights.data(), table.weights.size());
+   round_copy(out.basis.data(), table.basis.data(), table.basis.size());
+   round_copy(out.partials.data(), table.partials.data(), table.partials.size());
+}
+
+// positions, jacobians, determinants and inverse jacobians of a block
+template<class Precision>
+void evaluate_block(
+   precision_block<Precision> &block,                    // results (resized as needed)
+   const precision_table<Precision> &table,              // rounded reference table
+   const typename Precision::storage_t *vertices,        // element vertices [n_elem][n_node][dim]
+   const int &n_elem){                                   // number of elements
+
+   using storage_t = typename Precision::storage_t;
+   using accum_t = typename Precision::accum_t;
+
+   int n_qp   = table.n_qp;
+   int n_node = table.n_node;
+   int dim    = table.dim;
+
+   block.n_elem = n_elem;
+   block.n_qp   = n_qp;
+   block.n_node = n_node;
+   block.dim    = dim;
+
+   block.x_points.resize(n_elem*n_qp*dim);
+   block.J_matrix.resize(n_elem*n_qp*dim*dim);
+   block.det_J.resize(n_elem*n_qp);
+   block.J_inverse.resize(n_elem*n_qp*dim*dim);
+
+   accum_t *x_points = block.x_points.data();
+   accum_t *J_matrix = block.J_matrix.data();
+   accum_t *det_J = block.det_J.data();
+   accum_t *J_inverse = block.J_inverse.data();
+
+   if (table.type != element_type::quadN && table.type != element_type::hexN){
+
+      visit_element_kernel(table.type, [&](auto kernel){
+         using Kernel = decltype(kernel);
+         constexpr int Dim = Kernel::num_dim;
+         constexpr int NumNodes = Kernel::num_nodes;
+
+         Kernel::batched_physical_position(x_points, vertices,
+            table.basis.data(), n_elem, n_qp);
+
+         batched_jacobian_kernel<Dim, NumNodes>(J_matrix, det_J, J_inverse,
+            vertices, table.partials.data(), n_elem, n_qp);
+      });
+      return;
+   }
+
+   // node count only known at run time
+   for (int elem = 0; elem < n_elem; elem++){
+
+      const storage_t *elem_verts = vertices + elem*n_node*dim;
+
+      for (int qp = 0; qp < n_qp; qp++){
+
+         const storage_t *qp_basis = table.basis.data() + qp*n_node;
+         accum_t *x = x_points + (elem*n_qp + qp)*dim;
+
+         for (int d = 0; d < dim; d++) x[d] = 0.0;
+
+         for (int node = 0; node < n_node; node++)
+            for (int d = 0; d < dim; d++)
+               x[d] += accum_t(elem_verts[node*dim + d])*accum_t(qp_basis[node]);
+      } // end for qp
+   } // end for elem
+
+   if (dim == 2)
+      batched_jacobian_kernel<2>(J_matrix, det_J, J_inverse, vertices,
+         table.partials.data(), n_elem, n_qp, n_node);
+   else if (dim == 3)
+      batched_jacobian_kernel<3>(J_matrix, det_J, J_inverse, vertices,
+         table.partials.data(), n_elem, n_qp, n_node);
+   else
+      THROW_IMPLEMENTED_ERROR("precision blocks are only defined in 2D and 3D");
+}
+
+// integral of a field over every element of an evaluated block,
+// integrals[elem] = sum_qp w f |det J|
+template<class Precision>
+void integrate(
+   typename Precision::accum_t *integrals,               // integrals [n_elem]
+   const precision_table<Precision> &table,              // rounded reference table
+   const precision_block<Precision> &block,              // evaluated block
+   const typename Precision::storage_t *f_points){       // field values [n_elem][n_qp]
+
+   using accum_t = typename Precision::accum_t;
+
+   int n_qp = block.n_qp;
+
+   for (int elem = 0; elem < block.n_elem; elem++){
+
+      const accum_t *det = block.det_J.data() + elem*n_qp;
+      accum_t sum = 0.0;
+
+      for (int qp = 0; qp < n_qp; qp++){
+         accum_t abs_det = (det[qp] < 0.0) ? -det[qp] : det[qp];
+         sum += accum_t(table.weights[qp])*accum_t(f_points[elem*n_qp + qp])*abs_det;
+      }
+      integrals[elem] = sum;
+   } // end for elem
+}
+
+} //end namespace elements
+} //end namespace ristra
+
+#endif //ELEMENTS_PRECISION_H
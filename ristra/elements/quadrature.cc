@@ -0,0 +1,281 @@
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+
+#include "ristra/elements/quadrature.h"
+#include "ristra/assertions/errors.h"
+
+namespace ristra {
+namespace elements{
+
+namespace {
+
+const double pi = 3.14159265358979323846;
+
+// Newton iterations allowed per point before giving up
+const int max_newton_iterations = 100;
+
+// Newton step size at which a point has converged in T
+template<class T>
+T newton_tolerance(){
+   return std::max(T(1.0e-15), 4*std::numeric_limits<T>::epsilon());
+}
+
+// Legendre polynomials P_n(x) and P_{n-1}(x) by the three term recurrence
+template<class T>
+void legendre(T &p_n, T &p_nm1, const T &x, const int &n){
+
+   T p0 = 1.0;
+   T p1 = x;
+
+   if (n == 0){
+      p_n = p0;
+      p_nm1 = 0.0;
+      return;
+   }
+
+   for (int k = 2; k <= n; k++){
+      T p2 = ((T(2)*k - 1)*x*p1 - (T(k) - 1)*p0)/k;
+      p0 = p1;
+      p1 = p2;
+   } // end for k
+
+   p_n = p1;
+   p_nm1 = p0;
+}
+
+// rules with up to this many points are found without taking a lock
+const int max_indexed_order = 64;
+
+// rules built on first use and kept for the life of the program. A built
+// rule never moves, so once it is published to its slot later lookups are a
+// single atomic load; only the first build of a rule, and rules too large
+// for a slot, go through the lock
+template<class Key, class Rule>
+class rule_cache {
+
+   public:
+
+      template<class Build>
+      const Rule &get(const Key &key, std::atomic<const Rule *> *slot,
+         Build build){
+
+         if (slot){
+            const Rule *rule = slot->load(std::memory_order_acquire);
+            if (rule) return *rule;
+         }
+
+         std::lock_guard<std::mutex> lock(mutex_);
+
+         auto it = rules_.find(key);
+         if (it == rules_.end()){
+            std::unique_ptr<Rule> rule(new Rule);
+            build(*rule);
+            it = rules_.emplace(key, std::move(rule)).first;
+         }
+
+         if (slot) slot->store(it->second.get(), std::memory_order_release);
+         return *it->second;
+      }
+
+   private:
+
+      std::mutex mutex_;
+      std::map< Key, std::unique_ptr<Rule> > rules_;
+};
+
+// mirrors the lower half of a rule so it is exactly symmetric about 0
+template<class T>
+void symmetrize(T *points, T *weights, const int &n){
+
+   for (int i = 0; i < n/2; i++){
+      points[n - 1 - i] = -points[i];
+      weights[n - 1 - i] = weights[i];
+   }
+   if (n % 2 == 1) points[n/2] = 0.0;
+}
+
+} // namespace
+
+
+// computes an n point Gauss-Legendre rule
+template<class T>
+void compute_gauss_rule(
+   T *points,
+   T *weights,
+   const int &n){
+
+   if (n < 1) THROW_IMPLEMENTED_ERROR("a Gauss rule needs at least one point");
+
+   for (int i = 0; i < (n + 1)/2; i++){
+
+      // Chebyshev-like guess for the i-th root counted from -1
+      T x = -std::cos(T(pi)*(i + T(0.75))/(n + T(0.5)));
+      T p_n, p_nm1, dp;
+
+      for (int iter = 0; iter < max_newton_iterations; iter++){
+         legendre(p_n, p_nm1, x, n);
+         dp = n*(x*p_n - p_nm1)/(x*x - 1);
+
+         T dx = p_n/dp;
+         x -= dx;
+         if (std::abs(dx) <= newton_tolerance<T>()) break;
+      } // end for iter
+
+      legendre(p_n, p_nm1, x, n);
+      dp = n*(x*p_n - p_nm1)/(x*x - 1);
+
+      points[i]  = x;
+      weights[i] = 2/((1 - x*x)*dp*dp);
+   } // end for i
+
+   symmetrize(points, weights, n);
+}
+
+// computes an n point Gauss-Lobatto rule
+template<class T>
+void compute_lobatto_rule(
+   T *points,
+   T *weights,
+   const int &n){
+
+   if (n < 1) THROW_IMPLEMENTED_ERROR("a Lobatto rule needs at least one point");
+
+   if (n == 1){
+      points[0]  = 0.0;
+      weights[0] = 2.0;
+      return;
+   }
+
+   // the roots of (1 - x^2) P'_N are the end points and the extrema of P_N
+   int N = n - 1;
+
+   for (int i = 0; i < (n + 1)/2; i++){
+
+      // Chebyshev-Gauss-Lobatto guess
+      T x = -std::cos(T(pi)*i/N);
+      T p_n, p_nm1;
+
+      for (int iter = 0; iter < max_newton_iterations; iter++){
+         legendre(p_n, p_nm1, x, N);
+
+         T dx = (x*p_n - p_nm1)/(n*p_n);
+         x -= dx;
+         if (std::abs(dx) <= newton_tolerance<T>()) break;
+      } // end for iter
+
+      legendre(p_n, p_nm1, x, N);
+
+      points[i]  = x;
+      weights[i] = 2/(T(N)*n*p_n*p_n);
+   } // end for i
+
+   points[0] = -1.0;
+   symmetrize(points, weights, n);
+}
+
+
+// cached 1D rule with order points
+template<class T>
+const basic_quadrature_1d<T> &line_rule(
+   const quadrature_rule &rule,
+   const int &order){
+
+   using line_t = basic_quadrature_1d<T>;
+
+   if (order < 1)
+      THROW_IMPLEMENTED_ERROR("quadrature rules need at least one point");
+
+   // one cache per scalar type
+   static rule_cache< std::tuple<quadrature_rule, int>, line_t > rules;
+   static std::atomic<const line_t *> slots[2][max_indexed_order + 1];
+
+   std::atomic<const line_t *> *slot = nullptr;
+   if (order <= max_indexed_order) slot = &slots[static_cast<int>(rule)][order];
+
+   return rules.get(std::make_tuple(rule, order), slot, [&](line_t &line){
+      line.rule  = rule;
+      line.order = order;
+      line.points.resize(order);
+      line.weights.resize(order);
+
+      if (rule == quadrature_rule::gauss)
+         compute_gauss_rule(line.points.data(), line.weights.data(), order);
+      else
+         compute_lobatto_rule(line.points.data(), line.weights.data(), order);
+   });
+}
+
+// cached tensor rule with order points in each of dim directions
+template<class T>
+const basic_tensor_quadrature<T> &tensor_rule(
+   const quadrature_rule &rule,
+   const int &order,
+   const int &dim){
+
+   using tensor_t = basic_tensor_quadrature<T>;
+
+   if (dim < 1 || dim > 4)
+      THROW_IMPLEMENTED_ERROR("tensor rules are only built in 1D to 4D");
+
+   static rule_cache< std::tuple<quadrature_rule, int, int>, tensor_t > rules;
+   static std::atomic<const tensor_t *> slots[2][max_indexed_order + 1][4];
+
+   // built first, so the 1D cache is never entered under the tensor lock
+   const basic_quadrature_1d<T> &line = line_rule<T>(rule, order);
+
+   std::atomic<const tensor_t *> *slot = nullptr;
+   if (order <= max_indexed_order)
+      slot = &slots[static_cast<int>(rule)][order][dim - 1];
+
+   return rules.get(std::make_tuple(rule, order, dim), slot, [&](tensor_t &tensor){
+
+      int n_qp = 1;
+      for (int d = 0; d < dim; d++) n_qp *= order;
+
+      tensor.rule  = rule;
+      tensor.order = order;
+      tensor.dim   = dim;
+      tensor.n_qp  = n_qp;
+      tensor.points.resize(n_qp*dim);
+      tensor.weights.resize(n_qp);
+
+      for (int qp = 0; qp < n_qp; qp++){
+         int index = qp;
+         T weight = 1.0;
+
+         // xi fastest
+         for (int d = 0; d < dim; d++){
+            int i = index % order;
+            index /= order;
+
+            tensor.points[qp*dim + d] = line.points[i];
+            weight *= line.weights[i];
+         } // end for d
+
+         tensor.weights[qp] = weight;
+      } // end for qp
+   });
+}
+
+// the scalar types rules are built in
+#define ELEMENTS_INSTANTIATE_QUADRATURE(T) \
+   template void compute_gauss_rule<T>(T *, T *, const int &); \
+   template void compute_lobatto_rule<T>(T *, T *, const int &); \
+   template const basic_quadrature_1d<T> &line_rule<T>( \
+      const quadrature_rule &, const int &); \
+   template const basic_tensor_quadrature<T> &tensor_rule<T>( \
+      const quadrature_rule &, const int &, const int &);
+
+ELEMENTS_INSTANTIATE_QUADRATURE(float)
+ELEMENTS_INSTANTIATE_QUADRATURE(double)
+
+#undef ELEMENTS_INSTANTIATE_QUADRATURE
+
+} // end namespace elements
+} // end namespace ristra
@@ -0,0 +1,111 @@
+#ifndef ELEMENTS_QUADRATURE_H
+#define ELEMENTS_QUADRATURE_H
+
+#include "ristra/elements/utilities.h"
+
+namespace ristra{
+namespace elements{
+
+/*
+ ==========================
+  Quadrature rules
+ ==========================
+
+ Gauss-Legendre and Gauss-Lobatto rules of any order on [-1, 1]. Points are
+ found by Newton iteration on P_n (Gauss) or on (1 - x^2) P'_{n-1} (Lobatto)
+ and are listed in ascending order.
+
+ Rules are built once and kept in a process wide cache. The references handed
+ out stay valid, and unchanged, for the life of the program, and looking up a
+ rule that is already built takes no lock, so threads can share the cache
+ inside their loops. Tensor rules number their points with xi fastest, then eta, mu and tau, matching
+ Gauss2D/3D/4D.
+
+ A one point Lobatto rule does not exist; as in the line rules it has always
+ been the midpoint rule {0, 2}.
+
+ The rules are templated on the scalar type and computed in it, so a float
+ rule comes from Newton iterations in float rather than from a rounded double
+ table. float and double are instantiated; the real_t rules are the default.
+*/
+
+// quadrature rules
+enum class quadrature_rule {
+   gauss,
+   lobatto
+};
+
+// points and weights of a 1D rule
+template<class T>
+struct basic_quadrature_1d {
+
+   quadrature_rule rule;
+   int order = 0;                    // number of points
+
+   aligned_vector<T> points;         // [order]
+   aligned_vector<T> weights;        // [order]
+};
+
+// points and product weights of a tensor rule
+template<class T>
+struct basic_tensor_quadrature {
+
+   quadrature_rule rule;
+   int order = 0;                    // points per direction
+   int dim   = 0;                    // dimension
+   int n_qp  = 0;                    // order^dim
+
+   aligned_vector<T> points;         // [n_qp][dim]
+   aligned_vector<T> weights;        // [n_qp]
+};
+
+using quadrature_1d = basic_quadrature_1d<real_t>;
+using tensor_quadrature = basic_tensor_quadrature<real_t>;
+
+// computes an n point Gauss-Legendre rule
+template<class T>
+void compute_gauss_rule(
+   T *points,                        // points [n]
+   T *weights,                       // weights [n]
+   const int &n);                    // number of points
+
+// computes an n point Gauss-Lobatto rule
+template<class T>
+void compute_lobatto_rule(
+   T *points,                        // points [n]
+   T *weights,                       // weights [n]
+   const int &n);                    // number of points
+
+// cached 1D rule with order points
+template<class T = real_t>
+const basic_quadrature_1d<T> &line_rule(
+   const quadrature_rule &rule,      // Gauss or Lobatto
+   const int &order);                // number of points
+
+// copies the points and weights of a cached 1D rule computed in T, e.g. float
+template<class T>
+void line_rule(
+   T *points,                        // points [order]
+   T *weights,                       // weights [order]
+   const quadrature_rule &rule,      // Gauss or Lobatto
+   const int &order){                // number of points
+
+   const basic_quadrature_1d<T> &line = line_rule<T>(rule, order);
+
+   for (int i = 0; i < order; i++){
+      points[i]  = line.points[i];
+      weights[i] = line.weights[i];
+   }
+}
+
+// cached tensor rule with order points in each of dim (1 to 4) directions
+template<class T = real_t>
+const basic_tensor_quadrature<T> &tensor_rule(
+   const quadrature_rule &rule,      // Gauss or Lobatto
+   const int &order,                 // points per direction
+   const int &dim);                  // dimension
+
+} //end namespace elements
+} //end namespace ristra
+
+#endif //ELEMENTS_QUADRATURE_H
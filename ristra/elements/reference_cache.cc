@@ -0,0 +1,189 @@
+#include <algorithm>
+
+#include "ristra/elements/reference_cache.h"
+#include "ristra/elements/collocation.h"
+#include "ristra/elements/elements.h"
+#include "ristra/assertions/errors.h"
+
+namespace ristra {
+namespace elements{
+
+namespace {
+
+// identity basis and differentiation matrix partials of a collocated
+// table, the partial along d only involves the nodes on the line through
+// the point in that direction
+void collocated_reference_basis(
+   real_t *basis,
+   real_t *partials,
+   const real_t *D,
+   const int &N,
+   const int &dim){
+
+   int n_node = (dim == 2) ? N*N : N*N*N;
+   int stride[3] = {1, N, N*N};
+
+   std::fill(basis, basis + n_node*n_node, 0.0);
+   std::fill(partials, partials + n_node*n_node*dim, 0.0);
+
+   for (int qp = 0; qp < n_node; qp++){
+      int idx[3] = {qp % N, (qp/N) % N, qp/(N*N)};
+
+      basis[qp*n_node + qp] = 1.0;
+
+      for (int d = 0; d < dim; d++){
+         int line_start = qp - idx[d]*stride[d];
+         for (int n = 0; n < N; n++){
+            int node = line_start + n*stride[d];
+            partials[(qp*n_node + node)*dim + d] = D[idx[d]*N + n];
+         }
+      } // end for d
+   } // end for qp
+}
+
+} // namespace
+
+// builds the table for an element type and quadrature rule
+void build_reference_table(
+   reference_table &table,
+   const element_type &type,
+   const quadrature_rule &rule,
+   const int &quad_order,
+   const int &elem_order,
+   const node_spacing &spacing){
+
+   int dim    = num_dim(type);
+   int n_node = num_nodes(type, elem_order);
+
+   const tensor_quadrature &tensor = tensor_rule(rule, quad_order, dim);
+   int n_qp   = tensor.n_qp;
+
+   table.type       = type;
+   table.rule       = rule;
+   table.quad_order = quad_order;
+   table.elem_order = elem_order;
+   table.spacing    = spacing;
+   table.collocated = false;
+   table.n_qp       = n_qp;
+   table.n_node     = n_node;
+   table.dim        = dim;
+
+   table.basis.resize(n_qp*n_node);
+   table.partials.resize(n_qp*n_node*dim);
+
+   table.points.assign(tensor.points.begin(), tensor.points.end());
+   table.weights.assign(tensor.weights.begin(), tensor.weights.end());
+
+   if (type == element_type::quadN || type == element_type::hexN){
+      const node_set &nodes = get_node_set(spacing, elem_order);
+      table.collocated = is_collocated(nodes.nodes.data(), nodes.num_nodes,
+         line_rule(rule, quad_order));
+
+      if (table.collocated)
+         collocated_reference_basis(table.basis.data(), table.partials.data(),
+            nodes.D.data(), nodes.num_nodes, dim);
+      else
+         lagrange_reference_basis(table.basis.data(), table.partials.data(),
+            table.points.data(), n_qp, dim, elem_order, spacing);
+   }
+   else {
+      reference_basis(table.basis.data(), table.partials.data(),
+         table.points.data(), n_qp, type);
+   }
+} // end of build_reference_table
+
+
+// table for a fixed order element, built on first use
+const reference_table &reference_cache::get(
+   const element_type &type,
+   const quadrature_rule &rule,
+   const int &quad_order){
+
+   return get(type, rule, quad_order, 1);
+}
+
+// table for any element, elem_order and spacing are only used by quadN/hexN
+const reference_table &reference_cache::get(
+   const element_type &type,
+   const quadrature_rule &rule,
+   const int &quad_order,
+   const int &elem_order,
+   const node_spacing &spacing){
+
+   bool is_lagrange = (type == element_type::quadN || type == element_type::hexN);
+   key_t key(type, rule, quad_order, is_lagrange ? elem_order : 0,
+      is_lagrange ? spacing : node_spacing::chebyshev);
+
+   std::lock_guard<std::mutex> lock(mutex_);
+
+   auto it = tables_.find(key);
+   if (it != tables_.end()) return *it->second;
+
+   std::unique_ptr<reference_table> table(new reference_table);
+   build_reference_table(*table, type, rule, quad_order, elem_order, spacing);
+
+   return *tables_.emplace(key, std::move(table)).first->second;
+}
+
+// number of tables built so far
+std::size_t reference_cache::size() const {
+   std::lock_guard<std::mutex> lock(mutex_);
+   return tables_.size();
+}
+
+// drop every table, invalidating references handed out earlier
+void reference_cache::clear(){
+   std::lock_guard<std::mutex> lock(mutex_);
+   tables_.clear();
+}
+
+// process wide cache
+reference_cache &reference_cache::instance(){
+   static reference_cache cache;
+   return cache;
+}
+
+
+// evaluate a block of elements using a precomputed reference table
+void evaluate_block(
+   element_block &block,
+   const reference_table &table,
+   const real_t *vertices,
+   const int &n_elem){
+
+   int n_qp   = table.n_qp;
+   int n_node = table.n_node;
+   int dim    = table.dim;
+
+   block.type   = table.type;
+   block.n_elem = n_elem;
+   block.n_qp   = n_qp;
+   block.n_node = n_node;
+   block.dim    = dim;
+
+   // the cache keeps the table in place, so the block only points at it
+   block.basis.clear();
+   block.partials.clear();
+   block.table_basis    = table.basis.data();
+   block.table_partials = table.partials.data();
+   block.x_points.resize(n_elem*n_qp*dim);
+   block.J_matrix.resize(n_elem*n_qp*dim*dim);
+   block.det_J.resize(n_elem*n_qp);
+   block.J_inverse.resize(n_elem*n_qp*dim*dim);
+
+   // collocated points are the nodes, interpolation is a copy
+   if (table.collocated)
+      std::copy(vertices, vertices + n_elem*n_node*dim, block.x_points.data());
+   else
+      batched_physical_position(block.x_points.data(), vertices,
+         table.basis.data(), n_elem, n_qp, n_node, dim);
+
+   batched_jacobian(block.J_matrix.data(), block.det_J.data(), vertices,
+      table.partials.data(), n_elem, n_qp, n_node, dim);
+
+   batched_jacobian_inverse(block.J_inverse.data(), block.J_matrix.data(),
+      block.det_J.data(), n_elem*n_qp, dim);
+} // end of evaluate_block
+
+} // end namespace elements
+} // end namespace ristra
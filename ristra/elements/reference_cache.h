@@ -0,0 +1,118 @@
+#ifndef ELEMENTS_REFERENCE_CACHE_H
+#define ELEMENTS_REFERENCE_CACHE_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+
+#include "ristra/elements/batched.h"
+#include "ristra/elements/node_sets.h"
+#include "ristra/elements/quadrature.h"
+#include "ristra/elements/utilities.h"
+
+namespace ristra{
+namespace elements{
+
+/*
+ ==========================
+  Reference tables
+ ==========================
+
+ On the reference element the basis values and their xi/eta/mu partials only
+ depend on the quadrature point. A reference_table holds them, together with
+ the quadrature points and weights, for one (element type, quadrature rule)
+ pair so they are computed once and reused for every element.
+
+ QuadN/HexN tables whose 1D nodes are the points of the rule (GLL
+ collocation, Lobatto nodes with the order + 1 point Lobatto rule) are marked
+ collocated. Their basis is the identity and is not evaluated, the partials
+ come straight from the differentiation matrix of the node set, and
+ evaluate_block copies the vertices to the points instead of interpolating.
+
+ Tables are handed out by a reference_cache, which builds each one on first
+ request and never modifies it afterwards. References to a table stay valid
+ until the cache is cleared or destroyed.
+*/
+
+// read-only basis and partial tables for one element type and rule
+struct reference_table {
+
+   element_type type;
+   quadrature_rule rule;
+
+   int quad_order = 0;  // points per direction
+   int elem_order = 0;  // element order (quadN/hexN only)
+   node_spacing spacing = node_spacing::chebyshev;  // 1D nodes (quadN/hexN only)
+   bool collocated = false;  // nodes on the points, basis is the identity
+   int n_qp   = 0;      // number of quadrature points
+   int n_node = 0;      // nodes per element
+   int dim    = 0;      // dimension
+
+   aligned_vector<real_t> points;    // [n_qp][dim]
+   aligned_vector<real_t> weights;   // [n_qp], product of the 1D weights
+   aligned_vector<real_t> basis;     // [n_qp][n_node]
+   aligned_vector<real_t> partials;  // [n_qp][n_node][dim]
+};
+
+// builds the table for an element type and quadrature rule
+void build_reference_table(
+   reference_table &table,          // table to fill
+   const element_type &type,        // element type
+   const quadrature_rule &rule,     // quadrature rule
+   const int &quad_order,           // points per direction
+   const int &elem_order,           // element order (quadN/hexN only)
+   const node_spacing &spacing = node_spacing::chebyshev);  // 1D nodes (quadN/hexN only)
+
+
+// Thread safe store of reference tables keyed by
+// (element type, quadrature rule, quadrature order, element order)
+class reference_cache {
+   public:
+
+      // table for a fixed order element, built on first use
+      const reference_table &get(
+         const element_type &type,
+         const quadrature_rule &rule,
+         const int &quad_order);
+
+      // table for any element, elem_order and spacing are only used by
+      // quadN/hexN
+      const reference_table &get(
+         const element_type &type,
+         const quadrature_rule &rule,
+         const int &quad_order,
+         const int &elem_order,
+         const node_spacing &spacing = node_spacing::chebyshev);
+
+      // number of tables built so far
+      std::size_t size() const;
+
+      // drop every table, invalidating references handed out earlier
+      void clear();
+
+      // process wide cache
+      static reference_cache &instance();
+
+   private:
+
+      using key_t = std::tuple<element_type, quadrature_rule, int, int, node_spacing>;
+
+      mutable std::mutex mutex_;
+      std::map< key_t, std::unique_ptr<reference_table> > tables_;
+};
+
+
+// evaluate positions, jacobians, determinants and inverse jacobians for a
+// block of elements using a precomputed reference table; the block refers to
+// the table's basis and partials, which must outlive it
+void evaluate_block(
+   element_block &block,            // results (resized as needed)
+   const reference_table &table,    // reference basis and partials
+   const real_t *vertices,          // element vertices [n_elem][n_node][dim]
+   const int &n_elem);              // number of elements
+
+} //end namespace elements
+} //end namespace ristra
+
+#endif //ELEMENTS_REFERENCE_CACHE_H
@@ -0,0 +1,340 @@
+#include <algorithm>
+
+#include "ristra/elements/sum_factorization.h"
+#include "ristra/elements/lagrange.h"
+#include "ristra/elements/node_sets.h"
+
+namespace ristra {
+namespace elements{
+
+namespace {
+
+// applies a [rows][cols] 1D operator along the middle index of a
+// [n_outer][.][n_inner] array,
+//    out[o][a][i] = sum_b A[a][b] in[o][b][i]     (rows out, cols in)
+// or, transposed,
+//    out[o][b][i] = sum_a A[a][b] in[o][a][i]     (cols out, rows in)
+void contract(
+   real_t *out,
+   const real_t *in,
+   const real_t *A,
+   const int &rows,
+   const int &cols,
+   const int &n_outer,
+   const int &n_inner,
+   const bool &transpose){
+
+   int n_in  = transpose ? rows : cols;
+   int n_out = transpose ? cols : rows;
+
+   for (int o = 0; o < n_outer; o++){
+
+      const real_t *in_o = in + o*n_in*n_inner;
+      real_t *out_o = out + o*n_out*n_inner;
+
+      for (int a = 0; a < n_out; a++){
+         real_t *out_a = out_o + a*n_inner;
+
+         for (int i = 0; i < n_inner; i++) out_a[i] = 0.0;
+
+         for (int b = 0; b < n_in; b++){
+            real_t A_ab = transpose ? A[b*cols + a] : A[a*cols + b];
+            const real_t *in_b = in_o + b*n_inner;
+
+            for (int i = 0; i < n_inner; i++) out_a[i] += A_ab*in_b[i];
+         } // end for b
+      } // end for a
+   } // end for o
+}
+
+// one element, (A_eta x A_xi) u or its transpose
+void apply_2d(
+   real_t *out,
+   const real_t *in,
+   const real_t *A_xi,
+   const real_t *A_eta,
+   const int &N,
+   const int &Q,
+   const bool &transpose,
+   real_t *scratch){
+
+   if (!transpose){
+      contract(scratch, in, A_xi, Q, N, N, 1, false);    // [N][Q]
+      contract(out, scratch, A_eta, Q, N, 1, Q, false);  // [Q][Q]
+   }
+   else {
+      contract(scratch, in, A_xi, Q, N, Q, 1, true);     // [Q][N]
+      contract(out, scratch, A_eta, Q, N, 1, N, true);   // [N][N]
+   }
+}
+
+// one element, (A_mu x A_eta x A_xi) u or its transpose
+void apply_3d(
+   real_t *out,
+   const real_t *in,
+   const real_t *A_xi,
+   const real_t *A_eta,
+   const real_t *A_mu,
+   const int &N,
+   const int &Q,
+   const bool &transpose,
+   real_t *scratch_1,
+   real_t *scratch_2){
+
+   if (!transpose){
+      contract(scratch_1, in, A_xi, Q, N, N*N, 1, false);        // [N][N][Q]
+      contract(scratch_2, scratch_1, A_eta, Q, N, N, Q, false);  // [N][Q][Q]
+      contract(out, scratch_2, A_mu, Q, N, 1, Q*Q, false);       // [Q][Q][Q]
+   }
+   else {
+      contract(scratch_1, in, A_xi, Q, N, Q*Q, 1, true);         // [Q][Q][N]
+      contract(scratch_2, scratch_1, A_eta, Q, N, Q, N, true);   // [Q][N][N]
+      contract(out, scratch_2, A_mu, Q, N, 1, N*N, true);        // [N][N][N]
+   }
+}
+
+} // namespace
+
+
+// builds the 1D tables for any node set and points
+void build_tensor_basis_1d(
+   tensor_basis_1d &basis,
+   const real_t *nodes,
+   const int &num_nodes,
+   const real_t *points,
+   const int &num_points){
+
+   basis.num_nodes  = num_nodes;
+   basis.num_points = num_points;
+   basis.val.resize(num_points*num_nodes);
+   basis.grad.resize(num_points*num_nodes);
+
+   lagrange_1d lagrange(nodes, num_nodes);
+   lagrange.evaluate(basis.val.data(), basis.grad.data(), points, num_points);
+}
+
+// builds the 1D tables of a QuadN/HexN element (Chebyshev nodes) for a rule
+void build_tensor_basis_1d(
+   tensor_basis_1d &basis,
+   const int &elem_order,
+   const quadrature_rule &rule,
+   const int &quad_order){
+
+   const node_set &nodes = get_node_set(node_spacing::chebyshev, elem_order);
+   const quadrature_1d &line = line_rule(rule, quad_order);
+
+   build_tensor_basis_1d(basis, nodes.nodes.data(), elem_order + 1,
+      line.points.data(), quad_order);
+}
+
+
+// nodal values to values at the points
+void interpolate_2d(
+   real_t *u_qp,
+   const real_t *u,
+   const tensor_basis_1d &basis,
+   const int &n_elem){
+
+   int N = basis.num_nodes;
+   int Q = basis.num_points;
+   const real_t *B = basis.val.data();
+
+   vector<real_t> scratch(N*Q);
+
+   for (int elem = 0; elem < n_elem; elem++){
+      apply_2d(u_qp + elem*Q*Q, u + elem*N*N, B, B, N, Q, false,
+         scratch.data());
+   } // end for elem
+}
+
+void interpolate_3d(
+   real_t *u_qp,
+   const real_t *u,
+   const tensor_basis_1d &basis,
+   const int &n_elem){
+
+   int N = basis.num_nodes;
+   int Q = basis.num_points;
+   int M = std::max(N, Q);
+   const real_t *B = basis.val.data();
+
+   vector<real_t> scratch_1(M*M*M);
+   vector<real_t> scratch_2(M*M*M);
+
+   for (int elem = 0; elem < n_elem; elem++){
+      apply_3d(u_qp + elem*Q*Q*Q, u + elem*N*N*N, B, B, B, N, Q, false,
+         scratch_1.data(), scratch_2.data());
+   } // end for elem
+}
+
+// nodal values to reference gradients at the points
+void gradient_2d(
+   real_t *grad_qp,
+   const real_t *u,
+   const tensor_basis_1d &basis,
+   const int &n_elem){
+
+   int N = basis.num_nodes;
+   int Q = basis.num_points;
+   int n_qp = Q*Q;
+   const real_t *B = basis.val.data();
+   const real_t *G = basis.grad.data();
+
+   vector<real_t> scratch(N*Q);
+   vector<real_t> component(n_qp);
+
+   for (int elem = 0; elem < n_elem; elem++){
+      const real_t *u_e = u + elem*N*N;
+      real_t *grad_e = grad_qp + elem*n_qp*2;
+
+      for (int d = 0; d < 2; d++){
+         apply_2d(component.data(), u_e, d == 0 ? G : B, d == 1 ? G : B,
+            N, Q, false, scratch.data());
+
+         for (int qp = 0; qp < n_qp; qp++) grad_e[qp*2 + d] = component[qp];
+      } // end for d
+   } // end for elem
+}
+
+void gradient_3d(
+   real_t *grad_qp,
+   const real_t *u,
+   const tensor_basis_1d &basis,
+   const int &n_elem){
+
+   int N = basis.num_nodes;
+   int Q = basis.num_points;
+   int M = std::max(N, Q);
+   int n_qp = Q*Q*Q;
+   const real_t *B = basis.val.data();
+   const real_t *G = basis.grad.data();
+
+   vector<real_t> scratch_1(M*M*M);
+   vector<real_t> scratch_2(M*M*M);
+   vector<real_t> component(n_qp);
+
+   for (int elem = 0; elem < n_elem; elem++){
+      const real_t *u_e = u + elem*N*N*N;
+      real_t *grad_e = grad_qp + elem*n_qp*3;
+
+      for (int d = 0; d < 3; d++){
+         apply_3d(component.data(), u_e, d == 0 ? G : B, d == 1 ? G : B,
+            d == 2 ? G : B, N, Q, false, scratch_1.data(), scratch_2.data());
+
+         for (int qp = 0; qp < n_qp; qp++) grad_e[qp*3 + d] = component[qp];
+      } // end for d
+   } // end for elem
+}
+
+// transpose of interpolate, values at the points to nodal residuals
+void integrate_2d(
+   real_t *r,
+   const real_t *f_qp,
+   const tensor_basis_1d &basis,
+   const int &n_elem){
+
+   int N = basis.num_nodes;
+   int Q = basis.num_points;
+   const real_t *B = basis.val.data();
+
+   vector<real_t> scratch(N*Q);
+
+   for (int elem = 0; elem < n_elem; elem++){
+      apply_2d(r + elem*N*N, f_qp + elem*Q*Q, B, B, N, Q, true,
+         scratch.data());
+   } // end for elem
+}
+
+void integrate_3d(
+   real_t *r,
+   const real_t *f_qp,
+   const tensor_basis_1d &basis,
+   const int &n_elem){
+
+   int N = basis.num_nodes;
+   int Q = basis.num_points;
+   int M = std::max(N, Q);
+   const real_t *B = basis.val.data();
+
+   vector<real_t> scratch_1(M*M*M);
+   vector<real_t> scratch_2(M*M*M);
+
+   for (int elem = 0; elem < n_elem; elem++){
+      apply_3d(r + elem*N*N*N, f_qp + elem*Q*Q*Q, B, B, B, N, Q, true,
+         scratch_1.data(), scratch_2.data());
+   } // end for elem
+}
+
+// transpose of gradient, vectors at the points to nodal residuals
+void integrate_gradient_2d(
+   real_t *r,
+   const real_t *f_qp,
+   const tensor_basis_1d &basis,
+   const int &n_elem){
+
+   int N = basis.num_nodes;
+   int Q = basis.num_points;
+   int n_qp = Q*Q;
+   const real_t *B = basis.val.data();
+   const real_t *G = basis.grad.data();
+
+   vector<real_t> scratch(N*Q);
+   vector<real_t> component(n_qp);
+   vector<real_t> r_d(N*N);
+
+   for (int elem = 0; elem < n_elem; elem++){
+      const real_t *f_e = f_qp + elem*n_qp*2;
+      real_t *r_e = r + elem*N*N;
+
+      for (int n = 0; n < N*N; n++) r_e[n] = 0.0;
+
+      for (int d = 0; d < 2; d++){
+         for (int qp = 0; qp < n_qp; qp++) component[qp] = f_e[qp*2 + d];
+
+         apply_2d(r_d.data(), component.data(), d == 0 ? G : B,
+            d == 1 ? G : B, N, Q, true, scratch.data());
+
+         for (int n = 0; n < N*N; n++) r_e[n] += r_d[n];
+      } // end for d
+   } // end for elem
+}
+
+void integrate_gradient_3d(
+   real_t *r,
+   const real_t *f_qp,
+   const tensor_basis_1d &basis,
+   const int &n_elem){
+
+   int N = basis.num_nodes;
+   int Q = basis.num_points;
+   int M = std::max(N, Q);
+   int n_qp = Q*Q*Q;
+   int n_node = N*N*N;
+   const real_t *B = basis.val.data();
+   const real_t *G = basis.grad.data();
+
+   vector<real_t> scratch_1(M*M*M);
+   vector<real_t> scratch_2(M*M*M);
+   vector<real_t> component(n_qp);
+   vector<real_t> r_d(n_node);
+
+   for (int elem = 0; elem < n_elem; elem++){
+      const real_t *f_e = f_qp + elem*n_qp*3;
+      real_t *r_e = r + elem*n_node;
+
+      for (int n = 0; n < n_node; n++) r_e[n] = 0.0;
+
+      for (int d = 0; d < 3; d++){
+         for (int qp = 0; qp < n_qp; qp++) component[qp] = f_e[qp*3 + d];
+
+         apply_3d(r_d.data(), component.data(), d == 0 ? G : B,
+            d == 1 ? G : B, d == 2 ? G : B, N, Q, true,
+            scratch_1.data(), scratch_2.data());
+
+         for (int n = 0; n < n_node; n++) r_e[n] += r_d[n];
+      } // end for d
+   } // end for elem
+}
+
+} // end namespace elements
+} // end namespace ristra
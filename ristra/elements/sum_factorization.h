@@ -0,0 +1,112 @@
+#ifndef ELEMENTS_SUM_FACTORIZATION_H
+#define ELEMENTS_SUM_FACTORIZATION_H
+
+#include "ristra/elements/quadrature.h"
+#include "ristra/elements/utilities.h"
+
+namespace ristra{
+namespace elements{
+
+/*
+ ==========================
+  Sum factorization
+ ==========================
+
+ Tensor product (QuadN/HexN) operators applied one direction at a time from
+ the 1D basis tables, O(N^(d+1)) work per element instead of the O(N^(2d))
+ of a dense basis table.
+
+ Nodal values are numbered as in QuadN/HexN and quadrature points as in the
+ tensor rules, xi fastest:
+
+    u[(k*N + j)*N + i],   u_qp[(qk*Q + qj)*Q + qi]
+
+ Gradients are in reference coordinates and interleaved per point,
+ grad_qp[qp][dim]. Every routine works on n_elem elements stored back to back.
+
+ The integrate routines apply the transposes of interpolate and gradient,
+ i.e. r_i = sum_qp phi_i(qp) f(qp). Quadrature weights and any geometric
+ factors must already be folded into f.
+*/
+
+// 1D Lagrange basis evaluated at the 1D quadrature points
+struct tensor_basis_1d {
+
+   int num_nodes  = 0;              // N, nodes per direction
+   int num_points = 0;              // Q, points per direction
+
+   aligned_vector<real_t> val;      // [Q][N]
+   aligned_vector<real_t> grad;     // [Q][N]
+};
+
+// builds the 1D tables for any node set and points
+void build_tensor_basis_1d(
+   tensor_basis_1d &basis,          // tables to fill
+   const real_t *nodes,             // 1D nodes [N]
+   const int &num_nodes,            // N
+   const real_t *points,            // 1D points [Q]
+   const int &num_points);          // Q
+
+// builds the 1D tables of a QuadN/HexN element (Chebyshev nodes) for a rule
+void build_tensor_basis_1d(
+   tensor_basis_1d &basis,          // tables to fill
+   const int &elem_order,           // element order, N = elem_order + 1
+   const quadrature_rule &rule,     // quadrature rule
+   const int &quad_order);          // Q
+
+// nodal values to values at the points
+void interpolate_2d(
+   real_t *u_qp,                    // values [n_elem][Q*Q]
+   const real_t *u,                 // nodal values [n_elem][N*N]
+   const tensor_basis_1d &basis,    // 1D tables
+   const int &n_elem);              // number of elements
+
+void interpolate_3d(
+   real_t *u_qp,                    // values [n_elem][Q*Q*Q]
+   const real_t *u,                 // nodal values [n_elem][N*N*N]
+   const tensor_basis_1d &basis,    // 1D tables
+   const int &n_elem);              // number of elements
+
+// nodal values to reference gradients at the points
+void gradient_2d(
+   real_t *grad_qp,                 // gradients [n_elem][Q*Q][2]
+   const real_t *u,                 // nodal values [n_elem][N*N]
+   const tensor_basis_1d &basis,    // 1D tables
+   const int &n_elem);              // number of elements
+
+void gradient_3d(
+   real_t *grad_qp,                 // gradients [n_elem][Q*Q*Q][3]
+   const real_t *u,                 // nodal values [n_elem][N*N*N]
+   const tensor_basis_1d &basis,    // 1D tables
+   const int &n_elem);              // number of elements
+
+// transpose of interpolate, values at the points to nodal residuals
+void integrate_2d(
+   real_t *r,                       // nodal residuals [n_elem][N*N]
+   const real_t *f_qp,              // values [n_elem][Q*Q]
+   const tensor_basis_1d &basis,    // 1D tables
+   const int &n_elem);              // number of elements
+
+void integrate_3d(
+   real_t *r,                       // nodal residuals [n_elem][N*N*N]
+   const real_t *f_qp,              // values [n_elem][Q*Q*Q]
+   const tensor_basis_1d &basis,    // 1D tables
+   const int &n_elem);              // number of elements
+
+// transpose of gradient, vectors at the points to nodal residuals
+void integrate_gradient_2d(
+   real_t *r,                       // nodal residuals [n_elem][N*N]
+   const real_t *f_qp,              // vectors [n_elem][Q*Q][2]
+   const tensor_basis_1d &basis,    // 1D tables
+   const int &n_elem);              // number of elements
+
+void integrate_gradient_3d(
+   real_t *r,                       // nodal residuals [n_elem][N*N*N]
+   const real_t *f_qp,              // vectors [n_elem][Q*Q*Q][3]
+   const tensor_basis_1d &basis,    // 1D tables
+   const int &n_elem);              // number of elements
+
+} //end namespace elements
+} //end namespace ristra
+
+#endif //ELEMENTS_SUM_FACTORIZATION_H
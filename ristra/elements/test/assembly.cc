@@ -0,0 +1,174 @@
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "ristra/elements/assembly.h"
+#include "ristra/elements/elements.h"
+#include "ristra/elements/utilities.h"
+#include "ristra/elements/test/fixtures.h"
+
+namespace elements = ristra::elements;
+using ristra::elements::vector;
+using ristra::elements::real_t;
+using ristra::elements::fixtures::make_box;
+using ristra::elements::fixtures::mesh_t;
+
+namespace {
+
+real_t sum_all(const elements::csr_matrix &A){
+   real_t sum = 0.0;
+   for (auto v : A.values) sum += v;
+   return sum;
+}
+
+} // namespace
+
+TEST(assembly, coloring) {
+
+   const int n[3] = {5, 4, 3};
+   const real_t length[3] = {1.0, 1.0, 1.0};
+   mesh_t mesh = make_box(3, n, length);
+
+   vector<int> colors(mesh.n_elem);
+   int n_colors = elements::color_elements(colors.data(),
+      mesh.connectivity.data(), mesh.n_elem, mesh.n_node, mesh.n_global);
+
+   ASSERT_LE(n_colors, 8);
+
+   // elements of one color share no node
+   for (int c = 0; c < n_colors; c++){
+      vector<int> touched(mesh.n_global, 0);
+      for (int elem = 0; elem < mesh.n_elem; elem++){
+         if (colors[elem] != c) continue;
+         for (int node = 0; node < mesh.n_node; node++){
+            int g = mesh.connectivity[elem*mesh.n_node + node];
+            ASSERT_EQ(0, touched[g]);
+            touched[g] = 1;
+         }
+      }
+   }
+
+   // 27 point stencil in the interior
+   elements::csr_matrix A;
+   elements::build_sparsity(A, mesh.connectivity.data(), mesh.n_elem,
+      mesh.n_node, mesh.n_global);
+   int interior = (1*5 + 1)*6 + 1;    // node (1,1,1)
+   ASSERT_EQ(27, A.row_ptr[interior + 1] - A.row_ptr[interior]);
+   ASSERT_EQ(-1, A.find(0, mesh.n_global - 1));
+}
+
+TEST(assembly, hex8) {
+
+   const int n[3] = {4, 3, 5};
+   const real_t length[3] = {2.0, 1.0, 1.5};
+   const real_t volume = 3.0;
+   mesh_t mesh = make_box(3, n, length);
+
+   elements::assembly_options serial;
+   serial.n_threads = 1;
+
+   elements::assembly_options colored;
+   colored.n_threads = 4;
+
+   elements::assembly_options atomic;
+   atomic.n_threads = 4;
+   atomic.mode = elements::scatter_mode::atomic;
+
+   elements::csr_matrix M[3], K[3];
+   int i = 0;
+   for (auto &options : {serial, colored, atomic}){
+      elements::assembler assembler(elements::element_type::hex8,
+         mesh.coords.data(), mesh.n_global, mesh.connectivity.data(),
+         mesh.n_elem, elements::quadrature_rule::gauss, 2, options);
+      assembler.mass(M[i]);
+      assembler.stiffness(K[i]);
+      i++;
+   }
+
+   ASSERT_NEAR(volume, sum_all(M[0]), 1e-12);
+
+   // constants are in the kernel, u = x has energy |grad u|^2 volume
+   vector<real_t> ones(mesh.n_global, 1.0), x(mesh.n_global), Kx(mesh.n_global);
+   for (int g = 0; g < mesh.n_global; g++) x[g] = mesh.coords[g*3];
+
+   K[0].multiply(Kx.data(), ones.data());
+   for (auto v : Kx) ASSERT_NEAR(0.0, v, 1e-12);
+
+   K[0].multiply(Kx.data(), x.data());
+   real_t energy = 0.0;
+   for (int g = 0; g < mesh.n_global; g++) energy += x[g]*Kx[g];
+   ASSERT_NEAR(volume, energy, 1e-12);
+
+   // coloring adds in the same order whatever the thread count, the atomic
+   // mode only up to round off
+   for (int k = 0; k < M[0].nnz(); k++){
+      ASSERT_EQ(M[0].values[k], M[1].values[k]);
+      ASSERT_EQ(K[0].values[k], K[1].values[k]);
+      ASSERT_NEAR(M[0].values[k], M[2].values[k], 1e-14);
+      ASSERT_NEAR(K[0].values[k], K[2].values[k], 1e-13);
+   }
+}
+
+TEST(assembly, quad4) {
+
+   const int n[2] = {6, 3};
+   const real_t length[2] = {1.5, 0.5};
+   mesh_t mesh = make_box(2, n, length);
+
+   elements::assembly_options options;
+   options.n_threads = 3;
+
+   elements::assembler assembler(elements::element_type::quad4,
+      mesh.coords.data(), mesh.n_global, mesh.connectivity.data(),
+      mesh.n_elem, elements::quadrature_rule::gauss, 2, options);
+   ASSERT_LE(assembler.num_colors(), 4);
+
+   elements::csr_matrix M, K;
+   assembler.mass(M);
+   assembler.stiffness(K);
+
+   ASSERT_NEAR(0.75, sum_all(M), 1e-14);
+
+   // u = y
+   vector<real_t> y(mesh.n_global), Ky(mesh.n_global);
+   for (int g = 0; g < mesh.n_global; g++) y[g] = mesh.coords[g*2 + 1];
+   K.multiply(Ky.data(), y.data());
+
+   real_t energy = 0.0;
+   for (int g = 0; g < mesh.n_global; g++) energy += y[g]*Ky[g];
+   ASSERT_NEAR(0.75, energy, 1e-13);
+}
+
+TEST(assembly, atomic_dirty_heap) {
+
+   const int n[2] = {5, 4};
+   const real_t length[2] = {1.0, 2.0};
+   mesh_t mesh = make_box(2, n, length);
+
+   elements::assembly_options colored, atomic;
+   colored.n_threads = 2;
+   atomic.n_threads = 2;
+   atomic.mode = elements::scatter_mode::atomic;
+
+   elements::assembler by_color(elements::element_type::quad4,
+      mesh.coords.data(), mesh.n_global, mesh.connectivity.data(),
+      mesh.n_elem, elements::quadrature_rule::gauss, 2, colored);
+   elements::assembler by_atomic(elements::element_type::quad4,
+      mesh.coords.data(), mesh.n_global, mesh.connectivity.data(),
+      mesh.n_elem, elements::quadrature_rule::gauss, 2, atomic);
+
+   elements::csr_matrix expected, A;
+   by_color.stiffness(expected);
+   by_atomic.stiffness(A);
+
+   // the atomic accumulators must not pick up what freed memory held
+   for (int pass = 0; pass < 4; pass++){
+      {
+         vector<real_t> junk(expected.nnz(), 1.0e300);
+         ASSERT_EQ(1.0e300, junk.back());
+      }
+      by_atomic.stiffness(A);
+      for (int k = 0; k < A.nnz(); k++)
+         ASSERT_NEAR(expected.values[k], A.values[k], 1e-14);
+   }
+}
@@ -0,0 +1,278 @@
+#include <algorithm>
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "ristra/elements/batched.h"
+#include "ristra/elements/element_kernels.h"
+#include "ristra/elements/elements.h"
+#include "ristra/elements/utilities.h"
+#include "ristra/elements/test/fixtures.h"
+
+namespace elements = ristra::elements;
+using ristra::elements::vector;
+using ristra::elements::real_t;
+using ristra::elements::fixtures::make_points;
+using ristra::elements::fixtures::make_vertices;
+
+TEST(batched, hex) {
+
+   const int n_elem = 3;
+   const int n_qp = 7;
+   const int dim = 3;
+
+   elements::Hex20 hex20;
+   elements::Hex32 hex32;
+
+   struct case_t { elements::element_type type; elements::Element3D *elem;
+                   const real_t *ref_vert; };
+   case_t cases[] = {
+      {elements::element_type::hex20, &hex20, &elements::Hex20::ref_vert[0][0]},
+      {elements::element_type::hex32, &hex32, &elements::Hex32::ref_vert[0][0]}
+   };
+
+   for (auto &c : cases){
+
+      int n_node = elements::num_nodes(c.type);
+      ASSERT_EQ(dim, elements::num_dim(c.type));
+
+      auto verts = make_vertices(c.ref_vert, n_node, dim, n_elem);
+      auto points = make_points(dim, n_qp);
+
+      elements::element_block block;
+      elements::evaluate_block(block, c.type, verts.data(), n_elem,
+         points.data(), n_qp);
+
+      vector< vector<real_t> > J(dim, vector<real_t>(dim));
+      vector< vector<real_t> > partial(n_node, vector<real_t>(dim));
+      vector< vector<real_t> > vertices(n_node, vector<real_t>(dim));
+      vector<real_t> xi(dim), x(dim), val(n_node);
+      vector<real_t> p_xi(n_node), p_eta(n_node), p_mu(n_node);
+
+      for (int elem = 0; elem < n_elem; elem++){
+         for (int node = 0; node < n_node; node++)
+            for (int d = 0; d < dim; d++)
+               vertices[node][d] = verts[(elem*n_node + node)*dim + d];
+
+         for (int qp = 0; qp < n_qp; qp++){
+            for (int d = 0; d < dim; d++) xi[d] = points[qp*dim + d];
+
+            // reference tables match the per point routines
+            c.elem->basis(val, xi, vertices);
+            c.elem->partial_xi_shape_fcn(p_xi, xi);
+            c.elem->partial_eta_shape_fcn(p_eta, xi);
+            c.elem->partial_mu_shape_fcn(p_mu, xi);
+            for (int node = 0; node < n_node; node++){
+               ASSERT_DOUBLE_EQ(val[node], block.basis[qp*n_node + node]);
+               partial[node][0] = p_xi[node];
+               partial[node][1] = p_eta[node];
+               partial[node][2] = p_mu[node];
+            }
+
+            // positions
+            c.elem->physical_position(x, xi, vertices);
+            for (int d = 0; d < dim; d++)
+               ASSERT_NEAR(x[d], block.x_points[(elem*n_qp + qp)*dim + d], 1e-12);
+
+            // jacobian and determinant
+            real_t det_J;
+            elements::jacobian(J, det_J, vertices, partial, n_node, dim);
+            int m = elem*n_qp + qp;
+            ASSERT_NEAR(det_J, block.det_J[m], 1e-12);
+            for (int j = 0; j < dim; j++)
+               for (int k = 0; k < dim; k++)
+                  ASSERT_NEAR(J[j][k], block.J_matrix[m*9 + j*3 + k], 1e-12);
+
+            // inverse
+            for (int i = 0; i < dim; i++){
+               for (int j = 0; j < dim; j++){
+                  real_t sum = 0.0;
+                  for (int k = 0; k < dim; k++)
+                     sum += block.J_matrix[m*9 + i*3 + k]
+                          * block.J_inverse[m*9 + k*3 + j];
+                  ASSERT_NEAR(i == j ? 1.0 : 0.0, sum, 1e-12);
+               }
+            }
+         } // end for qp
+      } // end for elem
+   } // end for cases
+}
+
+TEST(batched, quad) {
+
+   const int n_elem = 2;
+   const int n_qp = 5;
+   const int dim = 2;
+
+   elements::Quad_8_2D quad8;
+   elements::Quad_12_2D quad12;
+
+   struct case_t { elements::element_type type; elements::Element2D *elem;
+                   const real_t *ref_vert; };
+   case_t cases[] = {
+      {elements::element_type::quad8, &quad8, &elements::Quad_8_2D::ref_vert[0][0]},
+      {elements::element_type::quad12, &quad12, &elements::Quad_12_2D::ref_vert[0][0]}
+   };
+
+   for (auto &c : cases){
+
+      int n_node = elements::num_nodes(c.type);
+      ASSERT_EQ(dim, elements::num_dim(c.type));
+
+      // the basis interpolates: kronecker delta at the nodes
+      vector<real_t> basis(n_node*n_node), partials(n_node*n_node*dim);
+      elements::reference_basis(basis.data(), partials.data(), c.ref_vert,
+         n_node, c.type);
+      for (int i = 0; i < n_node; i++)
+         for (int node = 0; node < n_node; node++)
+            ASSERT_NEAR(i == node ? 1.0 : 0.0, basis[i*n_node + node], 1e-14);
+
+      auto verts = make_vertices(c.ref_vert, n_node, dim, n_elem);
+      auto points = make_points(dim, n_qp);
+
+      elements::element_block block;
+      elements::evaluate_block(block, c.type, verts.data(), n_elem,
+         points.data(), n_qp);
+
+      vector< vector<real_t> > vertices(n_node, vector<real_t>(dim));
+      vector<real_t> xi(dim), x(dim);
+
+      for (int elem = 0; elem < n_elem; elem++){
+         for (int node = 0; node < n_node; node++)
+            for (int d = 0; d < dim; d++)
+               vertices[node][d] = verts[(elem*n_node + node)*dim + d];
+
+         for (int qp = 0; qp < n_qp; qp++){
+            for (int d = 0; d < dim; d++) xi[d] = points[qp*dim + d];
+            int m = elem*n_qp + qp;
+
+            // partition of unity
+            real_t sum = 0.0;
+            for (int node = 0; node < n_node; node++)
+               sum += block.basis[qp*n_node + node];
+            ASSERT_NEAR(1.0, sum, 1e-14);
+
+            // positions
+            c.elem->physical_position(x, xi, vertices);
+            for (int d = 0; d < dim; d++)
+               ASSERT_NEAR(x[d], block.x_points[m*dim + d], 1e-12);
+
+            // the quadratic map is reproduced, so the jacobian is exact
+            const real_t *J = &block.J_matrix[m*4];
+            ASSERT_NEAR(1.5 + 0.1*xi[1], J[0], 1e-12);
+            ASSERT_NEAR(0.1*xi[0], J[1], 1e-12);
+            ASSERT_NEAR(0.1*xi[0], J[2], 1e-12);
+            ASSERT_NEAR(0.8, J[3], 1e-12);
+            ASSERT_NEAR(J[0]*J[3] - J[1]*J[2], block.det_J[m], 1e-14);
+
+            // inverse
+            const real_t *J_inv = &block.J_inverse[m*4];
+            for (int i = 0; i < dim; i++)
+               for (int j = 0; j < dim; j++)
+                  ASSERT_NEAR(i == j ? 1.0 : 0.0,
+                     J[i*2 + 0]*J_inv[0*2 + j] + J[i*2 + 1]*J_inv[1*2 + j], 1e-12);
+         } // end for qp
+      } // end for elem
+   } // end for cases
+}
+
+namespace {
+
+// determinant by the permutation (Leibniz) sum
+real_t leibniz_det_4(const real_t *A){
+   int p[4] = {0, 1, 2, 3};
+   real_t det = 0.0;
+   do {
+      int inversions = 0;
+      for (int i = 0; i < 4; i++)
+         for (int j = i + 1; j < 4; j++) inversions += p[i] > p[j];
+      real_t term = (inversions % 2) ? -1.0 : 1.0;
+      for (int i = 0; i < 4; i++) term *= A[i*4 + p[i]];
+      det += term;
+   } while (std::next_permutation(p, p + 4));
+   return det;
+}
+
+} // namespace
+
+TEST(batched, tess16) {
+
+   const int n_elem = 2;
+   const int n_qp = 6;
+   const int dim = 4;
+   const int n_node = 16;
+
+   const real_t A[4][4] = {{1.2, 0.1, 0.0, 0.2},
+                           {0.0, 0.9, 0.3, 0.0},
+                           {0.1, 0.0, 1.1, 0.0},
+                           {0.0, 0.2, 0.0, 0.7}};
+
+   // x = A xi + shift, plus a bilinear term in the first coordinate
+   vector<real_t> verts(n_elem*n_node*dim);
+   for (int elem = 0; elem < n_elem; elem++)
+      for (int node = 0; node < n_node; node++){
+         const real_t *xi = elements::tess16_kernel::ref_vert[node];
+         real_t *x = &verts[(elem*n_node + node)*dim];
+         for (int k = 0; k < dim; k++){
+            x[k] = 2.5*elem*(k == 0);
+            for (int j = 0; j < dim; j++) x[k] += A[k][j]*xi[j];
+         }
+         x[0] += 0.1*xi[1]*xi[3];
+      }
+
+   auto points = make_points(dim, n_qp);
+
+   elements::element_block block;
+   elements::evaluate_tess16_block(block, verts.data(), n_elem, points.data(), n_qp);
+
+   ASSERT_EQ(elements::element_type::tess16, block.type);
+   ASSERT_EQ(dim, block.dim);
+   ASSERT_EQ(n_node, block.n_node);
+   ASSERT_EQ(n_node, elements::num_nodes(elements::element_type::tess16));
+   ASSERT_EQ(dim, elements::num_dim(elements::element_type::tess16));
+
+   // the generic entry point dispatches to the same kernel
+   elements::element_block generic;
+   elements::evaluate_block(generic, elements::element_type::tess16, verts.data(),
+      n_elem, points.data(), n_qp);
+   ASSERT_EQ(block.det_J, generic.det_J);
+   ASSERT_EQ(block.J_inverse, generic.J_inverse);
+
+   elements::Tess16 tess16;
+   vector< vector<real_t> > vertices(n_node, vector<real_t>(dim));
+   vector<real_t> xi(dim), x(dim);
+
+   for (int elem = 0; elem < n_elem; elem++){
+      for (int node = 0; node < n_node; node++)
+         for (int d = 0; d < dim; d++)
+            vertices[node][d] = verts[(elem*n_node + node)*dim + d];
+
+      for (int qp = 0; qp < n_qp; qp++){
+         for (int d = 0; d < dim; d++) xi[d] = points[qp*dim + d];
+         int m = elem*n_qp + qp;
+
+         tess16.physical_position(x, xi, vertices);
+         for (int d = 0; d < dim; d++)
+            ASSERT_NEAR(x[d], block.x_points[m*dim + d], 1e-13);
+
+         // J[j][k] = dx_k/dxi_j
+         real_t J_exact[16];
+         for (int j = 0; j < dim; j++)
+            for (int k = 0; k < dim; k++) J_exact[j*4 + k] = A[k][j];
+         J_exact[1*4 + 0] += 0.1*xi[3];
+         J_exact[3*4 + 0] += 0.1*xi[1];
+
+         const real_t *J = &block.J_matrix[m*16];
+         for (int i = 0; i < 16; i++) ASSERT_NEAR(J_exact[i], J[i], 1e-13);
+         ASSERT_NEAR(leibniz_det_4(J_exact), block.det_J[m], 1e-13);
+
+         const real_t *J_inv = &block.J_inverse[m*16];
+         for (int i = 0; i < dim; i++)
+            for (int j = 0; j < dim; j++){
+               real_t sum = 0.0;
+               for (int k = 0; k < dim; k++) sum += J[i*4 + k]*J_inv[k*4 + j];
+               ASSERT_NEAR(i == j ? 1.0 : 0.0, sum, 1e-13);
+            }
+      } // end for qp
+   } // end for elem
+}
@@ -0,0 +1,165 @@
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "ristra/elements/collocation.h"
+#include "ristra/elements/elements.h"
+#include "ristra/elements/lagrange.h"
+#include "ristra/elements/reference_cache.h"
+#include "ristra/elements/utilities.h"
+#include "ristra/elements/test/fixtures.h"
+
+namespace elements = ristra::elements;
+using ristra::elements::vector;
+using ristra::elements::real_t;
+using ristra::elements::fixtures::lagrange_nodes;
+using ristra::elements::fixtures::make_merged_mesh;
+using ristra::elements::fixtures::map_nodes;
+using ristra::elements::fixtures::mesh_t;
+
+namespace {
+
+// n^dim unit cells of GLL QuadN/HexN elements, sheared so det J stays
+// constant
+mesh_t make_mesh(int dim, int order, int n){
+
+   mesh_t mesh = make_merged_mesh(
+      lagrange_nodes(dim, order, elements::node_spacing::lobatto), dim, n);
+   map_nodes(mesh, [dim](real_t *y, const real_t *x){
+      y[0] = x[0] + 0.1*std::sin(x[1]);
+      if (dim == 3) y[1] = x[1] + 0.1*std::cos(x[2]);
+   });
+   return mesh;
+}
+
+void check_mass(elements::element_type type, int dim, int order){
+
+   const int n = 3;
+   mesh_t mesh = make_mesh(dim, order, n);
+
+   elements::collocation_mass mass(type, mesh.coords.data(), mesh.n_global,
+      mesh.connectivity.data(), mesh.n_elem, order);
+
+   // the shear keeps the volume, and the last coordinate is exactly linear
+   real_t volume = 0.0, moment = 0.0;
+   for (int g = 0; g < mesh.n_global; g++){
+      ASSERT_GT(mass.diagonal()[g], 0.0);
+      volume += mass.diagonal()[g];
+      moment += mass.diagonal()[g]*mesh.coords[g*dim + dim - 1];
+   }
+   real_t box = std::pow(real_t(n), dim);
+   ASSERT_NEAR(box, volume, 1e-12*box);
+   ASSERT_NEAR(0.5*n*box, moment, 1e-12*box*n);
+
+   // M^-1 M is the identity
+   vector<real_t> x(mesh.n_global), y(mesh.n_global), z(mesh.n_global);
+   for (int g = 0; g < mesh.n_global; g++) x[g] = std::cos(0.37*g);
+   mass.apply(y.data(), x.data());
+   mass.apply_inverse(z.data(), y.data());
+   for (int g = 0; g < mesh.n_global; g++) ASSERT_NEAR(x[g], z[g], 1e-14);
+
+   // interpolation is a gather
+   vector<real_t> u_points(mesh.n_elem*mass.num_points());
+   mass.interpolate(u_points.data(), x.data());
+   for (int i = 0; i < mesh.n_elem*mass.num_points(); i++)
+      ASSERT_EQ(x[mesh.connectivity[i]], u_points[i]);
+}
+
+} // namespace
+
+TEST(collocation, nodes) {
+
+   for (int order = 1; order <= 6; order++){
+      int N = order + 1;
+      const elements::quadrature_1d &rule =
+         elements::line_rule(elements::quadrature_rule::lobatto, N);
+
+      vector<real_t> gll(N), cheb(N);
+      elements::QuadN().lobatto_nodes_1D(gll, order);
+      elements::QuadN().chebyshev_nodes_1D(cheb, order);
+
+      ASSERT_TRUE(elements::is_collocated(gll.data(), N, rule));
+      ASSERT_EQ(order <= 2, elements::is_collocated(cheb.data(), N, rule));
+      ASSERT_FALSE(elements::is_collocated(gll.data(), N,
+         elements::line_rule(elements::quadrature_rule::gauss, N)));
+
+      // identity basis table, and D differentiates polynomials of the order
+      elements::lagrange_1d lagrange(gll.data(), N);
+      vector<real_t> val(N), deriv(N), D(N*N);
+      elements::differentiation_matrix(D.data(), gll.data(), N);
+
+      for (int q = 0; q < N; q++){
+         lagrange.evaluate(val.data(), deriv.data(), rule.points[q]);
+
+         real_t dp = 0.0;
+         for (int node = 0; node < N; node++){
+            ASSERT_NEAR((node == q) ? 1.0 : 0.0, val[node], 1e-14);
+            dp += D[q*N + node]*std::pow(gll[node], order);
+         }
+         ASSERT_NEAR(order*std::pow(gll[q], order - 1), dp, 1e-11);
+      }
+   }
+}
+
+TEST(collocation, lumped_mass) {
+   for (int order = 1; order <= 4; order++){
+      check_mass(elements::element_type::quadN, 2, order);
+      check_mass(elements::element_type::hexN, 3, order);
+   }
+}
+
+TEST(collocation, reference_table) {
+
+   elements::reference_cache cache;
+
+   for (int order = 1; order <= 4; order++){
+      int N = order + 1;
+
+      // the same table evaluated through the full Lagrange basis
+      const elements::tensor_quadrature &rule =
+         elements::tensor_rule(elements::quadrature_rule::lobatto, N, 3);
+      elements::reference_table full;
+      full.points.assign(rule.points.begin(), rule.points.end());
+      int n_node = N*N*N;
+      full.basis.resize(n_node*n_node);
+      full.partials.resize(n_node*n_node*3);
+      elements::lagrange_reference_basis(full.basis.data(), full.partials.data(),
+         full.points.data(), n_node, 3, order, elements::node_spacing::lobatto);
+
+      const elements::reference_table &table = cache.get(elements::element_type::hexN,
+         elements::quadrature_rule::lobatto, N, order, elements::node_spacing::lobatto);
+
+      ASSERT_TRUE(table.collocated);
+      for (int i = 0; i < n_node*n_node; i++)
+         ASSERT_NEAR(full.basis[i], table.basis[i], 1e-13);
+      for (int i = 0; i < n_node*n_node*3; i++)
+         ASSERT_NEAR(full.partials[i], table.partials[i], 1e-11);
+
+      // the points of a block are the vertices, the jacobian is unchanged
+      const elements::node_set &nodes =
+         elements::get_node_set(elements::node_spacing::lobatto, order);
+      vector<real_t> vertices(nodes.nodes_3d.begin(), nodes.nodes_3d.end());
+      for (int node = 0; node < n_node; node++)
+         vertices[node*3] += 0.1*std::sin(vertices[node*3 + 1]);
+
+      elements::element_block block, reference;
+      elements::evaluate_block(block, table, vertices.data(), 1);
+      for (int i = 0; i < n_node*3; i++)
+         ASSERT_EQ(vertices[i], block.x_points[i]);
+
+      full.n_qp = full.n_node = n_node;
+      full.dim = 3;
+      full.type = elements::element_type::hexN;
+      elements::evaluate_block(reference, full, vertices.data(), 1);
+      for (int i = 0; i < n_node*3; i++)
+         ASSERT_NEAR(reference.x_points[i], block.x_points[i], 1e-13);
+      for (int i = 0; i < n_node; i++)
+         ASSERT_NEAR(reference.det_J[i], block.det_J[i], 1e-12);
+   }
+
+   // Chebyshev nodes above order 2 and Gauss points are not collocated
+   ASSERT_FALSE(cache.get(elements::element_type::hexN,
+      elements::quadrature_rule::lobatto, 4, 3).collocated);
+   ASSERT_FALSE(cache.get(elements::element_type::quadN,
+      elements::quadrature_rule::gauss, 3, 2, elements::node_spacing::lobatto).collocated);
+}
@@ -0,0 +1,134 @@
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "ristra/elements/element_kernels.h"
+#include "ristra/elements/elements.h"
+#include "ristra/elements/utilities.h"
+
+namespace elements = ristra::elements;
+using ristra::elements::vector;
+using ristra::elements::real_t;
+
+namespace {
+
+// nodal interpolation, partition of unity and finite difference partials
+template<class Kernel>
+void check_kernel(){
+
+   const int dim = Kernel::num_dim;
+   const int n_node = Kernel::num_nodes;
+
+   real_t basis[n_node];
+
+   for (int node = 0; node < n_node; node++){
+      Kernel::basis(basis, Kernel::ref_vert[node]);
+      for (int i = 0; i < n_node; i++)
+         ASSERT_NEAR(i == node ? 1.0 : 0.0, basis[i], 1e-14);
+   }
+
+   const real_t h = 1e-6;
+   real_t xi[dim], partials[n_node*dim];
+   for (int d = 0; d < dim; d++) xi[d] = 0.3 - 0.25*d;
+
+   Kernel::basis(basis, xi);
+   Kernel::partials(partials, xi);
+
+   real_t unity = 0.0;
+   for (int node = 0; node < n_node; node++) unity += basis[node];
+   ASSERT_NEAR(1.0, unity, 1e-14);
+
+   for (int d = 0; d < dim; d++){
+      real_t xi_p[dim], xi_m[dim], b_p[n_node], b_m[n_node];
+      for (int k = 0; k < dim; k++) xi_p[k] = xi_m[k] = xi[k];
+      xi_p[d] += h;
+      xi_m[d] -= h;
+      Kernel::basis(b_p, xi_p);
+      Kernel::basis(b_m, xi_m);
+
+      for (int node = 0; node < n_node; node++)
+         ASSERT_NEAR((b_p[node] - b_m[node])/(2*h), partials[node*dim + d], 1e-8);
+   }
+}
+
+} // namespace
+
+TEST(element_kernels, shape_functions) {
+   check_kernel<elements::quad4_kernel>();
+   check_kernel<elements::quad8_kernel>();
+   check_kernel<elements::quad12_kernel>();
+   check_kernel<elements::hex8_kernel>();
+   check_kernel<elements::hex20_kernel>();
+   check_kernel<elements::hex32_kernel>();
+}
+
+TEST(element_kernels, visit_matches_virtual) {
+
+   const int n_qp = 5;
+   vector<real_t> points(n_qp*3);
+   for (int i = 0; i < n_qp*3; i++) points[i] = std::sin(0.9*i + 0.1);
+
+   const elements::Hex20 hex20;
+   const elements::Element3D &element = hex20;
+
+   vector<real_t> basis(n_qp*20), partials(n_qp*20*3);
+   elements::visit_element_kernel(elements::element_type::hex20,
+      [&](auto kernel){
+         ASSERT_EQ(3, decltype(kernel)::num_dim);
+         decltype(kernel)::reference_basis(basis.data(), partials.data(),
+            points.data(), n_qp);
+      });
+
+   vector<real_t> xi(3), val(20), p_xi(20), p_eta(20), p_mu(20);
+   vector< vector<real_t> > no_vertices;
+   for (int qp = 0; qp < n_qp; qp++){
+      for (int d = 0; d < 3; d++) xi[d] = points[qp*3 + d];
+
+      element.basis(val, xi, no_vertices);
+      element.partial_xi_shape_fcn(p_xi, xi);
+      element.partial_eta_shape_fcn(p_eta, xi);
+      element.partial_mu_shape_fcn(p_mu, xi);
+
+      for (int node = 0; node < 20; node++){
+         ASSERT_EQ(val[node], basis[qp*20 + node]);
+         ASSERT_EQ(p_xi[node], partials[(qp*20 + node)*3 + 0]);
+         ASSERT_EQ(p_eta[node], partials[(qp*20 + node)*3 + 1]);
+         ASSERT_EQ(p_mu[node], partials[(qp*20 + node)*3 + 2]);
+      }
+   }
+}
+
+// element evaluators hold no per call state, so one const object can be
+// shared by every caller
+TEST(element_kernels, const_evaluators) {
+
+   const elements::Hex20 hex20;
+   const elements::Tess16 tess16;
+   const elements::Element3D &element = hex20;
+
+   vector< vector<real_t> > vertices(20, vector<real_t>(3));
+   for (int node = 0; node < 20; node++)
+      for (int dim = 0; dim < 3; dim++)
+         vertices[node][dim] = 2.0*elements::Hex20::ref_vert[node][dim];
+
+   vector<real_t> xi = {0.1, -0.3, 0.6};
+   vector<real_t> x(3), basis(20);
+
+   element.physical_position(x, xi, vertices);
+   element.basis(basis, xi, vertices);
+
+   real_t unity = 0.0;
+   for (int node = 0; node < 20; node++) unity += basis[node];
+   ASSERT_NEAR(1.0, unity, 1e-14);
+   for (int dim = 0; dim < 3; dim++) ASSERT_NEAR(2.0*xi[dim], x[dim], 1e-14);
+
+   // the tesseract partials come from shared, static reference data
+   vector<real_t> xi_4d = {0.2, 0.4, -0.1, 0.3};
+   vector<real_t> partial_tau(16);
+   tess16.partial_tau_shape_fcn(partial_tau, xi_4d);
+
+   real_t sum = 0.0;
+   for (int node = 0; node < 16; node++) sum += partial_tau[node];
+   ASSERT_NEAR(0.0, sum, 1e-14);
+   ASSERT_NE(0.0, std::abs(partial_tau[0]));
+}
@@ -0,0 +1,218 @@
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "ristra/elements/element_kernels.h"
+#include "ristra/elements/faces.h"
+#include "ristra/elements/reference_cache.h"
+#include "ristra/elements/utilities.h"
+#include "ristra/elements/test/fixtures.h"
+
+namespace elements = ristra::elements;
+using ristra::elements::vector;
+using ristra::elements::real_t;
+using ristra::elements::fixtures::flatten;
+using ristra::elements::fixtures::make_lattice_box;
+using ristra::elements::fixtures::map_nodes;
+using ristra::elements::fixtures::mesh_t;
+
+namespace {
+
+// n^dim QuadN/HexN mesh of the box [0,lx]x[0,ly]x[0,lz], the interior
+// nodes pushed by a smooth distortion vanishing on the boundary
+mesh_t bumped_box(int dim, int n, int order, const real_t *length, real_t shake){
+
+   const real_t unit[3] = {1.0, 1.0, 1.0};
+
+   // the node lattice is uniform so the element order only sets the
+   // spacing, which is exact for order 1 and 2
+   mesh_t mesh = make_lattice_box(dim, n, order, unit);
+   map_nodes(mesh, [=](real_t *y, const real_t *s){
+      real_t bump = std::sin(M_PI*s[0])*std::sin(M_PI*s[1]);
+      if (dim == 3) bump *= std::sin(M_PI*s[2]);
+      for (int d = 0; d < dim; d++)
+         y[d] = length[d]*(s[d] + shake*bump*(d + 1));
+   });
+   return mesh;
+}
+
+// one element made from the distorted reference nodes
+template<int N, int Dim>
+mesh_t make_element(const real_t (&ref_vert)[N][Dim]){
+
+   mesh_t mesh;
+   mesh.dim = Dim;
+   mesh.n_global = N;
+   mesh.n_elem = 1;
+   mesh.n_node = N;
+   mesh.coords = flatten(ref_vert);
+   for (int node = 0; node < N; node++) mesh.connectivity.push_back(node);
+
+   map_nodes(mesh, [](real_t *y, const real_t *xi){
+      for (int d = 0; d < Dim; d++)
+         y[d] = (1.0 + 0.2*d)*xi[d] + 0.05*xi[(d + 1) % Dim]*xi[(d + 1) % Dim];
+   });
+   return mesh;
+}
+
+// closed surface checks, sum n dS = 0 and sum x.n dS = dim*volume
+void check_divergence(elements::element_type type, const mesh_t &mesh,
+   int order, int quad_order){
+
+   int dim = mesh.dim;
+
+   vector<int> faces;
+   elements::boundary_faces(faces, type, mesh.connectivity.data(), mesh.n_elem, order);
+
+   int n = std::lround(std::pow(mesh.n_elem, 1.0/dim));
+   ASSERT_EQ(2*dim*((dim == 3) ? n*n : n), int(faces.size()/2));
+
+   vector<elements::face_table> tables;
+   elements::build_face_tables(tables, type, elements::quadrature_rule::gauss,
+      quad_order, order);
+
+   elements::face_block block;
+   elements::evaluate_faces(block, tables, mesh.coords.data(),
+      mesh.connectivity.data(), faces.data(), faces.size()/2);
+
+   real_t flux[3] = {0.0, 0.0, 0.0};
+   real_t x_dot_n = 0.0;
+   for (int m = 0; m < block.n_faces*block.n_qp; m++){
+      real_t norm = 0.0;
+      for (int d = 0; d < dim; d++){
+         real_t n_d = block.normals[m*dim + d];
+         norm += n_d*n_d;
+         flux[d] += block.w_det_S[m]*n_d;
+         x_dot_n += block.w_det_S[m]*n_d*block.x_points[m*dim + d];
+      }
+      ASSERT_NEAR(1.0, norm, 1e-13);
+   }
+
+   // volume from the reference table
+   auto &table = elements::reference_cache::instance().get(type,
+      elements::quadrature_rule::gauss, quad_order, order);
+
+   vector<real_t> vertices(mesh.n_elem*mesh.n_node*dim);
+   for (int i = 0; i < mesh.n_elem*mesh.n_node; i++)
+      for (int d = 0; d < dim; d++)
+         vertices[i*dim + d] = mesh.coords[mesh.connectivity[i]*dim + d];
+
+   elements::element_block volume_block;
+   elements::evaluate_block(volume_block, table, vertices.data(), mesh.n_elem);
+
+   real_t volume = 0.0;
+   for (int elem = 0; elem < mesh.n_elem; elem++)
+      for (int qp = 0; qp < table.n_qp; qp++)
+         volume += table.weights[qp]*std::abs(volume_block.det_J[elem*table.n_qp + qp]);
+
+   for (int d = 0; d < dim; d++) EXPECT_NEAR(0.0, flux[d], 1e-12);
+   EXPECT_NEAR(dim*volume, x_dot_n, 1e-11);
+}
+
+} // namespace
+
+TEST(faces, face_nodes) {
+   vector<int> nodes;
+
+   const struct { elements::element_type type; int order; int count; } cases[] = {
+      {elements::element_type::quad4, 0, 2},
+      {elements::element_type::quad8, 0, 3},
+      {elements::element_type::quad12, 0, 4},
+      {elements::element_type::hex8, 0, 4},
+      {elements::element_type::hex20, 0, 8},
+      {elements::element_type::hex32, 0, 12},
+      {elements::element_type::quadN, 3, 4},
+      {elements::element_type::hexN, 2, 9}};
+
+   for (const auto &c : cases)
+      for (int face = 0; face < elements::num_faces(c.type); face++){
+         elements::face_nodes(nodes, c.type, face, c.order);
+         EXPECT_EQ(c.count, int(nodes.size()));
+      }
+
+   elements::face_nodes(nodes, elements::element_type::hexN, 1, 1);
+   EXPECT_EQ((vector<int>{1, 3, 5, 7}), nodes);
+
+   ASSERT_ANY_THROW(elements::face_nodes(nodes, elements::element_type::quad4, 4));
+}
+
+TEST(faces, table) {
+
+   // trace of the basis, the face nodes carry all of it
+   elements::face_table table;
+   elements::build_face_table(table, elements::element_type::hex20, 5,
+      elements::quadrature_rule::gauss, 3);
+
+   EXPECT_EQ(9, table.n_qp);
+   EXPECT_EQ(2, table.dir);
+   EXPECT_EQ(1.0, table.side);
+
+   vector<int> nodes;
+   elements::face_nodes(nodes, elements::element_type::hex20, 5);
+
+   real_t weight_sum = 0.0;
+   for (int qp = 0; qp < table.n_qp; qp++){
+      EXPECT_EQ(1.0, table.points[qp*3 + 2]);
+      weight_sum += table.weights[qp];
+
+      real_t on_face = 0.0;
+      for (int node : nodes) on_face += table.basis[qp*20 + node];
+      EXPECT_NEAR(1.0, on_face, 1e-14);
+   }
+   EXPECT_NEAR(4.0, weight_sum, 1e-14);
+}
+
+TEST(faces, box) {
+
+   // straight box, axis normals and exact face areas
+   const real_t length[3] = {2.0, 3.0, 0.5};
+   mesh_t mesh = bumped_box(3, 2, 1, length, 0.0);
+
+   vector<int> faces;
+   elements::boundary_faces(faces, elements::element_type::hexN,
+      mesh.connectivity.data(), mesh.n_elem, 1);
+
+   vector<elements::face_table> tables;
+   elements::build_face_tables(tables, elements::element_type::hexN,
+      elements::quadrature_rule::gauss, 2, 1);
+
+   elements::face_block block;
+   elements::evaluate_faces(block, tables, mesh.coords.data(),
+      mesh.connectivity.data(), faces.data(), faces.size()/2);
+
+   real_t area[6] = {0, 0, 0, 0, 0, 0};
+   for (int f = 0; f < block.n_faces; f++){
+      int face = faces[2*f + 1];
+      int dir = face/2;
+      real_t side = (face % 2 == 0) ? -1.0 : 1.0;
+      for (int qp = 0; qp < block.n_qp; qp++){
+         int m = f*block.n_qp + qp;
+         area[face] += block.w_det_S[m];
+         for (int d = 0; d < 3; d++)
+            EXPECT_NEAR((d == dir) ? side : 0.0, block.normals[m*3 + d], 1e-14);
+         EXPECT_NEAR(side > 0 ? length[dir] : 0.0, block.x_points[m*3 + dir], 1e-14);
+      }
+   }
+
+   for (int face = 0; face < 6; face++){
+      int dir = face/2;
+      EXPECT_NEAR(length[(dir + 1) % 3]*length[(dir + 2) % 3], area[face], 1e-13);
+   }
+}
+
+TEST(faces, divergence) {
+   check_divergence(elements::element_type::quad4,
+      make_element(elements::quad4_kernel::ref_vert), 0, 3);
+   check_divergence(elements::element_type::quad8,
+      make_element(elements::quad8_kernel::ref_vert), 0, 4);
+   check_divergence(elements::element_type::hex8,
+      make_element(elements::hex8_kernel::ref_vert), 0, 3);
+   check_divergence(elements::element_type::hex20,
+      make_element(elements::hex20_kernel::ref_vert), 0, 5);
+
+   const real_t length[3] = {1.0, 1.5, 0.75};
+   check_divergence(elements::element_type::quadN, bumped_box(2, 3, 1, length, 0.05), 1, 3);
+   check_divergence(elements::element_type::quadN, bumped_box(2, 2, 2, length, 0.05), 2, 4);
+   check_divergence(elements::element_type::hexN, bumped_box(3, 2, 1, length, 0.05), 1, 3);
+   check_divergence(elements::element_type::hexN, bumped_box(3, 2, 2, length, 0.05), 2, 4);
+}
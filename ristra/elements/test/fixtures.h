@@ -0,0 +1,221 @@
+#ifndef ELEMENTS_TEST_FIXTURES_H
+#define ELEMENTS_TEST_FIXTURES_H
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <tuple>
+
+#include "ristra/elements/node_sets.h"
+#include "ristra/elements/utilities.h"
+
+namespace ristra{
+namespace elements{
+namespace fixtures{
+
+/*
+ ==========================
+  Test fixtures
+ ==========================
+
+ Reference points, distorted elements and small meshes shared by the
+ elements tests and benchmarks. Every buffer has the flat layout of the
+ batched routines, e.g. coords[n_global][dim], and the meshes come out
+ undistorted so each test applies its own map with map_nodes.
+*/
+
+// a mesh given as node coordinates and element connectivity
+struct mesh_t {
+   int dim = 0;
+   int n_global = 0;
+   int n_elem = 0;
+   int n_node = 0;                  // nodes per element
+   vector<real_t> coords;           // [n_global][dim]
+   vector<int> connectivity;        // [n_elem][n_node]
+};
+
+// smoothly distorted image of a reference point, elements are shifted
+// apart along x
+inline void distort(real_t *x, const real_t *xi, int dim, int elem){
+   real_t shift = 2.5*elem;
+   if (dim == 2){
+      x[0] = shift + 1.5*xi[0] + 0.1*xi[0]*xi[1];
+      x[1] = 0.8*xi[1] + 0.05*xi[0]*xi[0];
+   }
+   else {
+      x[0] = shift + 1.5*xi[0] + 0.1*xi[1]*xi[2];
+      x[1] = 0.8*xi[1] + 0.05*xi[0]*xi[2];
+      x[2] = 1.2*xi[2] + 0.07*xi[0]*xi[1];
+   }
+}
+
+// vertices[n_elem][n_node][dim] of distorted copies of an element
+inline vector<real_t> make_vertices(const real_t *ref_vert, int n_node, int dim,
+   int n_elem){
+   vector<real_t> verts(n_elem*n_node*dim);
+   for (int elem = 0; elem < n_elem; elem++)
+      for (int node = 0; node < n_node; node++)
+         distort(&verts[(elem*n_node + node)*dim], ref_vert + node*dim, dim, elem);
+   return verts;
+}
+
+// points scattered through the reference element, scaled towards its center
+inline vector<real_t> make_points(int dim, int n_qp, real_t scale = 1.0){
+   vector<real_t> points(n_qp*dim);
+   for (int qp = 0; qp < n_qp; qp++)
+      for (int d = 0; d < dim; d++)
+         points[qp*dim + d] = scale*std::sin(1.3*qp + 0.7*d + 0.2);
+   return points;
+}
+
+// the reference vertices of a fixed order element as a flat [N][Dim] list
+template<int N, int Dim>
+vector<real_t> flatten(const real_t (&ref_vert)[N][Dim]){
+   vector<real_t> nodes;
+   for (int node = 0; node < N; node++)
+      for (int d = 0; d < Dim; d++) nodes.push_back(ref_vert[node][d]);
+   return nodes;
+}
+
+// reference nodes of a QuadN/HexN element, xi fastest
+inline vector<real_t> lagrange_nodes(int dim, int order,
+   node_spacing spacing = node_spacing::chebyshev){
+   const node_set &set = get_node_set(spacing, order);
+   if (dim == 2) return vector<real_t>(set.nodes_2d.begin(), set.nodes_2d.end());
+   return vector<real_t>(set.nodes_3d.begin(), set.nodes_3d.end());
+}
+
+// structured Quad_4_2D/Hex8 mesh of the box [0,lx]x[0,ly]x[0,lz] with n[d]
+// cells along d, nodes numbered i fastest and elements in the Quad_4_2D/Hex8
+// node order
+inline mesh_t make_box(int dim, const int *n, const real_t *length){
+
+   mesh_t mesh;
+   mesh.dim = dim;
+   mesh.n_node = (dim == 2) ? 4 : 8;
+
+   int nz = (dim == 2) ? 0 : n[2];
+   int px = n[0] + 1, py = n[1] + 1, pz = nz + 1;
+   mesh.n_global = px*py*pz;
+   mesh.n_elem = n[0]*n[1]*std::max(nz, 1);
+
+   mesh.coords.resize(mesh.n_global*dim);
+   for (int k = 0; k < pz; k++)
+      for (int j = 0; j < py; j++)
+         for (int i = 0; i < px; i++){
+            int g = (k*py + j)*px + i;
+            mesh.coords[g*dim + 0] = length[0]*i/n[0];
+            mesh.coords[g*dim + 1] = length[1]*j/n[1];
+            if (dim == 3) mesh.coords[g*dim + 2] = length[2]*k/nz;
+         }
+
+   // reference corner offsets, {xi, eta, mu} -> {i, j, k}
+   const int hex8[8][3] = {{0,0,0}, {1,0,0}, {1,0,1}, {0,0,1},
+                           {0,1,0}, {1,1,0}, {1,1,1}, {0,1,1}};
+   const int quad4[4][3] = {{0,0,0}, {1,0,0}, {1,1,0}, {0,1,0}};
+
+   for (int k = 0; k < std::max(nz, 1); k++)
+      for (int j = 0; j < n[1]; j++)
+         for (int i = 0; i < n[0]; i++)
+            for (int node = 0; node < mesh.n_node; node++){
+               const int *o = (dim == 2) ? quad4[node] : hex8[node];
+               int g = ((k + o[2])*py + (j + o[1]))*px + (i + o[0]);
+               mesh.connectivity.push_back(g);
+            }
+
+   return mesh;
+}
+
+// QuadN/HexN mesh of the box [0,lx]x[0,ly]x[0,lz] with n cells per side,
+// global nodes on a uniform lattice of n*order + 1 per side numbered i
+// fastest, element nodes xi fastest; only exact for equispaced nodes
+inline mesh_t make_lattice_box(int dim, int n, int order, const real_t *length){
+
+   mesh_t mesh;
+   mesh.dim = dim;
+
+   int p = n*order + 1;
+   int pz = (dim == 3) ? p : 1;
+   int N = order + 1;
+
+   mesh.n_global = p*p*pz;
+   mesh.n_elem = (dim == 3) ? n*n*n : n*n;
+   mesh.n_node = (dim == 3) ? N*N*N : N*N;
+
+   mesh.coords.resize(mesh.n_global*dim);
+   for (int k = 0; k < pz; k++)
+      for (int j = 0; j < p; j++)
+         for (int i = 0; i < p; i++){
+            int g = (k*p + j)*p + i;
+            int idx[3] = {i, j, k};
+            for (int d = 0; d < dim; d++)
+               mesh.coords[g*dim + d] = length[d]*(real_t(idx[d])/(p - 1));
+         }
+
+   int nz = (dim == 3) ? n : 1;
+   int Nz = (dim == 3) ? N : 1;
+   for (int ek = 0; ek < nz; ek++)
+      for (int ej = 0; ej < n; ej++)
+         for (int ei = 0; ei < n; ei++)
+            for (int c = 0; c < Nz; c++)
+               for (int b = 0; b < N; b++)
+                  for (int a = 0; a < N; a++){
+                     int i = ei*order + a, j = ej*order + b, k = ek*order + c;
+                     mesh.connectivity.push_back((k*p + j)*p + i);
+                  }
+   return mesh;
+}
+
+// n^dim unit cells, element nodes placed at their reference positions
+// ref_nodes[n_node][dim] and merged where they coincide
+inline mesh_t make_merged_mesh(const vector<real_t> &ref_nodes, int dim, int n){
+
+   mesh_t mesh;
+   mesh.dim = dim;
+   mesh.n_node = ref_nodes.size()/dim;
+   std::map< std::tuple<long, long, long>, int > ids;
+
+   int nz = (dim == 3) ? n : 1;
+   for (int k = 0; k < nz; k++)
+      for (int j = 0; j < n; j++)
+         for (int i = 0; i < n; i++){
+            int cell[3] = {i, j, k};
+            for (int node = 0; node < mesh.n_node; node++){
+               real_t x[3] = {0.0, 0.0, 0.0};
+               long key[3] = {0, 0, 0};
+               for (int d = 0; d < dim; d++){
+                  x[d] = cell[d] + 0.5*(ref_nodes[node*dim + d] + 1.0);
+                  key[d] = std::lround(x[d]*1e9);
+               }
+
+               auto inserted = ids.emplace(std::make_tuple(key[0], key[1], key[2]),
+                  mesh.n_global);
+               if (inserted.second){
+                  mesh.n_global++;
+                  for (int d = 0; d < dim; d++) mesh.coords.push_back(x[d]);
+               }
+               mesh.connectivity.push_back(inserted.first->second);
+            }
+            mesh.n_elem++;
+         }
+
+   return mesh;
+}
+
+// moves every node of a mesh, map(y, x) sets y[dim] from the old position
+// x[dim]
+template<class Map>
+void map_nodes(mesh_t &mesh, Map map){
+   real_t x[3] = {0.0, 0.0, 0.0};
+   for (int g = 0; g < mesh.n_global; g++){
+      real_t *y = &mesh.coords[g*mesh.dim];
+      std::copy(y, y + mesh.dim, x);
+      map(y, x);
+   }
+}
+
+} //end namespace fixtures
+} //end namespace elements
+} //end namespace ristra
+
+#endif //ELEMENTS_TEST_FIXTURES_H
@@ -0,0 +1,120 @@
+#include <cmath>
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include "ristra/elements/geometry_cache.h"
+#include "ristra/elements/reference_cache.h"
+#include "ristra/elements/utilities.h"
+#include "ristra/elements/test/fixtures.h"
+
+namespace elements = ristra::elements;
+using ristra::elements::vector;
+using ristra::elements::real_t;
+using ristra::elements::fixtures::make_box;
+using ristra::elements::fixtures::map_nodes;
+using ristra::elements::fixtures::mesh_t;
+
+namespace {
+
+const int n = 3;                 // cells per side
+const int p = n + 1;             // nodes per side
+
+// n^3 hex8 box of unit cells, smoothly distorted in x and y
+mesh_t distorted_box(){
+
+   const int cells[3] = {n, n, n};
+   const real_t length[3] = {n, n, n};
+
+   mesh_t mesh = make_box(3, cells, length);
+   map_nodes(mesh, [](real_t *y, const real_t *x){
+      y[0] = x[0] + 0.1*std::sin(x[1] + x[2]);
+      y[1] = x[1] + 0.1*std::cos(x[0]);
+   });
+   return mesh;
+}
+
+// cached values match a fresh evaluation of the whole mesh
+void check_cache(const elements::geometry_cache &cache,
+   const vector<real_t> &coords, const vector<int> &connectivity){
+
+   int n_elem = cache.num_elements();
+   int n_qp = cache.num_points();
+
+   vector<real_t> vertices(n_elem*8*3);
+   for (int i = 0; i < n_elem*8; i++)
+      for (int d = 0; d < 3; d++) vertices[i*3 + d] = coords[connectivity[i]*3 + d];
+
+   elements::element_block block;
+   elements::evaluate_block(block, cache.table(), vertices.data(), n_elem);
+
+   for (int elem = 0; elem < n_elem; elem++){
+      ASSERT_FALSE(cache.is_dirty(elem));
+      for (int qp = 0; qp < n_qp; qp++){
+         int m = elem*n_qp + qp;
+         ASSERT_EQ(block.det_J[m], cache.det_J(elem)[qp]);
+         ASSERT_EQ(block.det_J[m]*cache.table().weights[qp],
+            cache.weighted_det_J(elem)[qp]);
+         for (int i = 0; i < 9; i++)
+            ASSERT_EQ(block.J_inverse[m*9 + i], cache.J_inverse(elem)[qp*9 + i]);
+      }
+   }
+}
+
+} // namespace
+
+TEST(geometry_cache, dirty_flags) {
+
+   mesh_t mesh = distorted_box();
+   vector<real_t> &coords = mesh.coords;
+   const vector<int> &connectivity = mesh.connectivity;
+
+   elements::geometry_cache cache(elements::element_type::hex8,
+      connectivity.data(), n*n*n, p*p*p, elements::quadrature_rule::gauss, 2);
+
+   ASSERT_EQ(n*n*n*8*(9 + 2)*sizeof(real_t), cache.memory_bytes());
+
+   ASSERT_EQ(n*n*n, cache.update(coords.data()));
+   ASSERT_EQ(0, cache.update(coords.data()));
+   check_cache(cache, coords, connectivity);
+
+   // an interior node is shared by 8 elements, a corner by 1
+   int interior = (1*p + 1)*p + 1;
+   coords[interior*3 + 0] += 0.2;
+   cache.mark_node_moved(interior);
+   ASSERT_EQ(8, cache.update(coords.data()));
+   check_cache(cache, coords, connectivity);
+
+   coords[0] -= 0.1;
+   cache.mark_node_moved(0);
+   cache.mark_dirty(5);
+   ASSERT_EQ(2, cache.update(coords.data()));
+   check_cache(cache, coords, connectivity);
+
+   cache.mark_all_dirty();
+   ASSERT_EQ(n*n*n, cache.update(coords.data()));
+}
+
+TEST(geometry_cache, node_versions) {
+
+   mesh_t mesh = distorted_box();
+   vector<real_t> &coords = mesh.coords;
+   const vector<int> &connectivity = mesh.connectivity;
+
+   elements::geometry_cache cache(elements::element_type::hex8,
+      connectivity.data(), n*n*n, p*p*p, elements::quadrature_rule::gauss, 3);
+
+   vector<std::uint64_t> version(p*p*p, 0);
+   ASSERT_EQ(n*n*n, cache.update(coords.data(), version.data()));
+   ASSERT_EQ(0, cache.update(coords.data(), version.data()));
+
+   // move the top layer of nodes
+   for (int g = 0; g < p*p*p; g++){
+      if (g/(p*p) != n) continue;
+      coords[g*3 + 2] += 0.3;
+      version[g]++;
+   }
+   ASSERT_EQ(n*n, cache.update(coords.data(), version.data()));
+   ASSERT_EQ(0, cache.update(coords.data(), version.data()));
+   check_cache(cache, coords, connectivity);
+}
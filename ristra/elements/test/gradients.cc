@@ -0,0 +1,134 @@
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "ristra/elements/assembly.h"
+#include "ristra/elements/element_kernels.h"
+#include "ristra/elements/gradients.h"
+#include "ristra/elements/reference_cache.h"
+#include "ristra/elements/utilities.h"
+
+namespace elements = ristra::elements;
+using ristra::elements::vector;
+using ristra::elements::real_t;
+
+namespace {
+
+// n_elem distorted copies of the reference element, unshared nodes
+template<int N, int Dim>
+vector<real_t> distorted_vertices(const real_t (&ref_vert)[N][Dim], int n_elem){
+   vector<real_t> verts(n_elem*N*Dim);
+   for (int elem = 0; elem < n_elem; elem++)
+      for (int node = 0; node < N; node++)
+         for (int d = 0; d < Dim; d++){
+            const real_t *xi = ref_vert[node];
+            verts[(elem*N + node)*Dim + d] = (1.0 + 0.3*d)*xi[d] + 2.0*elem
+               + 0.08*std::sin(1.7*xi[(d + 1) % Dim] + 0.4*elem);
+         }
+   return verts;
+}
+
+// the block and table paths agree, and B differentiates linear fields exactly
+void check_gradients(elements::element_type type, const vector<real_t> &verts,
+   int n_elem){
+
+   auto &table = elements::reference_cache::instance().get(type,
+      elements::quadrature_rule::gauss, 3);
+
+   elements::element_block block;
+   elements::evaluate_block(block, table, verts.data(), n_elem);
+
+   elements::gradient_block from_block, from_table;
+   elements::build_gradients(from_block, block, table.weights.data());
+   elements::build_gradients(from_table, table, verts.data(), n_elem);
+
+   int n_qp = table.n_qp, n_node = table.n_node, dim = table.dim;
+   ASSERT_EQ(from_block.B.size(), std::size_t(n_elem*n_qp*dim*n_node));
+   ASSERT_EQ(from_block.B.size(), from_table.B.size());
+
+   for (std::size_t i = 0; i < from_block.B.size(); i++)
+      ASSERT_NEAR(from_block.B[i], from_table.B[i], 1e-13);
+
+   for (int elem = 0; elem < n_elem; elem++)
+      for (int qp = 0; qp < n_qp; qp++){
+         int m = elem*n_qp + qp;
+         real_t w = from_table.w_det_J[m];
+         ASSERT_NEAR(table.weights[qp]*std::abs(block.det_J[m]), w, 1e-14);
+
+         for (int k = 0; k < dim; k++){
+            const real_t *row = from_table.B.data() + (m*dim + k)*n_node;
+
+            // constants have no gradient, grad x_c = e_c
+            real_t sum = 0.0;
+            for (int node = 0; node < n_node; node++) sum += row[node];
+            ASSERT_NEAR(0.0, sum, 1e-13);
+
+            for (int c = 0; c < dim; c++){
+               real_t dx = 0.0;
+               for (int node = 0; node < n_node; node++)
+                  dx += verts[(elem*n_node + node)*dim + c]*row[node];
+               ASSERT_NEAR((c == k) ? w : 0.0, dx, 1e-12);
+            }
+         }
+      }
+}
+
+} // namespace
+
+TEST(gradients, linear_fields) {
+   check_gradients(elements::element_type::quad4,
+      distorted_vertices(elements::quad4_kernel::ref_vert, 3), 3);
+   check_gradients(elements::element_type::quad8,
+      distorted_vertices(elements::quad8_kernel::ref_vert, 3), 3);
+   check_gradients(elements::element_type::hex8,
+      distorted_vertices(elements::hex8_kernel::ref_vert, 3), 3);
+   check_gradients(elements::element_type::hex20,
+      distorted_vertices(elements::hex20_kernel::ref_vert, 2), 2);
+}
+
+TEST(gradients, stiffness) {
+
+   // one distorted hex8 as its own mesh, compared with the assembler
+   const int n_node = 8;
+   auto verts = distorted_vertices(elements::hex8_kernel::ref_vert, 1);
+   vector<int> connectivity = {0, 1, 2, 3, 4, 5, 6, 7};
+
+   elements::assembler assembler(elements::element_type::hex8, verts.data(),
+      n_node, connectivity.data(), 1, elements::quadrature_rule::gauss, 3);
+   elements::csr_matrix K;
+   assembler.stiffness(K);
+
+   auto &table = elements::reference_cache::instance().get(
+      elements::element_type::hex8, elements::quadrature_rule::gauss, 3);
+
+   elements::gradient_block grads;
+   elements::build_gradients(grads, table, verts.data(), 1);
+
+   vector<real_t> local(n_node*n_node);
+   elements::element_stiffness(local.data(), grads, 0);
+
+   for (int a = 0; a < n_node; a++)
+      for (int b = 0; b < n_node; b++){
+         int k = K.find(a, b);
+         ASSERT_GE(k, 0);
+         EXPECT_NEAR(K.values[k], local[a*n_node + b], 1e-13);
+         EXPECT_NEAR(local[b*n_node + a], local[a*n_node + b], 1e-14);
+      }
+}
+
+TEST(gradients, degenerate) {
+
+   // a collapsed element gives zero weights, gradients and stiffness
+   auto &table = elements::reference_cache::instance().get(
+      elements::element_type::quad4, elements::quadrature_rule::gauss, 2);
+   vector<real_t> flat(4*2, 0.0);
+
+   elements::gradient_block grads;
+   elements::build_gradients(grads, table, flat.data(), 1);
+
+   vector<real_t> local(16);
+   elements::element_stiffness(local.data(), grads, 0);
+   for (auto w : grads.w_det_J) EXPECT_EQ(0.0, w);
+   for (auto v : grads.B) EXPECT_EQ(0.0, v);
+   for (auto v : local) EXPECT_EQ(0.0, v);
+}
@@ -0,0 +1,135 @@
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "ristra/elements/batched.h"
+#include "ristra/elements/element_kernels.h"
+#include "ristra/elements/elements.h"
+#include "ristra/elements/inverse_map.h"
+#include "ristra/elements/utilities.h"
+#include "ristra/elements/test/fixtures.h"
+
+namespace elements = ristra::elements;
+using ristra::elements::vector;
+using ristra::elements::real_t;
+using ristra::elements::fixtures::flatten;
+using ristra::elements::fixtures::lagrange_nodes;
+using ristra::elements::fixtures::make_points;
+using ristra::elements::fixtures::make_vertices;
+
+namespace {
+
+// maps points of n_elem distorted elements back to the reference element
+void check_round_trip(elements::element_type type, const vector<real_t> &ref_nodes,
+   int elem_order){
+
+   const int n_elem = 3;
+   const int n_per = 11;            // points per element
+   const int n_points = n_elem*n_per;
+
+   int dim = elements::num_dim(type);
+   int n_node = ref_nodes.size()/dim;
+
+   // unshared element nodes
+   vector<real_t> coords = make_vertices(ref_nodes.data(), n_node, dim, n_elem);
+   vector<int> connectivity(n_elem*n_node);
+   for (int g = 0; g < n_elem*n_node; g++) connectivity[g] = g;
+
+   // reference points and their physical images
+   vector<real_t> xi_exact = make_points(dim, n_per, 0.95);
+
+   vector<real_t> basis(n_per*n_node), partials(n_per*n_node*dim);
+   if (elem_order > 0)
+      elements::lagrange_reference_basis(basis.data(), partials.data(),
+         xi_exact.data(), n_per, dim, elem_order);
+   else
+      elements::reference_basis(basis.data(), partials.data(),
+         xi_exact.data(), n_per, type);
+
+   vector<real_t> x_points(n_points*dim);
+   elements::batched_physical_position(x_points.data(), coords.data(),
+      basis.data(), n_elem, n_per, n_node, dim);
+
+   vector<int> point_elem(n_points);
+   for (int p = 0; p < n_points; p++) point_elem[p] = p/n_per;
+
+   vector<real_t> xi(n_points*dim);
+   vector<elements::inverse_map_status> status(n_points);
+   vector<int> iterations(n_points);
+
+   elements::inverse_map(xi.data(), status.data(), iterations.data(), type,
+      coords.data(), connectivity.data(), x_points.data(), point_elem.data(),
+      n_points, elements::inverse_map_options(), elem_order);
+
+   for (int p = 0; p < n_points; p++){
+      ASSERT_EQ(elements::inverse_map_status::converged, status[p]);
+      ASSERT_GT(iterations[p], 0);
+      ASSERT_LE(iterations[p], 10);
+      ASSERT_TRUE(elements::inside_reference(&xi[p*dim], dim));
+      for (int d = 0; d < dim; d++)
+         ASSERT_NEAR(xi_exact[(p % n_per)*dim + d], xi[p*dim + d], 1e-11);
+   }
+}
+
+} // namespace
+
+TEST(inverse_map, fixed_order) {
+   check_round_trip(elements::element_type::quad4,
+      flatten(elements::quad4_kernel::ref_vert), 0);
+   check_round_trip(elements::element_type::quad8,
+      flatten(elements::quad8_kernel::ref_vert), 0);
+   check_round_trip(elements::element_type::quad12,
+      flatten(elements::quad12_kernel::ref_vert), 0);
+   check_round_trip(elements::element_type::hex8,
+      flatten(elements::hex8_kernel::ref_vert), 0);
+   check_round_trip(elements::element_type::hex20,
+      flatten(elements::hex20_kernel::ref_vert), 0);
+   check_round_trip(elements::element_type::hex32,
+      flatten(elements::hex32_kernel::ref_vert), 0);
+}
+
+TEST(inverse_map, lagrange) {
+   for (int order = 1; order <= 4; order++){
+      check_round_trip(elements::element_type::quadN, lagrange_nodes(2, order), order);
+      check_round_trip(elements::element_type::hexN, lagrange_nodes(3, order), order);
+   }
+}
+
+TEST(inverse_map, status) {
+
+   // unit square hex8, affine, so one step from any guess
+   vector<real_t> coords = flatten(elements::hex8_kernel::ref_vert);
+   vector<int> connectivity = {0, 1, 2, 3, 4, 5, 6, 7};
+
+   // a point outside the element still converges, and is reported outside
+   real_t x_out[3] = {1.5, 0.25, -0.5};
+   int elem = 0;
+   real_t xi[3] = {0.9, 0.9, 0.9};
+   elements::inverse_map_status status;
+   int iterations;
+
+   elements::inverse_map_options options;
+   options.use_initial_guess = true;
+
+   elements::inverse_map(xi, &status, &iterations, elements::element_type::hex8,
+      coords.data(), connectivity.data(), x_out, &elem, 1, options);
+
+   EXPECT_EQ(elements::inverse_map_status::converged, status);
+   EXPECT_EQ(2, iterations);
+   EXPECT_FALSE(elements::inside_reference(xi, 3));
+   EXPECT_TRUE(elements::inside_reference(xi, 3, 0.5));
+   EXPECT_NEAR(1.5, xi[0], 1e-14);
+
+   // a collapsed element is singular
+   vector<real_t> flat(coords.size(), 0.0);
+   elements::inverse_map(xi, &status, &iterations, elements::element_type::hex8,
+      flat.data(), connectivity.data(), x_out, &elem, 1);
+   EXPECT_EQ(elements::inverse_map_status::singular, status);
+   EXPECT_EQ(0, iterations);
+
+   // no iterations allowed
+   options.max_iterations = 0;
+   elements::inverse_map(xi, &status, &iterations, elements::element_type::hex8,
+      coords.data(), connectivity.data(), x_out, &elem, 1, options);
+   EXPECT_EQ(elements::inverse_map_status::not_converged, status);
+}
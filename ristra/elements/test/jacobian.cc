@@ -0,0 +1,207 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "ristra/elements/elements.h"
+#include "ristra/elements/jacobian.h"
+#include "ristra/elements/utilities.h"
+
+namespace elements = ristra::elements;
+using ristra::elements::vector;
+using ristra::elements::real_t;
+
+namespace {
+
+// deterministic data in [-1, 1]
+real_t wobble(int i){ return std::sin(0.83*i + 0.3); }
+
+} // namespace
+
+TEST(jacobian, matches_element_functions) {
+
+   elements::Hex8 hex8;
+   elements::Quad_4_2D quad4;
+
+   // hex8: distorted cube
+   const real_t ref[8][3] = {
+      {-1,-1,-1}, {1,-1,-1}, {1,-1,1}, {-1,-1,1},
+      {-1, 1,-1}, {1, 1,-1}, {1, 1,1}, {-1, 1,1}};
+
+   vector< vector<real_t> > verts(8, vector<real_t>(3));
+   real_t flat_verts[8*3];
+   for (int n = 0; n < 8; n++)
+      for (int d = 0; d < 3; d++){
+         verts[n][d] = ref[n][d] + 0.15*wobble(3*n + d);
+         flat_verts[n*3 + d] = verts[n][d];
+      }
+
+   vector<real_t> xi = {0.2, -0.4, 0.7};
+   vector<real_t> p_xi(8), p_eta(8), p_mu(8);
+   hex8.partial_xi_shape_fcn(p_xi, xi);
+   hex8.partial_eta_shape_fcn(p_eta, xi);
+   hex8.partial_mu_shape_fcn(p_mu, xi);
+
+   vector< vector<real_t> > partial(8, vector<real_t>(3));
+   real_t flat_partial[8*3];
+   for (int n = 0; n < 8; n++){
+      partial[n] = {p_xi[n], p_eta[n], p_mu[n]};
+      for (int d = 0; d < 3; d++) flat_partial[n*3 + d] = partial[n][d];
+   }
+
+   vector< vector<real_t> > J_vec(3, vector<real_t>(3));
+   real_t det_vec;
+   elements::jacobian(J_vec, det_vec, verts, partial, 8, 3);
+
+   // same accumulation by hand
+   for (int j = 0; j < 3; j++)
+      for (int k = 0; k < 3; k++){
+         real_t sum = 0.0;
+         for (int n = 0; n < 8; n++) sum += verts[n][k]*partial[n][j];
+         ASSERT_NEAR(sum, J_vec[j][k], 1e-14);
+      }
+
+   real_t J[3][3], J_rt[3][3];
+   elements::jacobian_kernel<3, 8>(J, flat_verts, flat_partial);
+   elements::jacobian_kernel<3>(J_rt, flat_verts, flat_partial, 8);
+   for (int j = 0; j < 3; j++)
+      for (int k = 0; k < 3; k++){
+         ASSERT_DOUBLE_EQ(J_vec[j][k], J[j][k]);
+         ASSERT_DOUBLE_EQ(J_vec[j][k], J_rt[j][k]);
+      }
+   ASSERT_NEAR(det_vec, elements::determinant_kernel<3>(J), 1e-14);
+
+   // the inverse is a true inverse
+   vector< vector<real_t> > J_inv_vec(3, vector<real_t>(3));
+   elements::jacobian_inverse_3d(J_inv_vec, J_vec);
+   real_t J_inv[3][3];
+   elements::inverse_kernel<3>(J_inv, J, det_vec);
+   for (int i = 0; i < 3; i++)
+      for (int j = 0; j < 3; j++){
+         real_t sum = 0.0;
+         for (int k = 0; k < 3; k++) sum += J[i][k]*J_inv[k][j];
+         ASSERT_NEAR(i == j ? 1.0 : 0.0, sum, 1e-14);
+         ASSERT_NEAR(J_inv[i][j], J_inv_vec[i][j], 1e-14);
+      }
+
+   // quad4
+   const real_t ref2[4][2] = {{-1,-1}, {1,-1}, {1,1}, {-1,1}};
+   vector< vector<real_t> > verts2(4, vector<real_t>(2));
+   for (int n = 0; n < 4; n++)
+      for (int d = 0; d < 2; d++) verts2[n][d] = ref2[n][d] + 0.2*wobble(2*n + d);
+
+   vector<real_t> xi2 = {0.3, -0.6};
+   vector<real_t> q_xi(4), q_eta(4);
+   quad4.partial_xi_shape_fcn(q_xi, xi2);
+   quad4.partial_eta_shape_fcn(q_eta, xi2);
+   vector< vector<real_t> > partial2(4, vector<real_t>(2));
+   for (int n = 0; n < 4; n++) partial2[n] = {q_xi[n], q_eta[n]};
+
+   // 2x2 storage is enough for the 2D jacobian
+   vector< vector<real_t> > J2(2, vector<real_t>(2));
+   real_t det2;
+   elements::jacobian(J2, det2, verts2, partial2, 4, 2);
+   ASSERT_NEAR(J2[0][0]*J2[1][1] - J2[0][1]*J2[1][0], det2, 1e-15);
+
+   vector< vector<real_t> > J2_inv;
+   elements::jacobian_inverse_2d(J2_inv, J2);
+   ASSERT_EQ(2u, J2_inv.size());
+   for (int i = 0; i < 2; i++)
+      for (int j = 0; j < 2; j++)
+         ASSERT_NEAR(i == j ? 1.0 : 0.0,
+            J2[i][0]*J2_inv[0][j] + J2[i][1]*J2_inv[1][j], 1e-14);
+}
+
+TEST(jacobian, batched) {
+
+   const int n_elem = 4;
+   const int n_qp = 6;
+   const int n_node = 20;
+   const int dim = 3;
+
+   vector<real_t> verts(n_elem*n_node*dim), partials(n_qp*n_node*dim);
+   std::mt19937 gen(12345);
+   std::uniform_real_distribution<real_t> dist(-1.0, 1.0);
+   for (auto &v : verts) v = dist(gen);
+   for (auto &p : partials) p = dist(gen);
+
+   vector<real_t> J(n_elem*n_qp*9), det(n_elem*n_qp), J_inv(n_elem*n_qp*9);
+   vector<real_t> J_rt(n_elem*n_qp*9), det_rt(n_elem*n_qp);
+
+   elements::batched_jacobian_kernel<3, n_node>(J.data(), det.data(),
+      J_inv.data(), verts.data(), partials.data(), n_elem, n_qp);
+   elements::batched_jacobian_kernel<3>(J_rt.data(), det_rt.data(), nullptr,
+      verts.data(), partials.data(), n_elem, n_qp, n_node);
+
+   for (int m = 0; m < n_elem*n_qp; m++){
+      ASSERT_DOUBLE_EQ(det[m], det_rt[m]);
+
+      real_t Jm[3][3];
+      for (int j = 0; j < 3; j++)
+         for (int k = 0; k < 3; k++){
+            Jm[j][k] = J[m*9 + j*3 + k];
+            ASSERT_DOUBLE_EQ(Jm[j][k], J_rt[m*9 + j*3 + k]);
+         }
+      ASSERT_NEAR(elements::determinant_kernel<3>(Jm), det[m], 1e-12);
+
+      for (int i = 0; i < 3; i++)
+         for (int j = 0; j < 3; j++){
+            real_t sum = 0.0;
+            for (int k = 0; k < 3; k++) sum += Jm[i][k]*J_inv[m*9 + k*3 + j];
+            ASSERT_NEAR(i == j ? 1.0 : 0.0, sum, 1e-10);
+         }
+   }
+
+   vector<real_t> J_inv2(n_elem*n_qp*9);
+   elements::batched_inverse_kernel<3>(J_inv2.data(), J.data(), det.data(),
+      n_elem*n_qp);
+   for (std::size_t i = 0; i < J_inv.size(); i++) ASSERT_DOUBLE_EQ(J_inv[i], J_inv2[i]);
+}
+
+TEST(jacobian, four_by_four) {
+
+   std::mt19937 gen(4321);
+   std::uniform_real_distribution<real_t> dist(-1.0, 1.0);
+
+   for (int trial = 0; trial < 20; trial++){
+
+      real_t J[4][4];
+      vector< vector<real_t> > J_nested(4, vector<real_t>(4));
+      for (int j = 0; j < 4; j++)
+         for (int k = 0; k < 4; k++){
+            J[j][k] = dist(gen) + 2.0*(j == k);
+            J_nested[j][k] = J[j][k];
+         }
+
+      // permutation sum
+      int p[4] = {0, 1, 2, 3};
+      real_t det_exact = 0.0;
+      do {
+         int inversions = 0;
+         for (int i = 0; i < 4; i++)
+            for (int j = i + 1; j < 4; j++) inversions += p[i] > p[j];
+         real_t term = (inversions % 2) ? -1.0 : 1.0;
+         for (int i = 0; i < 4; i++) term *= J[i][p[i]];
+         det_exact += term;
+      } while (std::next_permutation(p, p + 4));
+
+      real_t det = elements::determinant_kernel<4>(J);
+      ASSERT_NEAR(det_exact, det, 1e-13);
+
+      // the nested interface gives the same inverse
+      real_t J_inv[4][4];
+      elements::inverse_kernel<4>(J_inv, J, det);
+
+      vector< vector<real_t> > J_inv_nested(4, vector<real_t>(4));
+      elements::jacobian_inverse_4d(J_inv_nested, J_nested, det);
+
+      for (int i = 0; i < 4; i++)
+         for (int j = 0; j < 4; j++){
+            real_t sum = 0.0;
+            for (int k = 0; k < 4; k++) sum += J[i][k]*J_inv[k][j];
+            ASSERT_NEAR(i == j ? 1.0 : 0.0, sum, 1e-13);
+            ASSERT_EQ(J_inv[i][j], J_inv_nested[i][j]);
+         }
+   }
+}
@@ -0,0 +1,123 @@
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "ristra/elements/elements.h"
+#include "ristra/elements/lagrange.h"
+#include "ristra/elements/utilities.h"
+
+namespace elements = ristra::elements;
+using ristra::elements::vector;
+using ristra::elements::real_t;
+
+namespace {
+
+// interpolant i and its derivative straight from the product definition
+void direct_lagrange(real_t &val, real_t &deriv, const real_t &x,
+   const vector<real_t> &nodes, int i){
+
+   int n = nodes.size();
+   real_t num = 1.0, den = 1.0, sum = 0.0;
+
+   for (int j = 0; j < n; j++){
+      if (j == i) continue;
+      num *= x - nodes[j];
+      den *= nodes[i] - nodes[j];
+
+      real_t prod = 1.0;
+      for (int l = 0; l < n; l++)
+         if (l != i && l != j) prod *= x - nodes[l];
+      sum += prod;
+   }
+   val = num/den;
+   deriv = sum/den;
+}
+
+vector<real_t> equispaced(int n){
+   vector<real_t> nodes(n);
+   for (int i = 0; i < n; i++) nodes[i] = (n == 1) ? 0.0 : -1.0 + 2.0*i/(n - 1);
+   return nodes;
+}
+
+} // namespace
+
+TEST(lagrange, matches_products) {
+
+   elements::HexN hexN;
+
+   for (int order = 1; order <= 10; order++){
+
+      int n = order + 1;
+      vector<real_t> cheb(n);
+      hexN.chebyshev_nodes_1D(cheb, order);
+
+      for (auto &nodes : {cheb, equispaced(n)}){
+
+         elements::lagrange_1d lagrange(nodes.data(), n);
+         vector<real_t> val(n), deriv(n);
+
+         // off node points and every node exactly
+         vector<real_t> points = {-0.93, -0.41, 0.0, 0.17, 0.66, 0.999};
+         points.insert(points.end(), nodes.begin(), nodes.end());
+
+         for (auto x : points){
+            lagrange.evaluate(val.data(), deriv.data(), x);
+
+            real_t unity = 0.0, dunity = 0.0;
+            for (int i = 0; i < n; i++){
+               real_t v, d;
+               direct_lagrange(v, d, x, nodes, i);
+               ASSERT_NEAR(v, val[i], 1e-12);
+               ASSERT_NEAR(d, deriv[i], 1e-10*std::max(1.0, std::abs(d)));
+               unity += val[i];
+               dunity += deriv[i];
+            }
+            ASSERT_NEAR(1.0, unity, 1e-13);
+            ASSERT_NEAR(0.0, dunity, 1e-10);
+         }
+      }
+   }
+}
+
+TEST(lagrange, batched) {
+
+   const int n = 7;
+   auto nodes = equispaced(n);
+   elements::lagrange_1d lagrange(nodes.data(), n);
+
+   const int num_x = 5;
+   real_t x[num_x] = {-1.0, -0.2, 0.3, 0.75, 1.0};
+   vector<real_t> val(num_x*n), deriv(num_x*n);
+   lagrange.evaluate(val.data(), deriv.data(), x, num_x);
+
+   vector<real_t> v(n), d(n);
+   for (int p = 0; p < num_x; p++){
+      lagrange.evaluate(v.data(), d.data(), x[p]);
+      for (int i = 0; i < n; i++){
+         ASSERT_EQ(v[i], val[p*n + i]);
+         ASSERT_EQ(d[i], deriv[p*n + i]);
+      }
+   }
+}
+
+TEST(lagrange, element_lagrange_1D) {
+
+   // the element routine computes its weights on the fly
+   const int order = 6;
+   elements::QuadN quadN;
+   vector<real_t> nodes(order + 1);
+   quadN.chebyshev_nodes_1D(nodes, order);
+
+   elements::lagrange_1d lagrange(nodes.data(), order + 1);
+   vector<real_t> interp(order + 1), Dinterp(order + 1);
+   vector<real_t> val(order + 1), deriv(order + 1);
+
+   for (real_t x = -1.0; x <= 1.0; x += 0.125){
+      quadN.lagrange_1D(interp, Dinterp, x, nodes, order);
+      lagrange.evaluate(val.data(), deriv.data(), x);
+      for (int i = 0; i <= order; i++){
+         ASSERT_NEAR(val[i], interp[i], 1e-14);
+         ASSERT_NEAR(deriv[i], Dinterp[i], 1e-12);
+      }
+   }
+}
@@ -0,0 +1,83 @@
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "ristra/elements/assembly.h"
+#include "ristra/elements/element_kernels.h"
+#include "ristra/elements/elements.h"
+#include "ristra/elements/matrix_free.h"
+#include "ristra/elements/utilities.h"
+#include "ristra/elements/test/fixtures.h"
+
+namespace elements = ristra::elements;
+using ristra::elements::vector;
+using ristra::elements::real_t;
+using ristra::elements::fixtures::flatten;
+using ristra::elements::fixtures::lagrange_nodes;
+using ristra::elements::fixtures::make_merged_mesh;
+using ristra::elements::fixtures::map_nodes;
+using ristra::elements::fixtures::mesh_t;
+
+namespace {
+
+// matrix-free and assembled stiffness agree
+void check_operator(
+   const elements::element_type &type,
+   const vector<real_t> &ref_nodes,
+   int dim,
+   int n,
+   int quad_order,
+   int elem_order,
+   bool tensor){
+
+   // n^dim cells, smoothly distorted
+   mesh_t mesh = make_merged_mesh(ref_nodes, dim, n);
+   map_nodes(mesh, [dim](real_t *y, const real_t *x){
+      for (int d = 0; d < dim; d++) y[d] = x[d] + 0.05*std::sin(x[(d + 1) % dim]);
+   });
+
+   elements::stiffness_operator K_free(type, mesh.coords.data(), mesh.n_global,
+      mesh.connectivity.data(), mesh.n_elem, elements::quadrature_rule::gauss,
+      quad_order, elem_order);
+   ASSERT_EQ(tensor, K_free.sum_factorized());
+
+   elements::assembly_options options;
+   options.n_threads = 1;
+   elements::assembler assembler(type, mesh.coords.data(), mesh.n_global,
+      mesh.connectivity.data(), mesh.n_elem, elements::quadrature_rule::gauss,
+      quad_order, options, elem_order);
+   elements::csr_matrix K;
+   assembler.stiffness(K);
+
+   vector<real_t> x(mesh.n_global), y(mesh.n_global), y_ref(mesh.n_global);
+   for (int g = 0; g < mesh.n_global; g++) x[g] = std::cos(0.37*g);
+
+   K_free.apply(y.data(), x.data());
+   K.multiply(y_ref.data(), x.data());
+
+   real_t scale = 0.0;
+   for (auto v : y_ref) scale = std::max(scale, std::abs(v));
+   for (int g = 0; g < mesh.n_global; g++)
+      ASSERT_NEAR(y_ref[g], y[g], 1e-12*scale);
+
+   // constants are in the kernel
+   vector<real_t> ones(mesh.n_global, 1.0);
+   K_free.apply(y.data(), ones.data());
+   for (auto v : y) ASSERT_NEAR(0.0, v, 1e-11);
+}
+
+} // namespace
+
+TEST(matrix_free, serendipity_hex) {
+   check_operator(elements::element_type::hex20,
+      flatten(elements::hex20_kernel::ref_vert), 3, 5, 3, 0, false);
+   check_operator(elements::element_type::hex32,
+      flatten(elements::hex32_kernel::ref_vert), 3, 2, 4, 0, false);
+}
+
+TEST(matrix_free, lagrange) {
+   check_operator(elements::element_type::hexN, lagrange_nodes(3, 3), 3, 3, 4, 3,
+      true);
+   check_operator(elements::element_type::quadN, lagrange_nodes(2, 4), 2, 4, 5, 4,
+      true);
+}
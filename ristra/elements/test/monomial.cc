@@ -0,0 +1,83 @@
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "ristra/elements/batched.h"
+#include "ristra/elements/monomial.h"
+#include "ristra/elements/utilities.h"
+#include "ristra/elements/test/fixtures.h"
+
+namespace elements = ristra::elements;
+using ristra::elements::vector;
+using ristra::elements::real_t;
+using ristra::elements::fixtures::make_points;
+
+// the monomial basis reproduces the hand written kernels
+TEST(monomial, matches_kernels) {
+
+   const elements::element_type types[] = {
+      elements::element_type::quad4, elements::element_type::quad8,
+      elements::element_type::quad12, elements::element_type::hex8,
+      elements::element_type::hex20, elements::element_type::hex32};
+
+   const int n_qp = 13;
+   const int n_elem = 5;
+
+   for (auto type : types){
+
+      elements::monomial_basis basis;
+      elements::build_monomial_basis(basis, type);
+
+      int dim = elements::num_dim(type);
+      int n_node = elements::num_nodes(type);
+      ASSERT_EQ(n_node, basis.n_mono);
+
+      auto points = make_points(dim, n_qp);
+
+      vector<real_t> values(n_qp*n_node), partials(n_qp*n_node*dim);
+      vector<real_t> values_ref(n_qp*n_node), partials_ref(n_qp*n_node*dim);
+
+      elements::monomial_reference_basis(values.data(), partials.data(), basis,
+         points.data(), n_qp);
+      elements::reference_basis(values_ref.data(), partials_ref.data(),
+         points.data(), n_qp, type);
+
+      for (int i = 0; i < n_qp*n_node; i++)
+         ASSERT_NEAR(values_ref[i], values[i], 1e-12);
+      for (int i = 0; i < n_qp*n_node*dim; i++)
+         ASSERT_NEAR(partials_ref[i], partials[i], 1e-12);
+
+      // positions through the second product
+      vector<real_t> verts(n_elem*n_node*dim);
+      for (std::size_t i = 0; i < verts.size(); i++) verts[i] = std::cos(0.61*i);
+
+      vector<real_t> x(n_elem*n_qp*dim), x_ref(n_elem*n_qp*dim);
+      elements::gemm_physical_position(x.data(), verts.data(), values.data(),
+         n_elem, n_qp, n_node, dim);
+      elements::batched_physical_position(x_ref.data(), verts.data(),
+         values_ref.data(), n_elem, n_qp, n_node, dim);
+
+      for (std::size_t i = 0; i < x.size(); i++) ASSERT_NEAR(x_ref[i], x[i], 1e-12);
+   }
+}
+
+TEST(monomial, small_gemm) {
+
+   const int m = 7, n = 300, k = 5;
+   vector<real_t> A(m*k), B(k*n), C(m*n, 1.0);
+   for (int i = 0; i < m*k; i++) A[i] = std::sin(0.3*i);
+   for (int i = 0; i < k*n; i++) B[i] = std::cos(0.2*i);
+
+   elements::small_gemm(C.data(), A.data(), B.data(), m, n, k);
+
+   for (int i = 0; i < m; i++)
+      for (int j = 0; j < n; j++){
+         real_t sum = 1.0;
+         for (int p = 0; p < k; p++) sum += A[i*k + p]*B[p*n + j];
+         ASSERT_NEAR(sum, C[i*n + j], 1e-13);
+      }
+
+   // element types without a fixed node set have no monomial basis
+   elements::monomial_basis basis;
+   ASSERT_ANY_THROW(elements::build_monomial_basis(basis, elements::element_type::hexN));
+}
@@ -0,0 +1,125 @@
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "ristra/elements/elements.h"
+#include "ristra/elements/lagrange.h"
+#include "ristra/elements/node_sets.h"
+#include "ristra/elements/quadrature.h"
+#include "ristra/elements/utilities.h"
+
+namespace elements = ristra::elements;
+using ristra::elements::vector;
+using ristra::elements::real_t;
+using ristra::elements::node_spacing;
+
+TEST(node_sets, nodes) {
+
+   const real_t pi = 3.14159265358979323846;
+
+   auto &cheb = elements::get_node_set(node_spacing::chebyshev, 3);
+   EXPECT_EQ(4, cheb.num_nodes);
+   EXPECT_EQ(-1.0, cheb.nodes[0]);
+   EXPECT_NEAR(-std::cos(3.0*pi/8.0), cheb.nodes[1], 1e-15);
+   EXPECT_NEAR(std::cos(3.0*pi/8.0), cheb.nodes[2], 1e-15);
+   EXPECT_EQ(1.0, cheb.nodes[3]);
+
+   for (int order = 1; order <= 8; order++){
+      int N = order + 1;
+
+      auto &gll = elements::get_node_set(node_spacing::lobatto, order);
+      auto &line = elements::line_rule(elements::quadrature_rule::lobatto, N);
+      for (int i = 0; i < N; i++) EXPECT_EQ(line.points[i], gll.nodes[i]);
+
+      auto &uniform = elements::get_node_set(node_spacing::equispaced, order);
+      for (int i = 0; i < N; i++)
+         EXPECT_NEAR(-1.0 + 2.0*i/order, uniform.nodes[i], 1e-15);
+   }
+
+   // one build per key, the same reference after
+   EXPECT_EQ(&cheb, &elements::get_node_set(node_spacing::chebyshev, 3));
+   ASSERT_ANY_THROW(elements::get_node_set(node_spacing::chebyshev, 0));
+}
+
+TEST(node_sets, derived) {
+
+   for (auto spacing : {node_spacing::chebyshev, node_spacing::lobatto,
+                        node_spacing::equispaced})
+      for (int order = 1; order <= 8; order++){
+
+         auto &set = elements::get_node_set(spacing, order);
+         int N = set.num_nodes;
+         const real_t *x = set.nodes.data();
+
+         vector<real_t> weights(N);
+         elements::barycentric_weights(weights.data(), x, N);
+         for (int i = 0; i < N; i++) EXPECT_EQ(weights[i], set.weights[i]);
+
+         // D differentiates every polynomial of degree <= order exactly
+         for (int k = 0; k <= order; k++)
+            for (int q = 0; q < N; q++){
+               real_t d = 0.0;
+               for (int n = 0; n < N; n++) d += set.D[q*N + n]*std::pow(x[n], k);
+               real_t exact = (k == 0) ? 0.0 : k*std::pow(x[q], k - 1);
+               EXPECT_NEAR(exact, d, 1e-10*(1 + order*order));
+            }
+
+         // tensor coordinates, xi fastest
+         for (int node = 0; node < N*N*N; node++){
+            EXPECT_EQ(x[node % N],       set.nodes_3d[node*3 + 0]);
+            EXPECT_EQ(x[(node/N) % N],   set.nodes_3d[node*3 + 1]);
+            EXPECT_EQ(x[node/(N*N)],     set.nodes_3d[node*3 + 2]);
+         }
+         for (int node = 0; node < N*N; node++){
+            EXPECT_EQ(x[node % N], set.nodes_2d[node*2 + 0]);
+            EXPECT_EQ(x[node/N],   set.nodes_2d[node*2 + 1]);
+         }
+      }
+}
+
+TEST(node_sets, element_basis) {
+
+   // the node set path of QuadN/HexN matches the general one
+   elements::QuadN quadN;
+   elements::HexN hexN;
+   vector<real_t> xi = {0.31, -0.72, 0.55};
+
+   for (int order = 1; order <= 5; order++){
+      int N = order + 1;
+      auto &set = elements::get_node_set(node_spacing::chebyshev, order);
+
+      vector<real_t> nodes_1d(N), val_1d(N), DVal_1d(N);
+      hexN.chebyshev_nodes_1D(nodes_1d, order);
+      for (int i = 0; i < N; i++) EXPECT_EQ(set.nodes[i], nodes_1d[i]);
+
+      for (int dim = 2; dim <= 3; dim++){
+         int n_node = (dim == 2) ? N*N : N*N*N;
+
+         vector< vector<real_t> > lag_nodes(n_node, vector<real_t>(dim));
+         vector< vector<real_t> > val_nd(n_node, vector<real_t>(dim));
+         vector< vector<real_t> > DVal_nd(n_node, vector<real_t>(dim));
+         vector< vector<real_t> > partial(n_node, vector<real_t>(dim));
+         vector< vector<real_t> > partial_set(n_node, vector<real_t>(dim));
+         vector<real_t> basis(n_node), basis_set(n_node);
+         vector<real_t> val(dim*N), dval(dim*N);
+         vector<real_t> point(xi.begin(), xi.begin() + dim);
+
+         if (dim == 2){
+            quadN.basis_partials(lag_nodes, nodes_1d, val_1d, DVal_1d, val_nd,
+               DVal_nd, basis, partial, point, order);
+            quadN.basis_partials(basis_set, partial_set, val, dval, point, set);
+         }
+         else {
+            hexN.basis_partials(lag_nodes, nodes_1d, val_1d, DVal_1d, val_nd,
+               DVal_nd, basis, partial, point, order);
+            hexN.basis_partials(basis_set, partial_set, val, dval, point, set);
+         }
+
+         for (int node = 0; node < n_node; node++){
+            EXPECT_NEAR(basis[node], basis_set[node], 1e-13);
+            for (int d = 0; d < dim; d++)
+               EXPECT_NEAR(partial[node][d], partial_set[node][d], 1e-12);
+         }
+      }
+   }
+}
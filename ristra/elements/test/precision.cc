@@ -0,0 +1,98 @@
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "ristra/elements/elements.h"
+#include "ristra/elements/precision.h"
+#include "ristra/elements/quadrature.h"
+#include "ristra/elements/reference_cache.h"
+#include "ristra/elements/utilities.h"
+#include "ristra/elements/test/fixtures.h"
+
+namespace elements = ristra::elements;
+using ristra::elements::vector;
+using ristra::elements::real_t;
+using ristra::elements::fixtures::flatten;
+using ristra::elements::fixtures::lagrange_nodes;
+using ristra::elements::fixtures::make_vertices;
+
+namespace {
+
+// largest relative deviation of each precision mode from the double
+// reference block of two distorted elements
+template<class Precision>
+void check_precision(const elements::reference_table &table,
+   const vector<real_t> &vertices, const real_t &tol){
+
+   using storage_t = typename Precision::storage_t;
+   using accum_t = typename Precision::accum_t;
+
+   const int n_elem = 2;
+   int n_qp = table.n_qp;
+   int dim = table.dim;
+
+   elements::element_block exact;
+   elements::evaluate_block(exact, table, vertices.data(), n_elem);
+
+   elements::precision_table<Precision> rounded;
+   elements::convert_table(rounded, table);
+
+   vector<storage_t> verts(vertices.size());
+   elements::round_copy(verts.data(), vertices.data(), vertices.size());
+
+   elements::precision_block<Precision> block;
+   elements::evaluate_block(block, rounded, verts.data(), n_elem);
+
+   for (int m = 0; m < n_elem*n_qp; m++){
+      ASSERT_NEAR(exact.det_J[m], block.det_J[m], tol*std::abs(exact.det_J[m]));
+      for (int d = 0; d < dim; d++)
+         ASSERT_NEAR(exact.x_points[m*dim + d], block.x_points[m*dim + d], tol*4.0);
+      for (int i = 0; i < dim*dim; i++)
+         ASSERT_NEAR(exact.J_inverse[m*dim*dim + i], block.J_inverse[m*dim*dim + i], tol);
+   }
+
+   // element volumes
+   vector<storage_t> ones(n_elem*n_qp, 1.0);
+   vector<accum_t> volume(n_elem);
+   elements::integrate(volume.data(), rounded, block, ones.data());
+
+   for (int elem = 0; elem < n_elem; elem++){
+      real_t exact_volume = 0.0;
+      for (int qp = 0; qp < n_qp; qp++)
+         exact_volume += table.weights[qp]*std::abs(exact.det_J[elem*n_qp + qp]);
+      ASSERT_NEAR(exact_volume, volume[elem], tol*exact_volume);
+   }
+}
+
+} // namespace
+
+// double, single and mixed precision blocks against the double evaluation
+TEST(precision, modes) {
+
+   const int order = 3;
+   vector<real_t> hex20_nodes = flatten(elements::Hex20::ref_vert);
+   vector<real_t> hexN_nodes = lagrange_nodes(3, order);
+
+   elements::reference_cache &cache = elements::reference_cache::instance();
+   const elements::reference_table &hex20 = cache.get(
+      elements::element_type::hex20, elements::quadrature_rule::gauss, 3);
+   const elements::reference_table &hexN = cache.get(
+      elements::element_type::hexN, elements::quadrature_rule::gauss, 4, order);
+
+   for (const auto *table : {&hex20, &hexN}){
+      const vector<real_t> &nodes = (table == &hex20) ? hex20_nodes : hexN_nodes;
+      vector<real_t> vertices = make_vertices(nodes.data(), table->n_node, 3, 2);
+
+      check_precision<elements::double_precision>(*table, vertices, 1e-13);
+      check_precision<elements::mixed_precision>(*table, vertices, 2e-6);
+      check_precision<elements::single_precision>(*table, vertices, 1e-5);
+   }
+}
+
+// quadrature rules computed in float
+TEST(precision, float_rules) {
+   float points[4], weights[4];
+   elements::line_rule(points, weights, elements::quadrature_rule::lobatto, 4);
+   ASSERT_EQ(-1.0f, points[0]);
+   ASSERT_NEAR(2.0f, weights[0] + weights[1] + weights[2] + weights[3], 1e-6f);
+}
@@ -0,0 +1,232 @@
+#include <cmath>
+#include <limits>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <ristra/ristra-config.h>
+#include "ristra/assertions/exceptions.h"
+#include "ristra/elements/elements.h"
+#include "ristra/elements/quadrature.h"
+#include "ristra/elements/utilities.h"
+
+namespace elements = ristra::elements;
+using ristra::elements::vector;
+using ristra::elements::real_t;
+using elements::quadrature_rule;
+
+namespace {
+
+// integral of x^k over [-1, 1]
+real_t monomial_integral(int k){
+   return (k % 2 == 1) ? 0.0 : 2.0/(k + 1.0);
+}
+
+// checks a rule integrates every monomial up to degree exactly
+void check_exactness(const elements::quadrature_1d &rule, int degree){
+   for (int k = 0; k <= degree; k++){
+      real_t sum = 0.0;
+      for (int i = 0; i < rule.order; i++)
+         sum += rule.weights[i]*std::pow(rule.points[i], k);
+      ASSERT_NEAR(monomial_integral(k), sum, 1e-13) << "degree " << k
+         << " with " << rule.order << " points";
+   }
+}
+
+} // namespace
+
+TEST(quadrature, gauss) {
+
+   for (int n = 1; n <= 40; n++){
+      auto &rule = elements::line_rule(quadrature_rule::gauss, n);
+      ASSERT_EQ(n, rule.order);
+
+      for (int i = 1; i < n; i++) ASSERT_LT(rule.points[i-1], rule.points[i]);
+      check_exactness(rule, std::min(2*n - 1, 30));
+   }
+
+   // a few closed forms
+   auto &g3 = elements::line_rule(quadrature_rule::gauss, 3);
+   ASSERT_NEAR(-std::sqrt(3.0/5.0), g3.points[0], 1e-15);
+   ASSERT_NEAR(8.0/9.0, g3.weights[1], 1e-15);
+
+   auto &g5 = elements::line_rule(quadrature_rule::gauss, 5);
+   ASSERT_NEAR(-std::sqrt(5.0 + 2.0*std::sqrt(10.0/7.0))/3.0, g5.points[0], 1e-15);
+   ASSERT_NEAR((322.0 - 13.0*std::sqrt(70.0))/900.0, g5.weights[0], 1e-15);
+}
+
+TEST(quadrature, lobatto) {
+
+   auto &l1 = elements::line_rule(quadrature_rule::lobatto, 1);
+   ASSERT_EQ(0.0, l1.points[0]);
+   ASSERT_EQ(2.0, l1.weights[0]);
+
+   for (int n = 2; n <= 40; n++){
+      auto &rule = elements::line_rule(quadrature_rule::lobatto, n);
+      ASSERT_EQ(-1.0, rule.points[0]);
+      ASSERT_EQ( 1.0, rule.points[n-1]);
+      ASSERT_NEAR(2.0/(n*(n - 1.0)), rule.weights[0], 1e-15);
+
+      for (int i = 1; i < n; i++) ASSERT_LT(rule.points[i-1], rule.points[i]);
+      check_exactness(rule, std::min(2*n - 3, 30));
+   }
+
+   auto &l5 = elements::line_rule(quadrature_rule::lobatto, 5);
+   ASSERT_NEAR(-std::sqrt(3.0/7.0), l5.points[1], 1e-15);
+   ASSERT_NEAR(49.0/90.0, l5.weights[1], 1e-15);
+   ASSERT_NEAR(32.0/45.0, l5.weights[2], 1e-15);
+}
+
+TEST(quadrature, cache) {
+
+   auto &a = elements::line_rule(quadrature_rule::gauss, 12);
+   auto &b = elements::line_rule(quadrature_rule::gauss, 12);
+   ASSERT_EQ(&a, &b);
+
+   auto &t = elements::tensor_rule(quadrature_rule::lobatto, 3, 4);
+   auto &u = elements::tensor_rule(quadrature_rule::lobatto, 3, 4);
+   ASSERT_EQ(&t, &u);
+}
+
+// threads racing to build and look up the same rules all get the one copy
+TEST(quadrature, threaded_cache) {
+
+   const int n_threads = 4;
+   const int n_orders = 8;
+   std::vector<const elements::quadrature_1d *> lines(n_threads*n_orders);
+   std::vector<const elements::tensor_quadrature *> tensors(n_threads*n_orders);
+
+   std::vector<std::thread> threads;
+   for (int t = 0; t < n_threads; t++)
+      threads.emplace_back([&, t](){
+         for (int i = 0; i < n_orders; i++){
+            int order = 20 + i;
+            lines[t*n_orders + i] = &elements::line_rule(quadrature_rule::gauss, order);
+            tensors[t*n_orders + i] = &elements::tensor_rule(quadrature_rule::gauss, order, 2);
+         }
+      });
+   for (auto &thread : threads) thread.join();
+
+   for (int t = 1; t < n_threads; t++)
+      for (int i = 0; i < n_orders; i++){
+         ASSERT_EQ(lines[i], lines[t*n_orders + i]);
+         ASSERT_EQ(tensors[i], tensors[t*n_orders + i]);
+      }
+
+   // beyond the indexed orders the locked map still hands out one copy
+   auto &a = elements::line_rule(quadrature_rule::lobatto, 80);
+   auto &b = elements::line_rule(quadrature_rule::lobatto, 80);
+   ASSERT_EQ(&a, &b);
+   ASSERT_EQ(80, a.order);
+}
+
+TEST(quadrature, tensor) {
+
+   for (int dim = 1; dim <= 4; dim++){
+      for (auto kind : {quadrature_rule::gauss, quadrature_rule::lobatto}){
+
+         const int order = 5;
+         auto &line = elements::line_rule(kind, order);
+         auto &rule = elements::tensor_rule(kind, order, dim);
+
+         ASSERT_EQ(dim, rule.dim);
+         ASSERT_EQ(int(std::pow(order, dim)), rule.n_qp);
+
+         real_t volume = 0.0;
+         for (int qp = 0; qp < rule.n_qp; qp++) volume += rule.weights[qp];
+         ASSERT_NEAR(std::pow(2.0, dim), volume, 1e-12);
+
+         // xi runs fastest
+         ASSERT_EQ(line.points[1], rule.points[1*dim + 0]);
+         if (dim > 1){
+            ASSERT_EQ(line.points[1], rule.points[order*dim + 1]);
+         }
+      }
+   }
+}
+
+TEST(quadrature, line_rules) {
+
+   // the element routines agree with the cached rules past the old order 8 cap
+   for (int p = 1; p <= 12; p++){
+      auto &gauss = elements::line_rule(quadrature_rule::gauss, p);
+      auto &lobatto = elements::line_rule(quadrature_rule::lobatto, p);
+
+      for (int m = 1; m <= p; m++){
+         real_t x, w;
+         int i = m, order = p;
+
+         elements::LineGaussRuleInfo(x, w, i, order);
+         ASSERT_EQ(gauss.points[m-1], x);
+         ASSERT_EQ(gauss.weights[m-1], w);
+
+         elements::LineLobattoRuleInfo(x, w, i, order);
+         ASSERT_EQ(lobatto.points[m-1], x);
+         ASSERT_EQ(lobatto.weights[m-1], w);
+      }
+   }
+
+   int quad_order = 10;
+   int n_qp = quad_order*quad_order*quad_order;
+   vector< vector<real_t> > pts(n_qp, vector<real_t>(3));
+   vector< vector<real_t> > weights(n_qp, vector<real_t>(3));
+   vector<real_t> tot_weight(n_qp);
+
+   elements::Gauss3D(pts, weights, tot_weight, quad_order);
+
+   real_t volume = 0.0;
+   for (int m = 0; m < n_qp; m++){
+      ASSERT_NEAR(weights[m][0]*weights[m][1]*weights[m][2], tot_weight[m], 1e-15);
+      volume += tot_weight[m];
+   }
+   ASSERT_NEAR(8.0, volume, 1e-12);
+}
+
+TEST(quadrature, float_rules) {
+
+   const float eps = std::numeric_limits<float>::epsilon();
+
+   for (auto kind : {quadrature_rule::gauss, quadrature_rule::lobatto}){
+      for (int n = 1; n <= 16; n++){
+         auto &rule = elements::line_rule<float>(kind, n);
+         auto &exact = elements::line_rule<double>(kind, n);
+         ASSERT_EQ(n, rule.order);
+
+         // computed in float, within a few ulps of the double rule
+         float sum = 0.0f;
+         for (int i = 0; i < n; i++){
+            ASSERT_NEAR(exact.points[i], rule.points[i], 8*eps);
+            ASSERT_NEAR(exact.weights[i], rule.weights[i], 64*eps*exact.weights[i]);
+            sum += rule.weights[i];
+         }
+         ASSERT_NEAR(2.0f, sum, 16*eps);
+      }
+   }
+
+   // a cache per scalar type
+   auto &g4 = elements::line_rule<float>(quadrature_rule::gauss, 4);
+   ASSERT_EQ(&g4, &elements::line_rule<float>(quadrature_rule::gauss, 4));
+
+   auto &t = elements::tensor_rule<float>(quadrature_rule::gauss, 3, 3);
+   float volume = 0.0f;
+   for (int qp = 0; qp < t.n_qp; qp++) volume += t.weights[qp];
+   ASSERT_NEAR(8.0f, volume, 64*eps);
+   ASSERT_EQ(g4.points.size(), 4u);
+}
+
+TEST(quadrature, invalid_order) {
+
+   // rejected by the library before anything is allocated
+#ifdef RISTRA_ENABLE_EXCEPTIONS
+   ASSERT_THROW(elements::line_rule(quadrature_rule::gauss, -1),
+      ristra::assertions::ExceptionNotImplemented);
+   ASSERT_THROW(elements::tensor_rule(quadrature_rule::lobatto, 0, 2),
+      ristra::assertions::ExceptionNotImplemented);
+#else
+   ASSERT_DEATH(elements::line_rule(quadrature_rule::gauss, -1),
+      "at least one point");
+   ASSERT_DEATH(elements::tensor_rule(quadrature_rule::lobatto, 0, 2),
+      "at least one point");
+#endif
+}
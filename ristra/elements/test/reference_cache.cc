@@ -0,0 +1,126 @@
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "ristra/elements/reference_cache.h"
+#include "ristra/elements/utilities.h"
+
+namespace elements = ristra::elements;
+using ristra::elements::vector;
+using ristra::elements::real_t;
+using elements::element_type;
+using elements::quadrature_rule;
+
+TEST(reference_cache, reuse) {
+
+   elements::reference_cache cache;
+
+   auto &a = cache.get(element_type::hex8, quadrature_rule::gauss, 2);
+   auto &b = cache.get(element_type::hex8, quadrature_rule::gauss, 2);
+   auto &c = cache.get(element_type::hex8, quadrature_rule::lobatto, 2);
+   auto &d = cache.get(element_type::hexN, quadrature_rule::gauss, 3, 2);
+   auto &e = cache.get(element_type::hexN, quadrature_rule::gauss, 3, 3);
+
+   // the same key hands back the same table
+   ASSERT_EQ(&a, &b);
+   ASSERT_NE(&a, &c);
+   ASSERT_NE(&d, &e);
+   ASSERT_EQ(4u, cache.size());
+
+   // elem_order does not distinguish fixed order elements
+   auto &f = cache.get(element_type::hex8, quadrature_rule::gauss, 2, 5);
+   ASSERT_EQ(&a, &f);
+
+   cache.clear();
+   ASSERT_EQ(0u, cache.size());
+}
+
+TEST(reference_cache, tables) {
+
+   auto &cache = elements::reference_cache::instance();
+
+   struct case_t { element_type type; int elem_order; int n_node; int dim; };
+   case_t cases[] = {
+      {element_type::quad4,  1,  4, 2},
+      {element_type::quad8,  1,  8, 2},
+      {element_type::quad12, 1, 12, 2},
+      {element_type::hex8,   1,  8, 3},
+      {element_type::hex20,  1, 20, 3},
+      {element_type::hex32,  1, 32, 3},
+      {element_type::quadN,  3, 16, 2},
+      {element_type::hexN,   2, 27, 3},
+      {element_type::tess16, 1, 16, 4}
+   };
+
+   for (auto &c : cases){
+      for (auto rule : {quadrature_rule::gauss, quadrature_rule::lobatto}){
+
+         const int quad_order = 4;
+         auto &table = cache.get(c.type, rule, quad_order, c.elem_order);
+
+         ASSERT_EQ(c.n_node, table.n_node);
+         ASSERT_EQ(c.dim, table.dim);
+         ASSERT_EQ(int(std::lround(std::pow(quad_order, c.dim))), table.n_qp);
+
+         // weights integrate a constant over the reference element
+         real_t volume = 0.0;
+         for (int qp = 0; qp < table.n_qp; qp++) volume += table.weights[qp];
+         ASSERT_NEAR(std::pow(2.0, c.dim), volume, 1e-12);
+
+         // partition of unity, partials sum to zero
+         for (int qp = 0; qp < table.n_qp; qp++){
+            real_t sum = 0.0;
+            vector<real_t> dsum(table.dim, 0.0);
+            for (int node = 0; node < table.n_node; node++){
+               sum += table.basis[qp*table.n_node + node];
+               for (int d = 0; d < table.dim; d++)
+                  dsum[d] += table.partials[(qp*table.n_node + node)*table.dim + d];
+            }
+            ASSERT_NEAR(1.0, sum, 1e-12);
+            for (int d = 0; d < table.dim; d++) ASSERT_NEAR(0.0, dsum[d], 1e-11);
+         }
+      }
+   }
+}
+
+TEST(reference_cache, evaluate_block) {
+
+   auto &table = elements::reference_cache::instance().get(
+      element_type::hex8, quadrature_rule::gauss, 3);
+
+   // two sheared unit cubes
+   const real_t ref[8][3] = {
+      {-1,-1,-1}, {1,-1,-1}, {1,-1,1}, {-1,-1,1},
+      {-1, 1,-1}, {1, 1,-1}, {1, 1,1}, {-1, 1,1}};
+
+   const int n_elem = 2;
+   vector<real_t> verts(n_elem*8*3);
+   for (int elem = 0; elem < n_elem; elem++)
+      for (int node = 0; node < 8; node++){
+         verts[(elem*8 + node)*3 + 0] = ref[node][0] + 0.3*ref[node][1] + 3.0*elem;
+         verts[(elem*8 + node)*3 + 1] = ref[node][1];
+         verts[(elem*8 + node)*3 + 2] = 2.0*ref[node][2];
+      }
+
+   elements::element_block from_table, from_points;
+   elements::evaluate_block(from_table, table, verts.data(), n_elem);
+   elements::evaluate_block(from_points, element_type::hex8, verts.data(),
+      n_elem, table.points.data(), table.n_qp);
+
+   ASSERT_EQ(from_points.x_points.size(), from_table.x_points.size());
+   for (std::size_t i = 0; i < from_table.x_points.size(); i++)
+      ASSERT_DOUBLE_EQ(from_points.x_points[i], from_table.x_points[i]);
+   for (std::size_t i = 0; i < from_table.J_inverse.size(); i++)
+      ASSERT_DOUBLE_EQ(from_points.J_inverse[i], from_table.J_inverse[i]);
+
+   // affine map: constant determinant
+   for (auto det : from_table.det_J) ASSERT_NEAR(2.0, det, 1e-12);
+
+   // the table's basis is shared, not copied into the block
+   ASSERT_EQ(table.basis.data(), from_table.basis_data());
+   ASSERT_EQ(table.partials.data(), from_table.partials_data());
+   ASSERT_TRUE(from_table.basis.empty());
+   ASSERT_EQ(from_points.basis.data(), from_points.basis_data());
+   for (int i = 0; i < table.n_qp*table.n_node; i++)
+      ASSERT_DOUBLE_EQ(from_points.basis_data()[i], from_table.basis_data()[i]);
+}
@@ -0,0 +1,135 @@
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "ristra/elements/reference_cache.h"
+#include "ristra/elements/sum_factorization.h"
+#include "ristra/elements/utilities.h"
+
+namespace elements = ristra::elements;
+using ristra::elements::vector;
+using ristra::elements::real_t;
+using elements::element_type;
+using elements::quadrature_rule;
+
+namespace {
+
+// deterministic nodal data
+vector<real_t> make_values(int n){
+   vector<real_t> u(n);
+   for (int i = 0; i < n; i++) u[i] = std::sin(0.37*i + 0.1) + 0.25*std::cos(1.9*i);
+   return u;
+}
+
+real_t dot(const vector<real_t> &a, const vector<real_t> &b){
+   real_t sum = 0.0;
+   for (std::size_t i = 0; i < a.size(); i++) sum += a[i]*b[i];
+   return sum;
+}
+
+// dense reference, out[elem][qp] = sum_node table[qp][node*stride + offset] u[elem][node]
+vector<real_t> dense_apply(const elements::reference_table &table,
+   const elements::aligned_vector<real_t> &values, int stride, int offset,
+   const vector<real_t> &u, int n_elem){
+   vector<real_t> out(n_elem*table.n_qp, 0.0);
+   for (int elem = 0; elem < n_elem; elem++)
+      for (int qp = 0; qp < table.n_qp; qp++)
+         for (int node = 0; node < table.n_node; node++)
+            out[elem*table.n_qp + qp] += values[(qp*table.n_node + node)*stride + offset]
+                                       * u[elem*table.n_node + node];
+   return out;
+}
+
+} // namespace
+
+TEST(sum_factorization, hex) {
+
+   const int n_elem = 3;
+
+   for (int order = 1; order <= 5; order++){
+      for (int quad_order : {order, order + 2}){
+
+         auto &table = elements::reference_cache::instance().get(
+            element_type::hexN, quadrature_rule::gauss, quad_order, order);
+
+         elements::tensor_basis_1d basis;
+         elements::build_tensor_basis_1d(basis, order, quadrature_rule::gauss,
+            quad_order);
+
+         int n_node = table.n_node;
+         int n_qp = table.n_qp;
+
+         auto u = make_values(n_elem*n_node);
+
+         // interpolation
+         vector<real_t> u_qp(n_elem*n_qp);
+         elements::interpolate_3d(u_qp.data(), u.data(), basis, n_elem);
+         auto u_dense = dense_apply(table, table.basis, 1, 0, u, n_elem);
+         for (int i = 0; i < n_elem*n_qp; i++) ASSERT_NEAR(u_dense[i], u_qp[i], 1e-12);
+
+         // gradients
+         vector<real_t> grad_qp(n_elem*n_qp*3);
+         elements::gradient_3d(grad_qp.data(), u.data(), basis, n_elem);
+         for (int d = 0; d < 3; d++){
+            auto g_dense = dense_apply(table, table.partials, 3, d, u, n_elem);
+            for (int i = 0; i < n_elem*n_qp; i++)
+               ASSERT_NEAR(g_dense[i], grad_qp[i*3 + d], 1e-11);
+         }
+
+         // integration is the transpose of interpolation
+         auto f = make_values(n_elem*n_qp);
+         vector<real_t> r(n_elem*n_node);
+         elements::integrate_3d(r.data(), f.data(), basis, n_elem);
+         ASSERT_NEAR(dot(u_qp, f), dot(u, r), 1e-10);
+
+         // and of the gradient
+         auto g = make_values(n_elem*n_qp*3);
+         elements::integrate_gradient_3d(r.data(), g.data(), basis, n_elem);
+         ASSERT_NEAR(dot(grad_qp, g), dot(u, r), 1e-9);
+      }
+   }
+}
+
+TEST(sum_factorization, quad) {
+
+   const int n_elem = 2;
+
+   for (int order = 1; order <= 6; order++){
+      for (int quad_order : {order, order + 1}){
+
+         auto &table = elements::reference_cache::instance().get(
+            element_type::quadN, quadrature_rule::lobatto, quad_order, order);
+
+         elements::tensor_basis_1d basis;
+         elements::build_tensor_basis_1d(basis, order, quadrature_rule::lobatto,
+            quad_order);
+
+         int n_node = table.n_node;
+         int n_qp = table.n_qp;
+
+         auto u = make_values(n_elem*n_node);
+
+         vector<real_t> u_qp(n_elem*n_qp);
+         elements::interpolate_2d(u_qp.data(), u.data(), basis, n_elem);
+         auto u_dense = dense_apply(table, table.basis, 1, 0, u, n_elem);
+         for (int i = 0; i < n_elem*n_qp; i++) ASSERT_NEAR(u_dense[i], u_qp[i], 1e-12);
+
+         vector<real_t> grad_qp(n_elem*n_qp*2);
+         elements::gradient_2d(grad_qp.data(), u.data(), basis, n_elem);
+         for (int d = 0; d < 2; d++){
+            auto g_dense = dense_apply(table, table.partials, 2, d, u, n_elem);
+            for (int i = 0; i < n_elem*n_qp; i++)
+               ASSERT_NEAR(g_dense[i], grad_qp[i*2 + d], 1e-11);
+         }
+
+         auto f = make_values(n_elem*n_qp);
+         vector<real_t> r(n_elem*n_node);
+         elements::integrate_2d(r.data(), f.data(), basis, n_elem);
+         ASSERT_NEAR(dot(u_qp, f), dot(u, r), 1e-10);
+
+         auto g = make_values(n_elem*n_qp*2);
+         elements::integrate_gradient_2d(r.data(), g.data(), basis, n_elem);
+         ASSERT_NEAR(dot(grad_qp, g), dot(u, r), 1e-9);
+      }
+   }
+}
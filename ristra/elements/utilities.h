@@ -1,6 +1,9 @@
 #ifndef ELEMENTS_UTILITIES_H
-#define ELEMENTS_UTILITIES_H 
+#define ELEMENTS_UTILITIES_H
 
+#include <cstddef>
+#include <new>
+#include <type_traits>
 #include <vector>
 
 namespace ristra {
@@ -12,6 +15,57 @@ using vector = std::vector<T>;
 
 using real_t = double;
 
+// scalar types of a precision mode: basis tables and coordinates are held
+// as storage_t, jacobians, determinants and sums are accumulated in accum_t
+template<class Storage, class Accum = Storage>
+struct precision_policy {
+   using storage_t = Storage;
+   using accum_t = Accum;
+};
+
+using double_precision = precision_policy<double>;
+using single_precision = precision_policy<float>;
+using mixed_precision  = precision_policy<float, double>;
+
+// T in a context that takes no part in template argument deduction
+template<class T>
+using no_deduce = typename std::common_type<T>::type;
+
+// byte alignment of the flat buffers used by the batched kernels
+constexpr std::size_t simd_alignment = 64;
+
+// allocator handing out simd_alignment aligned storage
+template<class T>
+class aligned_allocator {
+   public:
+
+      using value_type = T;
+
+      aligned_allocator() noexcept = default;
+
+      template<class U>
+      aligned_allocator(const aligned_allocator<U> &) noexcept {}
+
+      T *allocate(std::size_t n){
+         return static_cast<T*>(
+            ::operator new(n*sizeof(T), std::align_val_t(simd_alignment)));
+      }
+
+      void deallocate(T *p, std::size_t){
+         ::operator delete(p, std::align_val_t(simd_alignment));
+      }
+
+      template<class U>
+      bool operator==(const aligned_allocator<U> &) const noexcept { return true; }
+
+      template<class U>
+      bool operator!=(const aligned_allocator<U> &) const noexcept { return false; }
+};
+
+// contiguous, aligned storage for structure-of-arrays buffers
+template<class T>
+using aligned_vector = std::vector<T, aligned_allocator<T>>;
+
 }
 }
 
@@ -10,6 +10,7 @@
 
 // user includes
 #include "ristra/compatibility/type_traits.h"
+#include "ristra/math/expression.h"
 #include "ristra/utils/target.h"
 #include "ristra/utils/template_helpers.h"
 #include "ristra/utils/tuple_visit.h"
@@ -102,6 +103,18 @@ public:
       elems_[i] = rhs.elems_[i]; 
   }
 
+  //! \brief Constructor from an expression, evaluated in a single loop.
+  //! \param[in] expr The expression to evaluate.
+  template <
+    typename E,
+    typename = std::enable_if_t< is_expression_for_v<E,array> >
+  >
+  constexpr array(const E & expr) noexcept
+  {
+    for ( counter_type i=0; i<length_as_counter; i++ )
+      elems_[i] = expr[i];
+  }
+
   //! \brief Constructor with variadic arguments.
   //! \param[in] args The individual array values.
   template <
@@ -339,7 +352,10 @@ public:
   //! \brief assignement to constant value.
   //! \param[in] val The constant on the right hand side of the operator.
   //! \return A reference to the current object.
-  template <typename T2>
+  template <
+    typename T2,
+    typename = std::enable_if_t< !is_expression_v<T2> >
+  >
   auto & operator= (const T2 & val) {
     fill(val);
     return *this;
@@ -359,7 +375,10 @@ public:
   //! \brief Addiition binary operator involving a constant.
   //! \param[in] val The constant on the right hand side of the operator.
   //! \return A reference to the current object.
-  template <typename T2>
+  template <
+    typename T2,
+    typename = std::enable_if_t< !is_expression_v<T2> >
+  >
   auto & operator+=(const T2 & val) {
     for ( counter_type i=0; i<length_as_counter; i++ )
       elems_[i] += val;    
@@ -379,7 +398,10 @@ public:
   //! \brief Subtraction binary operator involving a constant.
   //! \param[in] val The constant on the right hand side of the operator.
   //! \return A reference to the current object.
-  template <typename T2>
+  template <
+    typename T2,
+    typename = std::enable_if_t< !is_expression_v<T2> >
+  >
   auto & operator-=(const T2 & val) {
     for ( counter_type i=0; i<length_as_counter; i++ )
       elems_[i] -= val;    
@@ -400,7 +422,10 @@ public:
   //! \brief Multiplication binary operator involving a constant.
   //! \param[in] val The constant on the right hand side of the operator.
   //! \return A reference to the current object.
-  template <typename T2>
+  template <
+    typename T2,
+    typename = std::enable_if_t< !is_expression_v<T2> >
+  >
   auto & operator*=(const T2 & val) {
     for ( counter_type i=0; i<length_as_counter; i++ )
       elems_[i] *= val;    
@@ -420,7 +445,10 @@ public:
   //! \brief Division operator involving a constant.
   //! \param[in] val The constant on the right hand side of the operator.
   //! \return A reference to the current object.
-  template <typename T2>
+  template <
+    typename T2,
+    typename = std::enable_if_t< !is_expression_v<T2> >
+  >
   auto & operator/=(const T2 & val) {
     auto inv = static_cast<T>(1) / val;
     for ( counter_type i=0; i<length_as_counter; i++ )
@@ -428,6 +456,76 @@ public:
     return *this;
   }
 
+  //! \brief Assignment from an expression, evaluated in a single loop.
+  //! \param[in] rhs The expression on the right hand side of the operator.
+  //! \return A reference to the current object.
+  template <
+    typename E,
+    typename = std::enable_if_t< is_expression_for_v<E,array> >,
+    typename = void
+  >
+  auto & operator= (const E & rhs) {
+    for ( counter_type i=0; i<length_as_counter; i++ )
+      elems_[i] = rhs[i];
+    return *this;
+  }
+
+  //! \brief Addition binary operator involving an expression.
+  //! \param[in] rhs The expression on the right hand side of the operator.
+  //! \return A reference to the current object.
+  template <
+    typename E,
+    typename = std::enable_if_t< is_expression_for_v<E,array> >,
+    typename = void
+  >
+  auto & operator+=(const E & rhs) {
+    for ( counter_type i=0; i<length_as_counter; i++ )
+      elems_[i] += rhs[i];
+    return *this;
+  }
+
+  //! \brief Subtraction binary operator involving an expression.
+  //! \param[in] rhs The expression on the right hand side of the operator.
+  //! \return A reference to the current object.
+  template <
+    typename E,
+    typename = std::enable_if_t< is_expression_for_v<E,array> >,
+    typename = void
+  >
+  auto & operator-=(const E & rhs) {
+    for ( counter_type i=0; i<length_as_counter; i++ )
+      elems_[i] -= rhs[i];
+    return *this;
+  }
+
+  //! \brief Multiplication binary operator involving an expression.
+  //! \param[in] rhs The expression on the right hand side of the operator.
+  //! \return A reference to the current object.
+  template <
+    typename E,
+    typename = std::enable_if_t< is_expression_for_v<E,array> >,
+    typename = void
+  >
+  auto & operator*=(const E & rhs) {
+    for ( counter_type i=0; i<length_as_counter; i++ )
+      elems_[i] *= rhs[i];
+    return *this;
+  }
+
+  //! \brief Division binary operator involving an expression.
+  //! \param[in] rhs The expression on the right hand side of the operator.
+  //! \return A reference to the current object.
+  template <
+    typename E,
+    typename = std::enable_if_t< is_expression_for_v<E,array> >,
+    typename = void
+  >
+  auto & operator/=(const E & rhs) {
+    for ( counter_type i=0; i<length_as_counter; i++ )
+      elems_[i] /= rhs[i];
+    return *this;
+  }
+
   //! \brief Unary - operator.
   //! \param[in] rhs The array on the right hand side of the operator.
   //! \return A reference to the current object.
@@ -462,7 +560,10 @@ bool operator==(const array<T,N>& lhs, const array<T,N>& rhs)
   return true;
 }
 
-template<typename T, typename U, std::size_t N>
+template<
+  typename T, typename U, std::size_t N,
+  typename = std::enable_if_t< !is_expression_v<U> >
+>
 bool operator==(const array<T,N>& lhs, const U& rhs)
 {
   using counter_type = typename array<T,N>::counter_type;
@@ -0,0 +1,1046 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2017 Los Alamos National Laboratory, LLC
+ * All rights reserved
+ *~-------------------------------------------------------------------------~~*/
+////////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Provides batches of small matrices and vectors stored interleaved,
+///        with kernels that work across the whole batch.
+///
+/// A batch of `n` matrices keeps element (i,j) of every matrix contiguous, so
+/// the kernels below loop over the batch in their innermost loop, where the
+/// compiler vectorizes them.  Pivoting is done with selects instead of
+/// branches so every matrix in the batch follows the same instructions.
+/// Large batches are split over threads in contiguous chunks.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// user includes
+#include "ristra/math/matrix.h"
+#include "ristra/utils/template_helpers.h"
+
+// system includes
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <initializer_list>
+#include <thread>
+#include <vector>
+
+namespace ristra {
+namespace math {
+
+////////////////////////////////////////////////////////////////////////////////
+//! \brief Options of the batched kernels.
+////////////////////////////////////////////////////////////////////////////////
+struct batch_options {
+  //! \brief The number of threads, 0 uses std::thread::hardware_concurrency.
+  std::size_t n_threads = 0;
+  //! \brief Batches smaller than this run on the calling thread.
+  std::size_t thread_threshold = 16384;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+//! \brief A batch of matrices stored interleaved, element (i,j) of every
+//!        matrix contiguous.
+//! \tparam T  The base value type.
+//! \tparam D1,D2  The matrix dimensions.
+////////////////////////////////////////////////////////////////////////////////
+template < typename T, std::size_t D1, std::size_t D2 >
+class batched_matrix {
+
+public:
+
+  using value_type = T;
+  using size_type  = std::size_t;
+
+  //! \brief The matrix dimensions.
+  static constexpr size_type rows    = D1;
+  static constexpr size_type columns = D2;
+
+  //! \brief Force the default constructor.
+  batched_matrix() = default;
+
+  //! \brief Constructor with the number of matrices.
+  //! \param[in] n  The number of matrices, all zero.
+  explicit batched_matrix( size_type n ) : n_(n), data_(D1*D2*n, T(0)) {}
+
+  //! \brief Change the number of matrices, keeping the first ones.
+  void resize( size_type n ) {
+    std::vector<T> data(D1*D2*n, T(0));
+    auto keep = std::min(n, n_);
+    for ( size_type c = 0; c < D1*D2; c++ )
+      std::copy_n( data_.begin() + c*n_, keep, data.begin() + c*n );
+    data_.swap(data);
+    n_ = n;
+  }
+
+  //! \brief The number of matrices.
+  size_type size() const { return n_; }
+
+  //! \brief Element (i,j) of matrix `m`.
+  //! @{
+  T & operator()( size_type m, size_type i, size_type j )
+  {
+    assert( m < n_ && i < D1 && j < D2 && "out of range" );
+    return data_[ (i*D2 + j)*n_ + m ];
+  }
+
+  const T & operator()( size_type m, size_type i, size_type j ) const
+  {
+    assert( m < n_ && i < D1 && j < D2 && "out of range" );
+    return data_[ (i*D2 + j)*n_ + m ];
+  }
+  //! @}
+
+  //! \brief Element (i,j) of every matrix, `size()` contiguous values.
+  //! @{
+  T * component( size_type i, size_type j )
+  { return data_.data() + (i*D2 + j)*n_; }
+
+  const T * component( size_type i, size_type j ) const
+  { return data_.data() + (i*D2 + j)*n_; }
+  //! @}
+
+  //! \brief Copy out matrix `m`.
+  matrix<T,D1,D2> get( size_type m ) const {
+    matrix<T,D1,D2> tmp;
+    for ( size_type i = 0; i < D1; i++ )
+      for ( size_type j = 0; j < D2; j++ ) tmp(i,j) = (*this)(m,i,j);
+    return tmp;
+  }
+
+  //! \brief Copy in matrix `m`.
+  void set( size_type m, const matrix<T,D1,D2> & mat ) {
+    for ( size_type i = 0; i < D1; i++ )
+      for ( size_type j = 0; j < D2; j++ ) (*this)(m,i,j) = mat(i,j);
+  }
+
+private:
+
+  //! \brief The number of matrices.
+  size_type n_ = 0;
+  //! \brief The matrices, [D1*D2][n].
+  std::vector<T> data_;
+
+};
+
+////////////////////////////////////////////////////////////////////////////////
+//! \brief A batch of vectors stored interleaved, element i of every vector
+//!        contiguous.
+//! \tparam T  The base value type.
+//! \tparam D  The vector dimension.
+////////////////////////////////////////////////////////////////////////////////
+template < typename T, std::size_t D >
+class batched_vector {
+
+public:
+
+  using value_type = T;
+  using size_type  = std::size_t;
+
+  //! \brief The vector dimension.
+  static constexpr size_type length = D;
+
+  //! \brief Force the default constructor.
+  batched_vector() = default;
+
+  //! \brief Constructor with the number of vectors.
+  //! \param[in] n  The number of vectors, all zero.
+  explicit batched_vector( size_type n ) : data_(n) {}
+
+  //! \brief Change the number of vectors, keeping the first ones.
+  void resize( size_type n ) { data_.resize(n); }
+
+  //! \brief The number of vectors.
+  size_type size() const { return data_.size(); }
+
+  //! \brief Element i of vector `m`.
+  //! @{
+  T & operator()( size_type m, size_type i ) { return data_(m,i,0); }
+  const T & operator()( size_type m, size_type i ) const { return data_(m,i,0); }
+  //! @}
+
+  //! \brief Element i of every vector, `size()` contiguous values.
+  //! @{
+  T * component( size_type i ) { return data_.component(i,0); }
+  const T * component( size_type i ) const { return data_.component(i,0); }
+  //! @}
+
+  //! \brief Copy out vector `m`.
+  vector<T,D> get( size_type m ) const {
+    vector<T,D> tmp;
+    for ( size_type i = 0; i < D; i++ ) tmp[i] = (*this)(m,i);
+    return tmp;
+  }
+
+  //! \brief Copy in vector `m`.
+  void set( size_type m, const vector<T,D> & vec ) {
+    for ( size_type i = 0; i < D; i++ ) (*this)(m,i) = vec[i];
+  }
+
+private:
+
+  //! \brief The vectors, a batch of column matrices.
+  batched_matrix<T,D,1> data_;
+
+};
+
+namespace detail {
+
+//! \brief The number of matrices one kernel call works on at a time.
+constexpr std::size_t batch_block = 32;
+
+//! \brief Run body(begin, end) over [0, n), split in contiguous chunks over
+//!        threads when the batch is large enough.
+template < typename Body >
+void batch_for( std::size_t n, const batch_options & options, Body body )
+{
+  std::size_t n_threads = options.n_threads;
+  if ( n_threads == 0 )
+    n_threads = std::max( 1u, std::thread::hardware_concurrency() );
+
+  // whole blocks per thread
+  std::size_t n_blocks = (n + batch_block - 1) / batch_block;
+  n_threads = std::min( n_threads, n_blocks );
+
+  if ( n < options.thread_threshold || n_threads <= 1 ) {
+    body( std::size_t(0), n );
+    return;
+  }
+
+  std::vector<std::thread> threads;
+  threads.reserve( n_threads );
+  for ( std::size_t t = 0; t < n_threads; t++ ) {
+    auto begin = std::min( n, (n_blocks*t/n_threads)*batch_block );
+    auto end = std::min( n, (n_blocks*(t+1)/n_threads)*batch_block );
+    if ( begin < end ) threads.emplace_back( body, begin, end );
+  }
+  for ( auto & thread : threads ) thread.join();
+}
+
+//! \brief Gaussian elimination with partial pivoting of a block of matrices
+//!        and their right hand sides, leaving U in `a`.
+//! \remark A zero pivot gives zero multipliers, so the diagonal of U still
+//!         gives a zero determinant.
+//! \param[in,out] a  The matrices, [N*N][batch_block]
+//! \param[in,out] r  The right hand sides, [N*M][batch_block]
+//! \param[out] sign  The sign of the row permutations
+//! \param[in] nb  The number of matrices in the block
+template < typename T, std::size_t N, std::size_t M >
+void eliminate_block(
+  std::array< std::array<T,batch_block>, N*N > & a,
+  std::array< std::array<T,batch_block>, N*M > & r,
+  std::array<T,batch_block> & sign,
+  std::size_t nb )
+{
+  std::array<bool,batch_block> flip;
+  std::array<T,batch_block> l;
+
+  for ( std::size_t m = 0; m < nb; m++ ) sign[m] = T(1);
+
+  for ( std::size_t k = 0; k < N; k++ ) {
+
+    // bring the largest entry of column k onto the diagonal
+    for ( std::size_t i = k+1; i < N; i++ ) {
+
+      for ( std::size_t m = 0; m < nb; m++ ) {
+        flip[m] = std::abs( a[i*N+k][m] ) > std::abs( a[k*N+k][m] );
+        sign[m] = flip[m] ? -sign[m] : sign[m];
+      }
+
+      for ( std::size_t j = k; j < N; j++ ) {
+        auto & ak = a[k*N+j];
+        auto & ai = a[i*N+j];
+        for ( std::size_t m = 0; m < nb; m++ ) {
+          T u = ak[m], v = ai[m];
+          ak[m] = flip[m] ? v : u;
+          ai[m] = flip[m] ? u : v;
+        }
+      }
+
+      for ( std::size_t j = 0; j < M; j++ ) {
+        auto & rk = r[k*M+j];
+        auto & ri = r[i*M+j];
+        for ( std::size_t m = 0; m < nb; m++ ) {
+          T u = rk[m], v = ri[m];
+          rk[m] = flip[m] ? v : u;
+          ri[m] = flip[m] ? u : v;
+        }
+      }
+
+    }
+
+    // eliminate below the pivot
+    for ( std::size_t i = k+1; i < N; i++ ) {
+
+      for ( std::size_t m = 0; m < nb; m++ ) {
+        T p = a[k*N+k][m];
+        l[m] = ( p != T(0) ) ? a[i*N+k][m] / p : T(0);
+      }
+
+      for ( std::size_t j = k+1; j < N; j++ )
+        for ( std::size_t m = 0; m < nb; m++ ) a[i*N+j][m] -= l[m] * a[k*N+j][m];
+
+      for ( std::size_t j = 0; j < M; j++ )
+        for ( std::size_t m = 0; m < nb; m++ ) r[i*M+j][m] -= l[m] * r[k*M+j][m];
+
+    }
+
+  }
+}
+
+//! \brief Back substitution of a block of upper triangular systems.
+//! \param[in] a  The matrices, [N*N][batch_block]
+//! \param[in,out] r  The right hand sides in, the solutions out
+//! \param[in] nb  The number of matrices in the block
+template < typename T, std::size_t N, std::size_t M >
+void back_substitute_block(
+  const std::array< std::array<T,batch_block>, N*N > & a,
+  std::array< std::array<T,batch_block>, N*M > & r,
+  std::size_t nb )
+{
+  for ( std::size_t i = N; i-- > 0; )
+    for ( std::size_t c = 0; c < M; c++ ) {
+      auto & ri = r[i*M+c];
+      for ( std::size_t j = i+1; j < N; j++ )
+        for ( std::size_t m = 0; m < nb; m++ ) ri[m] -= a[i*N+j][m] * r[j*M+c][m];
+      for ( std::size_t m = 0; m < nb; m++ ) ri[m] /= a[i*N+i][m];
+    }
+}
+
+//! \brief Copy a block of matrices out of a batch.
+template < typename T, std::size_t D1, std::size_t D2 >
+void load_block(
+  std::array< std::array<T,batch_block>, D1*D2 > & block,
+  const batched_matrix<T,D1,D2> & A,
+  std::size_t begin,
+  std::size_t nb )
+{
+  for ( std::size_t i = 0; i < D1; i++ )
+    for ( std::size_t j = 0; j < D2; j++ )
+      std::copy_n( A.component(i,j) + begin, nb, block[i*D2+j].begin() );
+}
+
+} // namespace detail
+
+////////////////////////////////////////////////////////////////////////////////
+//! \brief Compute the determinant of every matrix in a batch.
+//! \tparam T  The base value type.
+//! \tparam N  The matrix dimension.
+//! \param[in] A  The matrices
+//! \param[out] det  The determinants, resized to the batch
+//! \param[in] options  The threading options
+////////////////////////////////////////////////////////////////////////////////
+template < typename T, std::size_t N >
+void determinant(
+  const batched_matrix<T,N,N> & A,
+  std::vector<T> & det,
+  const batch_options & options = {} )
+{
+  using detail::batch_block;
+
+  det.resize( A.size() );
+
+  detail::batch_for( A.size(), options, [&]( std::size_t begin, std::size_t end ) {
+
+    // closed forms, the same as for one matrix
+    if constexpr ( N <= 3 ) {
+      T * d = det.data();
+      auto a = [&]( std::size_t i, std::size_t j ) { return A.component(i,j); };
+      for ( std::size_t m = begin; m < end; m++ ) {
+        if constexpr ( N == 1 )
+          d[m] = a(0,0)[m];
+        else if constexpr ( N == 2 )
+          d[m] = a(0,0)[m]*a(1,1)[m] - a(0,1)[m]*a(1,0)[m];
+        else
+          d[m] =
+            a(0,0)[m]*a(1,1)[m]*a(2,2)[m] + a(0,1)[m]*a(1,2)[m]*a(2,0)[m] +
+            a(0,2)[m]*a(1,0)[m]*a(2,1)[m] - a(2,0)[m]*a(1,1)[m]*a(0,2)[m] -
+            a(2,1)[m]*a(1,2)[m]*a(0,0)[m] - a(2,2)[m]*a(1,0)[m]*a(0,1)[m];
+      }
+    }
+
+    else {
+      std::array< std::array<T,batch_block>, N*N > a;
+      std::array< std::array<T,batch_block>, 0 > r;
+      std::array<T,batch_block> sign;
+
+      for ( std::size_t b = begin; b < end; b += batch_block ) {
+        auto nb = std::min( batch_block, end - b );
+        detail::load_block( a, A, b, nb );
+        detail::eliminate_block<T,N,0>( a, r, sign, nb );
+        for ( std::size_t m = 0; m < nb; m++ ) {
+          T d = sign[m];
+          for ( std::size_t k = 0; k < N; k++ ) d *= a[k*N+k][m];
+          det[b+m] = d;
+        }
+      }
+    }
+
+  } );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//! \brief Compute the inverse of every matrix in a batch.
+//! \remark Singular matrices give infinite or NaN entries.
+//! \tparam T  The base value type.
+//! \tparam N  The matrix dimension.
+//! \param[in] A  The matrices
+//! \param[out] Ainv  The inverses, resized to the batch
+//! \param[in] options  The threading options
+////////////////////////////////////////////////////////////////////////////////
+template < typename T, std::size_t N >
+void inverse(
+  const batched_matrix<T,N,N> & A,
+  batched_matrix<T,N,N> & Ainv,
+  const batch_options & options = {} )
+{
+  using detail::batch_block;
+
+  assert( &A != &Ainv && "inverse can not be done in place" );
+  if ( Ainv.size() != A.size() ) Ainv = batched_matrix<T,N,N>( A.size() );
+
+  detail::batch_for( A.size(), options, [&]( std::size_t begin, std::size_t end ) {
+
+    auto a = [&]( std::size_t i, std::size_t j ) { return A.component(i,j); };
+    auto x = [&]( std::size_t i, std::size_t j ) { return Ainv.component(i,j); };
+
+    // adjugate over determinant, the same as for one matrix
+    if constexpr ( N == 1 ) {
+      for ( std::size_t m = begin; m < end; m++ ) x(0,0)[m] = T(1) / a(0,0)[m];
+    }
+
+    else if constexpr ( N == 2 ) {
+      for ( std::size_t m = begin; m < end; m++ ) {
+        T a11 = a(0,0)[m], a12 = a(0,1)[m], a21 = a(1,0)[m], a22 = a(1,1)[m];
+        T inv = T(1) / ( a11*a22 - a12*a21 );
+        x(0,0)[m] =  a22 * inv;
+        x(0,1)[m] = -a12 * inv;
+        x(1,0)[m] = -a21 * inv;
+        x(1,1)[m] =  a11 * inv;
+      }
+    }
+
+    else if constexpr ( N == 3 ) {
+      for ( std::size_t m = begin; m < end; m++ ) {
+        T a11 = a(0,0)[m], a12 = a(0,1)[m], a13 = a(0,2)[m];
+        T a21 = a(1,0)[m], a22 = a(1,1)[m], a23 = a(1,2)[m];
+        T a31 = a(2,0)[m], a32 = a(2,1)[m], a33 = a(2,2)[m];
+        T inv = T(1) / (
+          a11*a22*a33 + a12*a23*a31 + a13*a21*a32 -
+          a31*a22*a13 - a32*a23*a11 - a33*a21*a12 );
+        x(0,0)[m] = ( a22*a33 - a32*a23 ) * inv;
+        x(0,1)[m] = ( a13*a32 - a33*a12 ) * inv;
+        x(0,2)[m] = ( a12*a23 - a22*a13 ) * inv;
+        x(1,0)[m] = ( a23*a31 - a33*a21 ) * inv;
+        x(1,1)[m] = ( a11*a33 - a31*a13 ) * inv;
+        x(1,2)[m] = ( a13*a21 - a23*a11 ) * inv;
+        x(2,0)[m] = ( a21*a32 - a31*a22 ) * inv;
+        x(2,1)[m] = ( a12*a31 - a32*a11 ) * inv;
+        x(2,2)[m] = ( a11*a22 - a21*a12 ) * inv;
+      }
+    }
+
+    // eliminate with the identity as right hand sides
+    else {
+      std::array< std::array<T,batch_block>, N*N > block;
+      std::array< std::array<T,batch_block>, N*N > r;
+      std::array<T,batch_block> sign;
+
+      for ( std::size_t b = begin; b < end; b += batch_block ) {
+        auto nb = std::min( batch_block, end - b );
+        detail::load_block( block, A, b, nb );
+        for ( std::size_t i = 0; i < N; i++ )
+          for ( std::size_t j = 0; j < N; j++ )
+            std::fill_n( r[i*N+j].begin(), nb, (i == j) ? T(1) : T(0) );
+        detail::eliminate_block<T,N,N>( block, r, sign, nb );
+        detail::back_substitute_block<T,N,N>( block, r, nb );
+        for ( std::size_t i = 0; i < N; i++ )
+          for ( std::size_t j = 0; j < N; j++ )
+            std::copy_n( r[i*N+j].begin(), nb, x(i,j) + b );
+      }
+    }
+
+  } );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//! \brief Solve the system A.x = b of every matrix in a batch.
+//! \remark Singular matrices give infinite or NaN entries.
+//! \tparam T  The base value type.
+//! \tparam N  The matrix dimension.
+//! \param[in] A  The matrices
+//! \param[in] b  The right hand sides
+//! \param[out] x  The solutions, resized to the batch
+//! \param[in] options  The threading options
+////////////////////////////////////////////////////////////////////////////////
+template < typename T, std::size_t N >
+void solve(
+  const batched_matrix<T,N,N> & A,
+  const batched_vector<T,N> & b,
+  batched_vector<T,N> & x,
+  const batch_options & options = {} )
+{
+  using detail::batch_block;
+
+  assert( A.size() == b.size() && "batch size mismatch" );
+  if ( x.size() != A.size() ) x.resize( A.size() );
+
+  detail::batch_for( A.size(), options, [&]( std::size_t begin, std::size_t end ) {
+
+    auto a = [&]( std::size_t i, std::size_t j ) { return A.component(i,j); };
+    auto rhs = [&]( std::size_t i ) { return b.component(i); };
+    auto sol = [&]( std::size_t i ) { return x.component(i); };
+
+    // adjugate times the right hand side over determinant, the right hand
+    // side is read before the solution is written so `x` may be `b`
+    if constexpr ( N == 1 ) {
+      for ( std::size_t m = begin; m < end; m++ )
+        sol(0)[m] = rhs(0)[m] / a(0,0)[m];
+    }
+
+    else if constexpr ( N == 2 ) {
+      for ( std::size_t m = begin; m < end; m++ ) {
+        T a11 = a(0,0)[m], a12 = a(0,1)[m], a21 = a(1,0)[m], a22 = a(1,1)[m];
+        T b1 = rhs(0)[m], b2 = rhs(1)[m];
+        T inv = T(1) / ( a11*a22 - a12*a21 );
+        sol(0)[m] = ( a22*b1 - a12*b2 ) * inv;
+        sol(1)[m] = ( a11*b2 - a21*b1 ) * inv;
+      }
+    }
+
+    else if constexpr ( N == 3 ) {
+      for ( std::size_t m = begin; m < end; m++ ) {
+        T a11 = a(0,0)[m], a12 = a(0,1)[m], a13 = a(0,2)[m];
+        T a21 = a(1,0)[m], a22 = a(1,1)[m], a23 = a(1,2)[m];
+        T a31 = a(2,0)[m], a32 = a(2,1)[m], a33 = a(2,2)[m];
+        T b1 = rhs(0)[m], b2 = rhs(1)[m], b3 = rhs(2)[m];
+        T inv = T(1) / (
+          a11*a22*a33 + a12*a23*a31 + a13*a21*a32 -
+          a31*a22*a13 - a32*a23*a11 - a33*a21*a12 );
+        sol(0)[m] = ( ( a22*a33 - a32*a23 )*b1 + ( a13*a32 - a33*a12 )*b2 +
+                      ( a12*a23 - a22*a13 )*b3 ) * inv;
+        sol(1)[m] = ( ( a23*a31 - a33*a21 )*b1 + ( a11*a33 - a31*a13 )*b2 +
+                      ( a13*a21 - a23*a11 )*b3 ) * inv;
+        sol(2)[m] = ( ( a21*a32 - a31*a22 )*b1 + ( a12*a31 - a32*a11 )*b2 +
+                      ( a11*a22 - a21*a12 )*b3 ) * inv;
+      }
+    }
+
+    // eliminate with b as the right hand side
+    else {
+      std::array< std::array<T,batch_block>, N*N > block;
+      std::array< std::array<T,batch_block>, N > r;
+      std::array<T,batch_block> sign;
+
+      for ( std::size_t blk = begin; blk < end; blk += batch_block ) {
+        auto nb = std::min( batch_block, end - blk );
+        detail::load_block( block, A, blk, nb );
+        for ( std::size_t i = 0; i < N; i++ )
+          std::copy_n( rhs(i) + blk, nb, r[i].begin() );
+        detail::eliminate_block<T,N,1>( block, r, sign, nb );
+        detail::back_substitute_block<T,N,1>( block, r, nb );
+        for ( std::size_t i = 0; i < N; i++ )
+          std::copy_n( r[i].begin(), nb, sol(i) + blk );
+      }
+    }
+
+  } );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//! \brief Compute y = alpha A x + beta y for every matrix in a batch.
+//! \remark `x` and `y` must be different.
+//! \tparam T  The base value type.
+//! \tparam D1,D2  The matrix dimensions.
+//! \param[in] alpha  The factor of A x
+//! \param[in] A  The matrices
+//! \param[in] x  The vectors that get right multiplied by `A`
+//! \param[in] beta  The factor of y
+//! \param[in,out] y  The result vectors
+//! \param[in] options  The threading options
+////////////////////////////////////////////////////////////////////////////////
+template < typename T, std::size_t D1, std::size_t D2 >
+void matrix_vector(
+  const T & alpha,
+  const batched_matrix<T,D1,D2> & A,
+  const batched_vector<T,D2> & x,
+  const T & beta,
+  batched_vector<T,D1> & y,
+  const batch_options & options = {} )
+{
+  assert( A.size() == x.size() && A.size() == y.size() && "batch size mismatch" );
+
+  detail::batch_for( A.size(), options, [&]( std::size_t begin, std::size_t end ) {
+    for ( std::size_t i = 0; i < D1; i++ ) {
+      T * yi = y.component(i);
+      for ( std::size_t m = begin; m < end; m++ ) yi[m] *= beta;
+      for ( std::size_t j = 0; j < D2; j++ ) {
+        const T * aij = A.component(i,j);
+        const T * xj = x.component(j);
+        for ( std::size_t m = begin; m < end; m++ ) yi[m] += alpha * aij[m] * xj[m];
+      }
+    }
+  } );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//! \brief Compute C += A B for every matrix in a batch, like the
+//!        matrix_multiply of one matrix.
+//! \remark `C` must be different from `A` and `B`.
+//! \tparam T  The base value type.
+//! \tparam D1,D2,D3  The matrix dimensions.
+//! \param[in] A,B  The matrices that get multiplied together.
+//! \param[in,out] C  The result matrices.
+//! \param[in] options  The threading options
+////////////////////////////////////////////////////////////////////////////////
+template < typename T, std::size_t D1, std::size_t D2, std::size_t D3 >
+void matrix_multiply(
+  const batched_matrix<T,D1,D2> & A,
+  const batched_matrix<T,D2,D3> & B,
+  batched_matrix<T,D1,D3> & C,
+  const batch_options & options = {} )
+{
+  assert( A.size() == B.size() && A.size() == C.size() && "batch size mismatch" );
+
+  detail::batch_for( A.size(), options, [&]( std::size_t begin, std::size_t end ) {
+    for ( std::size_t i = 0; i < D1; i++ )
+      for ( std::size_t j = 0; j < D3; j++ ) {
+        T * cij = C.component(i,j);
+        for ( std::size_t k = 0; k < D2; k++ ) {
+          const T * aik = A.component(i,k);
+          const T * bkj = B.component(k,j);
+          for ( std::size_t m = begin; m < end; m++ ) cij[m] += aik[m] * bkj[m];
+        }
+      }
+  } );
+}
+
+namespace detail {
+
+//! \brief The number of Jacobi sweeps of the batched eigen and singular
+//!        value kernels.
+//! \remark A 2x2 matrix is diagonal after one rotation.  Jacobi converges
+//!         quadratically, so a fixed number of sweeps reaches double
+//!         precision for the small sizes and keeps every matrix of the batch
+//!         on the same instructions.
+template < std::size_t N >
+constexpr std::size_t jacobi_sweeps = (N <= 2) ? 1 : (N <= 4) ? 6 : 10;
+
+//! \brief Rotate columns p and q of a block of matrices.
+template < typename T, std::size_t D1, std::size_t D2 >
+void rotate_columns_block(
+  std::array< std::array<T,batch_block>, D1*D2 > & a,
+  std::size_t p, std::size_t q,
+  const std::array<T,batch_block> & c,
+  const std::array<T,batch_block> & s,
+  std::size_t nb )
+{
+  for ( std::size_t k = 0; k < D1; k++ ) {
+    auto & ap = a[k*D2+p];
+    auto & aq = a[k*D2+q];
+    for ( std::size_t m = 0; m < nb; m++ ) {
+      T u = ap[m], v = aq[m];
+      ap[m] = c[m]*u - s[m]*v;
+      aq[m] = s[m]*u + c[m]*v;
+    }
+  }
+}
+
+//! \brief Diagonalize a block of symmetric matrices with a fixed number of
+//!        Jacobi sweeps, accumulating the rotations in `v` if `Vectors`.
+//! \param[in,out] a  The matrices, [N*N][batch_block]
+//! \param[in,out] v  The rotations, start from the identity
+//! \param[in] nb  The number of matrices in the block
+template < bool Vectors, typename T, std::size_t N >
+void jacobi_eigen_block(
+  std::array< std::array<T,batch_block>, N*N > & a,
+  std::array< std::array<T,batch_block>, N*N > & v,
+  std::size_t nb )
+{
+  std::array<T,batch_block> c, s;
+
+  for ( std::size_t sweep = 0; sweep < jacobi_sweeps<N>; sweep++ )
+    for ( std::size_t p = 0; p+1 < N; p++ )
+      for ( std::size_t q = p+1; q < N; q++ ) {
+
+        for ( std::size_t m = 0; m < nb; m++ )
+          jacobi_rotation( a[p*N+p][m], a[q*N+q][m], a[p*N+q][m], c[m], s[m] );
+
+        // rows, then columns
+        for ( std::size_t k = 0; k < N; k++ ) {
+          auto & ap = a[p*N+k];
+          auto & aq = a[q*N+k];
+          for ( std::size_t m = 0; m < nb; m++ ) {
+            T u = ap[m], w = aq[m];
+            ap[m] = c[m]*u - s[m]*w;
+            aq[m] = s[m]*u + c[m]*w;
+          }
+        }
+        rotate_columns_block<T,N,N>( a, p, q, c, s, nb );
+
+        std::fill_n( a[p*N+q].begin(), nb, T(0) );
+        std::fill_n( a[q*N+p].begin(), nb, T(0) );
+
+        if constexpr ( Vectors ) rotate_columns_block<T,N,N>( v, p, q, c, s, nb );
+      }
+}
+
+//! \brief Orthogonalize the columns of a block of matrices with a fixed
+//!        number of one sided Jacobi sweeps.
+//! \param[in,out] a  The matrices, [N*N][batch_block]
+//! \param[in] nb  The number of matrices in the block
+template < typename T, std::size_t N >
+void jacobi_svd_block(
+  std::array< std::array<T,batch_block>, N*N > & a,
+  std::size_t nb )
+{
+  std::array<T,batch_block> alpha, beta, gamma, c, s;
+
+  for ( std::size_t sweep = 0; sweep < jacobi_sweeps<N>; sweep++ )
+    for ( std::size_t p = 0; p+1 < N; p++ )
+      for ( std::size_t q = p+1; q < N; q++ ) {
+
+        // the 2x2 block of a^T a
+        alpha.fill( T(0) );
+        beta.fill( T(0) );
+        gamma.fill( T(0) );
+        for ( std::size_t k = 0; k < N; k++ ) {
+          const auto & ap = a[k*N+p];
+          const auto & aq = a[k*N+q];
+          for ( std::size_t m = 0; m < nb; m++ ) {
+            alpha[m] += ap[m] * ap[m];
+            beta[m]  += aq[m] * aq[m];
+            gamma[m] += ap[m] * aq[m];
+          }
+        }
+
+        for ( std::size_t m = 0; m < nb; m++ )
+          jacobi_rotation( alpha[m], beta[m], gamma[m], c[m], s[m] );
+
+        rotate_columns_block<T,N,N>( a, p, q, c, s, nb );
+      }
+}
+
+//! \brief Sort the values of a block with a sorting network, ascending or
+//!        descending, swapping the columns of `v` along if `Vectors`.
+template < bool Vectors, typename T, std::size_t N >
+void sort_block(
+  std::array< std::array<T,batch_block>, N > & w,
+  std::array< std::array<T,batch_block>, N*N > & v,
+  bool ascending,
+  std::size_t nb )
+{
+  std::array<bool,batch_block> flip;
+
+  for ( std::size_t i = 0; i < N; i++ )
+    for ( std::size_t j = i+1; j < N; j++ ) {
+
+      for ( std::size_t m = 0; m < nb; m++ ) {
+        T x = w[i][m], y = w[j][m];
+        flip[m] = ascending ? ( y < x ) : ( y > x );
+        w[i][m] = flip[m] ? y : x;
+        w[j][m] = flip[m] ? x : y;
+      }
+
+      if constexpr ( Vectors )
+        for ( std::size_t k = 0; k < N; k++ ) {
+          auto & vi = v[k*N+i];
+          auto & vj = v[k*N+j];
+          for ( std::size_t m = 0; m < nb; m++ ) {
+            T x = vi[m], y = vj[m];
+            vi[m] = flip[m] ? y : x;
+            vj[m] = flip[m] ? x : y;
+          }
+        }
+    }
+}
+
+//! \brief The eigenvalues, and optionally eigenvectors, of a batch.
+template < bool Vectors, typename T, std::size_t N >
+void symmetric_eigen(
+  const batched_matrix<T,N,N> & A,
+  batched_vector<T,N> & values,
+  batched_matrix<T,N,N> * vectors,
+  const batch_options & options )
+{
+  if ( values.size() != A.size() ) values = batched_vector<T,N>( A.size() );
+  if constexpr ( Vectors )
+    if ( vectors->size() != A.size() ) *vectors = batched_matrix<T,N,N>( A.size() );
+
+  batch_for( A.size(), options, [&]( std::size_t begin, std::size_t end ) {
+
+    std::array< std::array<T,batch_block>, N*N > a, v;
+    std::array< std::array<T,batch_block>, N > w;
+
+    for ( std::size_t b = begin; b < end; b += batch_block ) {
+      auto nb = std::min( batch_block, end - b );
+
+      load_block( a, A, b, nb );
+      if constexpr ( Vectors )
+        for ( std::size_t i = 0; i < N; i++ )
+          for ( std::size_t j = 0; j < N; j++ )
+            v[i*N+j].fill( (i == j) ? T(1) : T(0) );
+
+      jacobi_eigen_block<Vectors,T,N>( a, v, nb );
+
+      for ( std::size_t k = 0; k < N; k++ ) w[k] = a[k*N+k];
+      sort_block<Vectors,T,N>( w, v, true, nb );
+
+      for ( std::size_t k = 0; k < N; k++ )
+        std::copy_n( w[k].begin(), nb, values.component(k) + b );
+      if constexpr ( Vectors )
+        for ( std::size_t i = 0; i < N; i++ )
+          for ( std::size_t j = 0; j < N; j++ )
+            std::copy_n( v[i*N+j].begin(), nb, vectors->component(i,j) + b );
+    }
+
+  } );
+}
+
+} // namespace detail
+
+////////////////////////////////////////////////////////////////////////////////
+//! \brief Compute the eigenvalues of every symmetric matrix in a batch, like
+//!        the symmetric_eigenvalues of one matrix.
+//! \tparam T  The base value type.
+//! \tparam N  The matrix dimension.
+//! \param[in] A  The symmetric matrices
+//! \param[out] values  The eigenvalues in ascending order, resized to the batch
+//! \param[in] options  The threading options
+////////////////////////////////////////////////////////////////////////////////
+template < typename T, std::size_t N >
+void symmetric_eigenvalues(
+  const batched_matrix<T,N,N> & A,
+  batched_vector<T,N> & values,
+  const batch_options & options = {} )
+{
+  detail::symmetric_eigen<false>(
+    A, values, static_cast< batched_matrix<T,N,N> * >(nullptr), options );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//! \brief Compute the eigendecomposition of every symmetric matrix in a
+//!        batch, like the symmetric_eigen of one matrix.
+//! \tparam T  The base value type.
+//! \tparam N  The matrix dimension.
+//! \param[in] A  The symmetric matrices
+//! \param[out] values  The eigenvalues in ascending order, resized to the batch
+//! \param[out] vectors  The eigenvectors, one per column, resized to the batch
+//! \param[in] options  The threading options
+////////////////////////////////////////////////////////////////////////////////
+template < typename T, std::size_t N >
+void symmetric_eigen(
+  const batched_matrix<T,N,N> & A,
+  batched_vector<T,N> & values,
+  batched_matrix<T,N,N> & vectors,
+  const batch_options & options = {} )
+{
+  assert( &A != &vectors && "eigendecomposition can not be done in place" );
+  detail::symmetric_eigen<true>( A, values, &vectors, options );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//! \brief Compute the singular values of every matrix in a batch, like the
+//!        singular_values of one matrix.
+//! \tparam T  The base value type.
+//! \tparam N  The matrix dimension.
+//! \param[in] A  The matrices
+//! \param[out] values  The singular values in descending order, resized to
+//!                     the batch
+//! \param[in] options  The threading options
+////////////////////////////////////////////////////////////////////////////////
+template < typename T, std::size_t N >
+void singular_values(
+  const batched_matrix<T,N,N> & A,
+  batched_vector<T,N> & values,
+  const batch_options & options = {} )
+{
+  using detail::batch_block;
+
+  if ( values.size() != A.size() ) values = batched_vector<T,N>( A.size() );
+
+  detail::batch_for( A.size(), options, [&]( std::size_t begin, std::size_t end ) {
+
+    std::array< std::array<T,batch_block>, N*N > a;
+    std::array< std::array<T,batch_block>, N > w;
+
+    for ( std::size_t b = begin; b < end; b += batch_block ) {
+      auto nb = std::min( batch_block, end - b );
+
+      detail::load_block( a, A, b, nb );
+      detail::jacobi_svd_block<T,N>( a, nb );
+
+      // the column norms
+      for ( std::size_t k = 0; k < N; k++ ) {
+        w[k].fill( T(0) );
+        for ( std::size_t i = 0; i < N; i++ )
+          for ( std::size_t m = 0; m < nb; m++ ) w[k][m] += a[i*N+k][m] * a[i*N+k][m];
+        for ( std::size_t m = 0; m < nb; m++ ) w[k][m] = std::sqrt( w[k][m] );
+      }
+
+      detail::sort_block<false,T,N>( w, a, false, nb );
+
+      for ( std::size_t k = 0; k < N; k++ )
+        std::copy_n( w[k].begin(), nb, values.component(k) + b );
+    }
+
+  } );
+}
+
+namespace detail {
+
+//! \brief Compute c = a b for a block of matrices.
+template < typename T, std::size_t N >
+void multiply_block(
+  const std::array< std::array<T,batch_block>, N*N > & a,
+  const std::array< std::array<T,batch_block>, N*N > & b,
+  std::array< std::array<T,batch_block>, N*N > & c,
+  std::size_t nb )
+{
+  for ( std::size_t i = 0; i < N; i++ )
+    for ( std::size_t j = 0; j < N; j++ ) {
+      auto & cij = c[i*N+j];
+      std::fill_n( cij.begin(), nb, T(0) );
+      for ( std::size_t k = 0; k < N; k++ )
+        for ( std::size_t m = 0; m < nb; m++ ) cij[m] += a[i*N+k][m] * b[k*N+j][m];
+    }
+}
+
+} // namespace detail
+
+////////////////////////////////////////////////////////////////////////////////
+//! \brief Compute the exponential of every matrix in a batch, like the
+//!        exponential of one matrix.
+//! \remark Every matrix of a block uses the highest Pade degree any of them
+//!         needs, and is only scaled if that is degree 13.  Each matrix is
+//!         then squared its own number of times with selects.
+//! \tparam T  The base value type.
+//! \tparam N  The matrix dimension.
+//! \param[in] A  The matrices
+//! \param[out] E  The exponentials, resized to the batch
+//! \param[in] options  The threading options
+////////////////////////////////////////////////////////////////////////////////
+template < typename T, std::size_t N >
+void exponential(
+  const batched_matrix<T,N,N> & A,
+  batched_matrix<T,N,N> & E,
+  const batch_options & options = {} )
+{
+  using detail::batch_block;
+  using block_t = std::array< std::array<T,batch_block>, N*N >;
+
+  assert( &A != &E && "exponential can not be done in place" );
+  if ( E.size() != A.size() ) E = batched_matrix<T,N,N>( A.size() );
+
+  detail::batch_for( A.size(), options, [&]( std::size_t begin, std::size_t end ) {
+
+    block_t a, a2, a4, a6, u, v, x;
+    std::array<int,batch_block> s;
+    std::array<T,batch_block> scale, sign;
+
+    // y = sum of c_k x_k, plus c_i on the diagonal, y may be one of the x_k
+    auto combine = [&]( block_t & y, std::initializer_list<T> c,
+      std::initializer_list<const block_t *> xs, T c_i, std::size_t nb )
+    {
+      std::array<T,batch_block> sum;
+      for ( std::size_t ij = 0; ij < N*N; ij++ ) {
+        sum.fill( ( ij % (N+1) == 0 ) ? c_i : T(0) );
+        auto ck = c.begin();
+        for ( auto xk : xs ) {
+          for ( std::size_t m = 0; m < nb; m++ ) sum[m] += (*ck) * (*xk)[ij][m];
+          ++ck;
+        }
+        std::copy_n( sum.begin(), nb, y[ij].begin() );
+      }
+    };
+
+    for ( std::size_t blk = begin; blk < end; blk += batch_block ) {
+      auto nb = std::min( batch_block, end - blk );
+
+      detail::load_block( a, A, blk, nb );
+
+      // the degree of the block, and the scaling of each matrix
+      std::size_t index = 0;
+      int smax = 0;
+      for ( std::size_t m = 0; m < nb; m++ ) {
+        T norm = 0;
+        for ( std::size_t j = 0; j < N; j++ ) {
+          T col = 0;
+          for ( std::size_t i = 0; i < N; i++ ) col += std::abs( a[i*N+j][m] );
+          norm = std::max( norm, col );
+        }
+        std::size_t im;
+        detail::pade_parameters( norm, im, s[m] );
+        index = std::max( index, im );
+        smax = std::max( smax, s[m] );
+        scale[m] = std::ldexp( T(1), -s[m] );
+      }
+      const auto m_pade = detail::pade_degrees[index];
+      const auto & b = detail::pade_coefficients[index];
+
+      if ( smax > 0 )
+        for ( auto & aij : a )
+          for ( std::size_t m = 0; m < nb; m++ ) aij[m] *= scale[m];
+
+      // the even powers the degree needs
+      detail::multiply_block<T,N>( a, a, a2, nb );
+      if ( m_pade >= 5 ) detail::multiply_block<T,N>( a2, a2, a4, nb );
+      if ( m_pade >= 7 ) detail::multiply_block<T,N>( a2, a4, a6, nb );
+
+      // v holds the even terms, u the odd ones divided by A
+      if ( m_pade == 13 ) {
+        combine( x, { T(b[13]), T(b[11]), T(b[9]) }, { &a6, &a4, &a2 }, T(0), nb );
+        detail::multiply_block<T,N>( a6, x, u, nb );
+        combine( u, { T(1), T(b[7]), T(b[5]), T(b[3]) }, { &u, &a6, &a4, &a2 },
+          T(b[1]), nb );
+        combine( x, { T(b[12]), T(b[10]), T(b[8]) }, { &a6, &a4, &a2 }, T(0), nb );
+        detail::multiply_block<T,N>( a6, x, v, nb );
+        combine( v, { T(1), T(b[6]), T(b[4]), T(b[2]) }, { &v, &a6, &a4, &a2 },
+          T(b[0]), nb );
+      }
+      else {
+        combine( u, { T(b[3]) }, { &a2 }, T(b[1]), nb );
+        combine( v, { T(b[2]) }, { &a2 }, T(b[0]), nb );
+        if ( m_pade >= 5 ) {
+          combine( u, { T(1), T(b[5]) }, { &u, &a4 }, T(0), nb );
+          combine( v, { T(1), T(b[4]) }, { &v, &a4 }, T(0), nb );
+        }
+        if ( m_pade >= 7 ) {
+          combine( u, { T(1), T(b[7]) }, { &u, &a6 }, T(0), nb );
+          combine( v, { T(1), T(b[6]) }, { &v, &a6 }, T(0), nb );
+        }
+        if ( m_pade >= 9 ) {
+          detail::multiply_block<T,N>( a4, a4, x, nb );
+          combine( u, { T(1), T(b[9]) }, { &u, &x }, T(0), nb );
+          combine( v, { T(1), T(b[8]) }, { &v, &x }, T(0), nb );
+        }
+      }
+
+      // (v - a u) e = v + a u, e ends up in x
+      detail::multiply_block<T,N>( a, u, x, nb );
+      combine( u, { T(1), T(-1) }, { &v, &x }, T(0), nb );
+      combine( x, { T(1), T(1) }, { &v, &x }, T(0), nb );
+      detail::eliminate_block<T,N,N>( u, x, sign, nb );
+      detail::back_substitute_block<T,N,N>( u, x, nb );
+
+      // undo the scaling, the matrices done squaring keep their value
+      for ( int k = 0; k < smax; k++ ) {
+        detail::multiply_block<T,N>( x, x, u, nb );
+        for ( std::size_t ij = 0; ij < N*N; ij++ )
+          for ( std::size_t m = 0; m < nb; m++ )
+            x[ij][m] = ( k < s[m] ) ? u[ij][m] : x[ij][m];
+      }
+
+      for ( std::size_t i = 0; i < N; i++ )
+        for ( std::size_t j = 0; j < N; j++ )
+          std::copy_n( x[i*N+j].begin(), nb, E.component(i,j) + blk );
+    }
+
+  } );
+}
+
+} // namespace math
+} // namespace ristra
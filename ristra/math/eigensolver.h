@@ -0,0 +1,339 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2017 Los Alamos National Laboratory, LLC
+ * All rights reserved
+ *~-------------------------------------------------------------------------~~*/
+////////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Provides the eigendecomposition of small symmetric matrices and the
+///        singular value decomposition of small square matrices.
+///
+/// Both use Jacobi rotations: two sided on the symmetric matrix for the
+/// eigenvalues, one sided on the columns for the singular values.  A 2x2
+/// matrix needs a single rotation, which is the closed form.  Larger sizes
+/// sweep over every pair until the off diagonal part is negligible.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// user includes
+#include "ristra/math/array.h"
+#include "ristra/math/multi_array.h"
+#include "ristra/utils/template_helpers.h"
+
+// system includes
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace ristra {
+namespace math {
+
+////////////////////////////////////////////////////////////////////////////////
+//! \brief The eigendecomposition of a symmetric matrix, A = V diag(w) V^T.
+//! \tparam T  The base value type.
+//! \tparam N  The matrix dimension.
+////////////////////////////////////////////////////////////////////////////////
+template < typename T, std::size_t N >
+struct eigen_decomposition {
+  //! \brief The eigenvalues, in ascending order.
+  array<T, N> values;
+  //! \brief The orthonormal eigenvectors, column k goes with `values[k]`.
+  multi_array<T, N, N> vectors;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+//! \brief The singular value decomposition of a square matrix,
+//!        A = U diag(s) V^T.
+//! \tparam T  The base value type.
+//! \tparam N  The matrix dimension.
+////////////////////////////////////////////////////////////////////////////////
+template < typename T, std::size_t N >
+struct singular_value_decomposition {
+  //! \brief The singular values, in descending order.
+  array<T, N> values;
+  //! \brief The orthonormal left singular vectors, one per column.
+  multi_array<T, N, N> u;
+  //! \brief The orthonormal right singular vectors, one per column.
+  multi_array<T, N, N> v;
+};
+
+namespace detail {
+
+//! \brief The maximum number of Jacobi sweeps.
+constexpr std::size_t max_jacobi_sweeps = 50;
+
+//! \brief The Jacobi rotation zeroing the (p,q) entry of a symmetric
+//!        matrix, given its (p,p), (q,q) and (p,q) entries.
+//! \remark The smaller of the two rotation angles is used.  A zero (p,q)
+//!         entry gives the identity.
+//! \param[in] app,aqq,apq  The entries of the 2x2 block
+//! \param[out] c,s  The cosine and sine of the rotation
+template < typename T >
+void jacobi_rotation( T app, T aqq, T apq, T & c, T & s )
+{
+  T theta = (aqq - app) / ( T(2) * (apq != T(0) ? apq : T(1)) );
+  T t = ( theta < T(0) ? T(-1) : T(1) ) /
+    ( std::abs(theta) + std::sqrt( theta*theta + T(1) ) );
+  t = ( apq != T(0) ) ? t : T(0);
+  c = T(1) / std::sqrt( t*t + T(1) );
+  s = t * c;
+}
+
+//! \brief Rotate columns p and q of a matrix.
+template < typename T, std::size_t D1, std::size_t D2 >
+void rotate_columns( multi_array<T, D1, D2> & a, std::size_t p, std::size_t q,
+  T c, T s )
+{
+  for ( utils::select_counter_t<D1> k = 0; k < D1; k++ ) {
+    T akp = a(k,p), akq = a(k,q);
+    a(k,p) = c*akp - s*akq;
+    a(k,q) = s*akp + c*akq;
+  }
+}
+
+//! \brief Rotate rows p and q of a matrix.
+template < typename T, std::size_t D1, std::size_t D2 >
+void rotate_rows( multi_array<T, D1, D2> & a, std::size_t p, std::size_t q,
+  T c, T s )
+{
+  for ( utils::select_counter_t<D2> k = 0; k < D2; k++ ) {
+    T apk = a(p,k), aqk = a(q,k);
+    a(p,k) = c*apk - s*aqk;
+    a(q,k) = s*apk + c*aqk;
+  }
+}
+
+//! \brief Swap columns p and q of a matrix.
+template < typename T, std::size_t D1, std::size_t D2 >
+void swap_columns( multi_array<T, D1, D2> & a, std::size_t p, std::size_t q )
+{
+  for ( utils::select_counter_t<D1> k = 0; k < D1; k++ )
+    std::swap( a(k,p), a(k,q) );
+}
+
+//! \brief Diagonalize a symmetric matrix in place with two sided Jacobi
+//!        rotations, accumulating them in `v` if given.
+template < typename T, std::size_t N >
+void jacobi_eigen( multi_array<T, N, N> & a, multi_array<T, N, N> * v )
+{
+  constexpr T eps = std::numeric_limits<T>::epsilon();
+
+  for ( std::size_t sweep = 0; sweep < max_jacobi_sweeps; sweep++ ) {
+
+    bool rotated = false;
+
+    for ( std::size_t p = 0; p+1 < N; p++ )
+      for ( std::size_t q = p+1; q < N; q++ ) {
+
+        // negligible next to both diagonal entries
+        T apq = a(p,q);
+        if ( std::abs(apq) <= eps * eps * ( std::abs(a(p,p)) + std::abs(a(q,q)) )
+          || apq == T(0) )
+          continue;
+
+        T c, s;
+        jacobi_rotation( a(p,p), a(q,q), apq, c, s );
+        rotate_columns( a, p, q, c, s );
+        rotate_rows( a, p, q, c, s );
+        a(p,q) = a(q,p) = T(0);
+        if ( v ) rotate_columns( *v, p, q, c, s );
+        rotated = true;
+      }
+
+    if ( !rotated ) break;
+  }
+}
+
+//! \brief Orthogonalize the columns of `u` in place with one sided Jacobi
+//!        rotations, accumulating them in `v` if given.
+template < typename T, std::size_t N >
+void jacobi_svd( multi_array<T, N, N> & u, multi_array<T, N, N> * v )
+{
+  using counter_t = utils::select_counter_t<N>;
+  constexpr T eps = std::numeric_limits<T>::epsilon();
+
+  for ( std::size_t sweep = 0; sweep < max_jacobi_sweeps; sweep++ ) {
+
+    bool rotated = false;
+
+    for ( std::size_t p = 0; p+1 < N; p++ )
+      for ( std::size_t q = p+1; q < N; q++ ) {
+
+        // the 2x2 block of u^T u
+        T alpha = 0, beta = 0, gamma = 0;
+        for ( counter_t k = 0; k < N; k++ ) {
+          alpha += u(k,p) * u(k,p);
+          beta  += u(k,q) * u(k,q);
+          gamma += u(k,p) * u(k,q);
+        }
+
+        // columns already orthogonal to working precision
+        if ( std::abs(gamma) <= eps * std::sqrt(alpha * beta) || gamma == T(0) )
+          continue;
+
+        T c, s;
+        jacobi_rotation( alpha, beta, gamma, c, s );
+        rotate_columns( u, p, q, c, s );
+        if ( v ) rotate_columns( *v, p, q, c, s );
+        rotated = true;
+      }
+
+    if ( !rotated ) break;
+  }
+}
+
+} // namespace detail
+
+////////////////////////////////////////////////////////////////////////////////
+//! \brief Compute the eigenvalues of a symmetric matrix.
+//! \remark Only the symmetric part of `mat` is meaningful.
+//! \tparam T  The base value type.
+//! \tparam N  The matrix dimension.
+//! \param[in] mat  The symmetric matrix
+//! \return The eigenvalues, in ascending order
+////////////////////////////////////////////////////////////////////////////////
+template < typename T, std::size_t N >
+auto symmetric_eigenvalues( const multi_array<T, N, N> & mat )
+{
+  auto a = mat;
+  detail::jacobi_eigen( a, static_cast< multi_array<T,N,N> * >(nullptr) );
+
+  array<T, N> w;
+  for ( utils::select_counter_t<N> k = 0; k < N; k++ ) w[k] = a(k,k);
+  std::sort( w.begin(), w.end() );
+  return w;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//! \brief Compute the eigendecomposition of a symmetric matrix.
+//! \remark Only the symmetric part of `mat` is meaningful.
+//! \tparam T  The base value type.
+//! \tparam N  The matrix dimension.
+//! \param[in] mat  The symmetric matrix
+//! \return The eigenvalues and eigenvectors
+////////////////////////////////////////////////////////////////////////////////
+template < typename T, std::size_t N >
+auto symmetric_eigen( const multi_array<T, N, N> & mat )
+{
+  using counter_t = utils::select_counter_t<N>;
+
+  eigen_decomposition<T, N> eig;
+  auto & v = eig.vectors;
+  v = T(0);
+  for ( counter_t k = 0; k < N; k++ ) v(k,k) = T(1);
+
+  auto a = mat;
+  detail::jacobi_eigen( a, &v );
+  for ( counter_t k = 0; k < N; k++ ) eig.values[k] = a(k,k);
+
+  // ascending, the vectors follow
+  for ( counter_t i = 0; i < N; i++ )
+    for ( counter_t j = i+1; j < N; j++ )
+      if ( eig.values[j] < eig.values[i] ) {
+        std::swap( eig.values[i], eig.values[j] );
+        detail::swap_columns( v, i, j );
+      }
+
+  return eig;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//! \brief Compute the singular values of a square matrix.
+//! \tparam T  The base value type.
+//! \tparam N  The matrix dimension.
+//! \param[in] mat  The matrix
+//! \return The singular values, in descending order
+////////////////////////////////////////////////////////////////////////////////
+template < typename T, std::size_t N >
+auto singular_values( const multi_array<T, N, N> & mat )
+{
+  using counter_t = utils::select_counter_t<N>;
+
+  auto u = mat;
+  detail::jacobi_svd( u, static_cast< multi_array<T,N,N> * >(nullptr) );
+
+  array<T, N> s;
+  for ( counter_t k = 0; k < N; k++ ) {
+    T norm = 0;
+    for ( counter_t i = 0; i < N; i++ ) norm += u(i,k) * u(i,k);
+    s[k] = std::sqrt(norm);
+  }
+  std::sort( s.begin(), s.end(), [](T x, T y) { return x > y; } );
+  return s;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//! \brief Compute the singular value decomposition of a square matrix.
+//! \remark Left singular vectors of zero singular values complete `u` to an
+//!         orthonormal basis.
+//! \tparam T  The base value type.
+//! \tparam N  The matrix dimension.
+//! \param[in] mat  The matrix
+//! \return The singular values and vectors
+////////////////////////////////////////////////////////////////////////////////
+template < typename T, std::size_t N >
+auto svd( const multi_array<T, N, N> & mat )
+{
+  using counter_t = utils::select_counter_t<N>;
+
+  singular_value_decomposition<T, N> dec;
+  auto & u = dec.u;
+  auto & v = dec.v;
+  auto & s = dec.values;
+
+  u = mat;
+  v = T(0);
+  for ( counter_t k = 0; k < N; k++ ) v(k,k) = T(1);
+
+  detail::jacobi_svd( u, &v );
+
+  for ( counter_t k = 0; k < N; k++ ) {
+    T norm = 0;
+    for ( counter_t i = 0; i < N; i++ ) norm += u(i,k) * u(i,k);
+    s[k] = std::sqrt(norm);
+  }
+
+  // descending, the vectors follow
+  for ( counter_t i = 0; i < N; i++ )
+    for ( counter_t j = i+1; j < N; j++ )
+      if ( s[j] > s[i] ) {
+        std::swap( s[i], s[j] );
+        detail::swap_columns( u, i, j );
+        detail::swap_columns( v, i, j );
+      }
+
+  // normalize, the columns of zero singular values are completed with the
+  // unit vector furthest from the ones already found
+  T tiny = s[0] * N * std::numeric_limits<T>::epsilon();
+  for ( counter_t k = 0; k < N; k++ ) {
+
+    if ( s[k] > tiny && s[k] > T(0) ) {
+      for ( counter_t i = 0; i < N; i++ ) u(i,k) /= s[k];
+      continue;
+    }
+
+    array<T, N> best(T(0));
+    T best_norm = -1;
+    for ( counter_t e = 0; e < N; e++ ) {
+      array<T, N> w(T(0));
+      w[e] = T(1);
+      for ( counter_t j = 0; j < k; j++ ) {
+        T dot = u(e,j);
+        for ( counter_t i = 0; i < N; i++ ) w[i] -= dot * u(i,j);
+      }
+      T norm = 0;
+      for ( counter_t i = 0; i < N; i++ ) norm += w[i] * w[i];
+      if ( norm > best_norm ) {
+        best_norm = norm;
+        best = w;
+      }
+    }
+    best_norm = std::sqrt(best_norm);
+    for ( counter_t i = 0; i < N; i++ ) u(i,k) = best[i] / best_norm;
+  }
+
+  return dec;
+}
+
+} // namespace math
+} // namespace ristra
@@ -0,0 +1,554 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2017 Los Alamos National Laboratory, LLC
+ * All rights reserved
+ *~-------------------------------------------------------------------------~~*/
+////////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Provides opt-in elementwise expression templates for array and
+///        multi_array.
+///
+/// The operators of the value types still return values.  An operator only
+/// returns a lightweight expression, that just remembers its operands, when
+/// one of its operands already is an expression, and lazy() is what turns a
+/// value into one.  Operators are applied innermost first, so every
+/// subexpression between two values needs its own lazy(): `a + b*c - d` is
+/// written `lazy(a) + lazy(b)*c - d`, since `lazy(a) + b*c - d` would still
+/// build `b*c` as a value first.  A fully wrapped chain is evaluated in a
+/// single loop, with no temporaries, when it is assigned to, or used to
+/// construct, an array or multi_array.  Each element goes through exactly the
+/// same operations, in the same order and with the same conversions, as the
+/// operators of the value types.
+///
+/// Operands that are lvalues are held by reference and temporaries are
+/// moved into the expression, so an expression never outlives its
+/// temporaries.  An expression held with `auto` still refers to its lvalue
+/// operands though; use eval() to get a value.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// user includes
+#include "ristra/compatibility/type_traits.h"
+#include "ristra/utils/target.h"
+#include "ristra/utils/template_helpers.h"
+
+// system includes
+#include <iostream>
+#include <type_traits>
+#include <utility>
+
+namespace ristra {
+namespace math {
+
+template <typename T, std::size_t N> class array;
+template <typename T, std::size_t... N> class multi_array;
+
+////////////////////////////////////////////////////////////////////////////////
+//! \brief Traits of the types taking part in elementwise expressions.
+//!
+//! Value containers and expressions define `result_type`, the container an
+//! expression evaluates to, and `length`, the number of elements.
+//!
+//! \tparam E  The type to inspect.
+////////////////////////////////////////////////////////////////////////////////
+template <typename E>
+struct expression_traits {
+  static constexpr bool is_container = false;
+  static constexpr bool is_expression = false;
+};
+
+//! \copydoc expression_traits
+//! \remark this version is for array
+template <typename T, std::size_t N>
+struct expression_traits< array<T,N> > {
+  static constexpr bool is_container = true;
+  static constexpr bool is_expression = false;
+  static constexpr std::size_t length = N;
+  using result_type = array<T,N>;
+  template <typename U> using rebind = array<U,N>;
+};
+
+//! \copydoc expression_traits
+//! \remark this version is for multi_array
+template <typename T, std::size_t... N>
+struct expression_traits< multi_array<T,N...> > {
+  static constexpr bool is_container = true;
+  static constexpr bool is_expression = false;
+  static constexpr std::size_t length = utils::multiply(N...);
+  using result_type = multi_array<T,N...>;
+  template <typename U> using rebind = multi_array<U,N...>;
+};
+
+//! \brief True if E is an unevaluated expression.
+template <typename E>
+constexpr bool is_expression_v =
+  expression_traits< std::decay_t<E> >::is_expression;
+
+//! \brief True if E is an array, a multi_array or an expression of them.
+template <typename E>
+constexpr bool is_array_operand_v =
+  expression_traits< std::decay_t<E> >::is_container || is_expression_v<E>;
+
+//! \brief The number of elements of an array operand.
+template <typename E>
+constexpr std::size_t expression_length_v =
+  expression_traits< std::decay_t<E> >::length;
+
+//! \brief The container an array operand evaluates to.
+template <typename E>
+using expression_result_t =
+  typename expression_traits< std::decay_t<E> >::result_type;
+
+namespace detail {
+
+//! \brief True if E is an expression with the shape of the container C.
+template <typename E, typename C, typename = void>
+struct is_expression_for : std::false_type {};
+
+template <typename E, typename C>
+struct is_expression_for< E, C, std::enable_if_t< is_expression_v<E> > > :
+  std::integral_constant< bool, compatibility::is_same_v<
+    typename expression_traits< expression_result_t<E> >::template
+      rebind< typename C::value_type >,
+    C > > {};
+
+} // namespace detail
+
+//! \brief True if E is an expression that can be stored in the container C,
+//!        whatever their value types.
+template <typename E, typename C>
+constexpr bool is_expression_for_v = detail::is_expression_for<E,C>::value;
+
+namespace detail {
+
+//! \brief Storage of an operand: lvalue arrays and expressions are held by
+//!        reference, temporaries and scalars by value.
+template <typename E>
+using expression_storage_t = std::conditional_t<
+  std::is_lvalue_reference<E>::value && is_array_operand_v<E>,
+  const std::decay_t<E> &,
+  std::decay_t<E>
+>;
+
+//! \brief True if L and R can be combined elementwise.
+//! \remark array operands must evaluate to the same container, and scalars
+//!         must be arithmetic, just like the operators on the value types.
+template <typename L, typename R, typename = void>
+struct is_elementwise : std::false_type {};
+
+template <typename L, typename R>
+struct is_elementwise< L, R, std::enable_if_t<
+  is_array_operand_v<L> && is_array_operand_v<R> > > :
+  std::integral_constant< bool, compatibility::is_same_v<
+    expression_result_t<L>, expression_result_t<R> > > {};
+
+template <typename L, typename R>
+struct is_elementwise< L, R, std::enable_if_t<
+  is_array_operand_v<L> && !is_array_operand_v<R> > > :
+  std::integral_constant< bool,
+    compatibility::is_arithmetic_v< std::decay_t<R> > > {};
+
+template <typename L, typename R>
+struct is_elementwise< L, R, std::enable_if_t<
+  !is_array_operand_v<L> && is_array_operand_v<R> > > :
+  std::integral_constant< bool,
+    compatibility::is_arithmetic_v< std::decay_t<L> > > {};
+
+template <typename L, typename R>
+constexpr bool is_elementwise_v = is_elementwise<L,R>::value;
+
+//! \brief True if L and R combine into an expression, i.e. they can be
+//!        combined elementwise and one of them already is an expression.
+//! \remark Operations between value types are left to their own operators.
+template <typename L, typename R>
+constexpr bool is_lazy_elementwise_v =
+  (is_expression_v<L> || is_expression_v<R>) && is_elementwise_v<L,R>;
+
+//! \brief The container of the array side of an elementwise operation.
+template <typename L, typename R>
+using elementwise_result_t = expression_result_t<
+  std::conditional_t< is_array_operand_v<L>, L, R > >;
+
+//! \brief Element access, scalars are broadcast.
+//! @{
+template <
+  typename E,
+  typename = std::enable_if_t< is_array_operand_v<E> >
+>
+RISTRA_INLINE_TARGET
+constexpr auto element( const E & e, std::size_t i )
+{ return e[i]; }
+
+template <
+  typename E,
+  typename = std::enable_if_t< !is_array_operand_v<E> >,
+  typename = void
+>
+RISTRA_INLINE_TARGET
+constexpr const E & element( const E & e, std::size_t )
+{ return e; }
+//! @}
+
+//! \brief The elementwise operations.
+//! @{
+template <char Op> struct elementwise_op;
+
+template <> struct elementwise_op<'+'> {
+  template <typename L, typename R>
+  RISTRA_INLINE_TARGET
+  static constexpr auto apply(const L & l, const R & r) { return l + r; }
+};
+
+template <> struct elementwise_op<'-'> {
+  template <typename L, typename R>
+  RISTRA_INLINE_TARGET
+  static constexpr auto apply(const L & l, const R & r) { return l - r; }
+};
+
+template <> struct elementwise_op<'*'> {
+  template <typename L, typename R>
+  RISTRA_INLINE_TARGET
+  static constexpr auto apply(const L & l, const R & r) { return l * r; }
+};
+
+template <> struct elementwise_op<'/'> {
+  template <typename L, typename R>
+  RISTRA_INLINE_TARGET
+  static constexpr auto apply(const L & l, const R & r) { return l / r; }
+};
+//! @}
+
+} // namespace detail
+
+////////////////////////////////////////////////////////////////////////////////
+//! \brief An elementwise binary operation between two array operands, or
+//!        between an array operand and a scalar.
+//!
+//! Every element is converted to the value type of the result, just like
+//! the temporaries of the value types were.
+//!
+//! \tparam Op  The operation, one of '+', '-', '*' or '/'.
+//! \tparam L,R  The operand types as they were passed to the operator.
+////////////////////////////////////////////////////////////////////////////////
+template <char Op, typename L, typename R>
+class binary_expression {
+
+public:
+
+  using result_type = detail::elementwise_result_t<L,R>;
+  using value_type  = typename result_type::value_type;
+  using size_type   = std::size_t;
+
+  //! \brief The number of elements.
+  static constexpr size_type length = expression_length_v<result_type>;
+
+  //! \brief Constructor from the operands.
+  template <typename L2, typename R2>
+  constexpr binary_expression(L2 && lhs, R2 && rhs) :
+    lhs_( std::forward<L2>(lhs) ), rhs_( std::forward<R2>(rhs) )
+  {}
+
+  //! \brief Evaluate the `i`th element.
+  RISTRA_INLINE_TARGET
+  constexpr value_type operator[](size_type i) const
+  {
+    return static_cast<value_type>( detail::elementwise_op<Op>::apply(
+      detail::element(lhs_, i), detail::element(rhs_, i) ) );
+  }
+
+  //! \brief return the size
+  static constexpr size_type size() { return length; }
+
+  //! \brief Evaluate the whole expression.
+  result_type eval() const { return result_type(*this); }
+
+private:
+
+  detail::expression_storage_t<L> lhs_;
+  detail::expression_storage_t<R> rhs_;
+
+};
+
+////////////////////////////////////////////////////////////////////////////////
+//! \brief The negation of an expression.
+//! \tparam E  The operand type as it was passed to the operator.
+////////////////////////////////////////////////////////////////////////////////
+template <typename E>
+class negate_expression {
+
+public:
+
+  using result_type = expression_result_t<E>;
+  using value_type  = typename result_type::value_type;
+  using size_type   = std::size_t;
+
+  //! \brief The number of elements.
+  static constexpr size_type length = expression_length_v<result_type>;
+
+  //! \brief Constructor from the operand.
+  template <typename E2>
+  constexpr explicit negate_expression(E2 && e) : e_( std::forward<E2>(e) )
+  {}
+
+  //! \brief Evaluate the `i`th element.
+  RISTRA_INLINE_TARGET
+  constexpr value_type operator[](size_type i) const
+  { return -e_[i]; }
+
+  //! \brief return the size
+  static constexpr size_type size() { return length; }
+
+  //! \brief Evaluate the whole expression.
+  result_type eval() const { return result_type(*this); }
+
+private:
+
+  detail::expression_storage_t<E> e_;
+
+};
+
+////////////////////////////////////////////////////////////////////////////////
+//! \brief An array or multi_array used as the operand of an expression.
+//! \tparam E  The operand type as it was passed to lazy().
+////////////////////////////////////////////////////////////////////////////////
+template <typename E>
+class terminal_expression {
+
+public:
+
+  using result_type = expression_result_t<E>;
+  using value_type  = typename result_type::value_type;
+  using size_type   = std::size_t;
+
+  //! \brief The number of elements.
+  static constexpr size_type length = expression_length_v<result_type>;
+
+  //! \brief Constructor from the operand.
+  template <typename E2>
+  constexpr explicit terminal_expression(E2 && e) : e_( std::forward<E2>(e) )
+  {}
+
+  //! \brief Return the `i`th element.
+  RISTRA_INLINE_TARGET
+  constexpr value_type operator[](size_type i) const
+  { return e_[i]; }
+
+  //! \brief return the size
+  static constexpr size_type size() { return length; }
+
+  //! \brief Evaluate the whole expression.
+  result_type eval() const { return result_type(*this); }
+
+private:
+
+  detail::expression_storage_t<E> e_;
+
+};
+
+//! \copydoc expression_traits
+//! \remark this version is for the operands wrapped by lazy()
+template <typename E>
+struct expression_traits< terminal_expression<E> > {
+  static constexpr bool is_container = false;
+  static constexpr bool is_expression = true;
+  using result_type = typename terminal_expression<E>::result_type;
+  static constexpr std::size_t length = terminal_expression<E>::length;
+};
+
+//! \copydoc expression_traits
+//! \remark this version is for the binary expressions
+template <char Op, typename L, typename R>
+struct expression_traits< binary_expression<Op,L,R> > {
+  static constexpr bool is_container = false;
+  static constexpr bool is_expression = true;
+  using result_type = typename binary_expression<Op,L,R>::result_type;
+  static constexpr std::size_t length = binary_expression<Op,L,R>::length;
+};
+
+//! \copydoc expression_traits
+//! \remark this version is for negation
+template <typename E>
+struct expression_traits< negate_expression<E> > {
+  static constexpr bool is_container = false;
+  static constexpr bool is_expression = true;
+  using result_type = typename negate_expression<E>::result_type;
+  static constexpr std::size_t length = negate_expression<E>::length;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Evaluation
+////////////////////////////////////////////////////////////////////////////////
+
+//! \brief Evaluate an expression, anything else is passed through.
+//! \param[in] e  The quantity to evaluate.
+//! @{
+template <
+  typename E,
+  typename = std::enable_if_t< is_expression_v<E> >
+>
+auto evaluate( const E & e )
+{ return e.eval(); }
+
+template <
+  typename E,
+  typename = std::enable_if_t< !is_expression_v<E> >,
+  typename = void
+>
+constexpr const E & evaluate( const E & e )
+{ return e; }
+//! @}
+
+////////////////////////////////////////////////////////////////////////////////
+// Operators
+////////////////////////////////////////////////////////////////////////////////
+
+//! \brief Start a fused expression from an array or multi_array.
+//! \remark The operators on the result, and on whatever they return, build
+//!         expressions instead of values.  An operation between two values
+//!         inside a chain, like the product in `lazy(a) + b*c`, is still
+//!         evaluated by the value operator; wrap one of its operands too.
+//! \param[in] a The array to wrap.
+//! \return The array as an expression.
+template <
+  typename A,
+  typename = std::enable_if_t<
+    expression_traits< std::decay_t<A> >::is_container >
+>
+constexpr auto lazy( A && a )
+{
+  return terminal_expression<A>( std::forward<A>(a) );
+}
+
+//! \brief Addition operator involving arrays, expressions and scalars.
+//! \param[in] lhs The quantity on the left hand side of the operator.
+//! \param[in] rhs The quantity on the right hand side of the operator.
+//! \return The unevaluated sum.
+template <
+  typename L, typename R,
+  typename = std::enable_if_t< detail::is_lazy_elementwise_v<L,R> >
+>
+RISTRA_INLINE_TARGET
+constexpr auto operator+( L && lhs, R && rhs )
+{
+  return binary_expression<'+',L,R>(
+    std::forward<L>(lhs), std::forward<R>(rhs) );
+}
+
+//! \brief Subtraction operator involving arrays, expressions and scalars.
+//! \param[in] lhs The quantity on the left hand side of the operator.
+//! \param[in] rhs The quantity on the right hand side of the operator.
+//! \return The unevaluated difference.
+template <
+  typename L, typename R,
+  typename = std::enable_if_t< detail::is_lazy_elementwise_v<L,R> >
+>
+RISTRA_INLINE_TARGET
+constexpr auto operator-( L && lhs, R && rhs )
+{
+  return binary_expression<'-',L,R>(
+    std::forward<L>(lhs), std::forward<R>(rhs) );
+}
+
+//! \brief Multiplication operator involving arrays, expressions and scalars.
+//! \param[in] lhs The quantity on the left hand side of the operator.
+//! \param[in] rhs The quantity on the right hand side of the operator.
+//! \return The unevaluated product.
+template <
+  typename L, typename R,
+  typename = std::enable_if_t< detail::is_lazy_elementwise_v<L,R> >
+>
+RISTRA_INLINE_TARGET
+constexpr auto operator*( L && lhs, R && rhs )
+{
+  return binary_expression<'*',L,R>(
+    std::forward<L>(lhs), std::forward<R>(rhs) );
+}
+
+//! \brief Division operator involving arrays, expressions and scalars.
+//! \remark Division by a scalar multiplies by its inverse, like operator/=.
+//! \param[in] lhs The quantity on the left hand side of the operator.
+//! \param[in] rhs The quantity on the right hand side of the operator.
+//! \return The unevaluated quotient.
+//! @{
+template <
+  typename L, typename R,
+  typename = std::enable_if_t<
+    detail::is_lazy_elementwise_v<L,R> && is_array_operand_v<R> >
+>
+RISTRA_INLINE_TARGET
+constexpr auto operator/( L && lhs, R && rhs )
+{
+  return binary_expression<'/',L,R>(
+    std::forward<L>(lhs), std::forward<R>(rhs) );
+}
+
+template <
+  typename L, typename R,
+  typename = std::enable_if_t<
+    detail::is_lazy_elementwise_v<L,R> && !is_array_operand_v<R> >,
+  typename = void
+>
+RISTRA_INLINE_TARGET
+constexpr auto operator/( L && lhs, R && rhs )
+{
+  using value_type = typename expression_result_t<L>::value_type;
+  auto inv = static_cast<value_type>(1) / rhs;
+  return binary_expression<'*',L,decltype(inv)>( std::forward<L>(lhs), inv );
+}
+//! @}
+
+//! \brief Unary - operator for expressions.
+//! \remark Arrays have their own.
+//! \param[in] e The expression to negate.
+//! \return The unevaluated negation.
+template <
+  typename E,
+  typename = std::enable_if_t< is_expression_v<E> >
+>
+RISTRA_INLINE_TARGET
+constexpr auto operator-( E && e )
+{
+  return negate_expression<E>( std::forward<E>(e) );
+}
+
+//! \brief Comparison operators involving expressions.
+//! \param[in] lhs The quantity on the lhs.
+//! \param[in] rhs The quantity on the rhs.
+//! @{
+template <
+  typename L, typename R,
+  typename = std::enable_if_t<
+    (is_expression_v<L> || is_expression_v<R>) &&
+    is_array_operand_v<L> && is_array_operand_v<R> >
+>
+bool operator==( const L & lhs, const R & rhs )
+{
+  return evaluate(lhs) == evaluate(rhs);
+}
+
+template <
+  typename L, typename R,
+  typename = std::enable_if_t<
+    (is_expression_v<L> || is_expression_v<R>) &&
+    is_array_operand_v<L> && is_array_operand_v<R> >
+>
+bool operator!=( const L & lhs, const R & rhs )
+{
+  return !(lhs == rhs);
+}
+//! @}
+
+//! \brief Output operator for expressions.
+//! \param[in,out] os  The ostream to dump output to.
+//! \param[in]     e   The expression to print.
+//! \return A reference to the current ostream.
+template <
+  typename E,
+  typename = std::enable_if_t< is_expression_v<E> >
+>
+auto & operator<<( std::ostream & os, const E & e )
+{
+  return os << e.eval();
+}
+
+} // namespace math
+} // namespace ristra
@@ -0,0 +1,290 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2017 Los Alamos National Laboratory, LLC
+ * All rights reserved
+ *~-------------------------------------------------------------------------~~*/
+////////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Provides LU and Cholesky factorizations of small square matrices.
+///
+/// The sizes are known at compile time, so every loop has constant bounds
+/// and is unrolled by the compiler for the small sizes.  Solves go through
+/// forward and back substitution and never form the inverse.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// user includes
+#include "ristra/math/array.h"
+#include "ristra/math/multi_array.h"
+#include "ristra/utils/template_helpers.h"
+
+// system includes
+#include <cassert>
+#include <cmath>
+#include <utility>
+
+namespace ristra {
+namespace math {
+
+////////////////////////////////////////////////////////////////////////////////
+//! \brief The LU factorization with partial pivoting of a square matrix,
+//!        i.e. P A = L U.
+//!
+//! L has a unit diagonal that is not stored, so L and U are packed into one
+//! matrix.
+//!
+//! \tparam T  The base value type.
+//! \tparam N  The matrix dimension.
+////////////////////////////////////////////////////////////////////////////////
+template < typename T, std::size_t N >
+struct lu_factorization {
+  //! \brief L below the diagonal, U on and above it.
+  multi_array<T, N, N> lu;
+  //! \brief The row of the original matrix found in each row of `lu`.
+  array<std::size_t, N> pivots;
+  //! \brief The sign of the row permutation.
+  int sign = 1;
+  //! \brief True if a column had no nonzero pivot.
+  bool singular = false;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+//! \brief The Cholesky factorization of a symmetric positive definite
+//!        matrix, i.e. A = L L^T.
+//! \tparam T  The base value type.
+//! \tparam N  The matrix dimension.
+////////////////////////////////////////////////////////////////////////////////
+template < typename T, std::size_t N >
+struct cholesky_factorization {
+  //! \brief L on and below the diagonal, zero above it.
+  multi_array<T, N, N> l;
+  //! \brief False if a pivot was not positive, `l` is then incomplete.
+  bool positive_definite = true;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+//! \brief Compute the LU factorization of a square matrix.
+//! \tparam T  The base value type.
+//! \tparam N  The matrix dimension.
+//! \param[in] mat  The matrix to factor
+//! \return The factorization
+////////////////////////////////////////////////////////////////////////////////
+template < typename T, std::size_t N >
+auto lu_factor( const multi_array<T, N, N> & mat )
+{
+  using counter_t = utils::select_counter_t< N >;
+
+  lu_factorization<T, N> f;
+  f.lu = mat;
+  auto & a = f.lu;
+
+  for ( counter_t i = 0; i < N; i++ ) f.pivots[i] = i;
+
+  for ( counter_t k = 0; k < N; k++ ) {
+
+    // pivot on the largest entry left in the column
+    counter_t p = k;
+    T big = std::abs( a(k,k) );
+    for ( counter_t i = k+1; i < N; i++ ) {
+      T val = std::abs( a(i,k) );
+      if ( val > big ) {
+        big = val;
+        p = i;
+      }
+    }
+
+    if ( big == T(0) ) {
+      f.singular = true;
+      continue;
+    }
+
+    if ( p != k ) {
+      for ( counter_t j = 0; j < N; j++ ) std::swap( a(k,j), a(p,j) );
+      std::swap( f.pivots[k], f.pivots[p] );
+      f.sign = -f.sign;
+    }
+
+    // eliminate below the pivot
+    for ( counter_t i = k+1; i < N; i++ ) {
+      T l = a(i,k) / a(k,k);
+      a(i,k) = l;
+      for ( counter_t j = k+1; j < N; j++ ) a(i,j) -= l * a(k,j);
+    }
+
+  }
+
+  return f;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//! \brief Solve a system with an LU factorization.
+//! \tparam T  The base value type.
+//! \tparam N  The matrix dimension.
+//! \param[in] f  The factorization of the matrix
+//! \param[in] b  The right hand side vector
+//! \return The solution
+////////////////////////////////////////////////////////////////////////////////
+template <
+  typename T, std::size_t N,
+  template<typename, std::size_t> class C
+>
+auto lu_solve( const lu_factorization<T, N> & f, const C<T,N> & b )
+{
+  using counter_t = utils::select_counter_t< N >;
+
+  assert( !f.singular && "singular matrix" );
+
+  const auto & a = f.lu;
+  C<T,N> x;
+
+  // L y = P b
+  for ( counter_t i = 0; i < N; i++ ) {
+    T sum = b[ f.pivots[i] ];
+    for ( counter_t j = 0; j < i; j++ ) sum -= a(i,j) * x[j];
+    x[i] = sum;
+  }
+
+  // U x = y
+  for ( counter_t i = N; i-- > 0; ) {
+    T sum = x[i];
+    for ( counter_t j = i+1; j < N; j++ ) sum -= a(i,j) * x[j];
+    x[i] = sum / a(i,i);
+  }
+
+  return x;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//! \brief Solve a system with many right hand sides with an LU
+//!        factorization.
+//! \tparam T  The base value type.
+//! \tparam N  The matrix dimension.
+//! \tparam M  The number of right hand sides.
+//! \param[in] f  The factorization of the matrix
+//! \param[in] b  The right hand sides, one per column
+//! \return The solutions, one per column
+////////////////////////////////////////////////////////////////////////////////
+template < typename T, std::size_t N, std::size_t M >
+auto lu_solve( const lu_factorization<T, N> & f, const multi_array<T, N, M> & b )
+{
+  using counter_t = utils::select_counter_t< N >;
+  using column_t = utils::select_counter_t< M >;
+
+  assert( !f.singular && "singular matrix" );
+
+  const auto & a = f.lu;
+  multi_array<T, N, M> x;
+
+  // L y = P b
+  for ( counter_t i = 0; i < N; i++ ) {
+    for ( column_t k = 0; k < M; k++ ) x(i,k) = b( f.pivots[i], k );
+    for ( counter_t j = 0; j < i; j++ )
+      for ( column_t k = 0; k < M; k++ ) x(i,k) -= a(i,j) * x(j,k);
+  }
+
+  // U x = y
+  for ( counter_t i = N; i-- > 0; ) {
+    for ( counter_t j = i+1; j < N; j++ )
+      for ( column_t k = 0; k < M; k++ ) x(i,k) -= a(i,j) * x(j,k);
+    for ( column_t k = 0; k < M; k++ ) x(i,k) /= a(i,i);
+  }
+
+  return x;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//! \brief The determinant from an LU factorization.
+//! \tparam T  The base value type.
+//! \tparam N  The matrix dimension.
+//! \param[in] f  The factorization of the matrix
+//! \return The determinant
+////////////////////////////////////////////////////////////////////////////////
+template < typename T, std::size_t N >
+T lu_determinant( const lu_factorization<T, N> & f )
+{
+  if ( f.singular ) return T(0);
+  T det = f.sign;
+  for ( utils::select_counter_t< N > i = 0; i < N; i++ ) det *= f.lu(i,i);
+  return det;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//! \brief Compute the Cholesky factorization of a symmetric positive
+//!        definite matrix.
+//! \remark Only the lower triangle of `mat` is used.
+//! \tparam T  The base value type.
+//! \tparam N  The matrix dimension.
+//! \param[in] mat  The matrix to factor
+//! \return The factorization
+////////////////////////////////////////////////////////////////////////////////
+template < typename T, std::size_t N >
+auto cholesky_factor( const multi_array<T, N, N> & mat )
+{
+  using counter_t = utils::select_counter_t< N >;
+
+  cholesky_factorization<T, N> f;
+  auto & l = f.l;
+  l = T(0);
+
+  for ( counter_t j = 0; j < N; j++ ) {
+
+    T d = mat(j,j);
+    for ( counter_t k = 0; k < j; k++ ) d -= l(j,k) * l(j,k);
+
+    if ( !( d > T(0) ) ) {
+      f.positive_definite = false;
+      return f;
+    }
+
+    l(j,j) = std::sqrt( d );
+
+    for ( counter_t i = j+1; i < N; i++ ) {
+      T sum = mat(i,j);
+      for ( counter_t k = 0; k < j; k++ ) sum -= l(i,k) * l(j,k);
+      l(i,j) = sum / l(j,j);
+    }
+
+  }
+
+  return f;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//! \brief Solve a system with a Cholesky factorization.
+//! \tparam T  The base value type.
+//! \tparam N  The matrix dimension.
+//! \param[in] f  The factorization of the matrix
+//! \param[in] b  The right hand side vector
+//! \return The solution
+////////////////////////////////////////////////////////////////////////////////
+template <
+  typename T, std::size_t N,
+  template<typename, std::size_t> class C
+>
+auto cholesky_solve( const cholesky_factorization<T, N> & f, const C<T,N> & b )
+{
+  using counter_t = utils::select_counter_t< N >;
+
+  assert( f.positive_definite && "matrix is not positive definite" );
+
+  const auto & l = f.l;
+  C<T,N> x;
+
+  // L y = b
+  for ( counter_t i = 0; i < N; i++ ) {
+    T sum = b[i];
+    for ( counter_t j = 0; j < i; j++ ) sum -= l(i,j) * x[j];
+    x[i] = sum / l(i,i);
+  }
+
+  // L^T x = y
+  for ( counter_t i = N; i-- > 0; ) {
+    T sum = x[i];
+    for ( counter_t j = i+1; j < N; j++ ) sum -= l(j,i) * x[j];
+    x[i] = sum / l(i,i);
+  }
+
+  return x;
+}
+
+} // namespace math
+} // namespace ristra
@@ -10,6 +10,7 @@
 #pragma once
 
 // user includes
+#include "ristra/math/expression.h"
 #include "ristra/math/general_impl.h"
 
 #include "ristra/assertions/errors.h"
@@ -458,5 +459,107 @@ T triple_product(const C<T, 3> &a, const C<T, 3> &b, const C<T, 3> &c)
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+// unevaluated expressions
+////////////////////////////////////////////////////////////////////////////////
+
+//! \brief Versions of the above taking array expressions, like
+//!        `magnitude(lazy(a) - b)`.  The expressions are evaluated first.
+//! @{
+template< 
+  typename A, typename B,
+  typename = std::enable_if_t< is_expression_v<A> || is_expression_v<B> >
+>
+auto dot_product(const A &a, const B &b) 
+{
+  return dot_product( evaluate(a), evaluate(b) );
+}
+
+template< typename A, typename = std::enable_if_t< is_expression_v<A> > >
+auto magnitude(const A &a) 
+{
+  return magnitude( a.eval() );
+}
+
+template< typename A, typename = std::enable_if_t< is_expression_v<A> > >
+auto abs(const A &a) 
+{
+  return abs( a.eval() );
+}
+
+template< 
+  typename A, typename B,
+  typename = std::enable_if_t< is_expression_v<A> || is_expression_v<B> >
+>
+auto delta_magnitude(const A &a, const B &b) 
+{
+  return delta_magnitude( evaluate(a), evaluate(b) );
+}
+
+template< typename A, typename = std::enable_if_t< is_expression_v<A> > >
+auto min_element(const A &a) 
+{
+  return min_element( a.eval() );
+}
+
+template< typename A, typename = std::enable_if_t< is_expression_v<A> > >
+auto max_element(const A &a) 
+{
+  return max_element( a.eval() );
+}
+
+template< 
+  typename A, typename B,
+  typename = std::enable_if_t< is_expression_v<A> || is_expression_v<B> >
+>
+auto min(const A &a, const B &b) 
+{
+  return min( evaluate(a), evaluate(b) );
+}
+
+template< 
+  typename A, typename B,
+  typename = std::enable_if_t< is_expression_v<A> || is_expression_v<B> >
+>
+auto max(const A &a, const B &b) 
+{
+  return max( evaluate(a), evaluate(b) );
+}
+
+template< typename A, typename = std::enable_if_t< is_expression_v<A> > >
+auto unit(const A &a) 
+{
+  return unit( a.eval() );
+}
+
+template< 
+  typename A, typename B,
+  typename = std::enable_if_t< is_expression_v<A> || is_expression_v<B> >
+>
+auto normal(const A &a, const B &b) 
+{
+  return normal( evaluate(a), evaluate(b) );
+}
+
+template< 
+  typename A, typename B,
+  typename = std::enable_if_t< is_expression_v<A> || is_expression_v<B> >
+>
+auto cross_product(const A &a, const B &b) 
+{
+  return cross_product( evaluate(a), evaluate(b) );
+}
+
+template< 
+  typename A, typename B, typename C,
+  typename = std::enable_if_t< 
+    is_expression_v<A> || is_expression_v<B> || is_expression_v<C> >
+>
+auto triple_product(const A &a, const B &b, const C &c) 
+{
+  return triple_product( evaluate(a), evaluate(b), evaluate(c) );
+}
+//! @}
+
 } // namespace math
 } // namespace ristra
@@ -9,11 +9,14 @@
 #pragma once
 
 // user includes
+#include "ristra/math/eigensolver.h"
+#include "ristra/math/factorization.h"
 #include "ristra/math/multi_array.h"
 #include "ristra/math/vector.h"
 
 // system includes
  #include <cmath>
+#include <utility>
 
 namespace ristra {
 namespace math {
@@ -135,26 +138,13 @@ auto cofactor( const matrix<T, N, N> & mat, std::size_t row, std::size_t col )
 //! \tparam N  The matrix dimension.
 //! \param[in] mat  The matrix to invert
 //! \return The result of the operation
+//! \remark Sizes above three use an LU factorization with partial pivoting.
 ////////////////////////////////////////////////////////////////////////////////
 //! @{
 template < typename T, std::size_t N >
 auto determinant( const matrix<T, N, N> & mat )
 {
-
-  using counter_t = utils::select_counter_t< N >;
-
-  // the determinant value
-  T det = 0;
- 
-  for(counter_t i = 0; i < N; i++ )
-  {
-    // get minor of element (0,i)
-    auto minor = cofactor( mat, 0, i);
-    // the recusion is here!
-    det += (i%2==1 ? -1:1) * mat(0,i) * determinant(minor);
-  }
- 
-  return det;
+  return lu_determinant( lu_factor(mat) );
 }
 
 template < typename T >
@@ -162,6 +152,21 @@ auto determinant( const matrix<T, 1, 1> & mat )
 {
   return mat(0,0);
 }
+
+template < typename T >
+auto determinant( const matrix<T, 2, 2> & mat )
+{
+  return mat(0,0)*mat(1,1) - mat(0,1)*mat(1,0);
+}
+
+template < typename T >
+auto determinant( const matrix<T, 3, 3> & mat )
+{
+  return 
+    mat(0,0)*mat(1,1)*mat(2,2) + mat(0,1)*mat(1,2)*mat(2,0) + 
+    mat(0,2)*mat(1,0)*mat(2,1) - mat(2,0)*mat(1,1)*mat(0,2) - 
+    mat(2,1)*mat(1,2)*mat(0,0) - mat(2,2)*mat(1,0)*mat(0,1);
+}
 //! @}
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -169,6 +174,8 @@ auto determinant( const matrix<T, 1, 1> & mat )
 //! \tparam T  The base value type.
 //! \param[in] mat  The matrix to invert
 //! \return The result of the operation
+//! \remark Sizes above three solve for the columns of the identity with an
+//!         LU factorization.
 ////////////////////////////////////////////////////////////////////////////////
 //! @{
 template < typename T >
@@ -244,29 +251,13 @@ auto inverse( const matrix<T, 3, 3> & mat )
 template < typename T, std::size_t N >
 auto inverse( const matrix<T, N, N> & mat )
 {
+  auto f = lu_factor(mat);
+  assert( !f.singular );
 
-  using counter_t = utils::select_counter_t< N >;
-
-  matrix<T,N,N> tmp;
+  matrix<T,N,N> id(0);
+  for ( utils::select_counter_t<N> i = 0; i < N; i++ ) id(i,i) = 1;
 
-  // get the determinant of a
-  auto det = determinant(mat);
-  assert( std::abs(det) > 0 );
-  auto inv_det = 1 / det;
-
-  
-  for(counter_t j=0;j<N; j++) {
-    for(counter_t i=0; i<N; i++) {
-      // get the co-factor (matrix) of A(j,i)
-      auto minor = cofactor(mat,j,i);
-      // compute the result
-      auto val = inv_det * determinant(minor);
-      if ( (i+j)%2 == 1 ) val = -val;
-      tmp(i,j) = val;
-    }
-  }
-  
-  return tmp;
+  return lu_solve( f, id );
 }
 //! @}
 
@@ -332,6 +323,19 @@ auto operator*( const matrix<T, D1, D2> & lhs, const C<T,D2> & rhs )
   return tmp;
 }
 
+//! \brief Compute the product of a matrix times a vector expression.
+//! \remark The vector expression is evaluated first.
+template <
+  typename T, std::size_t D1, std::size_t D2, typename E,
+  typename = std::enable_if_t<
+    is_expression_v<E> &&
+    !detail::is_elementwise_v<const matrix<T, D1, D2> &, E> >
+>
+auto operator*( const matrix<T, D1, D2> & lhs, const E & rhs )
+{
+  return lhs * rhs.eval();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 //! \brief Compute the product of a matrix times a matrix
 //! \tparam T  The base value type.
@@ -383,18 +387,77 @@ auto matrix_multiply(
 //! \tparam D  The matrix/array dimension.
 //! \param[in] A  The matrix
 //! \param[in] B  The right hand side vector
+//! \remark Sizes above three use an LU factorization with partial pivoting,
+//!         the inverse is never formed.
 ////////////////////////////////////////////////////////////////////////////////
+//! @{
 template < 
   typename T, std::size_t D,
   template<typename, std::size_t> class C
 >
 auto solve( const matrix<T, D, D> & A, const C<T,D> & b )
 {
-  C<T,D> x(0);
-  auto inv = inverse(A);
-  ax_plus_y( inv, b, x );
+  return lu_solve( lu_factor(A), b );
+}
+
+template < 
+  typename T,
+  template<typename, std::size_t> class C
+>
+auto solve( const matrix<T, 1, 1> & A, const C<T,1> & b )
+{
+  assert( A(0,0) != T() );
+  C<T,1> x;
+  x[0] = b[0] / A(0,0);
+  return x;
+}
+
+template < 
+  typename T,
+  template<typename, std::size_t> class C
+>
+auto solve( const matrix<T, 2, 2> & A, const C<T,2> & b )
+{
+  auto det = determinant(A);
+  assert( det != T() );
+  C<T,2> x;
+  x[0] = ( b[0]*A(1,1) - A(0,1)*b[1] ) / det;
+  x[1] = ( A(0,0)*b[1] - b[0]*A(1,0) ) / det;
+  return x;
+}
+
+template < 
+  typename T,
+  template<typename, std::size_t> class C
+>
+auto solve( const matrix<T, 3, 3> & A, const C<T,3> & b )
+{
+  // Cramer's rule, column i replaced by b
+  auto det = determinant(A);
+  assert( det != T() );
+  C<T,3> x;
+  for ( int i = 0; i < 3; i++ ) {
+    auto Ai = A;
+    for ( int j = 0; j < 3; j++ ) Ai(j,i) = b[j];
+    x[i] = determinant(Ai) / det;
+  }
   return x;
 }
+//! @}
+
+////////////////////////////////////////////////////////////////////////////////
+//! \brief Solve the system AX=B for many right hand sides
+//! \tparam T  The base value type.
+//! \tparam D  The matrix dimension.
+//! \tparam M  The number of right hand sides.
+//! \param[in] A  The matrix
+//! \param[in] B  The right hand sides, one per column
+////////////////////////////////////////////////////////////////////////////////
+template < typename T, std::size_t D, std::size_t M >
+auto solve( const matrix<T, D, D> & A, const matrix<T, D, M> & B )
+{
+  return lu_solve( lu_factor(A), B );
+}
 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -504,8 +567,15 @@ auto one_norm( const matrix<T, N, N> & mat )
     return norm;
 }
 
+//! \brief The spectral norm, i.e. the largest singular value.
 template < typename T, size_t N >
 auto two_norm( const matrix<T, N, N> & mat )
+{
+    return singular_values( mat )[0];
+}
+
+template < typename T, size_t N >
+auto frobenius_norm( const matrix<T, N, N> & mat )
 {
     using counter_t = utils::select_counter_t< N >;
     //
@@ -559,62 +629,136 @@ auto transpose( const matrix<T, D1, D2> & mat )
     return t_mat;
 }
 
+namespace detail {
+
+//! \brief The degrees of the diagonal Pade approximants used by exponential.
+inline constexpr std::size_t pade_degrees[] = { 3, 5, 7, 9, 13 };
+
+//! \brief The largest 1-norm for which each degree is accurate to double
+//!        precision without scaling.
+inline constexpr double pade_thetas[] = {
+  1.495585217958292e-2, 2.539398330063230e-1, 9.504178996162932e-1,
+  2.097847961257068e0, 5.371920351148152e0
+};
+
+//! \brief The coefficients b_0 to b_m of each degree.
+inline constexpr double pade_coefficients[][14] = {
+  { 120., 60., 12., 1. },
+  { 30240., 15120., 3360., 420., 30., 1. },
+  { 17297280., 8648640., 1995840., 277200., 25200., 1512., 56., 1. },
+  { 17643225600., 8821612800., 2075673600., 302702400., 30270240.,
+    2162160., 110880., 3960., 90., 1. },
+  { 64764752532480000., 32382376266240000., 7771770303897600.,
+    1187353796428800., 129060195264000., 10559470521600., 670442572800.,
+    33522128640., 1323241920., 40840800., 960960., 16380., 182., 1. }
+};
+
+//! \brief Pick the lowest accurate degree for a matrix 1-norm, and the
+//!        number of squarings when even the highest needs scaling.
+//! \param[in] norm  The 1-norm of the matrix
+//! \param[out] index  The index of the degree in pade_degrees
+//! \param[out] squarings  The matrix is scaled by 2^-squarings
+inline void pade_parameters( double norm, std::size_t & index, int & squarings )
+{
+  squarings = 0;
+  for ( index = 0; index < 4; index++ )
+    if ( norm <= pade_thetas[index] ) return;
+
+  // ceil( log2( norm / theta ) ), exactly
+  if ( norm > pade_thetas[4] ) {
+    int e;
+    double f = std::frexp( norm / pade_thetas[4], &e );
+    squarings = ( f == 0.5 ) ? e-1 : e;
+  }
+}
+
+} // namespace detail
+
+////////////////////////////////////////////////////////////////////////////////
+//! \brief The matrix exponential, by scaling and squaring of a diagonal Pade
+//!        approximant.
+//!
+//! Nicholas J. Higham, "The Scaling and Squaring Method for the Matrix
+//! Exponential Revisited", SIAM J. Matrix Anal. Appl., 2005.
+//!
+//! The degree and the scaling come from the 1-norm.  The approximant is
+//! found with an LU solve, never an inverse.
+//!
+//! \tparam T  The base value type.
+//! \tparam N  The matrix dimension.
+//! \param[in] mat  The matrix
+//! \return exp(mat)
+////////////////////////////////////////////////////////////////////////////////
 template < typename T, size_t N >
 auto exponential( const matrix<T, N, N> & mat )
 {
+    std::size_t index;
+    int s;
+    detail::pade_parameters( one_norm( mat ), index, s );
+    const auto m = detail::pade_degrees[index];
+    const auto & b = detail::pade_coefficients[index];
     //
-    //    Cleve Moler and Charles VanLoan, 
-    //    "Nineteen Dubious Ways to Compute the Exponential of a Matrix,
-    //     Twenty-Five Years Later",
-    //    SIAM Review, 2003
-    //
-    // maximum number of power elevations. The higher q
-    // the higher the precision
-    constexpr size_t q = 6;
-    //
-    T mat_norm            = infinity_norm( mat );
-    T scaling_coefficient = ( std::log(mat_norm)
-                            / std::log(2.)
-                            ) + 1.;
-    const size_t s =
-        static_cast<size_t>
-        (
-            std::max( 0, 
-                      static_cast<int>(scaling_coefficient) + 1
-                    )
-        );
-    // scale matrix
-    auto A = mat/std::pow(2,s);
+    matrix<T,N,N> A = mat;
+    if ( s > 0 ) A *= std::ldexp( T(1), -s );
     //
-    auto E = identity_matrix<T,N>() + 0.5 * A;
-    // auxiliary matrices
-    auto D = identity_matrix<T,N>() - 0.5 * A;
-    auto X = A;
+    // the even powers the degree needs, X is scratch
+    matrix<T,N,N> A2(0), A4(0), A6(0), X(0), U, V;
+    matrix_multiply( A, A, A2 );
+    if ( m >= 5 ) matrix_multiply( A2, A2, A4 );
+    if ( m >= 7 ) matrix_multiply( A2, A4, A6 );
     //
-    T c = 0.5;
-    //
-    for ( size_t ii = 2; ii <= q; ii++ )
-    {
-        c *= static_cast<T>( q - ii + 1 )
-           / static_cast<T>( ii * ( 2 * q - ii + 1 ) );
-        //
-        X = matrix_multiply( A, X );
-        E = c * X + E;
-        //
-        if ( ii % 2  )
-            D -= c * X;
-        else
-            D += c * X;
-        //
+    // V holds the even terms, U the odd ones divided by A; every term is
+    // lazy so each sum is one loop with no temporaries, and the identity
+    // terms only touch the diagonal
+    if ( m == 13 ) {
+        X = b[13] * lazy(A6) + b[11] * lazy(A4) + b[9] * lazy(A2);
+        U = b[7] * lazy(A6) + b[5] * lazy(A4) + b[3] * lazy(A2);
+        for ( size_t ii = 0; ii < N; ii++ ) U(ii,ii) += b[1];
+        matrix_multiply( A6, X, U );
+        X = b[12] * lazy(A6) + b[10] * lazy(A4) + b[8] * lazy(A2);
+        V = b[6] * lazy(A6) + b[4] * lazy(A4) + b[2] * lazy(A2);
+        for ( size_t ii = 0; ii < N; ii++ ) V(ii,ii) += b[0];
+        matrix_multiply( A6, X, V );
+    }
+    else {
+        U = b[3] * lazy(A2);
+        V = b[2] * lazy(A2);
+        for ( size_t ii = 0; ii < N; ii++ ) {
+            U(ii,ii) += b[1];
+            V(ii,ii) += b[0];
+        }
+        if ( m >= 5 ) {
+            U += b[5] * lazy(A4);
+            V += b[4] * lazy(A4);
+        }
+        if ( m >= 7 ) {
+            U += b[7] * lazy(A6);
+            V += b[6] * lazy(A6);
+        }
+        if ( m >= 9 ) {
+            matrix_multiply( A4, A4, X );
+            U += b[9] * lazy(X);
+            V += b[8] * lazy(X);
+        }
     }
     //
-    E = matrix_multiply(inverse(D), E);
+    // (V - A U) E = V + A U
+    X = 0;
+    matrix_multiply( A, U, X );
+    U = lazy(V) - X;
+    V += X;
+    matrix<T,N,N> E = solve( U, V );
     //
-    for ( size_t ii = 0; ii < s; ii++ ){
-        E = matrix_multiply(E, E);
+    // undo the scaling, squaring back and forth between E and X
+    auto * result = &E;
+    auto * scratch = &X;
+    for ( int ii = 0; ii < s; ii++ ) {
+        *scratch = 0;
+        matrix_multiply( *result, *result, *scratch );
+        std::swap( result, scratch );
     }
     //
-    return E;
+    return *result;
 }
 
 
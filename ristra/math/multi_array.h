@@ -10,6 +10,7 @@
 
 // user includes
 #include "ristra/compatibility/type_traits.h"
+#include "ristra/math/expression.h"
 #include "ristra/utils/template_helpers.h"
 #include "ristra/utils/tuple_visit.h"
 
@@ -194,9 +195,24 @@ public:
     std::copy(oth.begin(),oth.end(), begin());    
   }
 
+  //! \brief Constructor from an expression, evaluated in a single loop.
+  //! \param[in] expr The expression to evaluate.
+  template <
+    typename E,
+    typename = std::enable_if_t< is_expression_for_v<E,multi_array> >,
+    typename = void
+  >
+  multi_array(const E & expr)
+  {
+    for ( counter_type i=0; i<elements; i++ ) elems_[i] = expr[i];
+  }
+
   //! \brief Constructor with one value.
   //! \param[in] val The value to set the multi_array to.
-  template < typename T2 >
+  template <
+    typename T2,
+    typename = std::enable_if_t< !is_expression_v<T2> >
+  >
   multi_array(const T2 & val)
   { 
     //std::cout << "multi_array (single value constructor)\n";
@@ -456,7 +472,10 @@ public:
 
   //! \param[in] val The constant on the right hand side of the operator.
   //! \return A reference to the current object.
-  template <typename T2>
+  template <
+    typename T2,
+    typename = std::enable_if_t< !is_expression_v<T2> >
+  >
   auto & operator= (const T2 & val) {
     fill(val);
     return *this;
@@ -475,7 +494,10 @@ public:
   //! \brief Addiition binary operator involving a constant.
   //! \param[in] val The constant on the right hand side of the operator.
   //! \return A reference to the current object.
-  template <typename T2>
+  template <
+    typename T2,
+    typename = std::enable_if_t< !is_expression_v<T2> >
+  >
   auto & operator+=(const T2 & val) {
     for ( counter_type i=0; i<elements; i++ ) elems_[i] += val;    
     return *this;
@@ -493,7 +515,10 @@ public:
   //! \brief Subtraction binary operator involving a constant.
   //! \param[in] val The constant on the right hand side of the operator.
   //! \return A reference to the current object.
-  template <typename T2>
+  template <
+    typename T2,
+    typename = std::enable_if_t< !is_expression_v<T2> >
+  >
   auto & operator-=(const T2 & val) {
     for ( counter_type i=0; i<elements; i++ ) elems_[i] -= val;    
     return *this;
@@ -512,7 +537,10 @@ public:
   //! \brief Multiplication binary operator involving a constant.
   //! \param[in] val The constant on the right hand side of the operator.
   //! \return A reference to the current object.
-  template <typename T2>
+  template <
+    typename T2,
+    typename = std::enable_if_t< !is_expression_v<T2> >
+  >
   auto & operator*=(const T2 & val) {
     for ( counter_type i=0; i<elements; i++ ) elems_[i] *= val;    
     return *this;
@@ -530,13 +558,86 @@ public:
   //! \brief Division operator involving a constant.
   //! \param[in] val The constant on the right hand side of the operator.
   //! \return A reference to the current object.
-  template <typename T2>
+  template <
+    typename T2,
+    typename = std::enable_if_t< !is_expression_v<T2> >
+  >
   auto & operator/=(const T2 & val) {
     auto inv = static_cast<T>(1) / val;
     for ( counter_type i=0; i<elements; i++ ) elems_[i] *= inv;
     return *this;
   }
 
+  //! \brief Assignment from an expression, evaluated in a single loop.
+  //! \param[in] rhs The expression on the right hand side of the operator.
+  //! \return A reference to the current object.
+  template <
+    typename E,
+    typename = std::enable_if_t< is_expression_for_v<E,multi_array> >,
+    typename = void
+  >
+  auto & operator= (const E & rhs) {
+    for ( counter_type i=0; i<elements; i++ )
+      elems_[i] = rhs[i];
+    return *this;
+  }
+
+  //! \brief Addition binary operator involving an expression.
+  //! \param[in] rhs The expression on the right hand side of the operator.
+  //! \return A reference to the current object.
+  template <
+    typename E,
+    typename = std::enable_if_t< is_expression_for_v<E,multi_array> >,
+    typename = void
+  >
+  auto & operator+=(const E & rhs) {
+    for ( counter_type i=0; i<elements; i++ )
+      elems_[i] += rhs[i];
+    return *this;
+  }
+
+  //! \brief Subtraction binary operator involving an expression.
+  //! \param[in] rhs The expression on the right hand side of the operator.
+  //! \return A reference to the current object.
+  template <
+    typename E,
+    typename = std::enable_if_t< is_expression_for_v<E,multi_array> >,
+    typename = void
+  >
+  auto & operator-=(const E & rhs) {
+    for ( counter_type i=0; i<elements; i++ )
+      elems_[i] -= rhs[i];
+    return *this;
+  }
+
+  //! \brief Multiplication binary operator involving an expression.
+  //! \param[in] rhs The expression on the right hand side of the operator.
+  //! \return A reference to the current object.
+  template <
+    typename E,
+    typename = std::enable_if_t< is_expression_for_v<E,multi_array> >,
+    typename = void
+  >
+  auto & operator*=(const E & rhs) {
+    for ( counter_type i=0; i<elements; i++ )
+      elems_[i] *= rhs[i];
+    return *this;
+  }
+
+  //! \brief Division binary operator involving an expression.
+  //! \param[in] rhs The expression on the right hand side of the operator.
+  //! \return A reference to the current object.
+  template <
+    typename E,
+    typename = std::enable_if_t< is_expression_for_v<E,multi_array> >,
+    typename = void
+  >
+  auto & operator/=(const E & rhs) {
+    for ( counter_type i=0; i<elements; i++ )
+      elems_[i] /= rhs[i];
+    return *this;
+  }
+
   //! \brief Unary - operator.
   //! \param[in] rhs The array on the right hand side of the operator.
   //! \return A reference to the current object.
@@ -660,7 +761,10 @@ bool operator==(const multi_array<T,N...>& lhs, const multi_array<T,N...>& rhs)
   return true;
 }
 
-template<typename T, typename U, std::size_t... N>
+template<
+  typename T, typename U, std::size_t... N,
+  typename = std::enable_if_t< !is_expression_v<U> >
+>
 bool operator==(const multi_array<T,N...>& lhs, const U& rhs)
 {
   using counter_type = typename multi_array<T,N...>::counter_type;
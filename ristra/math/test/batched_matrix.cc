@@ -0,0 +1,272 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2017 Los Alamos National Laboratory, LLC
+ * All rights reserved
+ *~-------------------------------------------------------------------------~~*/
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Tests related to the batched matrix kernels.
+///////////////////////////////////////////////////////////////////////////////
+
+#include<ristra/ristra-config.h>
+
+// user includes
+#include "ristra/math/batched_matrix.h"
+
+// system includes
+#include <gtest/gtest.h>
+#include <cmath>
+
+// explicitly use some stuff
+using namespace ristra;
+using namespace ristra::math;
+
+using real_t = config::real_t;
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Fill a batch with diagonally dominant matrices, some of them
+//!        needing pivoting.
+///////////////////////////////////////////////////////////////////////////////
+template < std::size_t N >
+void fill_batch( batched_matrix<real_t,N,N> & A, batched_vector<real_t,N> & x )
+{
+  for ( std::size_t m = 0; m < A.size(); m++ ) {
+    matrix<real_t,N,N> a;
+    vector<real_t,N> v;
+    for ( std::size_t i = 0; i < N; i++ ) {
+      v[i] = std::cos( 0.1*m + i );
+      for ( std::size_t j = 0; j < N; j++ )
+        a(i,j) = std::sin( 1.0 + 0.37*m + i + 2.0*j ) + ( (i == j) ? 2.0*N : 0.0 );
+    }
+    // swap the first two rows of every third matrix
+    if ( N > 1 && m % 3 == 0 )
+      for ( std::size_t j = 0; j < N; j++ ) std::swap( a(0,j), a(1,j) );
+    A.set( m, a );
+    x.set( m, v );
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Check every kernel against the one matrix versions.
+///////////////////////////////////////////////////////////////////////////////
+template < std::size_t N >
+void check_batch( std::size_t n, const batch_options & options )
+{
+  batched_matrix<real_t,N,N> A(n), Ainv, C(n);
+  batched_vector<real_t,N> x(n), b(n), sol;
+  fill_batch( A, x );
+
+  // b = A x
+  matrix_vector( real_t(1), A, x, real_t(0), b, options );
+
+  std::vector<real_t> det;
+  determinant( A, det, options );
+  inverse( A, Ainv, options );
+  solve( A, b, sol, options );
+  matrix_multiply( A, Ainv, C, options );
+
+  // solving in place gives the same solutions
+  auto b_in_place = b;
+  solve( A, b_in_place, b_in_place, options );
+
+  for ( std::size_t m = 0; m < n; m++ ) {
+    auto a = A.get(m);
+    auto d = determinant(a);
+    ASSERT_NEAR( 1.0, det[m] / d, 1e-13 );
+
+    auto bm = a * x.get(m);
+    for ( std::size_t i = 0; i < N; i++ ) {
+      ASSERT_NEAR( bm[i], b(m,i), 1e-13 );
+      ASSERT_NEAR( x(m,i), sol(m,i), 1e-13 );
+      ASSERT_EQ( sol(m,i), b_in_place(m,i) );
+      for ( std::size_t j = 0; j < N; j++ )
+        ASSERT_NEAR( (i == j) ? 1.0 : 0.0, C(m,i,j), 1e-13 );
+    }
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Test the batched kernels.
+///////////////////////////////////////////////////////////////////////////////
+TEST(batched_matrix, kernels) {
+
+  batch_options serial;
+  serial.n_threads = 1;
+
+  // sizes that do not fill the last block
+  check_batch<1>( 37, serial );
+  check_batch<2>( 37, serial );
+  check_batch<3>( 37, serial );
+  check_batch<5>( 101, serial );
+  check_batch<7>( 101, serial );
+
+  // threaded
+  batch_options threaded;
+  threaded.n_threads = 4;
+  threaded.thread_threshold = 0;
+  check_batch<3>( 1000, threaded );
+  check_batch<5>( 1000, threaded );
+
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Test the layout and the special cases.
+///////////////////////////////////////////////////////////////////////////////
+TEST(batched_matrix, layout) {
+
+  // element (i,j) of every matrix is contiguous
+  batched_matrix<real_t,2,3> A(4);
+  for ( std::size_t m = 0; m < 4; m++ )
+    A.set( m, matrix<real_t,2,3>{ 1.0*m, 1.0, 2.0, 3.0, 4.0, 5.0 } );
+  for ( std::size_t m = 0; m < 4; m++ ) {
+    ASSERT_EQ( real_t(m), A.component(0,0)[m] );
+    ASSERT_EQ( 5.0, A.component(1,2)[m] );
+  }
+
+  A.resize(6);
+  ASSERT_EQ( 3.0, A(3,0,0) );
+  ASSERT_EQ( 4.0, A(3,1,1) );
+  ASSERT_EQ( 0.0, A(5,1,1) );
+
+  // singular matrices give a zero determinant
+  batched_matrix<real_t,4,4> S(3);
+  batched_vector<real_t,4> unused(3);
+  fill_batch( S, unused );
+  S.set( 1, matrix<real_t,4,4>(1.0) );
+  std::vector<real_t> det;
+  determinant( S, det );
+  ASSERT_EQ( 0.0, det[1] );
+  ASSERT_NE( 0.0, det[0] );
+
+  // the closed form solves of singular matrices are not finite
+  batched_matrix<real_t,3,3> S3(2);
+  batched_vector<real_t,3> b3(2), x3;
+  S3.set( 0, matrix<real_t,3,3>(1.0) );
+  S3.set( 1, matrix<real_t,3,3>{ 2.0, 0.0, 0.0, 0.0, 3.0, 0.0, 0.0, 0.0, 4.0 } );
+  b3.set( 0, vector<real_t,3>(1.0) );
+  b3.set( 1, vector<real_t,3>(1.0) );
+  solve( S3, b3, x3 );
+  ASSERT_FALSE( std::isfinite( x3(0,0) ) );
+  ASSERT_EQ( 0.5, x3(1,0) );
+  ASSERT_EQ( 0.25, x3(1,2) );
+
+  // threaded and serial runs agree to the last bit
+  batched_matrix<real_t,5,5> B(5000), inv1, inv2;
+  batched_vector<real_t,5> x(5000);
+  fill_batch( B, x );
+
+  batch_options serial, threaded;
+  serial.n_threads = 1;
+  threaded.n_threads = 3;
+  threaded.thread_threshold = 0;
+  inverse( B, inv1, serial );
+  inverse( B, inv2, threaded );
+  for ( std::size_t m = 0; m < B.size(); m++ )
+    ASSERT_TRUE( inv1.get(m) == inv2.get(m) );
+
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Check the batched eigen and singular value kernels against the one
+//!        matrix versions.
+///////////////////////////////////////////////////////////////////////////////
+template < std::size_t N >
+void check_eigen_batch( std::size_t n, const batch_options & options )
+{
+  // symmetric, with some diagonal and rank deficient ones
+  batched_matrix<real_t,N,N> A(n), S(n), vectors;
+  batched_vector<real_t,N> x(n), w, w2, s;
+  fill_batch( A, x );
+  for ( std::size_t m = 0; m < n; m++ ) {
+    matrix<real_t,N,N> a = A.get(m);
+    matrix<real_t,N,N> sym = a + transpose(a);
+    if ( m % 5 == 1 )
+      for ( std::size_t i = 0; i < N; i++ )
+        for ( std::size_t j = 0; j < N; j++ ) sym(i,j) = (i == j) ? 1.0*(N-i) : 0.0;
+    if ( m % 7 == 2 )
+      for ( std::size_t i = 0; i < N; i++ )
+        for ( std::size_t j = 0; j < N; j++ ) sym(i,j) = x(m,i) * x(m,j);
+    S.set( m, sym );
+  }
+
+  symmetric_eigen( S, w, vectors, options );
+  symmetric_eigenvalues( S, w2, options );
+  singular_values( A, s, options );
+
+  for ( std::size_t m = 0; m < n; m++ ) {
+    auto sym = S.get(m);
+    auto eig = symmetric_eigen(sym);
+    auto sv = singular_values( A.get(m) );
+    auto v = vectors.get(m);
+    matrix<real_t,N,N> av = matrix_multiply(sym, v);
+    for ( std::size_t i = 0; i < N; i++ ) {
+      ASSERT_NEAR( eig.values[i], w(m,i), 1e-12 );
+      ASSERT_EQ( w(m,i), w2(m,i) );
+      ASSERT_NEAR( sv[i], s(m,i), 1e-12 );
+      for ( std::size_t j = 0; j < N; j++ )
+        ASSERT_NEAR( w(m,j) * v(i,j), av(i,j), 1e-12 );
+    }
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Test the batched eigen and singular value kernels.
+///////////////////////////////////////////////////////////////////////////////
+TEST(batched_matrix, eigen) {
+
+  batch_options serial;
+  serial.n_threads = 1;
+
+  check_eigen_batch<1>( 37, serial );
+  check_eigen_batch<2>( 37, serial );
+  check_eigen_batch<3>( 101, serial );
+  check_eigen_batch<4>( 101, serial );
+
+  batch_options threaded;
+  threaded.n_threads = 4;
+  threaded.thread_threshold = 0;
+  check_eigen_batch<3>( 1000, threaded );
+
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Test the batched exponential against the one matrix version.
+///////////////////////////////////////////////////////////////////////////////
+template < std::size_t N >
+void check_exponential_batch( std::size_t n, const batch_options & options )
+{
+  // norms from tiny to ones that need scaling, mixed within a block
+  batched_matrix<real_t,N,N> A(n), E;
+  batched_vector<real_t,N> unused(n);
+  fill_batch( A, unused );
+  for ( std::size_t m = 0; m < n; m++ ) {
+    matrix<real_t,N,N> a = A.get(m);
+    a *= std::pow( 10.0, -3.0 + 4.0 * ( (m*7) % 11 ) / 10.0 ) / one_norm(a);
+    A.set( m, a );
+  }
+
+  exponential( A, E, options );
+
+  for ( std::size_t m = 0; m < n; m++ ) {
+    auto e = exponential( A.get(m) );
+    for ( std::size_t i = 0; i < N; i++ )
+      for ( std::size_t j = 0; j < N; j++ )
+        ASSERT_NEAR( 1.0, (E(m,i,j) + 1.0) / (e(i,j) + 1.0), 1e-12 );
+  }
+}
+
+TEST(batched_matrix, exponential) {
+
+  batch_options serial;
+  serial.n_threads = 1;
+
+  check_exponential_batch<1>( 37, serial );
+  check_exponential_batch<2>( 37, serial );
+  check_exponential_batch<3>( 101, serial );
+  check_exponential_batch<5>( 101, serial );
+
+  batch_options threaded;
+  threaded.n_threads = 4;
+  threaded.thread_threshold = 0;
+  check_exponential_batch<3>( 1000, threaded );
+
+}
@@ -14,6 +14,7 @@
 
 // system includes
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <iostream>
 #include <cmath>
 
@@ -449,3 +450,220 @@ TEST(matrix, invert_5d) {
   
 }
 
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Test the fused expressions.
+///////////////////////////////////////////////////////////////////////////////
+TEST(matrix, expressions) {
+
+  matrix<real_t,3,3> x{ 0.1, 0.7, -1.3,
+                        1.0/3.0, 2.9, 0.25,
+                        -0.6, 1.0/7.0, 3.1 };
+  matrix<real_t,3,3> e = identity_matrix<real_t,3>();
+  real_t c = 1.0/12.0;
+
+  // E = c * X + E, a fused scale and add
+  auto ans = e;
+  auto cx = x;
+  cx *= c;
+  ans += cx;
+  e = c * lazy(x) + e;
+  ASSERT_TRUE( e == ans ) << " error in fused c * X + E";
+
+  ans = x;
+  ans /= std::pow(2,3);
+  matrix<real_t,3,3> a = lazy(x) / std::pow(2,3);
+  ASSERT_TRUE( a == ans ) << " error in fused X / 2^s";
+
+  // matrix times a vector expression
+  vector<real_t,3> u{ 1.0, 2.0, 3.0 };
+  vector<real_t,3> v{ 0.5, -1.0, 0.25 };
+  vector<real_t,3> w = u + v;
+  ASSERT_TRUE( x * (lazy(u) + v) == x * w ) << " error in matrix * expression";
+
+} // TEST
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Test the LU and Cholesky factorizations.
+///////////////////////////////////////////////////////////////////////////////
+TEST(matrix, factorization) {
+
+  // a row permutation of the lower triangular ones, needs pivoting
+  matrix<real_t,5,5> p{
+    1.0, 1.0, 1.0, 0.0, 0.0,
+    1.0, 0.0, 0.0, 0.0, 0.0,
+    1.0, 1.0, 1.0, 1.0, 1.0,
+    1.0, 1.0, 1.0, 1.0, 0.0,
+    1.0, 1.0, 0.0, 0.0, 0.0
+  };
+  ASSERT_EQ( -1.0, determinant(p) );
+  ASSERT_EQ( 0.0, determinant(matrix<real_t,4,4>(1.0)) );
+
+  // diagonally dominant 7x7 system with a known solution
+  matrix<real_t,7,7> a;
+  vector<real_t,7> x;
+  for ( int i=0; i<7; i++ ) {
+    x[i] = 1.0 + 0.5*i;
+    for ( int j=0; j<7; j++ )
+      a(i,j) = (i == j) ? 10.0 + i : std::sin(1.0 + i + 2.0*j);
+  }
+  vector<real_t,7> b = a * x;
+
+  auto sol = solve(a, b);
+  for ( int i=0; i<7; i++ ) ASSERT_NEAR( x[i], sol[i], 1e-13 );
+
+  // the inverse is the solve of the identity
+  auto ainv = inverse(a);
+  auto id = matrix_multiply(ainv, a);
+  for ( int i=0; i<7; i++ )
+    for ( int j=0; j<7; j++ )
+      ASSERT_NEAR( (i == j) ? 1.0 : 0.0, id(i,j), 1e-14 );
+
+  // symmetric positive definite, A^T A
+  matrix<real_t,7,7> spd = matrix_multiply(transpose(a), a);
+  vector<real_t,7> c = spd * x;
+  auto chol = cholesky_factor(spd);
+  ASSERT_TRUE( chol.positive_definite );
+  sol = cholesky_solve(chol, c);
+  for ( int i=0; i<7; i++ ) ASSERT_NEAR( x[i], sol[i], 1e-12 );
+
+  // the determinant of A^T A is the square of that of A
+  auto det = determinant(a);
+  ASSERT_NEAR( 1.0, determinant(spd) / (det*det), 1e-12 );
+  ASSERT_FALSE( cholesky_factor(matrix<real_t,3,3>(-1.0)).positive_definite );
+
+  // the unrolled small sizes
+  matrix<real_t,3,3> a3{ 2.0, -1.0, 0.5, 1.0, 3.0, -2.0, 0.0, 1.5, 4.0 };
+  vector<real_t,3> x3{ 1.0, -2.0, 0.5 };
+  auto sol3 = solve(a3, vector<real_t,3>(a3 * x3));
+  for ( int i=0; i<3; i++ ) ASSERT_NEAR( x3[i], sol3[i], 1e-14 );
+  ASSERT_NEAR( determinant(a3), lu_determinant(lu_factor(a3)), 1e-13 );
+
+  matrix<real_t,2,2> a2{ 1.0, 2.0, 3.0, 4.0 };
+  vector<real_t,2> x2{ 0.25, -1.0 };
+  auto sol2 = solve(a2, vector<real_t,2>(a2 * x2));
+  for ( int i=0; i<2; i++ ) ASSERT_NEAR( x2[i], sol2[i], 1e-15 );
+
+} // TEST
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Test the eigen and singular value decompositions.
+///////////////////////////////////////////////////////////////////////////////
+template < std::size_t N >
+void check_eigen( const matrix<real_t,N,N> & a )
+{
+  // A V = V diag(w), V^T V = I, ascending
+  auto eig = symmetric_eigen(a);
+  const auto & v = eig.vectors;
+  matrix<real_t,N,N> av = matrix_multiply(a, v);
+  matrix<real_t,N,N> vtv = matrix_multiply(transpose(v), v);
+  for ( std::size_t i=0; i<N; i++ )
+    for ( std::size_t j=0; j<N; j++ ) {
+      ASSERT_NEAR( eig.values[j] * v(i,j), av(i,j), 1e-13 );
+      ASSERT_NEAR( (i == j) ? 1.0 : 0.0, vtv(i,j), 1e-14 );
+    }
+  auto w = symmetric_eigenvalues(a);
+  for ( std::size_t k=0; k<N; k++ ) {
+    ASSERT_NEAR( eig.values[k], w[k], 1e-13 );
+    if ( k > 0 ) ASSERT_LE( w[k-1], w[k] );
+  }
+
+  // A = U diag(s) V^T, descending
+  auto dec = svd(a);
+  matrix<real_t,N,N> us = dec.u;
+  for ( std::size_t i=0; i<N; i++ )
+    for ( std::size_t j=0; j<N; j++ ) us(i,j) *= dec.values[j];
+  matrix<real_t,N,N> usv = matrix_multiply(us, transpose(dec.v));
+  matrix<real_t,N,N> utu = matrix_multiply(transpose(dec.u), dec.u);
+  auto s = singular_values(a);
+  for ( auto & wk : w ) wk = std::abs(wk);
+  std::sort( w.begin(), w.end(), [](real_t x, real_t y) { return x > y; } );
+  for ( std::size_t i=0; i<N; i++ ) {
+    ASSERT_NEAR( dec.values[i], s[i], 1e-13 );
+    ASSERT_NEAR( w[i], s[i], 1e-13 );
+    for ( std::size_t j=0; j<N; j++ ) {
+      ASSERT_NEAR( a(i,j), usv(i,j), 1e-13 );
+      ASSERT_NEAR( (i == j) ? 1.0 : 0.0, utu(i,j), 1e-14 );
+    }
+  }
+}
+
+TEST(matrix, eigen) {
+
+  // w = 1, 3, v = (1,-1), (1,1)
+  matrix<real_t,2,2> a2{ 2.0, 1.0, 1.0, 2.0 };
+  auto eig2 = symmetric_eigen(a2);
+  ASSERT_NEAR( 1.0, eig2.values[0], 1e-15 );
+  ASSERT_NEAR( 3.0, eig2.values[1], 1e-15 );
+  ASSERT_NEAR( 0.0, eig2.vectors(0,0) + eig2.vectors(1,0), 1e-15 );
+  ASSERT_NEAR( 0.0, eig2.vectors(0,1) - eig2.vectors(1,1), 1e-15 );
+  check_eigen(a2);
+  check_eigen( matrix<real_t,2,2>{ -3.0, 0.0, 0.0, 1.0 } );
+
+  // a stress like tensor, positive definite
+  matrix<real_t,3,3> a3{ 4.0, 1.0, -2.0, 1.0, 2.0, 0.5, -2.0, 0.5, 3.0 };
+  check_eigen(a3);
+  auto w3 = symmetric_eigenvalues(a3);
+  ASSERT_NEAR( trace_matrix(a3), w3[0] + w3[1] + w3[2], 1e-13 );
+  ASSERT_GT( w3[0], 0.0 );
+
+  // repeated eigenvalues and a rank one matrix
+  check_eigen( matrix<real_t,3,3>{ 2.0, 0.0, 0.0, 0.0, 2.0, 0.0, 0.0, 0.0, 5.0 } );
+  check_eigen( matrix<real_t,3,3>{ 1.0, 2.0, 3.0, 2.0, 4.0, 6.0, 3.0, 6.0, 9.0 } );
+  check_eigen( matrix<real_t,3,3>(0.0) );
+
+  // a larger size goes through the same sweeps
+  matrix<real_t,6,6> a6;
+  for ( int i=0; i<6; i++ )
+    for ( int j=0; j<6; j++ ) a6(i,j) = std::cos( 1.0 + i + j ) + ( (i == j) ? i : 0.0 );
+  check_eigen(a6);
+
+  // the spectral norm of a nonsymmetric matrix, the square root of the
+  // largest eigenvalue of A^T A
+  matrix<real_t,3,3> b{ 1.0, 2.0, 0.0, 0.0, 1.0, 3.0, -1.0, 0.0, 1.0 };
+  matrix<real_t,3,3> btb = matrix_multiply(transpose(b), b);
+  ASSERT_NEAR( std::sqrt(symmetric_eigenvalues(btb)[2]), two_norm(b), 1e-13 );
+  ASSERT_LT( two_norm(b), frobenius_norm(b) );
+  ASSERT_NEAR( 5.0, two_norm( matrix<real_t,2,2>{ 3.0, 0.0, 0.0, -5.0 } ), 1e-15 );
+
+} // TEST
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Test the matrix exponential.
+///////////////////////////////////////////////////////////////////////////////
+TEST(matrix, exponential) {
+
+  // rotations, with norms that pick every degree and some scaling
+  for ( real_t t : { 1e-3, 0.1, 0.5, 1.5, 4.0, 30.0 } ) {
+    matrix<real_t,2,2> a{ 0.0, -t, t, 0.0 };
+    auto e = exponential(a);
+    ASSERT_NEAR( std::cos(t), e(0,0), 1e-13 );
+    ASSERT_NEAR( -std::sin(t), e(0,1), 1e-13 );
+    ASSERT_NEAR( std::sin(t), e(1,0), 1e-13 );
+    ASSERT_NEAR( std::cos(t), e(1,1), 1e-13 );
+  }
+
+  // a Jordan block, exp = e^l (I + N)
+  for ( real_t l : { -2.0, 0.3, 8.0 } ) {
+    matrix<real_t,3,3> a{ l, 1.0, 0.0, 0.0, l, 1.0, 0.0, 0.0, l };
+    auto e = exponential(a);
+    real_t el = std::exp(l);
+    matrix<real_t,3,3> ans{ el, el, 0.5*el, 0.0, el, el, 0.0, 0.0, el };
+    for ( int i=0; i<3; i++ )
+      for ( int j=0; j<3; j++ )
+        ASSERT_NEAR( 1.0, (ans(i,j) + 1.0) / (e(i,j) + 1.0), 1e-13 );
+  }
+
+  // exp(A) exp(-A) = I
+  matrix<real_t,5,5> a;
+  for ( int i=0; i<5; i++ )
+    for ( int j=0; j<5; j++ ) a(i,j) = std::sin( 1.0 + 2.0*i + j );
+  matrix<real_t,5,5> ma = -a;
+  auto id = matrix_multiply( exponential(a), exponential(ma) );
+  for ( int i=0; i<5; i++ )
+    for ( int j=0; j<5; j++ )
+      ASSERT_NEAR( (i == j) ? 1.0 : 0.0, id(i,j), 1e-13 );
+
+  ASSERT_TRUE( exponential( matrix<real_t,4,4>(0.0) ) == (identity_matrix<real_t,4>()) );
+
+} // TEST
@@ -16,6 +16,7 @@
 // system includes
 #include <gtest/gtest.h>
 #include <iostream>
+#include <type_traits>
 
 // explicitly use some stuff
 using namespace ristra;
@@ -416,3 +417,120 @@ TEST(vector, magnitude) {
   ASSERT_EQ(sqrt(50.0), magnitude(c));
 
 } // TEST
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Test the fused expressions.
+///////////////////////////////////////////////////////////////////////////////
+TEST(vector, expressions) {
+
+  vector_3d_t a{ 0.1, 0.7, -1.3 };
+  vector_3d_t b{ 1.0/3.0, 2.9, 0.25 };
+  vector_3d_t c{ -0.6, 1.0/7.0, 3.1 };
+  vector_3d_t d{ 0.05, -2.2, 1.0/9.0 };
+  real_t s = 0.3;
+
+  // the operators of the value types still return values
+  static_assert( std::is_same<decltype(a + b*c - d), vector_3d_t>::value,
+    "not a value" );
+  auto g = a + b;
+  g *= g;
+  ASSERT_EQ( (a[0] + b[0])*(a[0] + b[0]), g[0] );
+
+  // lazy() opts in, nothing is evaluated until assignment
+  static_assert( is_expression_v<decltype(lazy(a) + lazy(b)*c - d)>, "not an expression" );
+
+  // the same operations as the temporaries of each operator
+  vector_3d_t bc = b;
+  bc *= c;
+  vector_3d_t ans = a;
+  ans += bc;
+  ans -= d;
+  vector_3d_t e = lazy(a) + lazy(b)*c - d;
+  ASSERT_TRUE( e == ans ) << " error in fused a + b*c - d";
+
+  // division by a scalar multiplies by its inverse
+  ans = a;
+  ans -= d;
+  ans /= s;
+  ans = 2.0 - ans;
+  e = 2.0 - (lazy(a) - d) / s;
+  ASSERT_TRUE( e == ans ) << " error in fused 2 - (a - d) / s";
+
+  ans = a;
+  ans += b;
+  ans = -ans;
+  e = -(lazy(a) + b);
+  ASSERT_TRUE( e == ans ) << " error in negated expression";
+
+  // every operation converts to the value type
+  vector<int,3> n{ 1, 2, 3 };
+  vector<int,3> m = lazy(n) * 2.5 * 2;
+  ASSERT_TRUE( m == (vector<int,3>{ 4, 10, 14 }) ) << " error in int chain";
+
+  // elementwise, so the result can alias an operand
+  ans = a * b + a;
+  e = a;
+  e = lazy(e) * b + e;
+  ASSERT_TRUE( e == ans ) << " error in aliased assignment";
+  e += lazy(a) * b;
+  ans += vector_3d_t( a * b );
+  ASSERT_TRUE( e == ans ) << " error in operator+= with expression";
+
+  // temporaries are kept alive by the expression
+  auto f = lazy(a) + lazy(vector_3d_t{ 1.0, 2.0, 3.0 }) * s;
+  ASSERT_EQ( a[2] + 3.0*s, f[2] );
+
+  // functions taking vectors evaluate their expression arguments
+  ASSERT_EQ( magnitude(vector_3d_t(a - b)), magnitude(lazy(a) - b) );
+  ASSERT_EQ( dot_product(vector_3d_t(a - b), c), dot_product(lazy(a) - b, c) );
+  ASSERT_TRUE( cross_product(lazy(a) + b, c) == cross_product(vector_3d_t(a + b), c) );
+
+} // TEST
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief An element type that counts how often it is default constructed,
+//!        i.e. how many elements of temporary arrays get built.
+///////////////////////////////////////////////////////////////////////////////
+struct counted_t {
+  static int defaults;
+  real_t v = 0;
+  counted_t() { defaults++; }
+  counted_t( real_t x ) : v(x) {}
+};
+
+int counted_t::defaults = 0;
+
+counted_t operator+( const counted_t & a, const counted_t & b ) { return a.v + b.v; }
+counted_t operator-( const counted_t & a, const counted_t & b ) { return a.v - b.v; }
+counted_t operator*( const counted_t & a, const counted_t & b ) { return a.v * b.v; }
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Test that a fully wrapped chain builds no temporary arrays.
+///////////////////////////////////////////////////////////////////////////////
+TEST(vector, expression_temporaries) {
+
+  using counted_vector_t = vector<counted_t,3>;
+  counted_vector_t a{ 0.1, 0.7, -1.3 };
+  counted_vector_t b{ 1.0/3.0, 2.9, 0.25 };
+  counted_vector_t c{ -0.6, 1.0/7.0, 3.1 };
+  counted_vector_t d{ 0.05, -2.2, 1.0/9.0 };
+  counted_vector_t e, f;
+
+  // the value operators build a temporary for b*c, a + b*c and the result
+  counted_t::defaults = 0;
+  e = a + b*c - d;
+  ASSERT_EQ( 9, counted_t::defaults );
+
+  // a product of two values is still a value, even inside a lazy chain
+  counted_t::defaults = 0;
+  f = lazy(a) + b*c - d;
+  ASSERT_EQ( 3, counted_t::defaults );
+
+  // every product wrapped, one loop straight into the result
+  counted_t::defaults = 0;
+  f = lazy(a) + lazy(b)*c - d;
+  ASSERT_EQ( 0, counted_t::defaults );
+
+  for ( int i = 0; i < 3; i++ ) ASSERT_EQ( e[i].v, f[i].v );
+
+} // TEST